@@ -2,8 +2,14 @@
 #include <cstdlib>
 #include <iostream>
 #include "serverCommon.h"
+#include "bitStream.h"
+#include "baseband.h"
+#include "sampleFormat.h"
+#include "noiseGenerator.h"
+#include "filter.h"
 #include <format>
 #include <optional>
+#include <random>
 #include <utility>
 
 /// @brief The deviation of Gaussian noise, use in noise normal distribution
@@ -12,6 +18,12 @@ constexpr double NOISE_LEVEL = 0.07;
 /// @brief The index use to smoothing out the noise and maintaining the integrity of the original signal
 constexpr double NOISE_FILTER_ALPHA = 0.7;
 
+/// @brief Key of the channel filter type in the server database, FILTER_TYPE_FIR or FILTER_TYPE_BIQUAD
+constexpr const char *FILTER_TYPE_KEY = "/antenna/filter/type";
+
+/// @brief Key of the channel filter coefficients in the server database, separated by spaces
+constexpr const char *FILTER_COEFFICIENTS_KEY = "/antenna/filter/coefficients";
+
 class Antenna
 {
 public:
@@ -27,9 +39,11 @@ public:
      *  if the parameter is empty, this plot original wave using FFT
      *
      * @param p_dataForDL optional parameter, contain a string of binary data if plot modulated wave
+     * @param p_fileSuffix appended to the paths of the signal files and of the plot
      * @returns None
      */
-    void visualizeData(std::optional<std::pair<std::string, std::string>> p_dataForDL = std::nullopt);
+    void visualizeData(std::optional<std::pair<std::string, std::string>> p_dataForDL = std::nullopt,
+                       const std::string &p_fileSuffix = "");
 
     /**
      * @brief generate the random binary data which simulate the data which we receive
@@ -38,6 +52,14 @@ public:
      * @returns value of length
      */
     std::string randomBinaryMessageGenerator(const int p_length);
+
+    /**
+     * @brief generate random binary data packed 64 bits per word
+     *
+     * @param p_length length of the binary data
+     * @param p_output stream resized to p_length random bits, its capacity is reused
+     */
+    void randomBitStream(const size_t p_length, BitStream &p_output);
     
     /**
      * @brief Add Gaussian noise to the signal
@@ -46,6 +68,25 @@ public:
      */
     void addNoise(std::vector<double> &p_signal);
 
+    /**
+     * @brief Add Gaussian noise to a block of the signal, the noise continues across blocks
+     *
+     * Q15 samples get the noise rounded to Q15 and saturate at full scale instead of wrapping around.
+     *
+     * @param p_signal - samples of the modulated signal, double, float or Q15
+     * @param p_size - the amount of samples
+     */
+    template <typename Sample>
+    void addNoise(Sample *p_signal, const size_t p_size);
+
+    /**
+     * @brief Load the channel filter from the server database, the 2-tap NOISE_FILTER_ALPHA filter is kept
+     * when the keys are missing or invalid
+     *
+     * @return true if the filter of the database is used
+     */
+    bool loadFilter();
+
     /**
      * @brief Filter by smoothing out the noise
      *
@@ -53,7 +94,61 @@ public:
      */
     void filterNoise(std::vector<double> &p_signal);
 
+    /**
+     * @brief Filter a block of the signal, continuing from the previous block
+     *
+     * float and Q15 samples are filtered as amplitudes one block at a time, Q15 outputs saturate at full scale.
+     *
+     * @param p_signal - samples of the modulated signal, double, float or Q15, filtered in place
+     * @param p_size - the amount of samples
+     */
+    template <typename Sample>
+    void filterNoise(Sample *p_signal, const size_t p_size);
+
+    /**
+     * @brief Start filtering a new signal, the filter starts as if the signal had always been its first sample
+     */
+    void resetFilter();
+
+    /**
+     * @brief Restart the noise from a seed, so a run can be reproduced
+     *
+     * @param p_seed - seed of the run
+     * @param p_stream - index of the noise stream, antennas sharing a seed get unrelated noise on other streams
+     */
+    void seedNoise(const uint64_t p_seed, const uint64_t p_stream = 0);
+
+    /**
+     * @brief Add complex Gaussian noise to a block of a baseband signal, the noise continues across blocks
+     *
+     * @param p_signal - IQ samples of the baseband signal
+     * @param p_size - the amount of samples
+     * @param p_rateRatio - baseband sample rate divided by the passband sample rate, so a symbol window
+     * keeps the noise the passband channel leaves after demodulation
+     */
+    void addNoise(IqSample *p_signal, const size_t p_size, const double p_rateRatio);
+
+    /**
+     * @brief Filter a block of a baseband signal
+     *
+     * The filter is far wider than the signal around the carrier, so in baseband it reduces to its response at the carrier.
+     *
+     * @param p_signal - IQ samples of the baseband signal, filtered in place
+     * @param p_size - the amount of samples
+     * @param p_carrierStep - carrier phase advanced by one passband sample (radian)
+     */
+    void filterNoise(IqSample *p_signal, const size_t p_size, const double p_carrierStep);
+
 private:
+    /// @brief Noise source shared by every block, so consecutive blocks get independent noise
+    NoiseGenerator m_noiseGenerator;
+
+    /// @brief Noise of one block of samples, added to the signal once generated
+    double m_noiseBlock[NOISE_BLOCK_SIZE];
+
+    /// @brief Channel filter, its state continues from one block of the signal to the next
+    FilterBank m_filter;
+
     /**
      * @brief using key to get value from database
      *
@@ -62,3 +157,12 @@ private:
      */
     std::optional<std::string> getValue(const std::string &p_key);
 };
+
+/**
+ * @brief Insert a suffix in a file name, before its extension
+ *
+ * @param p_path - a file path
+ * @param p_suffix - the suffix, empty to keep the path
+ * @return "dir/name<suffix>.ext", or the path followed by the suffix without extension
+ */
+std::string addFileSuffix(const std::string &p_path, const std::string &p_suffix);
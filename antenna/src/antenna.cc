@@ -1,13 +1,19 @@
 #include "antenna.h"
+#include <algorithm>
 #include <stdexcept>
 #include <random>
+#include <type_traits>
 
-Antenna::Antenna()
+Antenna::Antenna() : m_filter({NOISE_FILTER_ALPHA, 1 - NOISE_FILTER_ALPHA})
 {
+    // Antennas created within the same second get different noise, unless seeded for a reproducible run
+    std::random_device entropy;
+    m_noiseGenerator.seed((static_cast<uint64_t>(entropy()) << 32) | entropy());
     g_serverLogger.enableLogFile(true);
 }
 
-void Antenna::visualizeData(std::optional<std::pair<std::string, std::string>> p_dataForDL)
+void Antenna::visualizeData(std::optional<std::pair<std::string, std::string>> p_dataForDL,
+                            const std::string &p_fileSuffix)
 {
     std::string plotFileKey;
     std::string binaryCommand;
@@ -43,8 +49,8 @@ void Antenna::visualizeData(std::optional<std::pair<std::string, std::string>> p
         return;
     }
 
-    std::string str = "python3 " + dataValues["plotFile"].value() + " --output " + dataValues["output"].value() + " --inputNoise " \
-    + dataValues["inputNoise"].value()+ " --inputFiltered " + dataValues["inputFiltered"].value() \
+    std::string str = "python3 " + dataValues["plotFile"].value() + " --output " + addFileSuffix(dataValues["output"].value(), p_fileSuffix) + " --inputNoise " \
+    + addFileSuffix(dataValues["inputNoise"].value(), p_fileSuffix) + " --inputFiltered " + addFileSuffix(dataValues["inputFiltered"].value(), p_fileSuffix) \
      + " --fs " + dataValues["fs"].value() +\
      binaryCommand + frequencyCarrier;
     const char *command = str.c_str();
@@ -60,6 +66,17 @@ void Antenna::visualizeData(std::optional<std::pair<std::string, std::string>> p
     }
 }
 
+std::string addFileSuffix(const std::string &p_path, const std::string &p_suffix)
+{
+    size_t nameStart = p_path.find_last_of('/');
+    size_t extension = p_path.find_last_of('.');
+    if (extension == std::string::npos || (nameStart != std::string::npos && extension < nameStart))
+    {
+        return p_path + p_suffix;
+    }
+    return p_path.substr(0, extension) + p_suffix + p_path.substr(extension);
+}
+
 std::optional<std::string> Antenna::getValue(const std::string &p_key)
 {
     try
@@ -78,37 +95,149 @@ std::optional<std::string> Antenna::getValue(const std::string &p_key)
 
 std::string Antenna::randomBinaryMessageGenerator(const int p_length)
 {
-    std::string binaryMessage;
-    srand(time(0));
-    for (int index = 0; index < p_length; index++)
-    {
-        binaryMessage += (rand() % 2 + '0');
-    }
+    BitStream bits;
+    randomBitStream(p_length, bits);
+    std::string binaryMessage = bits.toAscii();
     std::cout << "Generated data: " << binaryMessage << std::endl;
     return binaryMessage;
 }
 
+void Antenna::randomBitStream(const size_t p_length, BitStream &p_output)
+{
+    // One draw fills 64 bits
+    std::mt19937_64 generator(time(0));
+    p_output.resize(p_length);
+    uint64_t *words = p_output.data();
+    for (size_t wordIdx = 0; wordIdx < p_output.getWordCount(); ++wordIdx)
+    {
+        words[wordIdx] = generator();
+    }
+    // Keep the bits past the end at 0
+    p_output.resize(p_length);
+}
+
 void Antenna::addNoise(std::vector<double> &p_signal)
 {
-    std::default_random_engine generator(time(0));
-    std::normal_distribution<double> distribution(0.0, NOISE_LEVEL);
-    for (double &i : p_signal)
+    addNoise(p_signal.data(), p_signal.size());
+}
+
+template <typename Sample>
+void Antenna::addNoise(Sample *p_signal, const size_t p_size)
+{
+    for (size_t blockStart = 0; blockStart < p_size; blockStart += NOISE_BLOCK_SIZE)
+    {
+        size_t blockSize = std::min(NOISE_BLOCK_SIZE, p_size - blockStart);
+        Sample *block = p_signal + blockStart;
+        if constexpr (std::is_same_v<Sample, Q15>)
+        {
+            m_noiseGenerator.fill(m_noiseBlock, blockSize, NOISE_LEVEL * SAMPLE_Q15_SCALE);
+            for (size_t sampleIdx = 0; sampleIdx < blockSize; ++sampleIdx)
+            {
+                // Round half away from zero, the noise stays far inside the int32 range
+                double noise = m_noiseBlock[sampleIdx];
+                int32_t step = static_cast<int32_t>(noise + (noise < 0.0 ? -0.5 : 0.5));
+                block[sampleIdx] = saturateQ15(block[sampleIdx] + step);
+            }
+        }
+        else
+        {
+            m_noiseGenerator.fill(m_noiseBlock, blockSize, NOISE_LEVEL);
+            for (size_t sampleIdx = 0; sampleIdx < blockSize; ++sampleIdx)
+            {
+                block[sampleIdx] += static_cast<Sample>(m_noiseBlock[sampleIdx]);
+            }
+        }
+    }
+}
+
+template void Antenna::addNoise<double>(double *, const size_t);
+template void Antenna::addNoise<float>(float *, const size_t);
+template void Antenna::addNoise<Q15>(Q15 *, const size_t);
+
+bool Antenna::loadFilter()
+{
+    std::optional<std::string> type = getValue(FILTER_TYPE_KEY);
+    std::optional<std::string> coefficients = getValue(FILTER_COEFFICIENTS_KEY);
+    if (!type.has_value() || !coefficients.has_value())
+    {
+        return false;
+    }
+    try
+    {
+        m_filter.configure(type.value(), coefficients.value());
+    }
+    catch (const std::invalid_argument &e)
     {
-        i += distribution(generator);
+        g_serverLogger.error(stringify("Invalid channel filter, keeping the default filter: ", e.what()));
+        return false;
     }
+    g_serverLogger.info(stringify("Channel filter loaded: ", type.value(), " ", coefficients.value()));
+    return true;
 }
 
 void Antenna::filterNoise(std::vector<double> &p_signal)
 {
-    if (p_signal.empty())
-        return;
-    double prevValue = p_signal[0];
-    double currentValue = 0.0;
-    // Using Exponential Moving Average Filter
-    for (size_t i = 1; i < p_signal.size(); ++i)
-    {
-        currentValue = p_signal[i];
-        p_signal[i] = NOISE_FILTER_ALPHA * currentValue + (1 - NOISE_FILTER_ALPHA) * prevValue;
-        prevValue = currentValue;
+    resetFilter();
+    filterNoise(p_signal.data(), p_signal.size());
+}
+
+template <typename Sample>
+void Antenna::filterNoise(Sample *p_signal, const size_t p_size)
+{
+    if constexpr (std::is_same_v<Sample, double>)
+    {
+        m_filter.process(p_signal, p_size);
+    }
+    else
+    {
+        // The filter state is kept in double, so a block is converted in and out around the filter
+        for (size_t blockStart = 0; blockStart < p_size; blockStart += NOISE_BLOCK_SIZE)
+        {
+            size_t blockSize = std::min(NOISE_BLOCK_SIZE, p_size - blockStart);
+            toAmplitudes(p_signal + blockStart, blockSize, m_noiseBlock);
+            m_filter.process(m_noiseBlock, blockSize);
+            toSamples(m_noiseBlock, blockSize, p_signal + blockStart);
+        }
+    }
+}
+
+template void Antenna::filterNoise<double>(double *, const size_t);
+template void Antenna::filterNoise<float>(float *, const size_t);
+template void Antenna::filterNoise<Q15>(Q15 *, const size_t);
+
+void Antenna::resetFilter()
+{
+    m_filter.reset();
+}
+
+void Antenna::seedNoise(const uint64_t p_seed, const uint64_t p_stream)
+{
+    m_noiseGenerator.seed(p_seed, p_stream);
+}
+
+void Antenna::addNoise(IqSample *p_signal, const size_t p_size, const double p_rateRatio)
+{
+    // Correlating N passband samples leaves a noise variance of 2 * sigma^2 / N on I and Q,
+    // averaging M baseband samples leaves sigma_b^2 / M, so sigma_b = sigma * sqrt(2 * M / N)
+    double deviation = NOISE_LEVEL * std::sqrt(2.0 * p_rateRatio);
+    constexpr size_t blockSamples = NOISE_BLOCK_SIZE / 2;
+    for (size_t blockStart = 0; blockStart < p_size; blockStart += blockSamples)
+    {
+        size_t blockSize = std::min(blockSamples, p_size - blockStart);
+        m_noiseGenerator.fill(m_noiseBlock, 2 * blockSize, deviation);
+        for (size_t sampleIdx = 0; sampleIdx < blockSize; ++sampleIdx)
+        {
+            p_signal[blockStart + sampleIdx] += IqSample(m_noiseBlock[2 * sampleIdx], m_noiseBlock[2 * sampleIdx + 1]);
+        }
+    }
+}
+
+void Antenna::filterNoise(IqSample *p_signal, const size_t p_size, const double p_carrierStep)
+{
+    // H(exp(-j * w)) at the carrier w
+    IqSample gain(m_filter.getResponse(p_carrierStep));
+    for (size_t sampleIdx = 0; sampleIdx < p_size; ++sampleIdx)
+    {
+        p_signal[sampleIdx] *= gain;
     }
 }
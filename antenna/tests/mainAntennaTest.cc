@@ -44,6 +44,96 @@ TEST(AntennaTest, genBinaryTest)
     EXPECT_EQ(AntennaObject.randomBinaryMessageGenerator(5).length(), 5);
     EXPECT_NE(AntennaObject.randomBinaryMessageGenerator(5).length(), 6);
 }
+/// @brief Test the baseband noise keeps the noise of a passband symbol window and the filter is the gain at the carrier
+TEST(AntennaTest, basebandChannelTest)
+{
+    Antenna AntennaObject;
+    // 8 baseband samples stand for 1000 passband samples
+    const double rateRatio = 8.0 / 1000.0;
+    std::vector<IqSample> signal(100000, IqSample(0.25f, -0.75f));
+    AntennaObject.addNoise(signal.data(), signal.size(), rateRatio);
+    double power = 0.0;
+    for (const IqSample &sample : signal)
+    {
+        power += std::norm(sample - IqSample(0.25f, -0.75f));
+    }
+    double expectedPower = 2 * NOISE_LEVEL * NOISE_LEVEL * 2 * rateRatio;
+    EXPECT_NEAR(power / signal.size(), expectedPower, 0.05 * expectedPower);
+
+    // A carrier far below the sample rate goes through with a gain close to 1 and a small phase lag
+    IqSample sample(1.0f, 0.0f);
+    AntennaObject.filterNoise(&sample, 1, 2 * M_PI * 5.0 / 5000.0);
+    EXPECT_NEAR(std::abs(sample), 1.0, 1e-3);
+    EXPECT_LT(sample.imag(), 0.0f);
+}
+/// @brief Test antennas seeded alike add the same noise and other seeds or streams add different noise
+TEST(AntennaTest, seededNoiseTest)
+{
+    Antenna firstAntenna;
+    Antenna secondAntenna;
+    std::vector<double> first(3000, 0.5);
+    std::vector<double> second(3000, 0.5);
+    firstAntenna.addNoise(first);
+    secondAntenna.addNoise(second);
+    EXPECT_NE(first, second);
+
+    firstAntenna.seedNoise(42);
+    secondAntenna.seedNoise(42);
+    std::fill(first.begin(), first.end(), 0.5);
+    std::fill(second.begin(), second.end(), 0.5);
+    firstAntenna.addNoise(first);
+    // Blocks continue the noise of the previous block
+    secondAntenna.addNoise(second.data(), 1000);
+    secondAntenna.addNoise(second.data() + 1000, 2000);
+    EXPECT_EQ(first, second);
+
+    secondAntenna.seedNoise(42, 1);
+    std::fill(second.begin(), second.end(), 0.5);
+    secondAntenna.addNoise(second);
+    EXPECT_NE(first, second);
+}
+/// @brief Test the Q15 channel saturates at full scale and filters like the double channel
+TEST(AntennaTest, q15ChannelTest)
+{
+    Antenna AntennaObject;
+    std::vector<Q15> fullScale(10000, INT16_MAX);
+    AntennaObject.addNoise(fullScale.data(), fullScale.size());
+    size_t clipped = 0;
+    for (Q15 sample : fullScale)
+    {
+        // Wrapping around would turn a full scale sample negative
+        EXPECT_GT(sample, 0);
+        clipped += sample == INT16_MAX;
+    }
+    EXPECT_GT(clipped, fullScale.size() / 3);
+
+    std::vector<double> signal(1000);
+    for (size_t sampleIdx = 0; sampleIdx < signal.size(); ++sampleIdx)
+    {
+        signal[sampleIdx] = std::sin(0.05 * sampleIdx) + (static_cast<int>(sampleIdx * 7919 % 13) - 6) * 0.02;
+    }
+    std::vector<Q15> q15Signal(signal.size());
+    std::vector<float> floatSignal(signal.size());
+    toSamples(signal.data(), signal.size(), q15Signal.data());
+    toSamples(signal.data(), signal.size(), floatSignal.data());
+    AntennaObject.filterNoise(signal);
+    AntennaObject.resetFilter();
+    AntennaObject.filterNoise(q15Signal.data(), q15Signal.size());
+    AntennaObject.resetFilter();
+    AntennaObject.filterNoise(floatSignal.data(), floatSignal.size());
+    for (size_t sampleIdx = 0; sampleIdx < signal.size(); ++sampleIdx)
+    {
+        EXPECT_NEAR(SampleFormat<Q15>::toAmplitude(q15Signal[sampleIdx]), signal[sampleIdx], 1.0 / SAMPLE_Q15_SCALE);
+        EXPECT_NEAR(floatSignal[sampleIdx], signal[sampleIdx], 1e-5);
+    }
+}
+/// @brief Test the suffix goes before the extension of the file name only
+TEST(AntennaTest, fileSuffixTest)
+{
+    EXPECT_EQ(addFileSuffix("/home/sample/pic.png", "_reactor1"), "/home/sample/pic_reactor1.png");
+    EXPECT_EQ(addFileSuffix("/home/sample.d/inputNoise", "_reactor1"), "/home/sample.d/inputNoise_reactor1");
+    EXPECT_EQ(addFileSuffix("inputFilter.txt", ""), "inputFilter.txt");
+}
 int main(int argc, char **argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
@@ -7,12 +7,14 @@
 #include <thread>
 #include <unistd.h>
 #include <fcntl.h>
+#include <poll.h>
 #include "logger.h"
 #include "inMemDatabase.h"
+#include "frameBuffer.h"
 #include <optional>
 
-/// @brief Size of the buffer for send and receive message
-constexpr int BUFFER_SIZE = 1024;
+/// @brief The longest wait for the socket to accept more bytes of a message (milliseconds)
+constexpr int SEND_POLL_TIMEOUT = 100;
 
 /// @brief Server IP to which client connect
 constexpr const char *SERVER_IP = "0.0.0.0";
@@ -61,6 +63,12 @@ private:
     /// @brief Thread to continuously holding the connection with the server
     std::thread communicationThread;
 
+    /// @brief Partial reply frame from server, only used by the communication thread
+    FrameReader frameReader;
+
+    /// @brief Message frames the socket has not accepted yet
+    FrameWriter frameWriter;
+
     /**
      * @brief Initiate a connection with the server at the beginning of the program
     */
@@ -78,8 +86,8 @@ private:
     void communicationLoop();
     
     /**
-     * @brief Send a message to server. If no connection is made, client will try to connect with
-     * server and create a new connection
+     * @brief Send a message to server as one length-prefixed frame, waiting until the socket accepts all of it.
+     * If no connection is made, client will try to connect with server and create a new connection
      * 
      * @param p_message The message that needed to be sent
     */
@@ -116,6 +116,9 @@ void Client::connectToServer()
         g_clientLogger.info(stringify("Connected to server at ", serverIp, ":", serverPort));
         connected = true;
         setSocketNonblocking(socketFd); // Optional: Make socket non-blocking
+        // Bytes of a previous connection belong to no frame of this one
+        frameReader = FrameReader();
+        frameWriter = FrameWriter();
     }
     else
     {
@@ -153,29 +156,35 @@ void Client::setSocketNonblocking(int p_fd)
 
 void Client::communicationLoop()
 {
-    char buffer[BUFFER_SIZE];
+    auto printMessage = [](const char *p_payload, size_t p_size)
+    {
+        std::string message(p_payload, p_size);
+        if (!message.empty() && message.back() == '\n')
+        {
+            message.pop_back();
+        }
+        std::cout << message << std::endl;
+        g_clientLogger.info(stringify("Message received: ", message));
+    };
 
     while (connected)
     {
-        // Receive message from server
-        int bytesReceived = recv(socketFd, buffer, BUFFER_SIZE - 1, 0);
+        // Receive every complete message from server, a partial one waits for the rest of its bytes
+        SocketStatus status = frameReader.readFrom(socketFd, printMessage);
 
-        if (bytesReceived > 0)
+        if (status == SocketStatus::CLOSED)
         {
-            if (buffer[bytesReceived - 1] == '\n') {
-                buffer[bytesReceived - 1] = '\0';
-            }
-            buffer[bytesReceived] = '\0';
-            std::cout << buffer << std::endl;
-            g_clientLogger.info(stringify("Message received: ", buffer));
+            g_clientLogger.info("Lose connection with server");
+            connected = false;
+            break;
         }
-        else if (bytesReceived == 0)
+        else if (status == SocketStatus::INVALID_FRAME)
         {
-            g_clientLogger.info("Lose connection with server");
+            g_clientLogger.error("Invalid message length from server");
             connected = false;
             break;
         }
-        else if (errno != EWOULDBLOCK && errno != EAGAIN) // Non-blocking mode check
+        else if (status == SocketStatus::FAILED)
         {
             perror("recv");
             connected = false;
@@ -201,10 +210,20 @@ void Client::sendMessage(const std::string &p_message)
         }
     }
 
-    // Send message
-    if (send(socketFd, p_message.c_str(), p_message.size(), 0) == -1)
+    // Send message, the non-blocking socket may take a long message in several parts
+    frameWriter.push(p_message);
+    while (frameWriter.getPendingSize() != 0)
     {
-        perror("send");
+        if (frameWriter.flush(socketFd) == SocketStatus::FAILED)
+        {
+            perror("send");
+            return;
+        }
+        if (frameWriter.getPendingSize() != 0)
+        {
+            struct pollfd writable = {socketFd, POLLOUT, 0};
+            poll(&writable, 1, SEND_POLL_TIMEOUT);
+        }
     }
 }
 
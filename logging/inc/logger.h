@@ -1,6 +1,7 @@
 #pragma once
 #include <iostream>
 #include <fstream>
+#include <mutex>
 #include <experimental/source_location>
 #include <sstream>
 #include "logException.h"
@@ -92,6 +93,8 @@ public:
 
 private:
     std::ofstream m_logFile;
+    /// @brief Serializes the messages of the threads sharing the logger
+    std::mutex m_mutex;
     std::string m_filePath;
     bool m_saveLogToFile;
     static LogPriority m_priority;
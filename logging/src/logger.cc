@@ -62,14 +62,16 @@ std::string Logger::logStr(const std::string &p_level, const std::string &p_mess
 
 void Logger::log(const std::string &p_level, const std::string &p_message, const sourceInfo &p_location)
 {
+    std::string line = logStr(p_level, p_message, p_location);
+    std::lock_guard<std::mutex> lock(m_mutex);
     if (m_saveLogToFile == true)
     {
-        m_logFile << logStr(p_level, p_message, p_location);
+        m_logFile << line;
         m_logFile.flush();
     }
     else
     {
-        std::cout << logStr(p_level, p_message, p_location);
+        std::cout << line;
     }
 }
 
@@ -0,0 +1,47 @@
+#pragma once
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "oscillator.h"
+
+/// @brief One complex baseband sample, I as real part and Q as imaginary part
+using IqSample = std::complex<float>;
+
+/// @brief The amount of baseband samples of one symbol window, enough for the FSK tones around the carrier
+constexpr size_t BASEBAND_SAMPLES_PER_SYMBOL = 8;
+
+/**
+ * @brief Converts baseband blocks to the real passband signal, only needed to export or visualize it
+ *
+ * A passband sample s = Re{x * exp(j * carrier phase)} takes the baseband sample x covering its time. Every
+ * baseband sample is held over its passband samples, which is exact for the schemes whose symbol is one point
+ * (ASK, BPSK, QAM) and approximates the FSK tones.
+ */
+class Upconverter
+{
+public:
+    /**
+     * @brief Constructor of a converter starting at symbol 0
+     *
+     * @param p_carrierFrequency - carrier wave frequency
+     * @param p_sampleRate - the amount of passband samples in 1 second
+     * @param p_phase - phase of the carrier at sample 0 (radian)
+     * @param p_samplesPerSymbol - the amount of passband samples in one symbol window
+     */
+    Upconverter(const double p_carrierFrequency, const double p_sampleRate, const double p_phase,
+                const size_t p_samplesPerSymbol);
+
+    /**
+     * @brief Convert the next baseband samples, following the samples of the previous writes
+     *
+     * @param p_signal - baseband samples of whole symbol windows
+     * @param p_size - the amount of samples, a multiple of BASEBAND_SAMPLES_PER_SYMBOL
+     * @param p_output - vector resized to the passband samples, its capacity is reused
+     */
+    void write(const IqSample *p_signal, const size_t p_size, std::vector<double> &p_output);
+
+private:
+    Oscillator m_carrier;
+    size_t m_samplesPerSymbol;
+};
@@ -0,0 +1,226 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <vector>
+
+/// @brief The amount of bits packed in one word of a bit stream
+constexpr size_t BITSTREAM_WORD_BITS = 64;
+
+/**
+ * @brief Binary data series packed 64 bits per word
+ *
+ * Bit n is stored in word n / 64 at bit position n % 64, the bits past size() are always 0.
+ * ASCII '0'/'1' characters are only used at the protocol edge through assignAscii() and toAscii().
+ */
+class BitStream
+{
+public:
+    /// @brief Read-only iterator over the bits, first bit first
+    class ConstIterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = bool;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = bool;
+
+        /**
+         * @brief Constructor of an iterator pointing at one bit
+         *
+         * @param p_words - packed words of the stream
+         * @param p_position - index of the bit
+         */
+        ConstIterator(const uint64_t *p_words, const size_t p_position);
+
+        bool operator*() const;
+        ConstIterator &operator++();
+        ConstIterator operator++(int);
+        bool operator==(const ConstIterator &p_other) const;
+        bool operator!=(const ConstIterator &p_other) const;
+
+    private:
+        const uint64_t *m_words;
+        size_t m_position;
+    };
+
+    /// @brief Default constructor of an empty stream
+    BitStream();
+
+    /**
+     * @brief Constructor of a stream of 0 bits
+     *
+     * @param p_size - the amount of bits
+     */
+    explicit BitStream(const size_t p_size);
+
+    /**
+     * @brief Get the amount of bits
+     *
+     * @return the amount of bits
+     */
+    size_t size() const;
+
+    /**
+     * @brief Check if the stream holds no bit
+     *
+     * @return true - no bit, false - at least one bit
+     */
+    bool empty() const;
+
+    /// @brief Remove all bits, the capacity is kept
+    void clear();
+
+    /**
+     * @brief Change the amount of bits, new bits are 0
+     *
+     * @param p_size - the amount of bits
+     */
+    void resize(const size_t p_size);
+
+    /**
+     * @brief Allocate room for bits without changing the size
+     *
+     * @param p_size - the amount of bits
+     */
+    void reserve(const size_t p_size);
+
+    /**
+     * @brief Read one bit
+     *
+     * @param p_position - index of the bit, lower than size()
+     * @return value of the bit
+     */
+    bool get(const size_t p_position) const
+    {
+        return (m_words[p_position / BITSTREAM_WORD_BITS] >> (p_position % BITSTREAM_WORD_BITS)) & 1;
+    }
+
+    /**
+     * @brief Write one bit
+     *
+     * @param p_position - index of the bit, lower than size()
+     * @param p_value - value of the bit
+     */
+    void set(const size_t p_position, const bool p_value)
+    {
+        uint64_t mask = static_cast<uint64_t>(1) << (p_position % BITSTREAM_WORD_BITS);
+        uint64_t &word = m_words[p_position / BITSTREAM_WORD_BITS];
+        word = p_value ? (word | mask) : (word & ~mask);
+    }
+
+    /**
+     * @brief Append one bit
+     *
+     * @param p_value - value of the bit
+     */
+    void pushBack(const bool p_value);
+
+    /**
+     * @brief Append the bits of another stream
+     *
+     * @param p_bits - bits appended after the last bit
+     */
+    void append(const BitStream &p_bits);
+
+    /**
+     * @brief Read a group of bits as one symbol, first bit as most significant
+     *
+     * @param p_position - index of the first bit
+     * @param p_count - the amount of bits, at most 32, p_position + p_count not greater than size()
+     * @return value of the symbol
+     */
+    unsigned int getBits(const size_t p_position, const unsigned int p_count) const;
+
+    /**
+     * @brief Write a symbol as a group of bits, most significant bit first
+     *
+     * @param p_position - index of the first bit
+     * @param p_value - value of the symbol
+     * @param p_count - the amount of bits, p_position + p_count not greater than size()
+     */
+    void setBits(const size_t p_position, const unsigned int p_value, const unsigned int p_count);
+
+    /**
+     * @brief Get the packed words
+     *
+     * @return (size() + 63) / 64 words
+     */
+    const uint64_t *data() const;
+
+    /**
+     * @brief Get the packed words to fill them in place, the bits past size() must stay 0
+     *
+     * @return (size() + 63) / 64 words
+     */
+    uint64_t *data();
+
+    /**
+     * @brief Get the amount of packed words
+     *
+     * @return (size() + 63) / 64
+     */
+    size_t getWordCount() const;
+
+    /**
+     * @brief Validate and pack a series of '0'/'1' characters
+     *
+     * @param p_data - the characters
+     * @param p_size - the amount of characters
+     * @return true - the stream holds the bits, false - a character is neither '0' nor '1' and the stream is emptied
+     */
+    bool assignAscii(const char *p_data, const size_t p_size);
+
+    /**
+     * @brief Validate and pack a binary data series
+     *
+     * @param p_binaryData - a binary data series
+     * @return true - the stream holds the bits, false - a character is neither '0' nor '1' and the stream is emptied
+     */
+    bool assignAscii(const std::string &p_binaryData);
+
+    /**
+     * @brief Unpack the bits into '0'/'1' characters
+     *
+     * @param p_output - buffer receiving size() characters, no terminating null character is written
+     */
+    void toAscii(char *p_output) const;
+
+    /**
+     * @brief Unpack the bits into a string owned by the caller
+     *
+     * @param p_output - string resized to size() characters, its capacity is reused
+     */
+    void toAscii(std::string &p_output) const;
+
+    /**
+     * @brief Unpack the bits into a binary data series
+     *
+     * @return a binary data series
+     */
+    std::string toAscii() const;
+
+    ConstIterator begin() const;
+    ConstIterator end() const;
+
+    bool operator==(const BitStream &p_other) const;
+    bool operator!=(const BitStream &p_other) const;
+
+private:
+    std::vector<uint64_t> m_words;
+    size_t m_size;
+
+    /// @brief Clear the bits of the last word past size()
+    void clearTail();
+};
+
+/**
+ * @brief Check if a series of characters only holds '0' and '1'
+ *
+ * @param p_data - the characters
+ * @param p_size - the amount of characters
+ * @return true - binary data series, false - otherwise
+ */
+bool isBinaryAscii(const char *p_data, const size_t p_size);
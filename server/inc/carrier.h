@@ -1,13 +1,29 @@
 #pragma once
 #include <string>
 #include "serverCommon.h"
+#include "modulationScheme.h"
+
+/// @brief Name of the payloads sent without forward error correction in carrier setup commands
+constexpr const char *FEC_NONE = "none";
+
+/// @brief Name of the rate 1/2, K = 7 convolutional code in carrier setup commands
+constexpr const char *FEC_CONVOLUTIONAL = "conv";
+
+/// @brief Forward error correction of the payloads of a carrier
+enum class FecType
+{
+	NONE,
+	CONVOLUTIONAL
+};
 
 class Carrier
 {
 private:
 	bool m_flagCarrier;
 	std::string m_network;
+	ModulationType m_modulationType;
 	size_t m_frequency;
+	FecType m_fec;
 
 public:
 	/**
@@ -35,6 +51,13 @@ public:
 	 */
 	std::string getNetwork();
 
+	/**
+	 * @brief function is called to get the modulation scheme of the network, resolved when the network is set up
+	 *
+	 * @return modulation scheme, UNKNOWN if the carrier has not been set up
+	 */
+	ModulationType getModulationType();
+
 	/**
 	 * @brief function is called to set frequency
 	 *
@@ -49,6 +72,21 @@ public:
 	 */
 	size_t getFrequency();
 
+	/**
+	 * @brief function is called to set the forward error correction of the payloads
+	 *
+	 * @param p_fec - FEC_NONE or FEC_CONVOLUTIONAL
+	 * @return false - unknown name, the setting is kept, true - set successfully
+	 */
+	bool setFec(const std::string &p_fec);
+
+	/**
+	 * @brief function is called to get the forward error correction of the payloads
+	 *
+	 * @return the code, NONE until it is set or after the carrier is released
+	 */
+	FecType getFec();
+
 	/**
 	 * @brief function is called to remove old setting of carrier
 	 */
@@ -0,0 +1,95 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "bitStream.h"
+
+/// @brief The amount of payload bits every coded pair depends on, the current bit and the 6 before it
+constexpr unsigned int CONV_CONSTRAINT_LENGTH = 7;
+
+/// @brief The amount of trellis states, one per value of the 6 previous payload bits
+constexpr size_t CONV_STATE_COUNT = 1u << (CONV_CONSTRAINT_LENGTH - 1);
+
+/// @brief The generator polynomials of the two coded bits, bit k taps the payload bit k steps back
+constexpr unsigned int CONV_POLYNOMIALS[2] = {0171, 0133};
+
+/// @brief The amount of coded bits of every payload bit
+constexpr size_t CONV_CODED_BITS = 2;
+
+/// @brief The zero bits flushed after the payload, so the trellis ends in state 0
+constexpr size_t CONV_TAIL_BITS = CONV_CONSTRAINT_LENGTH - 1;
+
+/// @brief The amount of quantization steps of one unit of soft ratio, as given by Modulator::demodulateSoft()
+constexpr float CONV_LLR_SCALE = 32.0f;
+
+/// @brief The amount of trellis steps between two renormalizations of the path metrics
+constexpr size_t VITERBI_RENORMALIZE_INTERVAL = 32;
+
+/**
+ * @brief Get the amount of coded bits of a payload, its tail included
+ *
+ * @param p_bitCount - the amount of payload bits
+ * @return CONV_CODED_BITS bits for every payload and tail bit
+ */
+constexpr size_t getConvolutionalCodedSize(const size_t p_bitCount)
+{
+    return CONV_CODED_BITS * (p_bitCount + CONV_TAIL_BITS);
+}
+
+/**
+ * @brief Encode a payload with the rate 1/2, K = 7 convolutional code, a word of bits at a time
+ *
+ * @param p_input - the payload
+ * @param p_output - resized to getConvolutionalCodedSize() bits, the two coded bits of every step in turn
+ */
+void convolutionalEncode(const BitStream &p_input, BitStream &p_output);
+
+/**
+ * @brief Maximum likelihood decoder of the rate 1/2, K = 7 convolutional code
+ *
+ * Every trellis step runs the add-compare-select of the 64 states as 32 butterflies, a vector of 16-bit path
+ * metrics at a time with the SIMD kernel selected by getSimdLevel(), and keeps one decision bit per state.
+ * The trellis ends in state 0 thanks to the tail, from which the decisions are traced back once at the end.
+ */
+class ViterbiDecoder
+{
+public:
+    /**
+     * @brief Decode quantized soft bits
+     *
+     * @param p_llr - log-likelihood ratios of the coded bits, positive for bit 0, see quantizeLlrs()
+     * @param p_size - the amount of ratios, those missing up to getConvolutionalCodedSize() are erasures
+     * @param p_bitCount - the amount of payload bits
+     * @param p_output - resized to p_bitCount bits, receives the payload
+     * @return the amount of payload bits
+     */
+    size_t decode(const int8_t *p_llr, const size_t p_size, const size_t p_bitCount, BitStream &p_output);
+
+    /**
+     * @brief Decode soft bits as given by the demodulators, quantized with CONV_LLR_SCALE
+     *
+     * @param p_llr - log-likelihood ratios of the coded bits, positive for bit 0
+     * @param p_size - the amount of ratios, those missing up to getConvolutionalCodedSize() are erasures
+     * @param p_bitCount - the amount of payload bits
+     * @param p_output - resized to p_bitCount bits, receives the payload
+     * @return the amount of payload bits
+     */
+    size_t decode(const float *p_llr, const size_t p_size, const size_t p_bitCount, BitStream &p_output);
+
+    /**
+     * @brief Decode hard bits, every bit counting as a ratio of the same magnitude
+     *
+     * @param p_coded - the coded bits, those missing up to getConvolutionalCodedSize() are erasures
+     * @param p_bitCount - the amount of payload bits
+     * @param p_output - resized to p_bitCount bits, receives the payload
+     * @return the amount of payload bits
+     */
+    size_t decode(const BitStream &p_coded, const size_t p_bitCount, BitStream &p_output);
+
+private:
+    /// @brief Bit s of word t is the decision of state s at step t, 1 when its predecessor has the high bit set
+    std::vector<uint64_t> m_decisions;
+
+    /// @brief Quantized ratios of every step, erasures included, its capacity is reused
+    std::vector<int8_t> m_llrs;
+};
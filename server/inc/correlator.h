@@ -0,0 +1,161 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+#include "sampleFormat.h"
+#include "simd.h"
+
+/**
+ * @brief Reference waveforms of one symbol window, starting at phase 0 of the window
+ *
+ * @param inPhase - cos(2*pi*f*t + phase) for every sample of the window
+ * @param quadrature - sin(2*pi*f*t + phase) for every sample of the window
+ * @param inPhaseFloat - inPhase in single precision, correlated against float signals
+ * @param quadratureFloat - quadrature in single precision, correlated against float signals
+ * @param inPhaseQ15 - inPhase in Q15, correlated against Q15 signals
+ * @param quadratureQ15 - quadrature in Q15, correlated against Q15 signals
+ */
+struct ReferenceWaveform
+{
+    std::vector<double> inPhase;
+    std::vector<double> quadrature;
+    std::vector<float> inPhaseFloat;
+    std::vector<float> quadratureFloat;
+    std::vector<Q15> inPhaseQ15;
+    std::vector<Q15> quadratureQ15;
+
+    /**
+     * @brief Get the in-phase reference in the format of the correlated signal
+     *
+     * @return double, float or Q15 samples of the window
+     */
+    template <typename Sample>
+    const Sample *getInPhase() const
+    {
+        if constexpr (std::is_same_v<Sample, Q15>)
+        {
+            return inPhaseQ15.data();
+        }
+        else if constexpr (std::is_same_v<Sample, float>)
+        {
+            return inPhaseFloat.data();
+        }
+        else
+        {
+            return inPhase.data();
+        }
+    }
+
+    /**
+     * @brief Get the quadrature reference in the format of the correlated signal
+     *
+     * @return double, float or Q15 samples of the window
+     */
+    template <typename Sample>
+    const Sample *getQuadrature() const
+    {
+        if constexpr (std::is_same_v<Sample, Q15>)
+        {
+            return quadratureQ15.data();
+        }
+        else if constexpr (std::is_same_v<Sample, float>)
+        {
+            return quadratureFloat.data();
+        }
+        else
+        {
+            return quadrature.data();
+        }
+    }
+};
+
+/**
+ * @brief Build the reference waveforms of one symbol window
+ *
+ * @param p_frequency - frequency of the reference tone (Hz)
+ * @param p_sampleRate - the amount of samples in 1 second
+ * @param p_phase - phase of the reference tone at the first sample (radian)
+ * @param p_samples - the amount of samples in one window
+ * @return in-phase and quadrature references
+ */
+ReferenceWaveform buildReferenceWaveform(const double p_frequency, const double p_sampleRate,
+                                         const double p_phase, const size_t p_samples);
+
+/**
+ * @brief Correlate a signal window against the in-phase and quadrature references at once
+ *
+ * @param p_signal - samples of the window
+ * @param p_inPhase - in-phase reference of the window
+ * @param p_quadrature - quadrature reference of the window
+ * @param p_count - the amount of samples in the window
+ * @param p_inPhaseSum - receives sum(signal * inPhase)
+ * @param p_quadratureSum - receives sum(signal * quadrature)
+ */
+void correlateQuadrature(const double *p_signal, const double *p_inPhase, const double *p_quadrature,
+                         const size_t p_count, double &p_inPhaseSum, double &p_quadratureSum);
+
+/**
+ * @brief Correlate a single precision signal window, twice as many samples per instruction as double
+ *
+ * @param p_signal - samples of the window
+ * @param p_inPhase - in-phase reference of the window
+ * @param p_quadrature - quadrature reference of the window
+ * @param p_count - the amount of samples in the window
+ * @param p_inPhaseSum - receives sum(signal * inPhase)
+ * @param p_quadratureSum - receives sum(signal * quadrature)
+ */
+void correlateQuadrature(const float *p_signal, const float *p_inPhase, const float *p_quadrature,
+                         const size_t p_count, double &p_inPhaseSum, double &p_quadratureSum);
+
+/**
+ * @brief Correlate a Q15 signal window with exact integer products
+ *
+ * @param p_signal - samples of the window
+ * @param p_inPhase - in-phase reference of the window
+ * @param p_quadrature - quadrature reference of the window
+ * @param p_count - the amount of samples in the window
+ * @param p_inPhaseSum - receives sum(signal * inPhase) in amplitude units
+ * @param p_quadratureSum - receives sum(signal * quadrature) in amplitude units
+ */
+void correlateQuadrature(const Q15 *p_signal, const Q15 *p_inPhase, const Q15 *p_quadrature,
+                         const size_t p_count, double &p_inPhaseSum, double &p_quadratureSum);
+
+/**
+ * @brief Rotate the correlations of a window by the carrier phase the window starts at
+ *
+ * References start at phase 0 of a window, the rotation gives the correlations against the carrier
+ * at its phase from sample 0 of the signal.
+ *
+ * @param p_windowPhase - carrier phase advanced from sample 0 to the first sample of the window
+ * @param p_inPhase - correlation with the in-phase reference, rotated in place
+ * @param p_quadrature - correlation with the quadrature reference, rotated in place
+ */
+void rotateCorrelation(const uint64_t p_windowPhase, double &p_inPhase, double &p_quadrature);
+
+/**
+ * @brief Sum the absolute values of a signal window (envelope detector of ASK)
+ *
+ * @param p_signal - samples of the window
+ * @param p_count - the amount of samples in the window
+ * @return sum(|signal|)
+ */
+double sumAbsolute(const double *p_signal, const size_t p_count);
+
+/**
+ * @brief Sum the absolute values of a single precision signal window
+ *
+ * @param p_signal - samples of the window
+ * @param p_count - the amount of samples in the window
+ * @return sum(|signal|)
+ */
+double sumAbsolute(const float *p_signal, const size_t p_count);
+
+/**
+ * @brief Sum the absolute values of a Q15 signal window
+ *
+ * @param p_signal - samples of the window
+ * @param p_count - the amount of samples in the window
+ * @return sum(|signal|) in amplitude units
+ */
+double sumAbsolute(const Q15 *p_signal, const size_t p_count);
@@ -0,0 +1,140 @@
+#pragma once
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Precomputed factors and twiddles of a forward discrete Fourier transform of one size
+ *
+ * Mixed-radix Cooley-Tukey: the size is split into radix-4 stages first, then radix-2, 3, 5 and any
+ * remaining prime, so every size is supported and powers of 2 take the radix-4 path. Radix 5 has its own
+ * butterfly since the sample rates of the server are multiples of 1000.
+ * A plan is not changed after construction and may be used by several threads at once.
+ */
+class FftPlan
+{
+public:
+    /**
+     * @brief Constructor of the plan of one size
+     *
+     * @param p_size - the amount of points, at least 1
+     */
+    explicit FftPlan(const size_t p_size);
+
+    /**
+     * @brief Get the amount of points
+     *
+     * @return the amount of points
+     */
+    size_t size() const;
+
+    /**
+     * @brief Forward transform, X[k] = sum(x[n] * exp(-2*pi*i*k*n/N)) as numpy.fft.fft
+     *
+     * @param p_input - size() points, must not overlap p_output
+     * @param p_output - receives size() points
+     */
+    void transform(const std::complex<double> *p_input, std::complex<double> *p_output) const;
+
+private:
+    size_t m_size;
+
+    /// @brief exp(-2*pi*i*k/N) for k in [0, N)
+    std::vector<std::complex<double>> m_twiddles;
+
+    /// @brief (radix, remaining length) of every stage
+    std::vector<std::pair<size_t, size_t>> m_stages;
+
+    /**
+     * @brief Transform one sub-sequence, recursing over the remaining stages
+     *
+     * @param p_output - receives the points of the sub-sequence
+     * @param p_input - first point of the sub-sequence
+     * @param p_stride - distance between two points of the sub-sequence in p_input
+     * @param p_stageIdx - the stage splitting the sub-sequence
+     */
+    void transformStage(std::complex<double> *p_output, const std::complex<double> *p_input,
+                        const size_t p_stride, const size_t p_stageIdx) const;
+
+    void butterfly2(std::complex<double> *p_output, const size_t p_stride, const size_t p_length) const;
+    void butterfly3(std::complex<double> *p_output, const size_t p_stride, const size_t p_length) const;
+    void butterfly4(std::complex<double> *p_output, const size_t p_stride, const size_t p_length) const;
+    void butterfly5(std::complex<double> *p_output, const size_t p_stride, const size_t p_length) const;
+    void butterflyGeneric(std::complex<double> *p_output, const size_t p_stride, const size_t p_length,
+                          const size_t p_radix) const;
+};
+
+/**
+ * @brief Forward transform of real points, computing only the non-negative frequencies
+ *
+ * An even size packs the even and odd points into one complex transform of half the size and splits
+ * the result afterwards, about half the work of a complex transform. An odd size uses a complex transform.
+ */
+class RealFftPlan
+{
+public:
+    /**
+     * @brief Constructor of the plan of one size
+     *
+     * @param p_size - the amount of real points, at least 1
+     */
+    explicit RealFftPlan(const size_t p_size);
+
+    /**
+     * @brief Get the amount of real points
+     *
+     * @return the amount of points
+     */
+    size_t size() const;
+
+    /**
+     * @brief Get the amount of bins produced, the non-negative frequencies
+     *
+     * @return size() / 2 + 1
+     */
+    size_t getBinCount() const;
+
+    /**
+     * @brief Forward transform, bins 0 to N/2 of numpy.fft.fft, the others are their complex conjugates
+     *
+     * @param p_input - size() real points
+     * @param p_output - receives getBinCount() bins
+     * @param p_scratch - working buffer, resized as needed so its capacity can be reused
+     */
+    void transform(const double *p_input, std::complex<double> *p_output,
+                   std::vector<std::complex<double>> &p_scratch) const;
+
+private:
+    size_t m_size;
+
+    /// @brief Complex plan of N/2 points for an even size, of N points for an odd size
+    FftPlan m_complexPlan;
+
+    /// @brief exp(-2*pi*i*k/N) for k in [0, N/2], used to split the packed transform
+    std::vector<std::complex<double>> m_splitTwiddles;
+};
+
+/**
+ * @brief Get the plan of one size, built on first use and kept for the lifetime of the process
+ *
+ * @param p_size - the amount of points, at least 1
+ * @return the plan, safe to use from several threads
+ */
+const FftPlan &getFftPlan(const size_t p_size);
+
+/**
+ * @brief Get the real-input plan of one size, built on first use and kept for the lifetime of the process
+ *
+ * @param p_size - the amount of real points, at least 1
+ * @return the plan, safe to use from several threads
+ */
+const RealFftPlan &getRealFftPlan(const size_t p_size);
+
+/**
+ * @brief Get the frequency of every bin of a transform, as numpy.fft.fftfreq
+ *
+ * @param p_size - the amount of points of the transform
+ * @param p_sampleRate - the amount of samples in 1 second
+ * @param p_output - resized to p_size frequencies (Hz), negative for the upper half
+ */
+void getFftFrequencies(const size_t p_size, const double p_sampleRate, std::vector<double> &p_output);
@@ -0,0 +1,255 @@
+#pragma once
+#include <array>
+#include <complex>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/// @brief The amount of samples filtered by one kernel call, longer signals are split into blocks
+constexpr size_t FILTER_BLOCK_SIZE = 512;
+
+/// @brief The amount of coefficients of one biquad section in a coefficient list: b0 b1 b2 a1 a2
+constexpr size_t BIQUAD_COEFFICIENTS = 5;
+
+/// @brief Filter type of FIR coefficients in the server database
+constexpr const char *FILTER_TYPE_FIR = "fir";
+
+/// @brief Filter type of biquad coefficients in the server database
+constexpr const char *FILTER_TYPE_BIQUAD = "biquad";
+
+/**
+ * @brief One second order IIR section, y[n] = b0 x[n] + b1 x[n-1] + b2 x[n-2] - a1 y[n-1] - a2 y[n-2]
+ */
+struct BiquadSection
+{
+    double b0;
+    double b1;
+    double b2;
+    double a1;
+    double a2;
+};
+
+/**
+ * @brief FIR filter processing blocks of samples in place, its history continues from one block to the next
+ *
+ * Every block is appended to the history and the outputs are computed a vector of outputs at a time,
+ * broadcasting one tap over the vector, with the SIMD kernel selected by getSimdLevel().
+ */
+class FirFilter
+{
+public:
+    /**
+     * @brief Constructor of a filter
+     *
+     * @param p_taps - p_taps[k] multiplies the input k samples back, at least one tap
+     */
+    explicit FirFilter(const std::vector<double> &p_taps = {1.0});
+
+    /**
+     * @brief Replace the taps and restart the history
+     *
+     * @param p_taps - p_taps[k] multiplies the input k samples back, at least one tap
+     */
+    void setTaps(const std::vector<double> &p_taps);
+
+    /**
+     * @brief Get the taps
+     *
+     * @return p_taps[k] multiplies the input k samples back
+     */
+    const std::vector<double> &getTaps() const;
+
+    /**
+     * @brief Start filtering a new signal, the history is filled with its first sample as a steady input
+     */
+    void reset();
+
+    /**
+     * @brief Filter a block of the signal, continuing from the previous block
+     *
+     * @param p_signal - samples filtered in place
+     * @param p_size - the amount of samples
+     */
+    void process(double *p_signal, const size_t p_size);
+
+    /**
+     * @brief Get the frequency response
+     *
+     * @param p_angularFrequency - frequency in radian per sample
+     * @return H(exp(j * w))
+     */
+    std::complex<double> getResponse(const double p_angularFrequency) const;
+
+private:
+    /// @brief The taps, m_taps[k] multiplies the input k samples back
+    std::vector<double> m_taps;
+
+    /// @brief The taps oldest first, the order the kernels walk the history in
+    std::vector<double> m_reversedTaps;
+
+    /// @brief The last m_taps.size() - 1 inputs followed by the current block
+    std::vector<double> m_history;
+
+    /// @brief true once the history holds inputs of the current signal
+    bool m_isPrimed;
+};
+
+/**
+ * @brief Cascade of biquad sections processing blocks of samples in place, the states continue across blocks
+ *
+ * The recursion of a section depends on its previous output, so every section runs over a whole block before
+ * the next one, keeping its coefficients and state in registers.
+ */
+class BiquadCascade
+{
+public:
+    /**
+     * @brief Constructor of a cascade
+     *
+     * @param p_sections - sections applied in order, none passes the signal unchanged
+     */
+    explicit BiquadCascade(const std::vector<BiquadSection> &p_sections = {});
+
+    /**
+     * @brief Replace the sections and restart the states
+     *
+     * @param p_sections - sections applied in order
+     */
+    void setSections(const std::vector<BiquadSection> &p_sections);
+
+    /**
+     * @brief Start filtering a new signal, the states are set as for a steady input equal to its first sample
+     */
+    void reset();
+
+    /**
+     * @brief Filter a block of the signal, continuing from the previous block
+     *
+     * @param p_signal - samples filtered in place
+     * @param p_size - the amount of samples
+     */
+    void process(double *p_signal, const size_t p_size);
+
+    /**
+     * @brief Get the frequency response
+     *
+     * @param p_angularFrequency - frequency in radian per sample
+     * @return H(exp(j * w)), the product of the responses of the sections
+     */
+    std::complex<double> getResponse(const double p_angularFrequency) const;
+
+private:
+    /// @brief The sections applied in order
+    std::vector<BiquadSection> m_sections;
+
+    /// @brief The two transposed direct form II states of every section
+    std::vector<std::array<double, 2>> m_states;
+
+    /// @brief true once the states hold the current signal
+    bool m_isPrimed;
+};
+
+/**
+ * @brief The channel filter: a FIR filter or a biquad cascade, chosen from coefficients of the server database
+ */
+class FilterBank
+{
+public:
+    /**
+     * @brief Constructor of a FIR filter bank
+     *
+     * @param p_taps - p_taps[k] multiplies the input k samples back
+     */
+    explicit FilterBank(const std::vector<double> &p_taps = {1.0});
+
+    /**
+     * @brief Select the filter from the values stored in the server database
+     *
+     * @param p_type - FILTER_TYPE_FIR or FILTER_TYPE_BIQUAD
+     * @param p_coefficients - the taps, or b0 b1 b2 a1 a2 of every section, separated by spaces
+     * @throw std::invalid_argument for an unknown type or coefficients that are not numbers, the filter is kept
+     */
+    void configure(const std::string &p_type, const std::string &p_coefficients);
+
+    /**
+     * @brief Use a FIR filter
+     *
+     * @param p_taps - p_taps[k] multiplies the input k samples back, at least one tap
+     */
+    void setFir(const std::vector<double> &p_taps);
+
+    /**
+     * @brief Use a biquad cascade
+     *
+     * @param p_sections - sections applied in order
+     */
+    void setBiquad(const std::vector<BiquadSection> &p_sections);
+
+    /**
+     * @brief Start filtering a new signal
+     */
+    void reset();
+
+    /**
+     * @brief Filter a block of the signal, continuing from the previous block
+     *
+     * @param p_signal - samples filtered in place
+     * @param p_size - the amount of samples
+     */
+    void process(double *p_signal, const size_t p_size);
+
+    /**
+     * @brief Get the frequency response of the selected filter
+     *
+     * @param p_angularFrequency - frequency in radian per sample
+     * @return H(exp(j * w))
+     */
+    std::complex<double> getResponse(const double p_angularFrequency) const;
+
+private:
+    /// @brief true when the biquad cascade is selected, false for the FIR filter
+    bool m_isBiquad;
+
+    FirFilter m_fir;
+    BiquadCascade m_biquad;
+};
+
+/**
+ * @brief Design a linear phase low-pass FIR filter, a Hamming windowed sinc
+ *
+ * @param p_cutoff - cutoff frequency (Hz)
+ * @param p_sampleRate - the amount of samples in 1 second
+ * @param p_tapCount - the amount of taps, odd for a whole sample delay of (p_tapCount - 1) / 2
+ * @return taps with a gain of 1 at 0 Hz
+ */
+std::vector<double> designLowPass(const double p_cutoff, const double p_sampleRate, const size_t p_tapCount);
+
+/**
+ * @brief Design a raised cosine pulse shaping filter
+ *
+ * @param p_rolloff - excess bandwidth, from 0 to 1
+ * @param p_samplesPerSymbol - the amount of samples of one symbol
+ * @param p_spanSymbols - the amount of symbols covered by the taps
+ * @return p_samplesPerSymbol * p_spanSymbols + 1 taps with a gain of 1 at 0 Hz
+ */
+std::vector<double> designRaisedCosine(const double p_rolloff, const size_t p_samplesPerSymbol,
+                                       const size_t p_spanSymbols);
+
+/**
+ * @brief Design the matched filter of a pulse
+ *
+ * @param p_pulse - samples of the pulse
+ * @param p_size - the amount of samples
+ * @return the pulse reversed in time, scaled to unit energy
+ */
+std::vector<double> designMatchedFilter(const double *p_pulse, const size_t p_size);
+
+/**
+ * @brief Design a second order low-pass section (Butterworth for a quality factor of 1 / sqrt(2))
+ *
+ * @param p_cutoff - cutoff frequency (Hz)
+ * @param p_sampleRate - the amount of samples in 1 second
+ * @param p_quality - quality factor of the section
+ * @return a section with a gain of 1 at 0 Hz
+ */
+BiquadSection designLowPassBiquad(const double p_cutoff, const double p_sampleRate, const double p_quality);
@@ -0,0 +1,154 @@
+#pragma once
+#include <cstddef>
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <string>
+#include <vector>
+
+/// @brief The amount of bytes of the big-endian payload length in front of every frame
+constexpr size_t FRAME_HEADER_SIZE = 4;
+
+/// @brief The largest payload of a frame, a longer length is a protocol error
+constexpr size_t FRAME_MAX_PAYLOAD = 1 << 24;
+
+/// @brief The least amount of free bytes offered to one recv() call
+constexpr size_t FRAME_READ_CHUNK = 16384;
+
+/// @brief The most frames gathered by one write, two buffers each: the header and the payload
+constexpr size_t FRAME_WRITE_BATCH = 64;
+
+/// @brief Receives the payload of every complete frame, valid during the call only
+using FrameSink = std::function<void(const char *p_payload, size_t p_size)>;
+
+/// @brief Asked before every read of the socket, true stops reading until the caller resumes
+using ReadPause = std::function<bool()>;
+
+/// @brief State of a connection after reading from or writing to its socket
+enum class SocketStatus
+{
+    /// @brief Every available byte has been handled, the socket would block now
+    OPEN,
+    /// @brief The peer closed the connection
+    CLOSED,
+    /// @brief The socket failed, errno tells why
+    FAILED,
+    /// @brief A frame announced a payload longer than FRAME_MAX_PAYLOAD, the stream can not be resynchronized
+    INVALID_FRAME,
+    /// @brief Reading stopped on request before the socket would block, the rest stays in the socket
+    PAUSED
+};
+
+/**
+ * @brief Reassembly of length-prefixed frames from a non-blocking stream socket
+ *
+ * Every read drains the socket until it would block, as required by edge-triggered epoll, and hands out the
+ * complete frames while reading, so the buffer only ever holds one partial frame and the bytes of one recv().
+ */
+class FrameReader
+{
+public:
+    /// @brief Constructor of a reader without buffered bytes
+    FrameReader();
+
+    /**
+     * @brief Read every available byte of a socket and hand out the complete frames
+     *
+     * @param p_socket - a non-blocking stream socket
+     * @param p_sink - receives the payload of every complete frame, in order
+     * @param p_pause - asked before every recv(), none reads until the socket would block
+     * @return OPEN when the socket would block, the partial frame staying buffered for the next read,
+     * PAUSED when p_pause stopped reading first
+     */
+    SocketStatus readFrom(const int p_socket, const FrameSink &p_sink, const ReadPause &p_pause = nullptr);
+
+    /**
+     * @brief Get the amount of bytes of the partial frame waiting for the rest of its bytes
+     *
+     * @return the amount of buffered bytes
+     */
+    size_t getBufferedSize() const;
+
+private:
+    /// @brief Received bytes from m_start to m_end, the room after m_end receives the next recv()
+    std::vector<char> m_buffer;
+    size_t m_start;
+    size_t m_end;
+
+    /**
+     * @brief Hand out the complete frames of the buffer
+     *
+     * @param p_sink - receives the payload of every complete frame
+     * @return false if a frame is longer than FRAME_MAX_PAYLOAD
+     */
+    bool extractFrames(const FrameSink &p_sink);
+};
+
+/**
+ * @brief Queue of length-prefixed frames written to a non-blocking stream socket
+ *
+ * Frames are appended behind the bytes the socket has not accepted yet and written until the socket would block,
+ * the rest waits for the next flush. Every frame keeps its payload in its own buffer, so one system call gathers
+ * the headers and payloads of up to FRAME_WRITE_BATCH frames without copying them together.
+ */
+class FrameWriter
+{
+public:
+    /// @brief Constructor of an empty queue
+    FrameWriter();
+
+    /**
+     * @brief Append a frame
+     *
+     * @param p_payload - the payload, at most FRAME_MAX_PAYLOAD bytes
+     * @param p_size - the amount of bytes of the payload
+     */
+    void push(const char *p_payload, const size_t p_size);
+
+    /**
+     * @brief Append a frame
+     *
+     * @param p_payload - the payload, at most FRAME_MAX_PAYLOAD bytes
+     */
+    void push(const std::string &p_payload);
+
+    /**
+     * @brief Append a frame, taking over the payload without copying it
+     *
+     * @param p_payload - the payload, at most FRAME_MAX_PAYLOAD bytes
+     */
+    void push(std::string &&p_payload);
+
+    /**
+     * @brief Write the queued bytes until the socket would block
+     *
+     * @param p_socket - a non-blocking stream socket
+     * @return OPEN when the queue is empty or the socket would block, FAILED when the socket failed
+     */
+    SocketStatus flush(const int p_socket);
+
+    /**
+     * @brief Get the amount of bytes not written yet
+     *
+     * @return the amount of queued bytes
+     */
+    size_t getPendingSize() const;
+
+private:
+    /// @brief A queued frame
+    struct Frame
+    {
+        std::array<char, FRAME_HEADER_SIZE> header;
+        std::string payload;
+    };
+
+    /// @brief Queued frames, oldest first
+    std::deque<Frame> m_frames;
+
+    /// @brief The amount of bytes of the oldest frame, header included, already written
+    size_t m_written;
+
+    /// @brief The amount of queued bytes not written yet
+    size_t m_pendingSize;
+};
@@ -0,0 +1,64 @@
+#pragma once
+#include <complex>
+#include <cstddef>
+#include "sampleFormat.h"
+
+/// @brief The amount of interleaved Goertzel recursions per tone, lane k takes the samples k, k + 8, k + 16...
+constexpr size_t GOERTZEL_LANES = 8;
+
+/// @brief The maximum amount of tones detected in one pass over the samples (2 for BFSK)
+constexpr size_t GOERTZEL_MAX_TONES = 2;
+
+/**
+ * @brief Tone detector computing the DFT of a block at a few frequencies with the Goertzel algorithm
+ *
+ * Every tone costs one multiply-add and one subtraction per sample and no trigonometry in the loop. The samples are
+ * split over GOERTZEL_LANES recursions running at the frequency multiplied by the amount of lanes, side by side in
+ * the vector registers of the SIMD kernels, and the lanes are turned back to the tone frequency and added at the end.
+ */
+class GoertzelDetector
+{
+public:
+    /// @brief Default constructor, no tone to detect
+    GoertzelDetector();
+
+    /**
+     * @brief Select the tones to detect
+     *
+     * @param p_frequencies - frequency of every tone (Hz)
+     * @param p_toneCount - the amount of tones, at most GOERTZEL_MAX_TONES
+     * @param p_sampleRate - the amount of samples in 1 second
+     */
+    void configure(const double *p_frequencies, const size_t p_toneCount, const double p_sampleRate);
+
+    /**
+     * @brief Correlate a block with every tone
+     *
+     * @param p_samples - samples of the block, double, float or Q15
+     * @param p_count - the amount of samples
+     * @param p_correlations - receives sum(x[n] * exp(-j * w * n)) of every tone, n counted from the start of the block
+     */
+    template <typename Sample>
+    void correlate(const Sample *p_samples, const size_t p_count, std::complex<double> *p_correlations);
+
+private:
+    size_t m_toneCount;
+
+    /// @brief Frequency of every tone in radian per sample
+    double m_angle[GOERTZEL_MAX_TONES];
+
+    /// @brief 2 * cos(GOERTZEL_LANES * w), the feedback of the recursions of every tone
+    double m_coefficient[GOERTZEL_MAX_TONES];
+
+    /// @brief exp(-j * w * k), the delay of lane k relative to lane 0
+    std::complex<double> m_laneRotation[GOERTZEL_MAX_TONES][GOERTZEL_LANES];
+
+    /// @brief exp(-j * GOERTZEL_LANES * w), the delay of one step of a recursion
+    std::complex<double> m_groupDelay[GOERTZEL_MAX_TONES];
+
+    /// @brief The amount of samples per lane the rotations below were computed for
+    size_t m_groupCount;
+
+    /// @brief exp(-j * GOERTZEL_LANES * w * (m_groupCount - 1)), turning the last recursion output back to the block start
+    std::complex<double> m_groupRotation[GOERTZEL_MAX_TONES];
+};
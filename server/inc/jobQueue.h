@@ -0,0 +1,73 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// @brief A job of the queue, given the index of the worker running it, so it can use state owned by that worker
+using Job = std::function<void(size_t p_workerIdx)>;
+
+/**
+ * @brief Fixed set of worker threads running long jobs in the order they were pushed
+ *
+ * Unlike ThreadPool, which splits one loop between the threads and waits for it, a job is handed to the first
+ * free worker and push() returns at once, so the pushing thread goes on serving other requests. The job reports
+ * its own completion, e.g. through Reactor replies.
+ */
+class JobQueue
+{
+public:
+    /**
+     * @brief Constructor starting the workers
+     *
+     * @param p_workerCount - the amount of workers, at least 1
+     */
+    explicit JobQueue(const size_t p_workerCount);
+
+    /**
+     * @brief Destructor finishing the running jobs, dropping the queued ones and joining the workers
+     */
+    ~JobQueue();
+
+    JobQueue(const JobQueue &) = delete;
+    JobQueue &operator=(const JobQueue &) = delete;
+
+    /**
+     * @brief Queue a job for the next free worker
+     *
+     * @param p_job - the job, it must not throw
+     */
+    void push(Job &&p_job);
+
+    /**
+     * @brief Get the amount of workers
+     *
+     * @return the amount of workers
+     */
+    size_t getWorkerCount() const;
+
+    /**
+     * @brief Get the amount of jobs waiting for a free worker
+     *
+     * @return the amount of queued jobs
+     */
+    size_t getQueuedCount();
+
+private:
+    std::deque<Job> m_jobs;
+    std::vector<std::thread> m_workers;
+
+    std::mutex m_mutex;
+    std::condition_variable m_jobReady;
+    bool m_isStopping;
+
+    /**
+     * @brief Run queued jobs until the queue stops
+     *
+     * @param p_workerIdx - the index of the worker
+     */
+    void runWorker(const size_t p_workerIdx);
+};
@@ -0,0 +1,200 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include "qamConstellation.h"
+
+/// @brief The sizeo of bits chunk when using 16QAM to modulate
+constexpr unsigned int BIT_SIZE_16QAM = 4;
+
+/// @brief The size of bits chunk when using 64QAM to modulate
+constexpr unsigned int BIT_SIZE_64QAM = 6;
+
+/// @brief The size of bits chunk when using 256QAM to modulate
+constexpr unsigned int BIT_SIZE_256QAM = 8;
+
+/// @brief The amplitude levels for 16QAM constellation diagram
+constexpr double IQ_VALUES[] = {-0.75, -0.25, 0.25, 0.75};
+
+/// @brief The modulation schemes, resolved once from the network type
+enum class ModulationType
+{
+    UNKNOWN,
+    ASK,
+    BPSK,
+    BFSK,
+    QAM16,
+    OFDM,
+    QAM64,
+    QAM256
+};
+
+/// @brief The amount of values of ModulationType
+constexpr size_t MODULATION_TYPE_COUNT = 8;
+
+/**
+ * @brief Compile-time description of a modulation scheme, specialized for every ModulationType
+ *
+ * @param NETWORK - network type using the scheme
+ * @param NAME - name of the scheme used in messages
+ * @param BITS_PER_SYMBOL - the amount of bits carried by one symbol window
+ */
+template <ModulationType Type>
+struct ModulationScheme;
+
+template <>
+struct ModulationScheme<ModulationType::ASK>
+{
+    static constexpr const char *NETWORK = "2G";
+    static constexpr const char *NAME = "ASK";
+    static constexpr unsigned int BITS_PER_SYMBOL = 1;
+};
+
+template <>
+struct ModulationScheme<ModulationType::BPSK>
+{
+    static constexpr const char *NETWORK = "3G";
+    static constexpr const char *NAME = "BPSK";
+    static constexpr unsigned int BITS_PER_SYMBOL = 1;
+};
+
+template <>
+struct ModulationScheme<ModulationType::BFSK>
+{
+    static constexpr const char *NETWORK = "4G";
+    static constexpr const char *NAME = "BFSK";
+    static constexpr unsigned int BITS_PER_SYMBOL = 1;
+};
+
+/// @brief Constellation - mapping and slicing of the points of a QAM scheme
+template <>
+struct ModulationScheme<ModulationType::QAM16>
+{
+    static constexpr const char *NETWORK = "5G";
+    static constexpr const char *NAME = "16-QAM";
+    static constexpr unsigned int BITS_PER_SYMBOL = BIT_SIZE_16QAM;
+    using Constellation = QamConstellation<BITS_PER_SYMBOL>;
+};
+
+template <>
+struct ModulationScheme<ModulationType::QAM64>
+{
+    static constexpr const char *NETWORK = "64QAM";
+    static constexpr const char *NAME = "64-QAM";
+    static constexpr unsigned int BITS_PER_SYMBOL = BIT_SIZE_64QAM;
+    using Constellation = QamConstellation<BITS_PER_SYMBOL>;
+};
+
+template <>
+struct ModulationScheme<ModulationType::QAM256>
+{
+    static constexpr const char *NETWORK = "256QAM";
+    static constexpr const char *NAME = "256-QAM";
+    static constexpr unsigned int BITS_PER_SYMBOL = BIT_SIZE_256QAM;
+    using Constellation = QamConstellation<BITS_PER_SYMBOL>;
+};
+
+/// @brief Every subcarrier carries one 16-QAM point, so payloads come in groups of 4 bits as for 16-QAM
+template <>
+struct ModulationScheme<ModulationType::OFDM>
+{
+    static constexpr const char *NETWORK = "OFDM";
+    static constexpr const char *NAME = "OFDM";
+    static constexpr unsigned int BITS_PER_SYMBOL = BIT_SIZE_16QAM;
+};
+
+/**
+ * @brief Resolve the modulation scheme of a network type
+ *
+ * @param p_network - a network type
+ * @return the scheme, UNKNOWN for an unsupported network
+ */
+inline ModulationType toModulationType(const std::string &p_network)
+{
+    if (p_network == ModulationScheme<ModulationType::ASK>::NETWORK)
+    {
+        return ModulationType::ASK;
+    }
+    if (p_network == ModulationScheme<ModulationType::BPSK>::NETWORK)
+    {
+        return ModulationType::BPSK;
+    }
+    if (p_network == ModulationScheme<ModulationType::BFSK>::NETWORK)
+    {
+        return ModulationType::BFSK;
+    }
+    if (p_network == ModulationScheme<ModulationType::QAM16>::NETWORK)
+    {
+        return ModulationType::QAM16;
+    }
+    if (p_network == ModulationScheme<ModulationType::OFDM>::NETWORK)
+    {
+        return ModulationType::OFDM;
+    }
+    if (p_network == ModulationScheme<ModulationType::QAM64>::NETWORK)
+    {
+        return ModulationType::QAM64;
+    }
+    if (p_network == ModulationScheme<ModulationType::QAM256>::NETWORK)
+    {
+        return ModulationType::QAM256;
+    }
+    return ModulationType::UNKNOWN;
+}
+
+/**
+ * @brief Get the network type of a modulation scheme
+ *
+ * @param p_type - a modulation scheme
+ * @return the network type, "" for UNKNOWN
+ */
+constexpr const char *toNetwork(const ModulationType p_type)
+{
+    switch (p_type)
+    {
+    case ModulationType::ASK:
+        return ModulationScheme<ModulationType::ASK>::NETWORK;
+    case ModulationType::BPSK:
+        return ModulationScheme<ModulationType::BPSK>::NETWORK;
+    case ModulationType::BFSK:
+        return ModulationScheme<ModulationType::BFSK>::NETWORK;
+    case ModulationType::QAM16:
+        return ModulationScheme<ModulationType::QAM16>::NETWORK;
+    case ModulationType::OFDM:
+        return ModulationScheme<ModulationType::OFDM>::NETWORK;
+    case ModulationType::QAM64:
+        return ModulationScheme<ModulationType::QAM64>::NETWORK;
+    case ModulationType::QAM256:
+        return ModulationScheme<ModulationType::QAM256>::NETWORK;
+    default:
+        return "";
+    }
+}
+
+/**
+ * @brief Get the amount of bits carried by one symbol window
+ *
+ * @param p_type - a modulation scheme
+ * @return the amount of bits, 0 for UNKNOWN
+ */
+constexpr unsigned int getBitsPerSymbol(const ModulationType p_type)
+{
+    switch (p_type)
+    {
+    case ModulationType::ASK:
+        return ModulationScheme<ModulationType::ASK>::BITS_PER_SYMBOL;
+    case ModulationType::BPSK:
+        return ModulationScheme<ModulationType::BPSK>::BITS_PER_SYMBOL;
+    case ModulationType::BFSK:
+        return ModulationScheme<ModulationType::BFSK>::BITS_PER_SYMBOL;
+    case ModulationType::QAM16:
+        return ModulationScheme<ModulationType::QAM16>::BITS_PER_SYMBOL;
+    case ModulationType::OFDM:
+        return ModulationScheme<ModulationType::OFDM>::BITS_PER_SYMBOL;
+    case ModulationType::QAM64:
+        return ModulationScheme<ModulationType::QAM64>::BITS_PER_SYMBOL;
+    case ModulationType::QAM256:
+        return ModulationScheme<ModulationType::QAM256>::BITS_PER_SYMBOL;
+    default:
+        return 0;
+    }
+}
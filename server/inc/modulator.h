@@ -4,7 +4,19 @@
 #include <vector>
 #include <cmath>
 #include <complex>
+#include <array>
+#include <map>
 #include <gtest/gtest.h>
+#include "oscillator.h"
+#include "correlator.h"
+#include "waveformCache.h"
+#include "bitStream.h"
+#include "modulationScheme.h"
+#include "streamingModulator.h"
+#include "streamingDemodulator.h"
+#include "ofdm.h"
+#include "baseband.h"
+#include "softBits.h"
 
 /// @brief The amplitude of carrier signal wave (value 1.0 is used to simplify equations)
 constexpr double CARRIER_AMPLITUDE = 1.0;
@@ -18,6 +30,9 @@ constexpr double DEFAULT_FREQUENCY_INDEX = 1.0;
 /// @brief The default value of phase angle (only changed when applied PSK)
 constexpr double DEFAULT_PHASE = -M_PI / 2;
 
+/// @brief The least amount of symbol windows split across a thread pool when demodulating
+constexpr size_t PARALLEL_DEMODULATION_MIN_SYMBOLS = 32;
+
 /// @brief The sample rate key
 constexpr const char *SAMPLE_RATE_KEY = "/fs";
 
@@ -39,14 +54,24 @@ constexpr const char *FSK_ZERO_SIGN_KEY = "/modulation/fsk/zeroSign";
 /// @brief The frequency index (FSK) key of bit 1
 constexpr const char *FSK_ONE_SIGN_KEY = "/modulation/fsk/oneSign";
 
-/// @brief The sizeo of bits chunk when using 16QAM to modulate
-constexpr unsigned int BIT_SIZE_16QAM = 4;
+/// @brief The FSK symbol detector key, FSK_DETECTOR_CORRELATOR or FSK_DETECTOR_GOERTZEL
+constexpr const char *FSK_DETECTOR_KEY = "/modulation/fsk/detector";
+
+/// @brief FSK decided on the in-phase correlation with both tones (coherent)
+constexpr const char *FSK_DETECTOR_CORRELATOR = "correlator";
+
+/// @brief FSK decided on the power of both tones from the Goertzel algorithm (non-coherent)
+constexpr const char *FSK_DETECTOR_GOERTZEL = "goertzel";
 
-/// @brief The maximum distance to assign a signal point to each 16QAM point
+/// @brief The maximum distance to assign a signal point to each 16QAM point, scaled with the level spacing of other QAM orders
 constexpr double RADIUS_BOUND_16QAM = 0.2;
 
-/// @brief The amplitude levels for 16QAM constellation diagram
-constexpr double IQ_VALUES[] = {-0.75, -0.25, 0.25, 0.75};
+/// @brief How FSK symbol windows are decided
+enum class FskDetector
+{
+    CORRELATOR,
+    GOERTZEL
+};
 
 class Modulator
 {
@@ -69,6 +94,84 @@ public:
      */
     Modulator(const double p_carrierFrequency, const std::string &p_binaryData);
 
+    /**
+     * @brief Get the amount of samples the modulated signal of the binary input holds
+     *
+     * @param p_networkTypes - a network type
+     *
+     * @return the amount of samples, 0 for an unknown network
+     */
+    size_t getModulatedSize(const std::string &p_networkTypes);
+
+    /**
+     * @brief Get the amount of samples the modulated signal of the binary input holds
+     *
+     * @param p_type - a modulation scheme
+     *
+     * @return the amount of samples, 0 for UNKNOWN
+     */
+    size_t getModulatedSize(const ModulationType p_type);
+
+    /**
+     * @brief Modulate signal with a scheme resolved beforehand into a buffer owned by the caller
+     *
+     * @param p_type - a modulation scheme
+     * @param p_output - buffer receiving the modulated signal
+     * @param p_capacity - the amount of samples p_output can hold
+     *
+     * @return the amount of samples written, 0 if the buffer is too small or the scheme is UNKNOWN
+     */
+    size_t modulate(const ModulationType p_type, double *p_output, const size_t p_capacity);
+
+    /**
+     * @brief Modulate the binary input into single precision samples
+     *
+     * @param p_type - a modulation scheme
+     * @param p_output - buffer receiving the modulated signal
+     * @param p_capacity - the amount of samples p_output can hold
+     *
+     * @return the amount of samples written, 0 if the buffer is too small or the scheme is UNKNOWN
+     */
+    size_t modulate(const ModulationType p_type, float *p_output, const size_t p_capacity);
+
+    /**
+     * @brief Modulate the binary input into Q15 samples as expected by a radio front-end
+     *
+     * @param p_type - a modulation scheme
+     * @param p_output - buffer receiving the modulated signal, saturated at SAMPLE_Q15_FULL_SCALE
+     * @param p_capacity - the amount of samples p_output can hold
+     *
+     * @return the amount of samples written, 0 if the buffer is too small or the scheme is UNKNOWN
+     */
+    size_t modulate(const ModulationType p_type, Q15 *p_output, const size_t p_capacity);
+
+    /**
+     * @brief Modulate signal with a scheme resolved beforehand into a vector owned by the caller
+     *
+     * @param p_type - a modulation scheme
+     * @param p_output - vector resized to the modulated signal, its capacity is reused
+     */
+    void modulate(const ModulationType p_type, std::vector<double> &p_output);
+
+    /**
+     * @brief Modulate signal based on network type into a buffer owned by the caller
+     *
+     * @param p_networkTypes - a network type
+     * @param p_output - buffer receiving the modulated signal
+     * @param p_capacity - the amount of samples p_output can hold
+     *
+     * @return the amount of samples written, 0 if the buffer is too small or the network is unknown
+     */
+    size_t modulate(const std::string &p_networkTypes, double *p_output, const size_t p_capacity);
+
+    /**
+     * @brief Modulate signal based on network type into a vector owned by the caller
+     *
+     * @param p_networkTypes - a network type
+     * @param p_output - vector resized to the modulated signal, its capacity is reused
+     */
+    void modulate(const std::string &p_networkTypes, std::vector<double> &p_output);
+
     /**
      * @brief Modulate signal based on network type
      *
@@ -78,16 +181,247 @@ public:
      */
     std::vector<double> modulate(const std::string &p_networkTypes);
 
+    /**
+     * @brief Open a stream modulating bits incrementally at the current carrier frequency
+     *
+     * @param p_type - a modulation scheme
+     * @param p_sink - receives the modulated sample blocks
+     * @param p_blockSize - the amount of samples of a full block
+     *
+     * @return a stream starting at symbol 0, it uses the templates of the modulator and must not outlive it
+     */
+    StreamingModulator openStream(const ModulationType p_type, SampleSink p_sink,
+                                  const size_t p_blockSize = STREAMING_BLOCK_SAMPLES);
+
+    /**
+     * @brief Open a stream demodulating sample blocks of any size at the current carrier frequency
+     *
+     * @param p_type - a modulation scheme
+     * @param p_sink - receives the demodulated bits
+     *
+     * @return a stream starting at sample 0, it uses the references of the modulator and must not outlive it
+     * nor a change of carrier frequency
+     */
+    StreamingDemodulator openDemodulationStream(const ModulationType p_type, BitSink p_sink);
+
+    /**
+     * @brief Get the amount of bits demodulated from a signal
+     *
+     * @param p_signalSize - the amount of samples of the signal
+     * @param p_networkTypes - a network type
+     *
+     * @return the amount of bits, 0 for an unknown network
+     */
+    size_t getDemodulatedSize(const size_t p_signalSize, const std::string &p_networkTypes);
+
+    /**
+     * @brief Get the amount of bits demodulated from a signal
+     *
+     * @param p_signalSize - the amount of samples of the signal
+     * @param p_type - a modulation scheme
+     *
+     * @return the amount of bits, 0 for UNKNOWN
+     */
+    size_t getDemodulatedSize(const size_t p_signalSize, const ModulationType p_type);
+
+    /**
+     * @brief Demodulate signal with a scheme resolved beforehand into a packed bit stream owned by the caller
+     *
+     * @param p_signal - samples representing modulated signal
+     * @param p_size - the amount of samples of p_signal
+     * @param p_type - a modulation scheme
+     * @param p_output - stream resized to the demodulated bits, its capacity is reused
+     *
+     * @return the amount of bits written, 0 if the scheme is UNKNOWN or the signal can not be demodulated
+     */
+    size_t demodulate(const double *p_signal, const size_t p_size, const ModulationType p_type, BitStream &p_output);
+
+    /**
+     * @brief Demodulate signal with a scheme resolved beforehand into a bit buffer owned by the caller
+     *
+     * @param p_signal - samples representing modulated signal
+     * @param p_size - the amount of samples of p_signal
+     * @param p_type - a modulation scheme
+     * @param p_output - buffer receiving one '0' or '1' character per bit
+     * @param p_capacity - the amount of bits p_output can hold
+     *
+     * @return the amount of bits written, 0 if the buffer is too small, the scheme is UNKNOWN
+     * or the signal can not be demodulated
+     */
+    size_t demodulate(const double *p_signal, const size_t p_size, const ModulationType p_type,
+                      char *p_output, const size_t p_capacity);
+
+    /**
+     * @brief Demodulate signal with a scheme resolved beforehand into a string owned by the caller
+     *
+     * @param p_signal - a vector of real number (type double) representing modulated signal
+     * @param p_type - a modulation scheme
+     * @param p_output - string resized to the binary data series, its capacity is reused
+     */
+    void demodulate(const std::vector<double> &p_signal, const ModulationType p_type, std::string &p_output);
+
+    /**
+     * @brief Demodulate a single precision signal, the windows are correlated in single precision
+     *
+     * @param p_signal - samples representing modulated signal
+     * @param p_size - the amount of samples of p_signal
+     * @param p_type - a modulation scheme
+     * @param p_output - stream resized to the demodulated bits, its capacity is reused
+     *
+     * @return the amount of bits written, 0 if the scheme is UNKNOWN or the signal can not be demodulated
+     */
+    size_t demodulate(const float *p_signal, const size_t p_size, const ModulationType p_type, BitStream &p_output);
+
+    /**
+     * @brief Demodulate a Q15 signal as delivered by a radio front-end, the windows are correlated in integers
+     *
+     * @param p_signal - samples representing modulated signal
+     * @param p_size - the amount of samples of p_signal
+     * @param p_type - a modulation scheme
+     * @param p_output - stream resized to the demodulated bits, its capacity is reused
+     *
+     * @return the amount of bits written, 0 if the scheme is UNKNOWN or the signal can not be demodulated
+     */
+    size_t demodulate(const Q15 *p_signal, const size_t p_size, const ModulationType p_type, BitStream &p_output);
+
+    /**
+     * @brief Demodulate signal based on network type into a packed bit stream owned by the caller
+     *
+     * @param p_signal - samples representing modulated signal
+     * @param p_size - the amount of samples of p_signal
+     * @param p_networkTypes - a network type
+     * @param p_output - stream resized to the demodulated bits, its capacity is reused
+     *
+     * @return the amount of bits written, 0 if the network is unknown or the signal can not be demodulated
+     */
+    size_t demodulate(const double *p_signal, const size_t p_size, const std::string &p_networkTypes, BitStream &p_output);
+
+    /**
+     * @brief Demodulate signal based on network type into a bit buffer owned by the caller
+     *
+     * @param p_signal - samples representing modulated signal
+     * @param p_size - the amount of samples of p_signal
+     * @param p_networkTypes - a network type
+     * @param p_output - buffer receiving one '0' or '1' character per bit
+     * @param p_capacity - the amount of bits p_output can hold
+     *
+     * @return the amount of bits written, 0 if the buffer is too small, the network is unknown
+     * or the signal can not be demodulated
+     */
+    size_t demodulate(const double *p_signal, const size_t p_size, const std::string &p_networkTypes,
+                      char *p_output, const size_t p_capacity);
+
+    /**
+     * @brief Demodulate signal based on network type into a string owned by the caller
+     *
+     * @param p_signal - a vector of real number (type double) representing modulated signal
+     * @param p_networkTypes - a network type
+     * @param p_output - string resized to the binary data series, its capacity is reused
+     */
+    void demodulate(const std::vector<double> &p_signal, const std::string &p_networkTypes, std::string &p_output);
+
     /**
      * @brief Demodulate signal based on network type
      *
      * @param p_signal - a vector of real number (type double) representing modulated signal
      * @param p_networkTypes - a network type
      *
-     * @return a set of real number (type double) representing modulated signal
+     * @return a binary data series representing message signal
      */
     std::string demodulate(const std::vector<double> &p_signal, const std::string &p_networkTypes);
 
+    /**
+     * @brief Demodulate signal into the log-likelihood ratio of every bit instead of a decided bit
+     *
+     * The ratios are max-log ratios, positive for bit 0, expressed as d1^2 - d0^2 where dB is the distance from the
+     * received point to the closest point of the scheme carrying B, in units of the carrier amplitude. Divided by
+     * twice the noise variance of a point they are natural log ratios. QAM and OFDM ratios are linear past half a
+     * level spacing from their boundary, see QamConstellation::softSlice(). No window is rejected: a point far from
+     * the constellation still gives ratios, large in magnitude.
+     *
+     * @param p_signal - samples representing modulated signal
+     * @param p_size - the amount of samples of p_signal
+     * @param p_type - a modulation scheme
+     * @param p_llr - buffer receiving one ratio per bit
+     * @param p_capacity - the amount of ratios p_llr can hold
+     *
+     * @return the amount of ratios written, 0 if the buffer is too small or the scheme is UNKNOWN
+     */
+    size_t demodulateSoft(const double *p_signal, const size_t p_size, const ModulationType p_type, float *p_llr,
+                          const size_t p_capacity);
+
+    /**
+     * @brief Demodulate signal into the log-likelihood ratio of every bit into a vector owned by the caller
+     *
+     * @param p_signal - samples representing modulated signal
+     * @param p_size - the amount of samples of p_signal
+     * @param p_type - a modulation scheme
+     * @param p_llr - vector resized to one ratio per bit, positive for bit 0, its capacity is reused
+     *
+     * @return the amount of ratios written, 0 if the scheme is UNKNOWN
+     */
+    size_t demodulateSoft(const double *p_signal, const size_t p_size, const ModulationType p_type,
+                          std::vector<float> &p_llr);
+
+    /**
+     * @brief Get the amount of baseband samples the binary input modulates to
+     *
+     * @param p_type - a modulation scheme
+     *
+     * @return BASEBAND_SAMPLES_PER_SYMBOL samples per symbol, 0 for a scheme without a baseband form
+     */
+    size_t getBasebandSize(const ModulationType p_type);
+
+    /**
+     * @brief Modulate the binary input into complex baseband samples, every symbol relative to the carrier
+     *
+     * @param p_type - a modulation scheme, OFDM has no baseband form
+     * @param p_output - vector resized to the baseband signal, its capacity is reused
+     *
+     * @return the amount of samples written, 0 if the scheme has no baseband form or the carrier frequency is not set
+     */
+    size_t modulateBaseband(const ModulationType p_type, std::vector<IqSample> &p_output);
+
+    /**
+     * @brief Demodulate complex baseband samples, every window is decided as the passband window it stands for
+     *
+     * @param p_signal - baseband samples, BASEBAND_SAMPLES_PER_SYMBOL per symbol window
+     * @param p_size - the amount of samples of p_signal
+     * @param p_type - a modulation scheme, OFDM has no baseband form
+     * @param p_output - stream resized to the demodulated bits, its capacity is reused
+     *
+     * @return the amount of bits written, 0 if the scheme has no baseband form or the signal can not be demodulated
+     */
+    size_t demodulateBaseband(const IqSample *p_signal, const size_t p_size, const ModulationType p_type,
+                              BitStream &p_output);
+
+    /**
+     * @brief Demodulate complex baseband samples into the log-likelihood ratio of every bit, as demodulateSoft()
+     *
+     * @param p_signal - baseband samples, BASEBAND_SAMPLES_PER_SYMBOL per symbol window
+     * @param p_size - the amount of samples of p_signal
+     * @param p_type - a modulation scheme, OFDM has no baseband form
+     * @param p_llr - vector resized to one ratio per bit, positive for bit 0, its capacity is reused
+     *
+     * @return the amount of ratios written, 0 if the scheme has no baseband form
+     */
+    size_t demodulateBasebandSoft(const IqSample *p_signal, const size_t p_size, const ModulationType p_type,
+                                  std::vector<float> &p_llr);
+
+    /**
+     * @brief Open a converter from baseband to passband samples at the current carrier frequency
+     *
+     * @return a converter starting at symbol 0
+     */
+    Upconverter openUpconverter();
+
+    /**
+     * @brief Get the amount of passband samples of one symbol window at the current carrier frequency
+     *
+     * @return the amount of samples
+     */
+    size_t getSamplesPerSymbol();
+
     /**
      * @brief Set carrier wave frequency for server
      *
@@ -102,6 +436,43 @@ public:
      */
     void setBinaryInput(const std::string &p_binaryData);
 
+    /**
+     * @brief Set packed binary data input for server
+     *
+     * @param p_binaryData - a packed binary data series
+     */
+    void setBinaryInput(const BitStream &p_binaryData);
+
+    /**
+     * @brief Split the symbols of long messages across a thread pool, each thread writing its own slice
+     *
+     * @param p_threadPool - threads used by modulate(), demodulate() and the modulation streams opened
+     * afterwards, must outlive them, nullptr works on the calling thread
+     */
+    void setThreadPool(ThreadPool *p_threadPool);
+
+    /**
+     * @brief Select how FSK symbol windows are decided, for demodulate() and the demodulation streams opened afterwards
+     *
+     * @param p_detector - CORRELATOR compares the in-phase correlations with both tones and needs the phase of the
+     * carrier, GOERTZEL compares the power of both tones whatever their phase
+     */
+    void setFskDetector(const FskDetector p_detector);
+
+    /**
+     * @brief Get how FSK symbol windows are decided
+     *
+     * @return the detector read from server database or set by setFskDetector()
+     */
+    FskDetector getFskDetector();
+
+    /**
+     * @brief Get the sample rate read from server database
+     *
+     * @return the amount of samples transmitted in 1 second
+     */
+    int getSampleRate();
+
     /**
      * @brief Generate random binary data
      *
@@ -131,7 +502,13 @@ private:
     size_t m_samplesPerBit;
 
     /// @brief A binary data series
-    std::string m_binaryInput;
+    BitStream m_binaryInput;
+
+    /// @brief Bits of the last demodulation unpacked by the ASCII overloads of demodulate()
+    BitStream m_demodulatedBits;
+
+    /// @brief Amplitudes of a float or Q15 signal, rendered or demodulated in double where a scheme has no other form
+    std::vector<double> m_conversionBuffer;
 
     /// @brief key of bit 0 sign for ASK
     float m_askZeroSign;
@@ -145,12 +522,60 @@ private:
     /// @brief key of bit 1 sign for PSK
     float m_pskOneSign;
 
+    /// @brief In-phase amplitude of the PSK symbols 0 and 1
+    double m_pskInPhase[2];
+
+    /// @brief Quadrature amplitude of the PSK symbols 0 and 1
+    double m_pskQuadrature[2];
+
     /// @brief key of bit 0 sign for FSK
     float m_fskZeroSign;
 
     /// @brief key of bit 1 sign for FSK
     float m_fskOneSign;
 
+    /// @brief How FSK symbol windows are decided
+    FskDetector m_fskDetector;
+
+    /// @brief Symbol templates of every network at the configured carrier frequencies
+    WaveformCache m_waveformCache;
+
+    /// @brief OFDM modem whose transform spans one symbol window, so the subcarrier spacing is the carrier frequency
+    OfdmModem m_ofdm;
+
+    /// @brief Symbol templates at the current carrier frequency, indexed by ModulationType
+    std::array<const WaveformTable *, MODULATION_TYPE_COUNT> m_waveformTables;
+
+    /// @brief Threads sharing the modulation and demodulation of long messages, nullptr when working on the caller
+    ThreadPool *m_threadPool;
+
+    /**
+     * @brief Kernels of one modulation scheme
+     *
+     * @param bitsPerSymbol - the amount of bits carried by one symbol window, 0 for UNKNOWN
+     * @param modulate - modulation kernel, nullptr for UNKNOWN
+     * @param demodulate - demodulation kernel, nullptr for UNKNOWN
+     * @param decide - decision of one symbol window, nullptr for UNKNOWN
+     * @param demodulateFloat - demodulation kernel of float signals, nullptr to demodulate them in double
+     * @param demodulateQ15 - demodulation kernel of Q15 signals, nullptr to demodulate them in double
+     * @param demodulateSoft - soft demodulation kernel, nullptr for UNKNOWN
+     * @param softDecide - log-likelihood ratios of one symbol window, nullptr for UNKNOWN
+     */
+    struct ModulationKernel
+    {
+        unsigned int bitsPerSymbol;
+        void (Modulator::*modulate)(double *p_output);
+        size_t (Modulator::*demodulate)(const double *p_signal, const size_t p_size, BitStream &p_output);
+        bool (Modulator::*decide)(const WindowCorrelation &p_correlation, unsigned int &p_symbol);
+        size_t (Modulator::*demodulateFloat)(const float *p_signal, const size_t p_size, BitStream &p_output);
+        size_t (Modulator::*demodulateQ15)(const Q15 *p_signal, const size_t p_size, BitStream &p_output);
+        size_t (Modulator::*demodulateSoft)(const double *p_signal, const size_t p_size, float *p_llr);
+        void (Modulator::*softDecide)(const WindowCorrelation &p_correlation, float *p_llr);
+    };
+
+    /// @brief Demodulation references of one bit window, keyed by tone frequency and samples per bit
+    std::map<std::pair<double, size_t>, ReferenceWaveform> m_referenceCache;
+
     /**
      * @brief Reading all modulation and sample rate values in server database
      */
@@ -169,66 +594,231 @@ private:
     double getCarrierSignalValue(const double &p_amplitudeIndex, const double &p_frequencyIndex, const double &p_time, const double &p_phase);
 
     /**
-     * @brief ASK Modulation
+     * @brief Correlate one bit window against the in-phase and quadrature carriers
      *
-     * @return a vector of real number (type double) representing modulated signal
+     * @param p_window - the first sample of the bit window, double, float or Q15
+     * @param p_reference - reference waveforms of one window, starting at phase 0 of the window
+     * @param p_windowPhase - carrier phase advanced from sample 0 to the first sample of the window
+     * @param p_inPhase - receives the correlation with the in-phase carrier
+     * @param p_quadrature - receives the correlation with the quadrature carrier
      */
-    std::vector<double> askModulation();
+    template <typename Sample>
+    void correlateWindow(const Sample *p_window, const ReferenceWaveform &p_reference, const uint64_t p_windowPhase,
+                         double &p_inPhase, double &p_quadrature);
 
     /**
-     * @brief PSK Modulation
+     * @brief Get the waveform of every symbol of a network
      *
-     * @return a vector of real number (type double) representing modulated signal
+     * @param p_networkTypes - a network type
+     *
+     * @return shapes indexed by symbol value, empty for an unknown network
      */
-    std::vector<double> pskModulation();
+    std::vector<SymbolShape> getSymbolShapes(const std::string &p_networkTypes);
 
     /**
-     * @brief FSK Modulation
+     * @brief Get the waveform of every symbol of a QAM scheme
      *
-     * @return a vector of real number (type double) representing modulated signal
+     * @return shapes indexed by symbol value, the constellation point riding on the in-phase and quadrature carriers
      */
-    std::vector<double> fskModulation();
+    template <ModulationType Type>
+    std::vector<SymbolShape> getQamShapes();
 
     /**
-     * @brief 16 QAM Modulation
+     * @brief Get the symbol templates of a network at the current carrier frequency
      *
-     * @return a vector of real number (type double) representing modulated signal
+     * @param p_networkTypes - a network type
+     *
+     * @return templates of the network, generated the first time they are requested
      */
-    std::vector<double> qam16Modulation();
+    const WaveformTable &getWaveformTable(const std::string &p_networkTypes);
 
     /**
-     * @brief ASK Demodulation
+     * @brief Get the demodulation references of one bit window
      *
-     * @param p_signal - a vector of real number (type double) representing modulated signal
+     * @param p_frequency - frequency of the reference tone
      *
-     * @return a binary data series representing message signal
+     * @return references of the tone, generated the first time they are requested
      */
-    std::string askDemodulation(const std::vector<double> &p_signal);
+    const ReferenceWaveform &getReferenceWaveform(const double p_frequency);
 
     /**
-     * @brief PSK Demodulation
+     * @brief Get the kernels of a modulation scheme
      *
-     * @param p_signal - a vector of real number (type double) representing modulated signal
+     * @param p_type - a modulation scheme
      *
-     * @return a binary data series representing message signal
+     * @return kernels instantiated for the scheme
      */
-    std::string pskDemodulation(const std::vector<double> &p_signal);
+    static const ModulationKernel &getKernel(const ModulationType p_type);
 
     /**
-     * @brief FSK Demodulation
+     * @brief Get the kernels of a scheme whose symbol windows are decided on their own
      *
-     * @param p_signal - a vector of real number (type double) representing modulated signal
+     * @return kernels instantiated for the scheme and every sample format
+     */
+    template <ModulationType Type>
+    static constexpr ModulationKernel getSchemeKernel();
+
+    /**
+     * @brief Modulation of one scheme, every symbol is copied from the templates of the scheme
      *
-     * @return a binary data series representing message signal
+     * @param p_output - buffer receiving the modulated signal, holds getModulatedSize() samples
      */
-    std::string fskDemodulation(const std::vector<double> &p_signal);
+    template <ModulationType Type>
+    void modulateScheme(double *p_output);
 
     /**
-     * @brief 16 QAM Demodulation
+     * @brief Get the reference tones every symbol window of a scheme is correlated against
      *
-     * @param p_signal - a vector of real number (type double) representing modulated signal
+     * @param p_type - a modulation scheme
      *
-     * @return a binary data series representing message signal
+     * @return references at the current carrier frequency, no tone for UNKNOWN
+     */
+    DemodulationReferences getDemodulationReferences(const ModulationType p_type);
+
+    /**
+     * @brief Decide the symbol of one window from its correlations, specialized for every scheme
+     *
+     * @param p_correlation - correlations of the window against the references of the scheme
+     * @param p_symbol - receives the symbol value
+     *
+     * @return false if the window can not be decided
+     */
+    template <ModulationType Type>
+    bool decideSymbol(const WindowCorrelation &p_correlation, unsigned int &p_symbol);
+
+    /**
+     * @brief Demodulation of one scheme, every window is correlated then decided by decideSymbol()
+     *
+     * @param p_signal - samples representing modulated signal, double, float or Q15
+     * @param p_size - the amount of samples of p_signal
+     * @param p_output - stream receiving the binary data series, holds getDemodulatedSize() bits
+     *
+     * @return the amount of bits written
+     */
+    template <ModulationType Type, typename Sample>
+    size_t demodulateScheme(const Sample *p_signal, const size_t p_size, BitStream &p_output);
+
+    /**
+     * @brief Give the log-likelihood ratios of the bits of one window from its correlations, specialized for every scheme
+     *
+     * @param p_correlation - correlations of the window against the references of the scheme
+     * @param p_llr - receives one ratio per bit of the symbol, most significant bit first
+     */
+    template <ModulationType Type>
+    void softDecideSymbol(const WindowCorrelation &p_correlation, float *p_llr);
+
+    /**
+     * @brief Soft demodulation of one scheme, every window is correlated then given ratios by softDecideSymbol()
+     *
+     * @param p_signal - samples representing modulated signal
+     * @param p_size - the amount of samples of p_signal
+     * @param p_llr - buffer receiving getDemodulatedSize() ratios
+     *
+     * @return the amount of ratios written
+     */
+    template <ModulationType Type>
+    size_t demodulateSoftScheme(const double *p_signal, const size_t p_size, float *p_llr);
+
+    /**
+     * @brief Correlate every symbol window of a signal against the references of a scheme, split across the thread pool
+     *
+     * @param p_signal - samples representing modulated signal, double, float or Q15
+     * @param p_symbolCount - the amount of whole symbol windows of p_signal
+     * @param p_groupSymbols - the amount of consecutive windows always handled by the same thread
+     * @param p_visit - called with the index and the correlations of every window, from any thread,
+     * returns false to stop at a window that can not be decided
+     *
+     * @return false if a window was not decided
+     */
+    template <ModulationType Type, typename Sample, typename Visitor>
+    bool correlateWindows(const Sample *p_signal, const size_t p_symbolCount, const size_t p_groupSymbols,
+                          Visitor p_visit);
+
+    /**
+     * @brief Correlate every baseband window against the references of a scheme, as the passband window it stands for
+     *
+     * @param p_signal - baseband samples, BASEBAND_SAMPLES_PER_SYMBOL per symbol window
+     * @param p_size - the amount of samples of p_signal
+     * @param p_type - a scheme with a baseband form
+     * @param p_visit - called with the index and the correlations of every window in order,
+     * returns false to stop at a window that can not be decided
+     *
+     * @return false if a window was not decided
+     */
+    template <typename Visitor>
+    bool correlateBaseband(const IqSample *p_signal, const size_t p_size, const ModulationType p_type,
+                           Visitor p_visit);
+
+    /**
+     * @brief Demodulate a float or Q15 signal with the kernel of its format, in double for schemes without one
+     *
+     * @param p_signal - samples representing modulated signal
+     * @param p_size - the amount of samples of p_signal
+     * @param p_type - a modulation scheme
+     * @param p_output - stream resized to the demodulated bits, its capacity is reused
+     *
+     * @return the amount of bits written, 0 if the scheme is UNKNOWN or the signal can not be demodulated
+     */
+    template <typename Sample>
+    size_t demodulateSamples(const Sample *p_signal, const size_t p_size, const ModulationType p_type,
+                             BitStream &p_output);
+
+    /**
+     * @brief Modulate in double then convert to a float or Q15 signal, the symbol templates stay in double
+     *
+     * @param p_type - a modulation scheme
+     * @param p_output - buffer receiving the modulated signal
+     * @param p_capacity - the amount of samples p_output can hold
+     *
+     * @return the amount of samples written, 0 if the buffer is too small or the scheme is UNKNOWN
+     */
+    template <typename Sample>
+    size_t modulateSamples(const ModulationType p_type, Sample *p_output, const size_t p_capacity);
+
+    /**
+     * @brief OFDM modulation, the symbols of the payload are spread over the subcarriers of m_ofdm
+     *
+     * @param p_output - buffer receiving the modulated signal, holds getModulatedSize() samples
+     */
+    void modulateOfdm(double *p_output);
+
+    /**
+     * @brief OFDM demodulation, every subcarrier is equalized with the training symbol then sliced
+     *
+     * @param p_signal - samples representing modulated signal
+     * @param p_size - the amount of samples of p_signal
+     * @param p_output - stream receiving the binary data series, holds getDemodulatedSize() bits
+     *
+     * @return the amount of bits written
+     */
+    size_t demodulateOfdm(const double *p_signal, const size_t p_size, BitStream &p_output);
+
+    /**
+     * @brief OFDM soft demodulation, every subcarrier is equalized with the training symbol then given ratios
+     *
+     * @param p_signal - samples representing modulated signal
+     * @param p_size - the amount of samples of p_signal
+     * @param p_llr - buffer receiving getDemodulatedSize() ratios
+     *
+     * @return the amount of ratios written
+     */
+    size_t demodulateOfdmSoft(const double *p_signal, const size_t p_size, float *p_llr);
+
+    /**
+     * @brief Check the carrier frequency has been set for a scheme
+     *
+     * @param p_type - a known modulation scheme
+     *
+     * @return true - the scheme can modulate, false - otherwise
+     */
+    bool isConfigured(const ModulationType p_type);
+
+    /**
+     * @brief Check a scheme has a baseband form, every symbol window being decided on its own
+     *
+     * @param p_type - a modulation scheme
+     *
+     * @return true - the scheme is known, is not OFDM and its carrier frequency has been set
      */
-    std::string qam16Demodulation(const std::vector<double> &p_signal);
+    bool hasBaseband(const ModulationType p_type);
 };
\ No newline at end of file
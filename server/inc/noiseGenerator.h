@@ -0,0 +1,97 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+/// @brief The amount of independent xoshiro256++ generators stepped together, one per 64-bit vector lane
+constexpr size_t NOISE_LANES = 4;
+
+/// @brief The amount of Gaussian samples generated at once, refilled when used up
+constexpr size_t NOISE_BLOCK_SIZE = 512;
+
+/// @brief The amount of layers of the ziggurat
+constexpr size_t NOISE_ZIGGURAT_LAYERS = 128;
+
+/**
+ * @brief Gaussian channel noise generator, reproducible for a given seed and stream
+ *
+ * Uniform words come from NOISE_LANES xoshiro256++ generators advanced side by side with the SIMD kernels.
+ * The ziggurat turns one word into one Gaussian sample with a multiplication and a comparison for nearly 99% of
+ * the words, a whole vector of words at a time. The remaining words take the exact slow path, drawing their extra
+ * uniform values from a separate scalar generator, so every instruction set gives the same samples.
+ */
+class NoiseGenerator
+{
+public:
+    /**
+     * @brief Constructor of a seeded generator
+     *
+     * @param p_seed - seed of the run
+     * @param p_stream - index of the stream, streams of one seed give unrelated noise
+     */
+    explicit NoiseGenerator(const uint64_t p_seed = 0, const uint64_t p_stream = 0);
+
+    /**
+     * @brief Restart the generator from a seed
+     *
+     * @param p_seed - seed of the run
+     * @param p_stream - index of the stream, streams of one seed give unrelated noise
+     */
+    void seed(const uint64_t p_seed, const uint64_t p_stream = 0);
+
+    /**
+     * @brief Fill a block with Gaussian samples, the noise continues across blocks
+     *
+     * @param p_output - buffer receiving p_size samples
+     * @param p_size - the amount of samples
+     * @param p_deviation - standard deviation of the samples
+     */
+    void fill(double *p_output, const size_t p_size, const double p_deviation);
+
+    /**
+     * @brief Draw one standard Gaussian sample
+     *
+     * @return a sample of mean 0 and deviation 1
+     */
+    double next();
+
+private:
+    /// @brief State word w of lane l at m_state[w][l], so a word of every lane loads as one vector
+    alignas(32) uint64_t m_state[4][NOISE_LANES];
+
+    /// @brief State of the generator of the slow path
+    uint64_t m_slowState[4];
+
+    /// @brief Uniform words of the current block
+    alignas(32) uint64_t m_block[NOISE_BLOCK_SIZE];
+
+    /// @brief Standard Gaussian samples not used yet from m_position on
+    alignas(32) double m_samples[NOISE_BLOCK_SIZE];
+
+    /// @brief Index of the next unused sample of m_samples
+    size_t m_position;
+
+    /// @brief Generate the next NOISE_BLOCK_SIZE samples
+    void refill();
+
+    /**
+     * @brief Finish a sample whose word fell outside the rectangle of its layer
+     *
+     * @param p_bits - the uniform word of the sample
+     * @return a standard Gaussian sample
+     */
+    double sampleSlow(uint64_t p_bits);
+
+    /**
+     * @brief Draw a uniform word from the generator of the slow path
+     *
+     * @return 64 uniform bits
+     */
+    uint64_t nextSlowUniform();
+
+    /**
+     * @brief Draw a uniform value from the generator of the slow path
+     *
+     * @return a value in (0, 1)
+     */
+    double nextOpenUniform();
+};
@@ -0,0 +1,134 @@
+#pragma once
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <vector>
+#include "bitStream.h"
+#include "fft.h"
+#include "modulationScheme.h"
+
+/// @brief The amount of data subcarriers of one OFDM symbol, bins 1 to 64 of the transform
+constexpr size_t OFDM_SUBCARRIERS = 64;
+
+/// @brief The bits carried by one OFDM symbol
+constexpr size_t OFDM_BITS_PER_SYMBOL = OFDM_SUBCARRIERS * BIT_SIZE_16QAM;
+
+/// @brief The cyclic prefix is 1/4 of the transform size
+constexpr size_t OFDM_CYCLIC_PREFIX_DIVISOR = 4;
+
+/// @brief Half the magnitude of the smallest 16-QAM point, an equalized subcarrier below it carries no data
+constexpr double OFDM_EMPTY_SUBCARRIER_LEVEL = IQ_VALUES[2] * M_SQRT2 / 2;
+
+/**
+ * @brief OFDM modem mapping 16-QAM points onto the subcarriers of a real signal
+ *
+ * Subcarrier k sits at k * fs / N, N being the transform size, and its Hermitian mirror at N - k keeps the
+ * signal real. A burst starts with a training symbol of known points, from which the receiver estimates the
+ * gain and phase of every subcarrier, then carries the data symbols. Subcarriers past the end of the payload
+ * in the last symbol are left empty.
+ */
+class OfdmModem
+{
+public:
+    /// @brief Default constructor of a modem without a transform size, it neither modulates nor demodulates
+    OfdmModem();
+
+    /**
+     * @brief Set the transform size, which sets the subcarrier spacing to fs / p_fftSize
+     *
+     * @param p_fftSize - the amount of samples of one symbol without its cyclic prefix
+     * @return true - the size leaves room for every subcarrier and its mirror, false - the modem is disabled
+     */
+    bool configure(const size_t p_fftSize);
+
+    /**
+     * @brief Get the amount of samples of one symbol with its cyclic prefix
+     *
+     * @return the amount of samples, 0 while disabled
+     */
+    size_t getSymbolSize() const;
+
+    /**
+     * @brief Get the amount of samples of a burst
+     *
+     * @param p_bitCount - the amount of bits of the payload
+     * @return the training symbol and the data symbols, 0 for an empty payload or while disabled
+     */
+    size_t getSignalSize(const size_t p_bitCount) const;
+
+    /**
+     * @brief Get the largest amount of bits a signal can hold
+     *
+     * @param p_signalSize - the amount of samples of the signal
+     * @return the bits of every whole data symbol
+     */
+    size_t getMaxBitCount(const size_t p_signalSize) const;
+
+    /**
+     * @brief Modulate a payload into a burst
+     *
+     * @param p_bits - the payload, a multiple of 4 bits
+     * @param p_output - receives getSignalSize() samples
+     */
+    void modulate(const BitStream &p_bits, double *p_output);
+
+    /**
+     * @brief Demodulate a burst, equalizing every subcarrier with the training symbol
+     *
+     * @param p_signal - samples of the burst, starting with the training symbol
+     * @param p_size - the amount of samples
+     * @param p_output - holds at least getMaxBitCount() bits, receives the payload
+     * @return the amount of bits of the payload
+     */
+    size_t demodulate(const double *p_signal, const size_t p_size, BitStream &p_output);
+
+    /**
+     * @brief Demodulate a burst into the log-likelihood ratio of every bit, see QamConstellation::softSlice()
+     *
+     * The ratios of a subcarrier are weighted by its power gain relative to the mean gain of the burst, the noise
+     * of a faded subcarrier being amplified by the equalizer.
+     *
+     * @param p_signal - samples of the burst, starting with the training symbol
+     * @param p_size - the amount of samples
+     * @param p_llr - holds at least getMaxBitCount() ratios, receives the ratios of the payload, positive for bit 0
+     * @return the amount of ratios of the payload
+     */
+    size_t demodulateSoft(const double *p_signal, const size_t p_size, float *p_llr);
+
+private:
+    size_t m_fftSize;
+    size_t m_prefixSize;
+
+    /// @brief Points of the training symbol, their quadratic phases keep its peak amplitude low
+    std::vector<std::complex<double>> m_trainingPoints;
+
+    /// @brief Estimated response of every subcarrier, from the training symbol of the current burst
+    std::vector<std::complex<double>> m_channel;
+
+    std::vector<std::complex<double>> m_bins;
+    std::vector<std::complex<double>> m_samples;
+    std::vector<std::complex<double>> m_scratch;
+
+    /**
+     * @brief Write one symbol and its cyclic prefix
+     *
+     * @param p_points - point of every subcarrier, OFDM_SUBCARRIERS points, 0 for an empty subcarrier
+     * @param p_output - receives getSymbolSize() samples
+     */
+    void writeSymbol(const std::complex<double> *p_points, double *p_output);
+
+    /**
+     * @brief Transform one received symbol, dropping its cyclic prefix
+     *
+     * @param p_symbol - the first sample of the cyclic prefix
+     * @return the bins of the transform, the subcarriers at index 1 to OFDM_SUBCARRIERS
+     */
+    const std::complex<double> *readSymbol(const double *p_symbol);
+
+    /**
+     * @brief Estimate the response of every subcarrier from the training symbol of a burst into m_channel
+     *
+     * @param p_signal - the first sample of the burst
+     */
+    void estimateChannel(const double *p_signal);
+};
@@ -0,0 +1,124 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+/// @brief The number of address bits of the cosine lookup table
+constexpr unsigned int OSCILLATOR_TABLE_BITS = 12;
+
+/// @brief The number of cosine lookup table entries over one carrier cycle
+constexpr size_t OSCILLATOR_TABLE_SIZE = static_cast<size_t>(1) << OSCILLATOR_TABLE_BITS;
+
+/// @brief The number of phase bits used to interpolate between two lookup table entries
+constexpr unsigned int OSCILLATOR_FRACTION_BITS = 32;
+
+/// @brief The worst-case absolute error of the interpolated table against std::cos, (2*pi/size)^2 / 8
+constexpr double OSCILLATOR_MAX_ERROR = 3.0e-7;
+
+/// @brief The phase word of a quarter cycle (pi/2)
+constexpr uint64_t OSCILLATOR_QUARTER_CYCLE = static_cast<uint64_t>(1) << 62;
+
+/**
+ * @brief Numerically controlled oscillator
+ *
+ * The phase is a 64-bit accumulator where 2^64 is one full cycle, so it wraps for free and
+ * never loses precision over long bursts. The value is read from a shared cosine table with
+ * linear interpolation instead of calling std::cos for every sample.
+ */
+class Oscillator
+{
+public:
+    /// @brief Default constructor, the oscillator stays at phase 0 until it is configured
+    Oscillator();
+
+    /**
+     * @brief Constructor to set up the tone of the oscillator
+     *
+     * @param p_frequency - frequency of the generated tone (Hz)
+     * @param p_sampleRate - the amount of samples generated in 1 second
+     * @param p_phase - phase of the tone at sample 0 (radian)
+     */
+    Oscillator(const double p_frequency, const double p_sampleRate, const double p_phase = 0.0);
+
+    /**
+     * @brief Set up the tone of the oscillator and rewind it to sample 0
+     *
+     * @param p_frequency - frequency of the generated tone (Hz)
+     * @param p_sampleRate - the amount of samples generated in 1 second
+     * @param p_phase - phase of the tone at sample 0 (radian)
+     */
+    void configure(const double p_frequency, const double p_sampleRate, const double p_phase = 0.0);
+
+    /**
+     * @brief Move the oscillator to an absolute sample index
+     *
+     * @param p_sampleIndex - index of the next generated sample, counted from sample 0
+     */
+    void seek(const uint64_t p_sampleIndex);
+
+    /**
+     * @brief Get the current value of the tone and advance one sample
+     *
+     * @return cos(2*pi*f*t + phase) at the current sample
+     */
+    double next();
+
+    /**
+     * @brief Get the in-phase and quadrature values of the tone and advance one sample
+     *
+     * @param p_inPhase - receives cos(2*pi*f*t + phase)
+     * @param p_quadrature - receives sin(2*pi*f*t + phase)
+     */
+    void nextQuadrature(double &p_inPhase, double &p_quadrature);
+
+    /**
+     * @brief Write p_count samples of a * cos(2*pi*f*t + phase) + b * sin(2*pi*f*t + phase)
+     *
+     * @param p_output - buffer receiving the samples, must hold at least p_count values
+     * @param p_count - the amount of samples to generate
+     * @param p_inPhaseAmplitude - amplitude a of the cosine component
+     * @param p_quadratureAmplitude - amplitude b of the sine component
+     */
+    void generate(double *p_output, const size_t p_count, const double p_inPhaseAmplitude = 1.0,
+                  const double p_quadratureAmplitude = 0.0);
+
+    /**
+     * @brief Get the phase word of the next sample
+     *
+     * @return phase where 2^64 is one full cycle
+     */
+    uint64_t getPhase() const;
+
+    /**
+     * @brief Convert an angle into a phase word
+     *
+     * @param p_radians - angle (radian), any value is wrapped into one cycle
+     * @return phase where 2^64 is one full cycle
+     */
+    static uint64_t toPhase(const double p_radians);
+
+    /**
+     * @brief Cosine of a phase word read from the lookup table
+     *
+     * @param p_phase - phase where 2^64 is one full cycle
+     * @return cosine value, within OSCILLATOR_MAX_ERROR of std::cos
+     */
+    static double cosine(const uint64_t p_phase);
+
+    /**
+     * @brief Sine of a phase word read from the lookup table
+     *
+     * @param p_phase - phase where 2^64 is one full cycle
+     * @return sine value, within OSCILLATOR_MAX_ERROR of std::sin
+     */
+    static double sine(const uint64_t p_phase);
+
+private:
+    /// @brief Phase of the next generated sample
+    uint64_t m_phase;
+
+    /// @brief Phase advanced every sample, (frequency / sample rate) * 2^64
+    uint64_t m_phaseIncrement;
+
+    /// @brief Phase at sample 0
+    uint64_t m_initialPhase;
+};
@@ -0,0 +1,145 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+
+/**
+ * @brief Square M-QAM constellation, M = 2^BitsPerSymbol, generated at compile time
+ *
+ * The first half of the bits of a symbol selects the I level, the second half the Q level, first bit as most
+ * significant. The bits of an axis are Gray coded, so neighbouring levels differ by one bit and a point sliced
+ * one level off costs one bit error. The levels are (2 * i + 1 - L) / L for L levels per axis, which keeps the
+ * largest point of every order inside the unit square.
+ */
+template <unsigned int BitsPerSymbol>
+struct QamConstellation
+{
+    static_assert(BitsPerSymbol >= 2 && BitsPerSymbol <= 16 && BitsPerSymbol % 2 == 0,
+                  "A square QAM carries an even amount of bits per symbol");
+
+    /// @brief The amount of bits selecting the level of one axis
+    static constexpr unsigned int BITS_PER_AXIS = BitsPerSymbol / 2;
+
+    /// @brief The amount of levels of one axis
+    static constexpr unsigned int LEVEL_COUNT = 1u << BITS_PER_AXIS;
+
+    /// @brief The distance between two neighbouring levels
+    static constexpr double SPACING = 2.0 / LEVEL_COUNT;
+
+    /// @brief The amplitude of every level, lowest first
+    static constexpr std::array<double, LEVEL_COUNT> LEVELS = []()
+    {
+        std::array<double, LEVEL_COUNT> levels{};
+        for (unsigned int levelIdx = 0; levelIdx < LEVEL_COUNT; ++levelIdx)
+        {
+            levels[levelIdx] = (2.0 * levelIdx + 1.0 - LEVEL_COUNT) / LEVEL_COUNT;
+        }
+        return levels;
+    }();
+
+    /// @brief The Gray coded bits of every level
+    static constexpr std::array<unsigned int, LEVEL_COUNT> LEVEL_BITS = []()
+    {
+        std::array<unsigned int, LEVEL_COUNT> bits{};
+        for (unsigned int levelIdx = 0; levelIdx < LEVEL_COUNT; ++levelIdx)
+        {
+            bits[levelIdx] = levelIdx ^ (levelIdx >> 1);
+        }
+        return bits;
+    }();
+
+    /// @brief The amplitude selected by every group of axis bits, the inverse of LEVEL_BITS
+    static constexpr std::array<double, LEVEL_COUNT> BIT_LEVELS = []()
+    {
+        std::array<double, LEVEL_COUNT> levels{};
+        for (unsigned int levelIdx = 0; levelIdx < LEVEL_COUNT; ++levelIdx)
+        {
+            levels[LEVEL_BITS[levelIdx]] = LEVELS[levelIdx];
+        }
+        return levels;
+    }();
+
+    /**
+     * @brief Map a symbol to its constellation point
+     *
+     * @param p_symbol - the bits of the symbol, lower than 2^BitsPerSymbol
+     * @return I + jQ
+     */
+    static std::complex<double> map(const unsigned int p_symbol)
+    {
+        return std::complex<double>(BIT_LEVELS[p_symbol >> BITS_PER_AXIS], BIT_LEVELS[p_symbol & (LEVEL_COUNT - 1)]);
+    }
+
+    /**
+     * @brief Find the closest level of one axis without comparing against every level
+     *
+     * @param p_value - the received amplitude of the axis
+     * @return index of the level in LEVELS, values past the outer levels give the outer levels
+     */
+    static unsigned int sliceLevel(const double p_value)
+    {
+        // Level i covers [-1 + i * SPACING, -1 + (i + 1) * SPACING)
+        double position = std::floor((p_value + 1.0) * (LEVEL_COUNT / 2.0));
+        return static_cast<unsigned int>(std::clamp(position, 0.0, LEVEL_COUNT - 1.0));
+    }
+
+    /**
+     * @brief Slice a received point to the closest symbol
+     *
+     * @param p_inPhase - the received I amplitude
+     * @param p_quadrature - the received Q amplitude
+     * @param p_distance - receives the squared distance between the received point and the symbol
+     * @return the bits of the symbol
+     */
+    static unsigned int slice(const double p_inPhase, const double p_quadrature, double &p_distance)
+    {
+        unsigned int inPhaseLevel = sliceLevel(p_inPhase);
+        unsigned int quadratureLevel = sliceLevel(p_quadrature);
+        double inPhaseError = p_inPhase - LEVELS[inPhaseLevel];
+        double quadratureError = p_quadrature - LEVELS[quadratureLevel];
+        p_distance = inPhaseError * inPhaseError + quadratureError * quadratureError;
+        return (LEVEL_BITS[inPhaseLevel] << BITS_PER_AXIS) | LEVEL_BITS[quadratureLevel];
+    }
+
+    /**
+     * @brief Soft slice a received point into the log-likelihood ratio of every bit, simplified max-log approximation
+     *
+     * @param p_inPhase - the received I amplitude
+     * @param p_quadrature - the received Q amplitude
+     * @param p_llr - receives BitsPerSymbol ratios, first bit first, see softSliceAxis()
+     */
+    static void softSlice(const double p_inPhase, const double p_quadrature, float *p_llr)
+    {
+        softSliceAxis(p_inPhase, p_llr);
+        softSliceAxis(p_quadrature, p_llr + BITS_PER_AXIS);
+    }
+
+    /**
+     * @brief Soft slice the bits of one axis without comparing against every level
+     *
+     * The first bit of the Gray code splits the axis at 0, every next bit splits the value folded at the previous
+     * boundary at half its distance, so each ratio is 2 * SPACING times the signed distance to the nearest
+     * boundary of its bit. That is the max-log ratio of the two levels around the boundary: exact up to half a
+     * spacing from it, linear further out where the exact ratio bends, with the same sign everywhere.
+     *
+     * @param p_value - the received amplitude of the axis
+     * @param p_llr - receives BITS_PER_AXIS ratios, positive for bit 0, d1^2 - d0^2 with dB the distance to the
+     * closest level whose bit is B, so dividing by 2 * sigma^2 of the noise of the axis gives the natural log ratio
+     */
+    static void softSliceAxis(const double p_value, float *p_llr)
+    {
+        // The lower half of the levels has the first bit at 0
+        double folded = -p_value;
+        double boundary = 0.5;
+        p_llr[0] = static_cast<float>(2.0 * SPACING * folded);
+        for (unsigned int bitIdx = 1; bitIdx < BITS_PER_AXIS; ++bitIdx)
+        {
+            // The outer levels of every folded half have the bit at 0
+            folded = std::fabs(folded) - boundary;
+            boundary /= 2.0;
+            p_llr[bitIdx] = static_cast<float>(2.0 * SPACING * folded);
+        }
+    }
+};
@@ -0,0 +1,218 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include "frameBuffer.h"
+#include "session.h"
+
+/// @brief The backlog of pending connections of every listener
+constexpr int MAX_CONNECTION_REQUEST = SOMAXCONN;
+
+/// @brief The maximum number of events handled by one epoll_wait() of a reactor
+constexpr int MAX_EVENTS = 64;
+
+/// @brief The longest wait of a reactor for events before it checks whether the server is still running (ms)
+constexpr int REACTOR_WAIT_TIMEOUT = 200;
+
+/// @brief The most requests of a client waiting for their replies, reading pauses above it like above the high-water mark
+constexpr size_t MAX_PENDING_REPLIES = 64;
+
+/// @brief Receives the payload of the reply frame of one request, exactly once, from any thread
+using ReplySink = std::function<void(std::string p_reply)>;
+
+/// @brief Answers the payload of a request frame of a client, at once or later from another thread through the sink.
+/// The session of the client may only be used during the call, a later reply copies what it needs from it.
+using RequestHandler = std::function<void(Session &p_session, const std::string &p_request, const ReplySink &p_reply)>;
+
+/// @brief The reply of a request, sent once it and the replies of the earlier requests of its client are ready
+struct PendingReply
+{
+    bool isReady = false;
+    std::string payload;
+};
+
+/// @brief Buffers of one client connection, requests and replies are length-prefixed frames
+struct ClientConnection
+{
+    /// @brief Partial request frame waiting for the rest of its bytes
+    FrameReader reader;
+
+    /// @brief Reply frames the socket has not accepted yet
+    FrameWriter writer;
+
+    /// @brief true while the replies are above the high-water mark, the requests then wait in the socket
+    bool isReadPaused = false;
+
+    /// @brief Unique in the reactor, so a late reply to a closed client does not reach a client reusing its socket
+    uint64_t id = 0;
+
+    /// @brief The replies not queued in the writer yet, in request order
+    std::deque<PendingReply> replies;
+
+    /// @brief The sequence number of the request of replies.front()
+    uint64_t firstSequence = 0;
+
+    /// @brief The state of the client, taken from the session pool of the reactor and given back on close
+    std::unique_ptr<Session> session;
+};
+
+/**
+ * @brief One event loop serving its own share of the clients
+ *
+ * Every reactor has its own listener bound with SO_REUSEPORT on the server port, so the kernel spreads the
+ * incoming connections over the reactors and a connection stays on the reactor that accepted it. The loop runs
+ * on one thread pinned to one core and owns its connections, nothing of a reactor is shared with another one.
+ *
+ * A request answered on another thread is handed back through a completion queue and an eventfd waking the
+ * loop, so slow requests never block the loop and the cheap requests of other clients are answered meanwhile.
+ */
+class Reactor
+{
+public:
+    /**
+     * @brief Constructor of a reactor without listener
+     *
+     * @param p_index - the index of the reactor, also the core its loop is pinned to modulo the amount of cores
+     * @param p_outputHighWater - reading from a client pauses above this amount of queued reply bytes and resumes
+     * below half of it
+     * @param p_handler - answers every request of the clients of this reactor, called on the thread of the loop
+     */
+    Reactor(const size_t p_index, const size_t p_outputHighWater, const RequestHandler &p_handler);
+
+    /// @brief Destructor closing the listener, the epoll instance and the client sockets
+    ~Reactor();
+
+    Reactor(const Reactor &) = delete;
+    Reactor &operator=(const Reactor &) = delete;
+
+    /**
+     * @brief Create the listener and the epoll instance
+     *
+     * @param p_address - the IPv4 address to listen on
+     * @param p_port - the port shared by every reactor, 0 lets the kernel choose one, see getPort()
+     * @return false if a socket call failed, the error is logged
+     */
+    bool listen(const char *p_address, const uint16_t p_port);
+
+    /**
+     * @brief Get the port of the listener
+     *
+     * @return the port, 0 before listen()
+     */
+    uint16_t getPort() const;
+
+    /**
+     * @brief Pin the calling thread to the core of the reactor and handle events until the server stops
+     *
+     * @param p_isRunning - checked at least every REACTOR_WAIT_TIMEOUT milliseconds
+     */
+    void run(const std::atomic<bool> &p_isRunning);
+
+    /**
+     * @brief Get the amount of clients connected to this reactor
+     *
+     * @return the amount of connections
+     */
+    size_t getConnectionCount() const;
+
+private:
+    size_t m_index;
+    size_t m_outputHighWater;
+    RequestHandler m_handler;
+
+    int m_listenSocket;
+    int m_epollFd;
+    struct epoll_event m_events[MAX_EVENTS];
+
+    /// @brief Buffers of every connected client, keyed by socket
+    std::unordered_map<int, ClientConnection> m_connections;
+
+    /// @brief Amount of clients, read by other threads
+    std::atomic<size_t> m_connectionCount;
+
+    /// @brief Sessions of the closed connections, reused by the next accepted ones
+    SessionPool m_sessions;
+
+    /// @brief The id of the next accepted connection
+    uint64_t m_nextConnectionId;
+
+    /// @brief The thread running the loop, replies given on it skip the completion queue
+    std::thread::id m_loopThread;
+
+    /// @brief A reply given on another thread
+    struct Completion
+    {
+        int socket;
+        uint64_t connectionId;
+        uint64_t sequence;
+        std::string payload;
+    };
+
+    /// @brief Replies given on other threads since the loop last woke up, under m_completionMutex
+    std::vector<Completion> m_completions;
+    std::mutex m_completionMutex;
+
+    /// @brief eventfd counting the replies given on other threads, it wakes the loop through epoll
+    int m_wakeFd;
+
+    /**
+     * @brief Accept every pending connection of the listener
+     */
+    void acceptClients();
+
+    /**
+     * @brief Handle the events of a client: write the queued replies, read every available byte unless the replies
+     * are backed up, and answer every complete request frame
+     *
+     * @param p_clientSocket - a client socket
+     * @param p_events - the epoll events of the socket
+     */
+    void handleClient(const int p_clientSocket, const uint32_t p_events);
+
+    /**
+     * @brief Check whether reading from a client must wait for its replies to be sent
+     *
+     * @param p_connection - the connection
+     * @param p_divider - 1 to check the limits, 2 to check half of them as when resuming
+     * @return true above the high-water mark or with more than MAX_PENDING_REPLIES unanswered requests
+     */
+    bool isBackedUp(const ClientConnection &p_connection, const size_t p_divider) const;
+
+    /**
+     * @brief Store a reply in the slot of its request and queue the ready replies in request order
+     *
+     * @param p_completion - the reply, dropped if its connection has been closed
+     * @return true if the connection still exists
+     */
+    bool deliver(Completion &&p_completion);
+
+    /**
+     * @brief Deliver the replies given on other threads and write them
+     */
+    void drainCompletions();
+
+    /**
+     * @brief Close a client socket, drop its buffers and give its session back to the pool
+     *
+     * @param p_clientSocket - a client socket
+     */
+    void closeClient(const int p_clientSocket);
+};
+
+/**
+ * @brief Set a socket to non-blocking mode
+ *
+ * @param p_sockFD - a socket
+ * @return a number indicating whether a socket is set to non-blocking mode successfully or not
+ * (Returns 0 on success, -1 for errors)
+ */
+int setSocketNonblocking(const int p_sockFD);
@@ -0,0 +1,118 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+/// @brief Fixed point sample as delivered by radio front-ends, see SampleFormat<Q15> for its scale
+using Q15 = int16_t;
+
+/// @brief The amplitude of the largest Q15 sample, the headroom above 1.0 keeps the QAM corners and the noise
+constexpr double SAMPLE_Q15_FULL_SCALE = 2.0;
+
+/// @brief The amount of Q15 steps of one unit of amplitude
+constexpr double SAMPLE_Q15_SCALE = 32768.0 / SAMPLE_Q15_FULL_SCALE;
+
+/**
+ * @brief Clamp a wide integer into the Q15 range instead of wrapping around
+ *
+ * @param p_value - a sum or product of Q15 values
+ * @return the closest Q15 value
+ */
+constexpr Q15 saturateQ15(const int32_t p_value)
+{
+    return static_cast<Q15>(p_value > INT16_MAX ? INT16_MAX : (p_value < INT16_MIN ? INT16_MIN : p_value));
+}
+
+/**
+ * @brief Conversion between a sample type of the signal chain and amplitudes, specialized for every type
+ *
+ * @param NAME - name of the format in messages and benchmarks
+ * @param fromAmplitude - the sample of an amplitude, saturated to the range of the format
+ * @param toAmplitude - the amplitude of a sample
+ */
+template <typename Sample>
+struct SampleFormat;
+
+template <>
+struct SampleFormat<double>
+{
+    static constexpr const char *NAME = "double";
+
+    static double fromAmplitude(const double p_amplitude)
+    {
+        return p_amplitude;
+    }
+
+    static double toAmplitude(const double p_sample)
+    {
+        return p_sample;
+    }
+};
+
+template <>
+struct SampleFormat<float>
+{
+    static constexpr const char *NAME = "float";
+
+    static float fromAmplitude(const double p_amplitude)
+    {
+        return static_cast<float>(p_amplitude);
+    }
+
+    static double toAmplitude(const float p_sample)
+    {
+        return p_sample;
+    }
+};
+
+template <>
+struct SampleFormat<Q15>
+{
+    static constexpr const char *NAME = "q15";
+
+    static Q15 fromAmplitude(const double p_amplitude)
+    {
+        // Clamp before converting, a double out of the int range has no defined conversion,
+        // then round half away from zero with a truncating conversion that compiles to one instruction
+        double scaled = p_amplitude * SAMPLE_Q15_SCALE;
+        scaled = scaled > INT16_MAX ? INT16_MAX : (scaled < INT16_MIN ? INT16_MIN : scaled);
+        return static_cast<Q15>(static_cast<int32_t>(scaled + (scaled < 0.0 ? -0.5 : 0.5)));
+    }
+
+    static double toAmplitude(const Q15 p_sample)
+    {
+        return p_sample / SAMPLE_Q15_SCALE;
+    }
+};
+
+/**
+ * @brief Convert amplitudes to samples of another format
+ *
+ * @param p_input - amplitudes
+ * @param p_size - the amount of samples
+ * @param p_output - receives p_size samples, saturated to the range of the format
+ */
+template <typename Sample>
+void toSamples(const double *p_input, const size_t p_size, Sample *p_output)
+{
+    for (size_t sampleIdx = 0; sampleIdx < p_size; ++sampleIdx)
+    {
+        p_output[sampleIdx] = SampleFormat<Sample>::fromAmplitude(p_input[sampleIdx]);
+    }
+}
+
+/**
+ * @brief Convert samples of another format to amplitudes
+ *
+ * @param p_input - samples
+ * @param p_size - the amount of samples
+ * @param p_output - receives p_size amplitudes
+ */
+template <typename Sample>
+void toAmplitudes(const Sample *p_input, const size_t p_size, double *p_output)
+{
+    for (size_t sampleIdx = 0; sampleIdx < p_size; ++sampleIdx)
+    {
+        p_output[sampleIdx] = SampleFormat<Sample>::toAmplitude(p_input[sampleIdx]);
+    }
+}
@@ -1,39 +1,51 @@
 #pragma once
 #include <iostream>
+#include <fstream>
 #include <atomic>
+#include <memory>
 #include <thread>
 #include <vector>
 #include <unistd.h>
-#include <netinet/in.h>
-#include <arpa/inet.h>
-#include <sys/socket.h>
-#include <sys/epoll.h>
 #include "serverCommon.h"
 #include "carrier.h"
-#include "modulator.h"
-#include "antenna.h"
+#include "threadPool.h"
+#include "reactor.h"
+#include "transceiver.h"
+#include "jobQueue.h"
 
 /// @brief The port number used to establish connection with client
 constexpr unsigned int SERVER_PORT = 8080;
 
-/// @brief The size of the read and the write buffer of server
-constexpr unsigned int BUFFER_SIZE = 1024;
-
 /// @brief The domain address used to establish connection with client
 constexpr const char *SERVER_IP_ADDR = "0.0.0.0";
 
-/// @brief The database file path of server
-constexpr int MAX_CONNECTION_REQUEST = 3;
-
-/// @brief The maximum number of events to be monitored with epoll
-constexpr int MAX_EVENTS = 10;
-
 /// @brief The log file path of server
 constexpr const char *LOG_FILE_PATH = "server.log";
 
 /// @brief The database file path of server
 constexpr const char *INITIAL_DATABASE_PATH = "./db";
 
+/// @brief Database key of the amount of threads sharing the modulation, 0 uses every hardware thread
+constexpr const char *WORKER_THREADS_KEY = "/server/workerThreads";
+
+/// @brief Database key selecting the UL channel on complex baseband samples (1) or real passband samples (0)
+constexpr const char *BASEBAND_KEY = "/server/baseband";
+
+/// @brief Database key of the channel noise seed, 0 gives different noise on every run
+constexpr const char *NOISE_SEED_KEY = "/server/noiseSeed";
+
+/// @brief Database key of the amount of reply bytes queued for a client above which its requests are not read
+constexpr const char *OUTPUT_HIGH_WATER_KEY = "/server/outputHighWater";
+
+/// @brief The high-water mark of the reply queues when the key is 0 or missing (bytes)
+constexpr size_t DEFAULT_OUTPUT_HIGH_WATER = 1 << 20;
+
+/// @brief Database key of the amount of event loops serving the clients, 0 runs one per hardware thread
+constexpr const char *REACTORS_KEY = "/server/reactors";
+
+/// @brief Database key of the amount of workers running DL and UL bursts, 0 runs one per hardware thread
+constexpr const char *RADIO_WORKERS_KEY = "/server/radioWorkers";
+
 /// @brief Initialize logger of server side
 void initLogger();
 
@@ -43,12 +55,12 @@ public:
     Server();
     ~Server();
     /**
-     * @brief Initialize server socket
+     * @brief Initialize the listener and the epoll instance of every reactor
      */
     void init();
 
     /**
-     * @brief Accept incoming connections and handle clients
+     * @brief Accept incoming connections and handle clients, the first reactor runs on the calling thread
      */
     void start();
 
@@ -57,22 +69,21 @@ private:
     std::string m_dbPath;
     std::atomic<bool> m_serverRunning;
 
-    int m_serverSocket;
-    int m_clientSocket;
     std::vector<std::thread> m_threads;
-    struct sockaddr_in m_serverAddress;
-    struct sockaddr_in m_clientAddress;
-    socklen_t m_clientAddrLen = sizeof(m_clientAddress);
-
-    int m_epollFd;
-    struct epoll_event ev;
-    struct epoll_event events[MAX_EVENTS];
 
     bool m_canInitDB;
 
-    std::unique_ptr<Carrier> m_carrier;
-    std::unique_ptr<Modulator> m_modulator;
-    std::unique_ptr<Antenna> m_antenna;
+    /// @brief Threads shared by the modulator of the only radio worker, none when several workers modulate at once
+    std::unique_ptr<ThreadPool> m_threadPool;
+
+    /// @brief The radio chain of every radio worker, same index as the worker
+    std::vector<std::unique_ptr<Transceiver>> m_transceivers;
+
+    /// @brief The event loops, each with its own listener on SERVER_PORT and its own share of the clients
+    std::vector<std::unique_ptr<Reactor>> m_reactors;
+
+    /// @brief Workers running the DL and UL bursts off the event loops, destroyed first as its jobs reply to them
+    std::unique_ptr<JobQueue> m_radioJobs;
 
     /**
      * @brief Initialize database of server side
@@ -80,20 +91,46 @@ private:
     void initDB();
 
     /**
-     * @brief Set a socket to non-blocking mode
+     * @brief Read the amount of worker threads in server database
      *
-     * @param p_sockFD - a socket
-     * @return a number indicating whether a socket is set to non-blocking mode successfully or not
-     * (Returns 0 on success, -1 for errors)
+     * @return the configured amount, the amount of hardware threads when it is 0 or missing
      */
-    int setSocketNonblocking(const int &p_sockFD);
+    size_t readWorkerThreads();
 
     /**
-     * @brief Handle a client
+     * @brief Read the UL channel mode in server database
      *
-     * @param p_clientSocket - a client socket
+     * @return true - complex baseband samples, false - real passband samples, also when the key is missing
      */
-    void handleClient(const int &p_clientSocket);
+    bool readBaseband();
+
+    /**
+     * @brief Read the channel noise seed in server database
+     *
+     * @return the configured seed, 0 when it is not set or the key is missing
+     */
+    uint64_t readNoiseSeed();
+
+    /**
+     * @brief Read the high-water mark of the reply queues in server database
+     *
+     * @return the configured amount of bytes, DEFAULT_OUTPUT_HIGH_WATER when it is 0 or missing
+     */
+    size_t readOutputHighWater();
+
+    /**
+     * @brief Read the amount of reactors in server database
+     *
+     * @return the configured amount, the amount of hardware threads when it is 0, 1 when the key is missing
+     */
+    size_t readReactorCount();
+
+    /**
+     * @brief Read the amount of radio workers in server database
+     *
+     * @return the configured amount, the amount of hardware threads when it is 0, 1 when the key is missing
+     */
+    size_t readRadioWorkerCount();
 
     /**
      * @brief Handle common server commands
@@ -114,19 +151,33 @@ private:
     std::string handleClientGetDBCommand(const std::string &p_key);
 
     /**
-     * @brief Handle commands from client sent to server.
+     * @brief Handle a request of a client: DL and UL bursts are queued for the radio workers and answered when they
+     * are done, the other commands are answered at once on the event loop
+     *
+     * @param p_session - the session of the client, its carrier is copied into the queued bursts
+     * @param p_request - payload of a request frame from client
+     * @param p_reply - receives the reply
+     */
+    void handleRequest(Session &p_session, const std::string &p_request, const ReplySink &p_reply);
+
+    /**
+     * @brief Handle commands from client sent to server, except the DL and UL bursts
      *
-     * @param p_buffer - message from client
+     * @param p_session - the session of the client, carrier commands set up its own carrier
+     * @param p_request - payload of a request frame from client
      * @return message containing database results sent to client.
      */
-    std::string handleClientCommand(const char *p_buffer);
+    std::string handleClientCommand(Session &p_session, const std::string &p_request);
 
     /**
-     * @brief Set up carrier for server
+     * @brief Set up the carrier of a client
      *
+     * @param p_carrier - the carrier of the session of the client
      * @param p_network - network that is set up to transmit and receive data
      * @param p_freq - frequency of carrier
+     * @param p_fec - forward error correction of the payloads, FEC_NONE or FEC_CONVOLUTIONAL
      * @return message send to client
      */
-    std::string setNetworkForServer(const std::string &p_network, const ssize_t &p_freq);
+    std::string setNetworkForServer(Carrier &p_carrier, const std::string &p_network, const ssize_t &p_freq,
+                                    const std::string &p_fec);
 };
\ No newline at end of file
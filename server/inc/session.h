@@ -0,0 +1,66 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "carrier.h"
+
+/// @brief The most released sessions a pool keeps for the next clients, the others are freed
+constexpr size_t SESSION_POOL_CAPACITY = 1024;
+
+/**
+ * @brief State of one client connection, from its accept to its close
+ *
+ * Every client sets up its own carrier, so the setup of one client never changes the bursts of another one. The
+ * modulator is not part of it: a burst runs on a copy of the carrier with the radio chain of a worker.
+ */
+struct Session
+{
+    /// @brief The carrier of the DL and UL bursts of the client
+    Carrier carrier;
+
+    /**
+     * @brief Forget the state of the previous client before the session is reused
+     */
+    void reset();
+};
+
+/**
+ * @brief Sessions released by closed connections, handed to the next accepted ones instead of allocating
+ *
+ * A pool is owned by one reactor and only used on its thread, so it has no lock.
+ */
+class SessionPool
+{
+public:
+    /**
+     * @brief Constructor of an empty pool
+     *
+     * @param p_capacity - the most released sessions kept
+     */
+    explicit SessionPool(const size_t p_capacity = SESSION_POOL_CAPACITY);
+
+    /**
+     * @brief Get a session in its initial state, a released one if any
+     *
+     * @return the session
+     */
+    std::unique_ptr<Session> acquire();
+
+    /**
+     * @brief Give back the session of a closed connection
+     *
+     * @param p_session - the session, reset and kept if the pool is not full, freed otherwise
+     */
+    void release(std::unique_ptr<Session> &&p_session);
+
+    /**
+     * @brief Get the amount of released sessions waiting for a client
+     *
+     * @return the amount of free sessions
+     */
+    size_t getFreeCount() const;
+
+private:
+    size_t m_capacity;
+    std::vector<std::unique_ptr<Session>> m_free;
+};
@@ -0,0 +1,31 @@
+#pragma once
+
+/// @brief The instruction sets the SIMD kernels are written for
+enum class SimdLevel
+{
+    SCALAR,
+    SSE2,
+    AVX2
+};
+
+/**
+ * @brief Get the instruction set used by the SIMD kernels
+ *
+ * @return the best level supported by the CPU, unless lowered by setSimdLevel
+ */
+SimdLevel getSimdLevel();
+
+/**
+ * @brief Select the instruction set used by the SIMD kernels (for tests and benchmarks)
+ *
+ * @param p_level - requested level, lowered to the best level supported by the CPU
+ */
+void setSimdLevel(const SimdLevel p_level);
+
+/**
+ * @brief Name of an instruction set level
+ *
+ * @param p_level - instruction set level
+ * @return "scalar", "sse2" or "avx2"
+ */
+const char *toString(const SimdLevel p_level);
@@ -0,0 +1,26 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "bitStream.h"
+
+/// @brief The largest magnitude of a quantized log-likelihood ratio, symmetric so both bits get the same range
+constexpr int8_t LLR_INT8_MAX = 127;
+
+/**
+ * @brief Quantize log-likelihood ratios to 8 bits, the compact input of a decoder
+ *
+ * @param p_llr - log-likelihood ratios, positive for bit 0
+ * @param p_size - the amount of ratios
+ * @param p_scale - the amount of quantization steps of one unit of ratio
+ * @param p_output - receives p_size ratios rounded to the closest step, saturated at +-LLR_INT8_MAX
+ */
+void quantizeLlrs(const float *p_llr, const size_t p_size, const float p_scale, int8_t *p_output);
+
+/**
+ * @brief Take the hard decisions of soft bits
+ *
+ * @param p_llr - log-likelihood ratios, positive for bit 0
+ * @param p_size - the amount of ratios
+ * @param p_output - resized to p_size bits, 1 where the sign of the ratio is negative
+ */
+void hardDecide(const float *p_llr, const size_t p_size, BitStream &p_output);
@@ -0,0 +1,90 @@
+#pragma once
+#include <complex>
+#include <cstddef>
+#include <vector>
+#include "fft.h"
+
+/// @brief The amount of samples of one frame of the spectrum monitor, a power of 4 takes the radix-4 path
+constexpr size_t SPECTRUM_FRAME_SAMPLES = 4096;
+
+/**
+ * @brief One-sided amplitude spectrum, as computed by plot_frequency_domain() of FFT/plot_fft.py
+ *
+ * @param frequency - frequency of every bin (Hz), k * fs / N for k < N / 2
+ * @param amplitude - |X[k]| * 2 / N for k < N / 2
+ * @param peakIndex - the first bin of the highest amplitude
+ */
+struct Spectrum
+{
+    std::vector<double> frequency;
+    std::vector<double> amplitude;
+    size_t peakIndex;
+};
+
+/**
+ * @brief Compute the one-sided amplitude spectrum of a real signal
+ *
+ * @param p_signal - samples of the signal
+ * @param p_size - the amount of samples
+ * @param p_sampleRate - the amount of samples in 1 second
+ * @param p_output - receives p_size / 2 bins, its capacity is reused
+ */
+void computeSpectrum(const double *p_signal, const size_t p_size, const double p_sampleRate, Spectrum &p_output);
+
+/**
+ * @brief Spectrum of a signal received block by block, averaged over fixed-size frames
+ *
+ * Memory does not depend on the length of the signal. A signal shorter than one frame is transformed at
+ * its own length, a tail shorter than one frame after full frames is left out of the average.
+ */
+class SpectrumMonitor
+{
+public:
+    /**
+     * @brief Constructor of an empty monitor
+     *
+     * @param p_sampleRate - the amount of samples in 1 second
+     * @param p_frameSize - the amount of samples of one frame
+     */
+    SpectrumMonitor(const double p_sampleRate, const size_t p_frameSize = SPECTRUM_FRAME_SAMPLES);
+
+    /**
+     * @brief Add the next samples of the signal
+     *
+     * @param p_samples - the samples
+     * @param p_count - the amount of samples
+     */
+    void write(const double *p_samples, const size_t p_count);
+
+    /**
+     * @brief Get the spectrum of the samples written since the last reset
+     *
+     * @param p_output - receives the averaged spectrum, empty if no sample was written
+     */
+    void getSpectrum(Spectrum &p_output);
+
+    /**
+     * @brief Forget the samples written, to monitor a new signal
+     */
+    void reset();
+
+private:
+    double m_sampleRate;
+    size_t m_frameSize;
+
+    /// @brief Samples of the frame being filled
+    std::vector<double> m_frame;
+    size_t m_frameFill;
+
+    /// @brief Sum of the amplitudes of every full frame
+    std::vector<double> m_amplitudeSum;
+    size_t m_frameCount;
+
+    std::vector<std::complex<double>> m_bins;
+    std::vector<std::complex<double>> m_scratch;
+
+    /**
+     * @brief Add the amplitudes of the frame to the sum
+     */
+    void closeFrame();
+};
@@ -0,0 +1,147 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include "bitStream.h"
+#include "correlator.h"
+#include "goertzel.h"
+#include "oscillator.h"
+
+/// @brief The maximum amount of reference tones correlated per symbol window (2 for BFSK)
+constexpr size_t DEMODULATION_MAX_TONES = 2;
+
+/**
+ * @brief Correlations of one symbol window
+ *
+ * @param inPhase - correlation with the cosine of every reference tone, at its phase from sample 0 of the signal
+ * @param quadrature - correlation with the sine of every reference tone, at its phase from sample 0 of the signal
+ * @param absolute - sum of the absolute sample values, the envelope of the window
+ * @param power - squared magnitude of the correlation with every reference tone, whatever the phase of the tone
+ */
+struct WindowCorrelation
+{
+    double inPhase[DEMODULATION_MAX_TONES];
+    double quadrature[DEMODULATION_MAX_TONES];
+    double absolute;
+    double power[DEMODULATION_MAX_TONES];
+};
+
+/**
+ * @brief What a modulation correlates every symbol window against
+ *
+ * @param toneCount - the amount of reference tones used
+ * @param frequency - frequency of every reference tone
+ * @param reference - reference waveforms of one window of every tone
+ * @param needsEnvelope - true if the decision uses the sum of absolute values
+ * @param needsTonePower - true if the decision only uses the power of the tones, detected with the Goertzel
+ * algorithm instead of the reference waveforms
+ */
+struct DemodulationReferences
+{
+    size_t toneCount;
+    double frequency[DEMODULATION_MAX_TONES];
+    const ReferenceWaveform *reference[DEMODULATION_MAX_TONES];
+    bool needsEnvelope;
+    bool needsTonePower;
+};
+
+/// @brief Decides the symbol of a closed window, returns false when the window can not be decided
+using SymbolDecider = std::function<bool(const WindowCorrelation &p_correlation, unsigned int &p_symbol)>;
+
+/// @brief Receives the bits of the symbol windows closed by one write, only valid during the call
+using BitSink = std::function<void(const BitStream &p_bits)>;
+
+/**
+ * @brief Demodulator fed with sample blocks of any size, for continuous reception
+ *
+ * Partial correlations of the open symbol window and the absolute sample clock are kept across
+ * writes, so a window may span several blocks. Bits are handed to the sink at the end of every write
+ * that closes at least one window.
+ */
+class StreamingDemodulator
+{
+public:
+    /**
+     * @brief Constructor of a stream starting at sample 0, which is a symbol boundary
+     *
+     * @param p_references - reference tones of the modulation, the waveforms must outlive the stream
+     * @param p_bitsPerSymbol - the amount of bits carried by one symbol window
+     * @param p_samplesPerSymbol - the amount of samples in one symbol window
+     * @param p_sampleRate - the amount of samples in 1 second
+     * @param p_decider - decides the symbol of every closed window
+     * @param p_sink - receives the demodulated bits
+     */
+    StreamingDemodulator(const DemodulationReferences &p_references, const unsigned int p_bitsPerSymbol,
+                         const size_t p_samplesPerSymbol, const double p_sampleRate, SymbolDecider p_decider, BitSink p_sink);
+
+    /**
+     * @brief Demodulate the next samples, following the samples of the previous writes
+     *
+     * @param p_samples - samples of the received signal
+     * @param p_count - the amount of samples, any size
+     */
+    void write(const double *p_samples, const size_t p_count);
+
+    /**
+     * @brief Restart the stream at sample 0, dropping the open window
+     */
+    void reset();
+
+    /**
+     * @brief Get the amount of samples received since the start of the stream
+     *
+     * @return the absolute sample clock
+     */
+    uint64_t getSampleCount() const;
+
+    /**
+     * @brief Get the amount of symbol windows closed since the start of the stream
+     *
+     * @return the amount of symbols
+     */
+    uint64_t getSymbolCount() const;
+
+    /**
+     * @brief Get the amount of windows that could not be decided, their bits are sent as 0
+     *
+     * @return the amount of windows
+     */
+    uint64_t getErrorCount() const;
+
+private:
+    DemodulationReferences m_references;
+    unsigned int m_bitsPerSymbol;
+    size_t m_samplesPerSymbol;
+    SymbolDecider m_decider;
+    BitSink m_sink;
+
+    /// @brief Clock of every reference tone, giving its phase at the start of a window
+    Oscillator m_windowClocks[DEMODULATION_MAX_TONES];
+
+    /// @brief Correlations of the open window, relative to its first sample
+    WindowCorrelation m_partial;
+
+    /// @brief Tone detector of the windows decided on the power of the tones
+    GoertzelDetector m_toneDetector;
+
+    /// @brief DFT of the open window at every tone, relative to its first sample
+    std::complex<double> m_partialTones[DEMODULATION_MAX_TONES];
+
+    /// @brief Frequency of every reference tone in radian per sample
+    double m_toneAngle[DEMODULATION_MAX_TONES];
+
+    /// @brief The amount of samples of the open window received so far
+    size_t m_windowFill;
+
+    uint64_t m_sampleClock;
+    uint64_t m_symbolIndex;
+    uint64_t m_errorCount;
+
+    /// @brief Bits decided during the current write
+    BitStream m_bits;
+
+    /**
+     * @brief Decide the open window and start the next one
+     */
+    void closeWindow();
+};
@@ -0,0 +1,142 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "bitStream.h"
+#include "threadPool.h"
+#include "waveformCache.h"
+
+/// @brief The default amount of samples handed to the sink at once
+constexpr size_t STREAMING_BLOCK_SAMPLES = 4096;
+
+/// @brief The least amount of symbols split across a thread pool, below it the hand-off costs more than it saves
+constexpr size_t PARALLEL_MODULATION_MIN_SYMBOLS = 64;
+
+/**
+ * @brief Receives one block of modulated samples
+ *
+ * The block may be modified in place (e.g. to add noise) and is only valid during the call.
+ */
+using SampleSink = std::function<void(double *p_samples, size_t p_count)>;
+
+/**
+ * @brief Modulator fed with bits incrementally, emitting fixed-size sample blocks
+ *
+ * Symbols are written from the waveform templates at their absolute position in the stream, so the
+ * carrier phase is continuous across writes and blocks. Memory use does not depend on the payload size.
+ */
+class StreamingModulator
+{
+public:
+    /**
+     * @brief Constructor of a stream starting at symbol 0
+     *
+     * @param p_waveforms - symbol templates of the modulation, must outlive the stream
+     * @param p_bitsPerSymbol - the amount of bits carried by one symbol window
+     * @param p_samplesPerSymbol - the amount of samples in one symbol window
+     * @param p_sink - receives every full block and the last partial block on flush()
+     * @param p_blockSize - the amount of samples of a full block
+     */
+    StreamingModulator(const WaveformTable &p_waveforms, const unsigned int p_bitsPerSymbol, const size_t p_samplesPerSymbol,
+                       SampleSink p_sink, const size_t p_blockSize = STREAMING_BLOCK_SAMPLES);
+
+    /**
+     * @brief Modulate the next bits, following the bits of the previous writes
+     *
+     * @param p_bits - bits of any length, a symbol may span several writes
+     */
+    void write(const BitStream &p_bits);
+
+    /**
+     * @brief Modulate the symbols of long writes on several threads, blocks still reach the sink in order
+     *
+     * @param p_threadPool - threads filling batches of symbols, must outlive the stream, nullptr modulates on the caller
+     */
+    void setThreadPool(ThreadPool *p_threadPool);
+
+    /**
+     * @brief Hand the samples that do not fill a whole block to the sink
+     */
+    void flush();
+
+    /**
+     * @brief Restart the stream at symbol 0, dropping pending bits and samples
+     */
+    void reset();
+
+    /**
+     * @brief Get the amount of symbols modulated since the start of the stream
+     *
+     * @return the amount of symbols
+     */
+    uint64_t getSymbolCount() const;
+
+    /**
+     * @brief Get the amount of bits waiting for the rest of their symbol
+     *
+     * @return the amount of bits, lower than the bits per symbol
+     */
+    unsigned int getPendingBits() const;
+
+private:
+    const WaveformTable *m_waveforms;
+    unsigned int m_bitsPerSymbol;
+    size_t m_samplesPerSymbol;
+    SampleSink m_sink;
+    size_t m_blockSize;
+
+    /// @brief Samples not handed to the sink yet
+    std::vector<double> m_block;
+    size_t m_blockFill;
+
+    /// @brief Scratch window of a symbol that straddles two blocks
+    std::vector<double> m_symbolWindow;
+
+    /// @brief Bits of the symbol being assembled, first bit as most significant
+    unsigned int m_pendingSymbol;
+    unsigned int m_pendingBits;
+
+    /// @brief Absolute index of the next symbol, which sets its carrier phase
+    uint64_t m_symbolIndex;
+
+    ThreadPool *m_threadPool;
+
+    /// @brief Samples of the symbols modulated in parallel, before they are cut into blocks
+    std::vector<double> m_batch;
+
+    /**
+     * @brief Write one symbol into the blocks
+     *
+     * @param p_symbol - symbol value
+     */
+    void emitSymbol(const unsigned int p_symbol);
+
+    /**
+     * @brief Add one bit to the symbol being assembled, writing the symbol once it is complete
+     *
+     * @param p_bit - value of the bit
+     */
+    void addPendingBit(const bool p_bit);
+
+    /**
+     * @brief Modulate whole symbols of the bits on the thread pool
+     *
+     * @param p_bits - bits of the write
+     * @param p_position - index of the first bit of a symbol, advanced past the modulated symbols
+     */
+    void emitBatches(const BitStream &p_bits, size_t &p_position);
+
+    /**
+     * @brief Copy samples into the blocks, handing every full block to the sink
+     *
+     * @param p_samples - the samples
+     * @param p_count - the amount of samples
+     */
+    void appendSamples(const double *p_samples, const size_t p_count);
+
+    /**
+     * @brief Hand the filled part of the block to the sink
+     */
+    void emitBlock();
+};
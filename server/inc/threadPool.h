@@ -0,0 +1,88 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// @brief The amount of ranges per thread, so a thread finishing early steals the ranges of a slower one
+constexpr size_t THREAD_POOL_RANGES_PER_THREAD = 4;
+
+/**
+ * @brief Fixed set of worker threads splitting index ranges between them
+ *
+ * Every thread owns a queue of ranges, runs its own ranges newest first and steals the oldest range of
+ * another queue once its own is empty. The thread calling parallelFor() works on the ranges too, so a
+ * pool of 1 thread runs everything on the caller without any hand-off.
+ */
+class ThreadPool
+{
+public:
+    /**
+     * @brief Constructor starting the workers
+     *
+     * @param p_threadCount - the amount of threads sharing a range, the caller included, at least 1
+     */
+    explicit ThreadPool(const size_t p_threadCount);
+
+    /**
+     * @brief Destructor finishing the queued ranges and joining the workers
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    /**
+     * @brief Get the amount of threads sharing a range, the caller included
+     *
+     * @return the amount of threads
+     */
+    size_t getThreadCount() const;
+
+    /**
+     * @brief Split [0, p_count) into contiguous ranges and wait for all of them
+     *
+     * @param p_count - the amount of indexes
+     * @param p_body - called once per range with its first and past-the-end index, concurrently for
+     * different ranges; it must not throw
+     */
+    void parallelFor(const size_t p_count, const std::function<void(size_t, size_t)> &p_body);
+
+private:
+    /// @brief Ranges queued on one thread, the caller of parallelFor() uses queue 0
+    struct WorkQueue
+    {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkQueue>> m_queues;
+    std::vector<std::thread> m_workers;
+
+    /// @brief The amount of ranges waiting in all queues
+    std::atomic<size_t> m_queuedTasks;
+
+    std::mutex m_sleepMutex;
+    std::condition_variable m_taskReady;
+    bool m_isStopping;
+
+    /**
+     * @brief Run queued tasks until the pool stops
+     *
+     * @param p_queueIdx - the queue owned by the worker
+     */
+    void runWorker(const size_t p_queueIdx);
+
+    /**
+     * @brief Run one task, the newest of the own queue or else the oldest of another queue
+     *
+     * @param p_queueIdx - the queue owned by the calling thread
+     * @return true - a task ran, false - every queue is empty
+     */
+    bool runTask(const size_t p_queueIdx);
+};
@@ -0,0 +1,160 @@
+#pragma once
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "carrier.h"
+#include "modulator.h"
+#include "antenna.h"
+#include "threadPool.h"
+#include "spectrum.h"
+#include "convolutionalCode.h"
+
+/**
+ * @brief The DL and UL radio chain of one reactor: modulator, channel, receiver and the buffers of a burst
+ *
+ * Every reactor owns a transceiver, so the bursts of clients of different reactors are modulated at the same
+ * time without sharing any state. The carrier of a request is given by the caller.
+ */
+class Transceiver
+{
+public:
+    /**
+     * @brief Constructor of a transceiver
+     *
+     * @param p_threadPool - threads shared by the modulator, none modulates on the calling thread only
+     * @param p_isBaseband - true to run the UL channel on complex baseband samples
+     * @param p_noiseSeed - seed of the channel noise, 0 for different noise on every run
+     * @param p_noiseStream - index of the noise stream, transceivers sharing a seed get unrelated noise
+     * @param p_fileSuffix - appended to the paths of the exported signals and plots, so transceivers running at
+     * the same time do not write the same files
+     */
+    Transceiver(ThreadPool *p_threadPool, const bool p_isBaseband, const uint64_t p_noiseSeed,
+                const uint64_t p_noiseStream, const std::string &p_fileSuffix);
+
+    /**
+     * @brief Send a DL burst through the channel into the exported signal files
+     *
+     * @param p_carrier - a carrier that has been set up
+     * @param p_binaryData - the payload as a string of '0' and '1'
+     * @return an error message, empty on success
+     */
+    std::string downlink(Carrier &p_carrier, const std::string &p_binaryData);
+
+    /**
+     * @brief Receive a UL burst of random bits through the channel
+     *
+     * @param p_carrier - a carrier that has been set up
+     * @return the received bits as a string of '0' and '1'
+     */
+    std::string uplink(Carrier &p_carrier);
+
+private:
+    std::unique_ptr<Modulator> m_modulator;
+    std::unique_ptr<Antenna> m_antenna;
+
+    /// @brief Appended to the paths of the exported signals and plots
+    std::string m_fileSuffix;
+
+    /// @brief Spectrum of the noisy signal of the current DL or UL burst
+    std::unique_ptr<SpectrumMonitor> m_spectrumMonitor;
+
+    /// @brief Spectrum logged after every burst, its capacity is reused
+    Spectrum m_spectrum;
+
+    /// @brief Whole OFDM burst, the only scheme modulated at once instead of streamed, its capacity is reused
+    std::vector<double> m_signalBuffer;
+
+    /// @brief true when the UL channel runs on complex baseband samples
+    bool m_isBaseband;
+
+    /// @brief Baseband UL burst, its capacity is reused by every UL request
+    std::vector<IqSample> m_basebandBuffer;
+
+    /// @brief Bits received by the UL demodulation stream, its capacity is reused by every UL request
+    BitStream m_receivedBits;
+
+    /// @brief Demodulated binary data reused by every UL request
+    std::string m_binaryBuffer;
+
+    /// @brief Packed binary data of the current DL or UL request
+    BitStream m_bitBuffer;
+
+    /// @brief Coded bits of the current request when the carrier uses FEC, its capacity is reused
+    BitStream m_codedBits;
+
+    /// @brief Soft bits of the UL burst when the carrier uses FEC and the scheme gives them, empty otherwise
+    std::vector<float> m_softBits;
+
+    /// @brief Decoder of the UL bursts of carriers using the convolutional code
+    ViterbiDecoder m_viterbi;
+
+    /**
+     * @brief Open the file of the clean or the noisy signal named in server database
+     *
+     * @param p_file - the file to open
+     * @param p_isFilter - true for the clean signal, false for the noisy one
+     * @return true if the file is open
+     */
+    bool openInputFile(std::ofstream &p_file, const bool p_isFilter);
+
+    /**
+     * @brief Replace the payload of m_bitBuffer with its coded bits when the carrier uses FEC
+     *
+     * @param p_carrier - the carrier of the request
+     * @param p_bitsPerSymbol - the coded bits are padded with 0 to whole symbols of the scheme
+     */
+    void encodePayload(Carrier &p_carrier, const unsigned int p_bitsPerSymbol);
+
+    /**
+     * @brief Decode the UL burst received when the carrier uses FEC, from m_softBits if the scheme gave them
+     * and from the hard bits of m_receivedBits otherwise
+     *
+     * @param p_carrier - the carrier of the request
+     * @param p_bitCount - the amount of payload bits
+     */
+    void decodePayload(Carrier &p_carrier, const size_t p_bitCount);
+
+    /**
+     * @brief Run the UL burst of m_bitBuffer through the passband channel into m_receivedBits
+     *
+     * With FEC the OFDM burst is demodulated into m_softBits instead, the other schemes are demodulated by a
+     * stream of hard bits.
+     *
+     * @param p_carrier - the carrier of the request
+     * @param p_type - a known modulation scheme
+     * @param p_filteredFile - receives the clean signal
+     * @param p_noiseFile - receives the noisy signal
+     */
+    void receivePassband(Carrier &p_carrier, const ModulationType p_type, std::ofstream &p_filteredFile,
+                         std::ofstream &p_noiseFile);
+
+    /**
+     * @brief Run the UL burst of m_bitBuffer through a complex baseband channel into m_receivedBits
+     *
+     * Passband samples are only rebuilt when a file is open to export them. With FEC the burst is demodulated
+     * into m_softBits instead.
+     *
+     * @param p_carrier - the carrier of the request
+     * @param p_type - a modulation scheme with a baseband form
+     * @param p_filteredFile - receives the clean signal if it is open
+     * @param p_noiseFile - receives the noisy signal if it is open
+     */
+    void receiveBaseband(Carrier &p_carrier, const ModulationType p_type, std::ofstream &p_filteredFile,
+                         std::ofstream &p_noiseFile);
+
+    /**
+     * @brief Log the frequency and amplitude of the spectrum peak of the last burst
+     *
+     * @param p_direction - "DL" or "UL"
+     */
+    void logSpectrum(const std::string &p_direction);
+
+    /**
+     * @brief Modulate the bits of m_bitBuffer and hand the signal to a sink block by block
+     *
+     * @param p_type - a known modulation scheme
+     * @param p_sink - receives the blocks in order, they may be modified in place
+     */
+    void transmit(const ModulationType p_type, const SampleSink &p_sink);
+};
@@ -0,0 +1,156 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+/// @brief The maximum amount of samples kept for one network, frequency and sample rate (8 MB of double)
+constexpr size_t WAVEFORM_CACHE_MAX_SAMPLES = static_cast<size_t>(1) << 20;
+
+/// @brief The tolerance used to decide if a window holds a whole number of carrier cycles
+constexpr double WAVEFORM_PHASE_EPSILON = 1e-9;
+
+/**
+ * @brief Waveform of one symbol: a * cos(2*pi*k*fc*t + phase) + b * sin(2*pi*k*fc*t + phase)
+ *
+ * @param frequencyIndex - k, the tone of the symbol relative to the carrier frequency
+ * @param phase - phase of the tone at sample 0 of the signal (radian)
+ * @param inPhase - a, amplitude of the cosine component
+ * @param quadrature - b, amplitude of the sine component
+ */
+struct SymbolShape
+{
+    double frequencyIndex;
+    double phase;
+    double inPhase;
+    double quadrature;
+};
+
+/**
+ * @brief Key of the waveform templates of one modulation
+ *
+ * @param network - network type, which selects the modulation
+ * @param carrierFrequency - carrier wave frequency
+ * @param sampleRate - the amount of samples transmitted in 1 second
+ */
+struct WaveformKey
+{
+    std::string network;
+    double carrierFrequency;
+    int sampleRate;
+
+    bool operator<(const WaveformKey &p_other) const
+    {
+        return std::tie(network, carrierFrequency, sampleRate) <
+               std::tie(p_other.network, p_other.carrierFrequency, p_other.sampleRate);
+    }
+};
+
+/**
+ * @brief Templates of every symbol of one modulation
+ *
+ * When a symbol window does not hold a whole number of carrier cycles, the window of symbol n starts
+ * at a different carrier phase than the window of symbol 0. The phase repeats every `phaseCount`
+ * symbols, so the templates are stored per (phase offset, symbol).
+ */
+class WaveformTable
+{
+public:
+    /**
+     * @brief Constructor to generate the templates
+     *
+     * @param p_key - network, carrier frequency and sample rate of the templates
+     * @param p_shapes - waveform of every symbol, indexed by symbol value
+     * @param p_samplesPerSymbol - the amount of samples in one symbol window
+     */
+    WaveformTable(const WaveformKey &p_key, const std::vector<SymbolShape> &p_shapes, const size_t p_samplesPerSymbol);
+
+    /**
+     * @brief Check if the templates have been generated
+     *
+     * @return false - the phase does not repeat within WAVEFORM_CACHE_MAX_SAMPLES, true - templates are ready
+     */
+    bool isCached() const;
+
+    /**
+     * @brief Write the waveform of one symbol
+     *
+     * @param p_symbolIndex - position of the symbol in the signal, used for the carrier phase
+     * @param p_symbol - symbol value
+     * @param p_output - buffer receiving samplesPerSymbol samples
+     */
+    void writeSymbol(const uint64_t p_symbolIndex, const unsigned int p_symbol, double *p_output) const;
+
+    /**
+     * @brief Get the amount of distinct window phase offsets
+     *
+     * @return phase period in symbols, 0 when the templates are not cached
+     */
+    size_t getPhaseCount() const;
+
+    /**
+     * @brief Get the waveform of every symbol
+     *
+     * @return shapes indexed by symbol value
+     */
+    const std::vector<SymbolShape> &getShapes() const;
+
+private:
+    WaveformKey m_key;
+    std::vector<SymbolShape> m_shapes;
+    size_t m_samplesPerSymbol;
+    size_t m_phaseCount;
+
+    /// @brief Templates laid out as [phase offset][symbol][sample]
+    std::vector<double> m_samples;
+
+    /**
+     * @brief Find after how many symbols the carrier phase of every tone repeats
+     *
+     * @param p_maxPeriod - the largest period accepted
+     * @return period in symbols, 0 when it is larger than p_maxPeriod
+     */
+    size_t findPhasePeriod(const size_t p_maxPeriod) const;
+
+    /**
+     * @brief Generate the waveform of one symbol with the oscillator
+     *
+     * @param p_symbolIndex - position of the symbol in the signal, used for the carrier phase
+     * @param p_symbol - symbol value
+     * @param p_output - buffer receiving samplesPerSymbol samples
+     */
+    void generateSymbol(const uint64_t p_symbolIndex, const unsigned int p_symbol, double *p_output) const;
+};
+
+class WaveformCache
+{
+public:
+    /**
+     * @brief Find the templates of a modulation
+     *
+     * @param p_key - network, carrier frequency and sample rate of the templates
+     * @return templates of the modulation, nullptr when they have not been generated yet
+     */
+    const WaveformTable *find(const WaveformKey &p_key) const;
+
+    /**
+     * @brief Generate and store the templates of a modulation
+     *
+     * @param p_key - network, carrier frequency and sample rate of the templates
+     * @param p_shapes - waveform of every symbol, indexed by symbol value
+     * @param p_samplesPerSymbol - the amount of samples in one symbol window
+     * @return templates of the modulation
+     */
+    const WaveformTable &insert(const WaveformKey &p_key, const std::vector<SymbolShape> &p_shapes,
+                                const size_t p_samplesPerSymbol);
+
+    /**
+     * @brief Remove all templates
+     */
+    void clear();
+
+private:
+    std::map<WaveformKey, WaveformTable> m_tables;
+};
@@ -0,0 +1,27 @@
+#include "baseband.h"
+
+Upconverter::Upconverter(const double p_carrierFrequency, const double p_sampleRate, const double p_phase,
+                         const size_t p_samplesPerSymbol)
+    : m_carrier(p_carrierFrequency, p_sampleRate, p_phase), m_samplesPerSymbol(p_samplesPerSymbol)
+{
+}
+
+void Upconverter::write(const IqSample *p_signal, const size_t p_size, std::vector<double> &p_output)
+{
+    size_t totalSymbols = p_size / BASEBAND_SAMPLES_PER_SYMBOL;
+    p_output.resize(totalSymbols * m_samplesPerSymbol);
+    double *output = p_output.data();
+    for (size_t symbolIdx = 0; symbolIdx < totalSymbols; ++symbolIdx)
+    {
+        const IqSample *symbol = p_signal + symbolIdx * BASEBAND_SAMPLES_PER_SYMBOL;
+        for (size_t sampleIdx = 0; sampleIdx < m_samplesPerSymbol; ++sampleIdx)
+        {
+            // s = Re{x * (cos + j * sin)} = I * cos - Q * sin
+            const IqSample &sample = symbol[sampleIdx * BASEBAND_SAMPLES_PER_SYMBOL / m_samplesPerSymbol];
+            double inPhase = 0.0;
+            double quadrature = 0.0;
+            m_carrier.nextQuadrature(inPhase, quadrature);
+            *output++ = sample.real() * inPhase - sample.imag() * quadrature;
+        }
+    }
+}
@@ -0,0 +1,468 @@
+#include "bitStream.h"
+#include "simd.h"
+#include <array>
+#include <cstring>
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace
+{
+    /// @brief Packs whole 64-character chunks into words, returns false on a character other than '0'/'1'
+    using PackKernel = bool (*)(const char *, size_t, uint64_t *);
+
+    /// @brief Unpacks whole words into 64 characters each
+    using UnpackKernel = void (*)(const uint64_t *, size_t, char *);
+
+    /// @brief Validates a series of characters
+    using ValidateKernel = bool (*)(const char *, size_t);
+
+    inline bool isBinaryChar(const char p_char)
+    {
+        // '0' is 0x30 and '1' is 0x31, they only differ in the lowest bit
+        return (static_cast<unsigned char>(p_char) & 0xFE) == '0';
+    }
+
+    bool packScalar(const char *p_data, size_t p_words, uint64_t *p_output)
+    {
+        for (size_t wordIdx = 0; wordIdx < p_words; ++wordIdx)
+        {
+            const char *chunk = p_data + wordIdx * BITSTREAM_WORD_BITS;
+            uint64_t word = 0;
+            bool isValid = true;
+            for (size_t bitIdx = 0; bitIdx < BITSTREAM_WORD_BITS; ++bitIdx)
+            {
+                isValid &= isBinaryChar(chunk[bitIdx]);
+                word |= static_cast<uint64_t>(chunk[bitIdx] & 1) << bitIdx;
+            }
+            if (!isValid)
+            {
+                return false;
+            }
+            p_output[wordIdx] = word;
+        }
+        return true;
+    }
+
+    /// @brief 8 characters of every byte value, first character in the lowest byte
+    using AsciiTable = std::array<uint64_t, 256>;
+
+    const AsciiTable &getAsciiTable()
+    {
+        static const AsciiTable table = []()
+        {
+            AsciiTable values{};
+            for (size_t byte = 0; byte < values.size(); ++byte)
+            {
+                char chars[8];
+                for (size_t bitIdx = 0; bitIdx < 8; ++bitIdx)
+                {
+                    chars[bitIdx] = ((byte >> bitIdx) & 1) ? '1' : '0';
+                }
+                std::memcpy(&values[byte], chars, sizeof(chars));
+            }
+            return values;
+        }();
+        return table;
+    }
+
+    void unpackScalar(const uint64_t *p_words, size_t p_count, char *p_output)
+    {
+        const AsciiTable &table = getAsciiTable();
+        for (size_t wordIdx = 0; wordIdx < p_count; ++wordIdx)
+        {
+            uint64_t word = p_words[wordIdx];
+            for (size_t byteIdx = 0; byteIdx < 8; ++byteIdx)
+            {
+                std::memcpy(p_output + wordIdx * BITSTREAM_WORD_BITS + byteIdx * 8, &table[(word >> (byteIdx * 8)) & 0xFF], 8);
+            }
+        }
+    }
+
+    bool validateScalar(const char *p_data, size_t p_size)
+    {
+        bool isValid = true;
+        for (size_t charIdx = 0; charIdx < p_size; ++charIdx)
+        {
+            isValid &= isBinaryChar(p_data[charIdx]);
+        }
+        return isValid;
+    }
+
+#if defined(__x86_64__)
+    bool packSse2(const char *p_data, size_t p_words, uint64_t *p_output)
+    {
+        const __m128i clearLowBit = _mm_set1_epi8(static_cast<char>(0xFE));
+        const __m128i zeroChar = _mm_set1_epi8('0');
+        for (size_t wordIdx = 0; wordIdx < p_words; ++wordIdx)
+        {
+            const char *chunk = p_data + wordIdx * BITSTREAM_WORD_BITS;
+            uint64_t word = 0;
+            int validMask = 0xFFFF;
+            for (size_t laneIdx = 0; laneIdx < 4; ++laneIdx)
+            {
+                __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i *>(chunk + laneIdx * 16));
+                validMask &= _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(chars, clearLowBit), zeroChar));
+                // Move the lowest bit of every character to its sign bit, which movemask gathers
+                uint64_t bits = static_cast<uint32_t>(_mm_movemask_epi8(_mm_slli_epi16(chars, 7)));
+                word |= bits << (laneIdx * 16);
+            }
+            if (validMask != 0xFFFF)
+            {
+                return false;
+            }
+            p_output[wordIdx] = word;
+        }
+        return true;
+    }
+
+    void unpackSse2(const uint64_t *p_words, size_t p_count, char *p_output)
+    {
+        const __m128i bitMask = _mm_set1_epi64x(static_cast<long long>(0x8040201008040201ULL));
+        const __m128i zeroChar = _mm_set1_epi8('0');
+        for (size_t wordIdx = 0; wordIdx < p_count; ++wordIdx)
+        {
+            uint64_t word = p_words[wordIdx];
+            for (size_t laneIdx = 0; laneIdx < 4; ++laneIdx)
+            {
+                // Spread the 2 bytes of the lane over 8 bytes each: b0 x8, b1 x8
+                __m128i bytes = _mm_cvtsi32_si128(static_cast<int>((word >> (laneIdx * 16)) & 0xFFFF));
+                bytes = _mm_unpacklo_epi8(bytes, bytes);
+                bytes = _mm_unpacklo_epi16(bytes, bytes);
+                bytes = _mm_unpacklo_epi32(bytes, bytes);
+                // 0xFF where the bit of the character is set, '0' - (-1) gives '1'
+                __m128i isOne = _mm_cmpeq_epi8(_mm_and_si128(bytes, bitMask), bitMask);
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(p_output + wordIdx * BITSTREAM_WORD_BITS + laneIdx * 16),
+                                 _mm_sub_epi8(zeroChar, isOne));
+            }
+        }
+    }
+
+    bool validateSse2(const char *p_data, size_t p_size)
+    {
+        const __m128i clearLowBit = _mm_set1_epi8(static_cast<char>(0xFE));
+        const __m128i zeroChar = _mm_set1_epi8('0');
+        __m128i mismatch = _mm_setzero_si128();
+        size_t charIdx = 0;
+        for (; charIdx + 16 <= p_size; charIdx += 16)
+        {
+            __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p_data + charIdx));
+            mismatch = _mm_or_si128(mismatch, _mm_xor_si128(_mm_and_si128(chars, clearLowBit), zeroChar));
+        }
+        bool isValid = _mm_movemask_epi8(_mm_cmpeq_epi8(mismatch, _mm_setzero_si128())) == 0xFFFF;
+        return isValid && validateScalar(p_data + charIdx, p_size - charIdx);
+    }
+
+    __attribute__((target("avx2"))) bool packAvx2(const char *p_data, size_t p_words, uint64_t *p_output)
+    {
+        const __m256i clearLowBit = _mm256_set1_epi8(static_cast<char>(0xFE));
+        const __m256i zeroChar = _mm256_set1_epi8('0');
+        for (size_t wordIdx = 0; wordIdx < p_words; ++wordIdx)
+        {
+            const char *chunk = p_data + wordIdx * BITSTREAM_WORD_BITS;
+            __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(chunk));
+            __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(chunk + 32));
+            __m256i isValid = _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_and_si256(low, clearLowBit), zeroChar),
+                                               _mm256_cmpeq_epi8(_mm256_and_si256(high, clearLowBit), zeroChar));
+            if (static_cast<uint32_t>(_mm256_movemask_epi8(isValid)) != 0xFFFFFFFFU)
+            {
+                return false;
+            }
+            uint64_t lowBits = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_slli_epi16(low, 7)));
+            uint64_t highBits = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_slli_epi16(high, 7)));
+            p_output[wordIdx] = lowBits | (highBits << 32);
+        }
+        return true;
+    }
+
+    __attribute__((target("avx2"))) void unpackAvx2(const uint64_t *p_words, size_t p_count, char *p_output)
+    {
+        // Byte shuffles work inside each 128-bit lane, the 4 bytes are broadcast to both lanes
+        const __m256i spread = _mm256_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1,
+                                                2, 2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3);
+        const __m256i bitMask = _mm256_set1_epi64x(static_cast<long long>(0x8040201008040201ULL));
+        const __m256i zeroChar = _mm256_set1_epi8('0');
+        for (size_t wordIdx = 0; wordIdx < p_count; ++wordIdx)
+        {
+            uint64_t word = p_words[wordIdx];
+            for (size_t laneIdx = 0; laneIdx < 2; ++laneIdx)
+            {
+                __m256i bytes = _mm256_set1_epi32(static_cast<int>((word >> (laneIdx * 32)) & 0xFFFFFFFFU));
+                bytes = _mm256_shuffle_epi8(bytes, spread);
+                __m256i isOne = _mm256_cmpeq_epi8(_mm256_and_si256(bytes, bitMask), bitMask);
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(p_output + wordIdx * BITSTREAM_WORD_BITS + laneIdx * 32),
+                                    _mm256_sub_epi8(zeroChar, isOne));
+            }
+        }
+    }
+
+    __attribute__((target("avx2"))) bool validateAvx2(const char *p_data, size_t p_size)
+    {
+        const __m256i clearLowBit = _mm256_set1_epi8(static_cast<char>(0xFE));
+        const __m256i zeroChar = _mm256_set1_epi8('0');
+        __m256i mismatch = _mm256_setzero_si256();
+        size_t charIdx = 0;
+        for (; charIdx + 32 <= p_size; charIdx += 32)
+        {
+            __m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p_data + charIdx));
+            mismatch = _mm256_or_si256(mismatch, _mm256_xor_si256(_mm256_and_si256(chars, clearLowBit), zeroChar));
+        }
+        bool isValid = _mm256_testz_si256(mismatch, mismatch) != 0;
+        return isValid && validateScalar(p_data + charIdx, p_size - charIdx);
+    }
+#endif
+
+    /// @brief The kernels of one instruction set level
+    struct KernelTable
+    {
+        PackKernel pack;
+        UnpackKernel unpack;
+        ValidateKernel validate;
+    };
+
+    /// @brief The kernels indexed by SimdLevel, falling back to the closest lower level
+    const KernelTable KERNEL_TABLES[] = {
+        {packScalar, unpackScalar, validateScalar},
+#if defined(__x86_64__)
+        {packSse2, unpackSse2, validateSse2},
+        {packAvx2, unpackAvx2, validateAvx2},
+#else
+        {packScalar, unpackScalar, validateScalar},
+        {packScalar, unpackScalar, validateScalar},
+#endif
+    };
+
+    const KernelTable &getKernelTable()
+    {
+        return KERNEL_TABLES[static_cast<int>(getSimdLevel())];
+    }
+
+    inline size_t toWordCount(const size_t p_bits)
+    {
+        return (p_bits + BITSTREAM_WORD_BITS - 1) / BITSTREAM_WORD_BITS;
+    }
+}
+
+BitStream::ConstIterator::ConstIterator(const uint64_t *p_words, const size_t p_position)
+    : m_words(p_words), m_position(p_position)
+{
+}
+
+bool BitStream::ConstIterator::operator*() const
+{
+    return (m_words[m_position / BITSTREAM_WORD_BITS] >> (m_position % BITSTREAM_WORD_BITS)) & 1;
+}
+
+BitStream::ConstIterator &BitStream::ConstIterator::operator++()
+{
+    ++m_position;
+    return *this;
+}
+
+BitStream::ConstIterator BitStream::ConstIterator::operator++(int)
+{
+    ConstIterator previous = *this;
+    ++m_position;
+    return previous;
+}
+
+bool BitStream::ConstIterator::operator==(const ConstIterator &p_other) const
+{
+    return m_position == p_other.m_position;
+}
+
+bool BitStream::ConstIterator::operator!=(const ConstIterator &p_other) const
+{
+    return m_position != p_other.m_position;
+}
+
+BitStream::BitStream() : m_size(0)
+{
+}
+
+BitStream::BitStream(const size_t p_size) : m_words(toWordCount(p_size), 0), m_size(p_size)
+{
+}
+
+size_t BitStream::size() const
+{
+    return m_size;
+}
+
+bool BitStream::empty() const
+{
+    return m_size == 0;
+}
+
+void BitStream::clear()
+{
+    m_words.clear();
+    m_size = 0;
+}
+
+void BitStream::resize(const size_t p_size)
+{
+    m_words.resize(toWordCount(p_size), 0);
+    m_size = p_size;
+    clearTail();
+}
+
+void BitStream::reserve(const size_t p_size)
+{
+    m_words.reserve(toWordCount(p_size));
+}
+
+void BitStream::clearTail()
+{
+    size_t usedBits = m_size % BITSTREAM_WORD_BITS;
+    if (usedBits != 0)
+    {
+        m_words.back() &= (static_cast<uint64_t>(1) << usedBits) - 1;
+    }
+}
+
+void BitStream::pushBack(const bool p_value)
+{
+    if (m_size % BITSTREAM_WORD_BITS == 0)
+    {
+        m_words.push_back(0);
+    }
+    ++m_size;
+    set(m_size - 1, p_value);
+}
+
+void BitStream::append(const BitStream &p_bits)
+{
+    size_t offset = m_size;
+    resize(m_size + p_bits.m_size);
+    size_t shift = offset % BITSTREAM_WORD_BITS;
+    uint64_t *words = m_words.data() + offset / BITSTREAM_WORD_BITS;
+    for (size_t wordIdx = 0; wordIdx < p_bits.m_words.size(); ++wordIdx)
+    {
+        // Every source word lands across two destination words unless the offset is word aligned
+        words[wordIdx] |= p_bits.m_words[wordIdx] << shift;
+        if (shift != 0 && offset / BITSTREAM_WORD_BITS + wordIdx + 1 < m_words.size())
+        {
+            words[wordIdx + 1] |= p_bits.m_words[wordIdx] >> (BITSTREAM_WORD_BITS - shift);
+        }
+    }
+}
+
+unsigned int BitStream::getBits(const size_t p_position, const unsigned int p_count) const
+{
+    // Gather the bits into one word, first bit in the lowest position
+    size_t wordIdx = p_position / BITSTREAM_WORD_BITS;
+    size_t offset = p_position % BITSTREAM_WORD_BITS;
+    uint64_t bits = m_words[wordIdx] >> offset;
+    if (offset + p_count > BITSTREAM_WORD_BITS)
+    {
+        bits |= m_words[wordIdx + 1] << (BITSTREAM_WORD_BITS - offset);
+    }
+    unsigned int value = 0;
+    for (unsigned int bitIdx = 0; bitIdx < p_count; ++bitIdx)
+    {
+        value = (value << 1) | static_cast<unsigned int>((bits >> bitIdx) & 1);
+    }
+    return value;
+}
+
+void BitStream::setBits(const size_t p_position, const unsigned int p_value, const unsigned int p_count)
+{
+    for (unsigned int bitIdx = 0; bitIdx < p_count; ++bitIdx)
+    {
+        set(p_position + bitIdx, (p_value >> (p_count - 1 - bitIdx)) & 1);
+    }
+}
+
+const uint64_t *BitStream::data() const
+{
+    return m_words.data();
+}
+
+uint64_t *BitStream::data()
+{
+    return m_words.data();
+}
+
+size_t BitStream::getWordCount() const
+{
+    return m_words.size();
+}
+
+bool BitStream::assignAscii(const char *p_data, const size_t p_size)
+{
+    resize(p_size);
+    size_t fullWords = p_size / BITSTREAM_WORD_BITS;
+    size_t tailBits = p_size % BITSTREAM_WORD_BITS;
+    bool isValid = getKernelTable().pack(p_data, fullWords, m_words.data());
+    if (isValid && tailBits != 0)
+    {
+        const char *tail = p_data + fullWords * BITSTREAM_WORD_BITS;
+        isValid = validateScalar(tail, tailBits);
+        uint64_t word = 0;
+        for (size_t bitIdx = 0; bitIdx < tailBits; ++bitIdx)
+        {
+            word |= static_cast<uint64_t>(tail[bitIdx] & 1) << bitIdx;
+        }
+        m_words[fullWords] = word;
+    }
+    if (!isValid)
+    {
+        clear();
+    }
+    return isValid;
+}
+
+bool BitStream::assignAscii(const std::string &p_binaryData)
+{
+    return assignAscii(p_binaryData.data(), p_binaryData.size());
+}
+
+void BitStream::toAscii(char *p_output) const
+{
+    size_t fullWords = m_size / BITSTREAM_WORD_BITS;
+    getKernelTable().unpack(m_words.data(), fullWords, p_output);
+    for (size_t bitIdx = fullWords * BITSTREAM_WORD_BITS; bitIdx < m_size; ++bitIdx)
+    {
+        p_output[bitIdx] = get(bitIdx) ? '1' : '0';
+    }
+}
+
+void BitStream::toAscii(std::string &p_output) const
+{
+    p_output.resize(m_size);
+    toAscii(p_output.data());
+}
+
+std::string BitStream::toAscii() const
+{
+    std::string binaryData;
+    toAscii(binaryData);
+    return binaryData;
+}
+
+BitStream::ConstIterator BitStream::begin() const
+{
+    return ConstIterator(m_words.data(), 0);
+}
+
+BitStream::ConstIterator BitStream::end() const
+{
+    return ConstIterator(m_words.data(), m_size);
+}
+
+bool BitStream::operator==(const BitStream &p_other) const
+{
+    // The bits past size() are 0, so whole words can be compared
+    return m_size == p_other.m_size && m_words == p_other.m_words;
+}
+
+bool BitStream::operator!=(const BitStream &p_other) const
+{
+    return !(*this == p_other);
+}
+
+bool isBinaryAscii(const char *p_data, const size_t p_size)
+{
+    return getKernelTable().validate(p_data, p_size);
+}
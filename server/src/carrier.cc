@@ -3,8 +3,10 @@
 Carrier::Carrier()
 {
     m_network = "";
+    m_modulationType = ModulationType::UNKNOWN;
     m_flagCarrier = false;
     m_frequency = 0;
+    m_fec = FecType::NONE;
 }
 
 bool Carrier::setNetwork(const std::string &p_network)
@@ -12,6 +14,7 @@ bool Carrier::setNetwork(const std::string &p_network)
     if (!m_flagCarrier)
     {
         m_network = p_network;
+        m_modulationType = toModulationType(p_network);
         m_flagCarrier = true;
         return true;
     }
@@ -26,6 +29,11 @@ std::string Carrier::getNetwork()
     return m_network;
 }
 
+ModulationType Carrier::getModulationType()
+{
+    return m_modulationType;
+}
+
 void Carrier::setFrequency(const size_t &p_freq)
 {
     m_frequency = p_freq;
@@ -36,11 +44,33 @@ size_t Carrier::getFrequency()
     return m_frequency;
 }
 
+bool Carrier::setFec(const std::string &p_fec)
+{
+    if (p_fec == FEC_NONE)
+    {
+        m_fec = FecType::NONE;
+        return true;
+    }
+    if (p_fec == FEC_CONVOLUTIONAL)
+    {
+        m_fec = FecType::CONVOLUTIONAL;
+        return true;
+    }
+    return false;
+}
+
+FecType Carrier::getFec()
+{
+    return m_fec;
+}
+
 void Carrier::releaseCarrier()
 {
     m_network = "";
+    m_modulationType = ModulationType::UNKNOWN;
     m_flagCarrier = false;
     m_frequency = 0;
+    m_fec = FecType::NONE;
 }
 
 bool Carrier::getCarrierStatus()
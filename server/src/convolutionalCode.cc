@@ -0,0 +1,341 @@
+#include "convolutionalCode.h"
+#include "simd.h"
+#include "softBits.h"
+#include <algorithm>
+#include <array>
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace
+{
+    using AcsKernel = void (*)(const int8_t *, size_t, uint64_t *);
+
+    /// @brief The butterflies of a step, state j and j + 32 both lead to states 2j and 2j + 1
+    constexpr size_t BUTTERFLY_COUNT = CONV_STATE_COUNT / 2;
+
+    /// @brief Metric of the states other than 0 at the start, far enough below that the first steps leave state 0
+    constexpr int16_t UNREACHED_METRIC = -4096;
+
+    /// @brief Ratio of a hard bit, every hard bit weighs the same
+    constexpr int8_t HARD_LLR = 1;
+
+    /**
+     * @brief Sign of a coded bit along the branch from state j to state 2j, +1 for bit 0 and -1 for bit 1
+     *
+     * The generators tap the current bit and the bit 6 steps back, so the branch from j + 32 and the branch
+     * to 2j + 1 both flip both coded bits: one table gives every branch of a butterfly.
+     */
+    template <unsigned int Polynomial>
+    constexpr std::array<int16_t, BUTTERFLY_COUNT> makeBranchSigns()
+    {
+        std::array<int16_t, BUTTERFLY_COUNT> signs{};
+        for (unsigned int state = 0; state < BUTTERFLY_COUNT; ++state)
+        {
+            unsigned int taps = (state << 1) & Polynomial;
+            unsigned int parity = 0;
+            for (; taps != 0; taps &= taps - 1)
+            {
+                parity ^= 1;
+            }
+            signs[state] = parity ? -1 : 1;
+        }
+        return signs;
+    }
+
+    alignas(32) constexpr std::array<int16_t, BUTTERFLY_COUNT> BRANCH_SIGNS_0 = makeBranchSigns<CONV_POLYNOMIALS[0]>();
+    alignas(32) constexpr std::array<int16_t, BUTTERFLY_COUNT> BRANCH_SIGNS_1 = makeBranchSigns<CONV_POLYNOMIALS[1]>();
+
+    static_assert((CONV_POLYNOMIALS[0] & CONV_POLYNOMIALS[1] & 1) != 0 &&
+                      (CONV_POLYNOMIALS[0] & CONV_POLYNOMIALS[1] & CONV_STATE_COUNT) != 0,
+                  "The butterflies need both generators to tap the current and the oldest bit");
+
+    /**
+     * @brief Spread the low 32 bits of a word to the even bits
+     *
+     * @param p_bits - bit i moves to bit 2i
+     * @return the spread bits
+     */
+    uint64_t spreadBits(uint64_t p_bits)
+    {
+        p_bits &= 0xFFFFFFFFull;
+        p_bits = (p_bits | (p_bits << 16)) & 0x0000FFFF0000FFFFull;
+        p_bits = (p_bits | (p_bits << 8)) & 0x00FF00FF00FF00FFull;
+        p_bits = (p_bits | (p_bits << 4)) & 0x0F0F0F0F0F0F0F0Full;
+        p_bits = (p_bits | (p_bits << 2)) & 0x3333333333333333ull;
+        p_bits = (p_bits | (p_bits << 1)) & 0x5555555555555555ull;
+        return p_bits;
+    }
+
+    int16_t addSaturated(const int32_t p_left, const int32_t p_right)
+    {
+        return static_cast<int16_t>(std::clamp(p_left + p_right, INT16_MIN, INT16_MAX));
+    }
+
+    void initializeMetrics(int16_t *p_metrics)
+    {
+        std::fill(p_metrics, p_metrics + CONV_STATE_COUNT, UNREACHED_METRIC);
+        p_metrics[0] = 0;
+    }
+
+    void acsScalar(const int8_t *p_llr, size_t p_steps, uint64_t *p_decisions)
+    {
+        int16_t metrics[2][CONV_STATE_COUNT];
+        initializeMetrics(metrics[0]);
+        for (size_t stepIdx = 0; stepIdx < p_steps; ++stepIdx)
+        {
+            const int16_t *current = metrics[stepIdx % 2];
+            int16_t *next = metrics[(stepIdx + 1) % 2];
+            uint64_t decisions = 0;
+            for (size_t butterflyIdx = 0; butterflyIdx < BUTTERFLY_COUNT; ++butterflyIdx)
+            {
+                int16_t branch = static_cast<int16_t>(BRANCH_SIGNS_0[butterflyIdx] * p_llr[2 * stepIdx] +
+                                                      BRANCH_SIGNS_1[butterflyIdx] * p_llr[2 * stepIdx + 1]);
+                int16_t low = current[butterflyIdx];
+                int16_t high = current[butterflyIdx + BUTTERFLY_COUNT];
+                int16_t even0 = addSaturated(low, branch);
+                int16_t even1 = addSaturated(high, -branch);
+                int16_t odd0 = addSaturated(low, -branch);
+                int16_t odd1 = addSaturated(high, branch);
+                next[2 * butterflyIdx] = std::max(even0, even1);
+                next[2 * butterflyIdx + 1] = std::max(odd0, odd1);
+                decisions |= static_cast<uint64_t>(even1 > even0) << (2 * butterflyIdx);
+                decisions |= static_cast<uint64_t>(odd1 > odd0) << (2 * butterflyIdx + 1);
+            }
+            p_decisions[stepIdx] = decisions;
+            if ((stepIdx + 1) % VITERBI_RENORMALIZE_INTERVAL == 0)
+            {
+                // Only the differences matter, keep them around 0 so the metrics never saturate
+                int16_t reference = next[0];
+                for (size_t stateIdx = 0; stateIdx < CONV_STATE_COUNT; ++stateIdx)
+                {
+                    next[stateIdx] = addSaturated(next[stateIdx], -reference);
+                }
+            }
+        }
+    }
+
+#if defined(__x86_64__)
+    void acsSse2(const int8_t *p_llr, size_t p_steps, uint64_t *p_decisions)
+    {
+        constexpr size_t lanes = 8;
+        constexpr size_t vectors = BUTTERFLY_COUNT / lanes;
+        __m128i metrics[2][2 * vectors];
+        alignas(16) int16_t initial[CONV_STATE_COUNT];
+        initializeMetrics(initial);
+        for (size_t vectorIdx = 0; vectorIdx < 2 * vectors; ++vectorIdx)
+        {
+            metrics[0][vectorIdx] = _mm_load_si128(reinterpret_cast<const __m128i *>(initial + vectorIdx * lanes));
+        }
+        __m128i signs0[vectors];
+        __m128i signs1[vectors];
+        for (size_t vectorIdx = 0; vectorIdx < vectors; ++vectorIdx)
+        {
+            signs0[vectorIdx] = _mm_load_si128(reinterpret_cast<const __m128i *>(BRANCH_SIGNS_0.data() + vectorIdx * lanes));
+            signs1[vectorIdx] = _mm_load_si128(reinterpret_cast<const __m128i *>(BRANCH_SIGNS_1.data() + vectorIdx * lanes));
+        }
+        for (size_t stepIdx = 0; stepIdx < p_steps; ++stepIdx)
+        {
+            const __m128i *current = metrics[stepIdx % 2];
+            __m128i *next = metrics[(stepIdx + 1) % 2];
+            const __m128i llr0 = _mm_set1_epi16(p_llr[2 * stepIdx]);
+            const __m128i llr1 = _mm_set1_epi16(p_llr[2 * stepIdx + 1]);
+            uint64_t decisions = 0;
+            for (size_t vectorIdx = 0; vectorIdx < vectors; ++vectorIdx)
+            {
+                __m128i branch = _mm_add_epi16(_mm_mullo_epi16(signs0[vectorIdx], llr0),
+                                               _mm_mullo_epi16(signs1[vectorIdx], llr1));
+                __m128i low = current[vectorIdx];
+                __m128i high = current[vectorIdx + vectors];
+                __m128i even0 = _mm_adds_epi16(low, branch);
+                __m128i even1 = _mm_subs_epi16(high, branch);
+                __m128i odd0 = _mm_subs_epi16(low, branch);
+                __m128i odd1 = _mm_adds_epi16(high, branch);
+                __m128i even = _mm_max_epi16(even0, even1);
+                __m128i odd = _mm_max_epi16(odd0, odd1);
+                __m128i evenDecision = _mm_cmpgt_epi16(even1, even0);
+                __m128i oddDecision = _mm_cmpgt_epi16(odd1, odd0);
+                // Interleaving the butterflies puts the states back in order: 2j, 2j + 1, ...
+                next[2 * vectorIdx] = _mm_unpacklo_epi16(even, odd);
+                next[2 * vectorIdx + 1] = _mm_unpackhi_epi16(even, odd);
+                __m128i decisionBytes = _mm_packs_epi16(_mm_unpacklo_epi16(evenDecision, oddDecision),
+                                                        _mm_unpackhi_epi16(evenDecision, oddDecision));
+                decisions |= static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(decisionBytes)))
+                             << (2 * lanes * vectorIdx);
+            }
+            p_decisions[stepIdx] = decisions;
+            if ((stepIdx + 1) % VITERBI_RENORMALIZE_INTERVAL == 0)
+            {
+                __m128i reference = _mm_set1_epi16(static_cast<int16_t>(_mm_extract_epi16(next[0], 0)));
+                for (size_t vectorIdx = 0; vectorIdx < 2 * vectors; ++vectorIdx)
+                {
+                    next[vectorIdx] = _mm_subs_epi16(next[vectorIdx], reference);
+                }
+            }
+        }
+    }
+
+    __attribute__((target("avx2"))) void acsAvx2(const int8_t *p_llr, size_t p_steps, uint64_t *p_decisions)
+    {
+        constexpr size_t lanes = 16;
+        constexpr size_t vectors = BUTTERFLY_COUNT / lanes;
+        __m256i metrics[2][2 * vectors];
+        alignas(32) int16_t initial[CONV_STATE_COUNT];
+        initializeMetrics(initial);
+        for (size_t vectorIdx = 0; vectorIdx < 2 * vectors; ++vectorIdx)
+        {
+            metrics[0][vectorIdx] = _mm256_load_si256(reinterpret_cast<const __m256i *>(initial + vectorIdx * lanes));
+        }
+        __m256i signs0[vectors];
+        __m256i signs1[vectors];
+        for (size_t vectorIdx = 0; vectorIdx < vectors; ++vectorIdx)
+        {
+            signs0[vectorIdx] = _mm256_load_si256(reinterpret_cast<const __m256i *>(BRANCH_SIGNS_0.data() + vectorIdx * lanes));
+            signs1[vectorIdx] = _mm256_load_si256(reinterpret_cast<const __m256i *>(BRANCH_SIGNS_1.data() + vectorIdx * lanes));
+        }
+        for (size_t stepIdx = 0; stepIdx < p_steps; ++stepIdx)
+        {
+            const __m256i *current = metrics[stepIdx % 2];
+            __m256i *next = metrics[(stepIdx + 1) % 2];
+            const __m256i llr0 = _mm256_set1_epi16(p_llr[2 * stepIdx]);
+            const __m256i llr1 = _mm256_set1_epi16(p_llr[2 * stepIdx + 1]);
+            uint64_t decisions = 0;
+            for (size_t vectorIdx = 0; vectorIdx < vectors; ++vectorIdx)
+            {
+                __m256i branch = _mm256_add_epi16(_mm256_mullo_epi16(signs0[vectorIdx], llr0),
+                                                  _mm256_mullo_epi16(signs1[vectorIdx], llr1));
+                __m256i low = current[vectorIdx];
+                __m256i high = current[vectorIdx + vectors];
+                __m256i even0 = _mm256_adds_epi16(low, branch);
+                __m256i even1 = _mm256_subs_epi16(high, branch);
+                __m256i odd0 = _mm256_subs_epi16(low, branch);
+                __m256i odd1 = _mm256_adds_epi16(high, branch);
+                __m256i even = _mm256_max_epi16(even0, even1);
+                __m256i odd = _mm256_max_epi16(odd0, odd1);
+                __m256i evenDecision = _mm256_cmpgt_epi16(even1, even0);
+                __m256i oddDecision = _mm256_cmpgt_epi16(odd1, odd0);
+                // The unpacks interleave within 128-bit halves, the low halves hold states 0 to 15 of the vector
+                __m256i interleavedLow = _mm256_unpacklo_epi16(even, odd);
+                __m256i interleavedHigh = _mm256_unpackhi_epi16(even, odd);
+                next[2 * vectorIdx] = _mm256_permute2x128_si256(interleavedLow, interleavedHigh, 0x20);
+                next[2 * vectorIdx + 1] = _mm256_permute2x128_si256(interleavedLow, interleavedHigh, 0x31);
+                // The pack works within halves too, which leaves the decision bytes in state order
+                __m256i decisionBytes = _mm256_packs_epi16(_mm256_unpacklo_epi16(evenDecision, oddDecision),
+                                                           _mm256_unpackhi_epi16(evenDecision, oddDecision));
+                decisions |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(decisionBytes)))
+                             << (2 * lanes * vectorIdx);
+            }
+            p_decisions[stepIdx] = decisions;
+            if ((stepIdx + 1) % VITERBI_RENORMALIZE_INTERVAL == 0)
+            {
+                __m256i reference = _mm256_set1_epi16(static_cast<int16_t>(_mm256_extract_epi16(next[0], 0)));
+                for (size_t vectorIdx = 0; vectorIdx < 2 * vectors; ++vectorIdx)
+                {
+                    next[vectorIdx] = _mm256_subs_epi16(next[vectorIdx], reference);
+                }
+            }
+        }
+    }
+#endif
+
+    /// @brief The kernels indexed by SimdLevel
+    const AcsKernel ACS_KERNELS[] = {
+        acsScalar,
+#if defined(__x86_64__)
+        acsSse2,
+        acsAvx2,
+#else
+        acsScalar,
+        acsScalar,
+#endif
+    };
+}
+
+void convolutionalEncode(const BitStream &p_input, BitStream &p_output)
+{
+    size_t stepCount = p_input.size() + CONV_TAIL_BITS;
+    p_output.resize(CONV_CODED_BITS * stepCount);
+    const uint64_t *input = p_input.data();
+    size_t inputWords = p_input.getWordCount();
+    uint64_t *output = p_output.data();
+    size_t outputWords = p_output.getWordCount();
+    uint64_t previous = 0;
+    // The bits past the payload are 0, which flushes the tail, and a coded bit past the tail only taps them
+    for (size_t wordIdx = 0; 2 * wordIdx < outputWords; ++wordIdx)
+    {
+        uint64_t current = wordIdx < inputWords ? input[wordIdx] : 0;
+        uint64_t parity[CONV_CODED_BITS] = {0, 0};
+        for (unsigned int delay = 0; delay < CONV_CONSTRAINT_LENGTH; ++delay)
+        {
+            // Bit i of the delayed word is the payload bit i - delay
+            uint64_t delayed = delay == 0 ? current : (current << delay) | (previous >> (BITSTREAM_WORD_BITS - delay));
+            for (size_t codedIdx = 0; codedIdx < CONV_CODED_BITS; ++codedIdx)
+            {
+                if ((CONV_POLYNOMIALS[codedIdx] >> delay) & 1)
+                {
+                    parity[codedIdx] ^= delayed;
+                }
+            }
+        }
+        previous = current;
+        output[2 * wordIdx] = spreadBits(parity[0]) | (spreadBits(parity[1]) << 1);
+        if (2 * wordIdx + 1 < outputWords)
+        {
+            output[2 * wordIdx + 1] = spreadBits(parity[0] >> 32) | (spreadBits(parity[1] >> 32) << 1);
+        }
+    }
+}
+
+size_t ViterbiDecoder::decode(const int8_t *p_llr, const size_t p_size, const size_t p_bitCount, BitStream &p_output)
+{
+    size_t stepCount = p_bitCount + CONV_TAIL_BITS;
+    size_t codedSize = getConvolutionalCodedSize(p_bitCount);
+    const int8_t *llr = p_llr;
+    if (p_size < codedSize)
+    {
+        // A missing coded bit is an erasure, it favours no branch
+        m_llrs.resize(codedSize);
+        std::copy(p_llr, p_llr + p_size, m_llrs.begin());
+        std::fill(m_llrs.begin() + p_size, m_llrs.end(), 0);
+        llr = m_llrs.data();
+    }
+    m_decisions.resize(stepCount);
+    ACS_KERNELS[static_cast<int>(getSimdLevel())](llr, stepCount, m_decisions.data());
+
+    // The tail brings the encoder back to state 0, the decisions lead from there to the start
+    p_output.resize(p_bitCount);
+    unsigned int state = 0;
+    for (size_t stepIdx = stepCount; stepIdx-- > 0;)
+    {
+        if (stepIdx < p_bitCount)
+        {
+            p_output.set(stepIdx, state & 1);
+        }
+        unsigned int decision = (m_decisions[stepIdx] >> state) & 1;
+        state = (state >> 1) | (decision << (CONV_CONSTRAINT_LENGTH - 2));
+    }
+    return p_bitCount;
+}
+
+size_t ViterbiDecoder::decode(const float *p_llr, const size_t p_size, const size_t p_bitCount, BitStream &p_output)
+{
+    size_t codedSize = getConvolutionalCodedSize(p_bitCount);
+    size_t size = std::min(p_size, codedSize);
+    m_llrs.resize(codedSize);
+    quantizeLlrs(p_llr, size, CONV_LLR_SCALE, m_llrs.data());
+    std::fill(m_llrs.begin() + size, m_llrs.end(), 0);
+    return decode(m_llrs.data(), codedSize, p_bitCount, p_output);
+}
+
+size_t ViterbiDecoder::decode(const BitStream &p_coded, const size_t p_bitCount, BitStream &p_output)
+{
+    size_t codedSize = getConvolutionalCodedSize(p_bitCount);
+    size_t size = std::min(p_coded.size(), codedSize);
+    m_llrs.resize(codedSize);
+    for (size_t bitIdx = 0; bitIdx < size; ++bitIdx)
+    {
+        m_llrs[bitIdx] = p_coded.get(bitIdx) ? -HARD_LLR : HARD_LLR;
+    }
+    std::fill(m_llrs.begin() + size, m_llrs.end(), 0);
+    return decode(m_llrs.data(), codedSize, p_bitCount, p_output);
+}
@@ -0,0 +1,525 @@
+#include "correlator.h"
+#include "oscillator.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace
+{
+    using QuadratureKernel = void (*)(const double *, const double *, const double *, size_t, double &, double &);
+    using AbsoluteKernel = double (*)(const double *, size_t);
+    using QuadratureFloatKernel = void (*)(const float *, const float *, const float *, size_t, double &, double &);
+    using AbsoluteFloatKernel = double (*)(const float *, size_t);
+    using QuadratureQ15Kernel = void (*)(const Q15 *, const Q15 *, const Q15 *, size_t, double &, double &);
+    using AbsoluteQ15Kernel = double (*)(const Q15 *, size_t);
+
+    /// @brief Amplitude of the product of two Q15 samples
+    constexpr double Q15_PRODUCT_SCALE = 1.0 / (SAMPLE_Q15_SCALE * SAMPLE_Q15_SCALE);
+
+    void correlateQuadratureScalar(const double *p_signal, const double *p_inPhase, const double *p_quadrature,
+                                   size_t p_count, double &p_inPhaseSum, double &p_quadratureSum)
+    {
+        double inPhaseSum = 0.0;
+        double quadratureSum = 0.0;
+        for (size_t sampleIdx = 0; sampleIdx < p_count; ++sampleIdx)
+        {
+            inPhaseSum += p_signal[sampleIdx] * p_inPhase[sampleIdx];
+            quadratureSum += p_signal[sampleIdx] * p_quadrature[sampleIdx];
+        }
+        p_inPhaseSum = inPhaseSum;
+        p_quadratureSum = quadratureSum;
+    }
+
+    double sumAbsoluteScalar(const double *p_signal, size_t p_count)
+    {
+        double sum = 0.0;
+        for (size_t sampleIdx = 0; sampleIdx < p_count; ++sampleIdx)
+        {
+            sum += std::fabs(p_signal[sampleIdx]);
+        }
+        return sum;
+    }
+
+    void correlateQuadratureFloatScalar(const float *p_signal, const float *p_inPhase, const float *p_quadrature,
+                                        size_t p_count, double &p_inPhaseSum, double &p_quadratureSum)
+    {
+        float inPhaseSum = 0.0f;
+        float quadratureSum = 0.0f;
+        for (size_t sampleIdx = 0; sampleIdx < p_count; ++sampleIdx)
+        {
+            inPhaseSum += p_signal[sampleIdx] * p_inPhase[sampleIdx];
+            quadratureSum += p_signal[sampleIdx] * p_quadrature[sampleIdx];
+        }
+        p_inPhaseSum = inPhaseSum;
+        p_quadratureSum = quadratureSum;
+    }
+
+    double sumAbsoluteFloatScalar(const float *p_signal, size_t p_count)
+    {
+        float sum = 0.0f;
+        for (size_t sampleIdx = 0; sampleIdx < p_count; ++sampleIdx)
+        {
+            sum += std::fabs(p_signal[sampleIdx]);
+        }
+        return sum;
+    }
+
+    void correlateQuadratureQ15Scalar(const Q15 *p_signal, const Q15 *p_inPhase, const Q15 *p_quadrature,
+                                      size_t p_count, double &p_inPhaseSum, double &p_quadratureSum)
+    {
+        // The products are exact in 32 bits, their sums in 64 bits
+        int64_t inPhaseSum = 0;
+        int64_t quadratureSum = 0;
+        for (size_t sampleIdx = 0; sampleIdx < p_count; ++sampleIdx)
+        {
+            inPhaseSum += static_cast<int32_t>(p_signal[sampleIdx]) * p_inPhase[sampleIdx];
+            quadratureSum += static_cast<int32_t>(p_signal[sampleIdx]) * p_quadrature[sampleIdx];
+        }
+        p_inPhaseSum = static_cast<double>(inPhaseSum) * Q15_PRODUCT_SCALE;
+        p_quadratureSum = static_cast<double>(quadratureSum) * Q15_PRODUCT_SCALE;
+    }
+
+    double sumAbsoluteQ15Scalar(const Q15 *p_signal, size_t p_count)
+    {
+        int64_t sum = 0;
+        for (size_t sampleIdx = 0; sampleIdx < p_count; ++sampleIdx)
+        {
+            // INT16_MIN counts as INT16_MAX as in the saturating vector kernels
+            sum += std::min(std::abs(static_cast<int32_t>(p_signal[sampleIdx])), static_cast<int32_t>(INT16_MAX));
+        }
+        return static_cast<double>(sum) / SAMPLE_Q15_SCALE;
+    }
+
+#if defined(__x86_64__)
+    inline double horizontalSum(__m128d p_value)
+    {
+        return _mm_cvtsd_f64(_mm_add_sd(p_value, _mm_unpackhi_pd(p_value, p_value)));
+    }
+
+    void correlateQuadratureSse2(const double *p_signal, const double *p_inPhase, const double *p_quadrature,
+                                 size_t p_count, double &p_inPhaseSum, double &p_quadratureSum)
+    {
+        __m128d inPhaseAcc0 = _mm_setzero_pd();
+        __m128d inPhaseAcc1 = _mm_setzero_pd();
+        __m128d quadratureAcc0 = _mm_setzero_pd();
+        __m128d quadratureAcc1 = _mm_setzero_pd();
+        size_t sampleIdx = 0;
+        for (; sampleIdx + 4 <= p_count; sampleIdx += 4)
+        {
+            __m128d signal0 = _mm_loadu_pd(p_signal + sampleIdx);
+            __m128d signal1 = _mm_loadu_pd(p_signal + sampleIdx + 2);
+            inPhaseAcc0 = _mm_add_pd(inPhaseAcc0, _mm_mul_pd(signal0, _mm_loadu_pd(p_inPhase + sampleIdx)));
+            inPhaseAcc1 = _mm_add_pd(inPhaseAcc1, _mm_mul_pd(signal1, _mm_loadu_pd(p_inPhase + sampleIdx + 2)));
+            quadratureAcc0 = _mm_add_pd(quadratureAcc0, _mm_mul_pd(signal0, _mm_loadu_pd(p_quadrature + sampleIdx)));
+            quadratureAcc1 = _mm_add_pd(quadratureAcc1, _mm_mul_pd(signal1, _mm_loadu_pd(p_quadrature + sampleIdx + 2)));
+        }
+        double inPhaseSum = horizontalSum(_mm_add_pd(inPhaseAcc0, inPhaseAcc1));
+        double quadratureSum = horizontalSum(_mm_add_pd(quadratureAcc0, quadratureAcc1));
+        for (; sampleIdx < p_count; ++sampleIdx)
+        {
+            inPhaseSum += p_signal[sampleIdx] * p_inPhase[sampleIdx];
+            quadratureSum += p_signal[sampleIdx] * p_quadrature[sampleIdx];
+        }
+        p_inPhaseSum = inPhaseSum;
+        p_quadratureSum = quadratureSum;
+    }
+
+    double sumAbsoluteSse2(const double *p_signal, size_t p_count)
+    {
+        // Clearing the sign bit gives the absolute value
+        const __m128d absMask = _mm_castsi128_pd(_mm_set1_epi64x(0x7FFFFFFFFFFFFFFFLL));
+        __m128d sumAcc0 = _mm_setzero_pd();
+        __m128d sumAcc1 = _mm_setzero_pd();
+        size_t sampleIdx = 0;
+        for (; sampleIdx + 4 <= p_count; sampleIdx += 4)
+        {
+            sumAcc0 = _mm_add_pd(sumAcc0, _mm_and_pd(absMask, _mm_loadu_pd(p_signal + sampleIdx)));
+            sumAcc1 = _mm_add_pd(sumAcc1, _mm_and_pd(absMask, _mm_loadu_pd(p_signal + sampleIdx + 2)));
+        }
+        double sum = horizontalSum(_mm_add_pd(sumAcc0, sumAcc1));
+        for (; sampleIdx < p_count; ++sampleIdx)
+        {
+            sum += std::fabs(p_signal[sampleIdx]);
+        }
+        return sum;
+    }
+
+    inline float horizontalSum(__m128 p_value)
+    {
+        __m128 pairs = _mm_add_ps(p_value, _mm_movehl_ps(p_value, p_value));
+        return _mm_cvtss_f32(_mm_add_ss(pairs, _mm_shuffle_ps(pairs, pairs, 1)));
+    }
+
+    void correlateQuadratureFloatSse2(const float *p_signal, const float *p_inPhase, const float *p_quadrature,
+                                      size_t p_count, double &p_inPhaseSum, double &p_quadratureSum)
+    {
+        __m128 inPhaseAcc0 = _mm_setzero_ps();
+        __m128 inPhaseAcc1 = _mm_setzero_ps();
+        __m128 quadratureAcc0 = _mm_setzero_ps();
+        __m128 quadratureAcc1 = _mm_setzero_ps();
+        size_t sampleIdx = 0;
+        for (; sampleIdx + 8 <= p_count; sampleIdx += 8)
+        {
+            __m128 signal0 = _mm_loadu_ps(p_signal + sampleIdx);
+            __m128 signal1 = _mm_loadu_ps(p_signal + sampleIdx + 4);
+            inPhaseAcc0 = _mm_add_ps(inPhaseAcc0, _mm_mul_ps(signal0, _mm_loadu_ps(p_inPhase + sampleIdx)));
+            inPhaseAcc1 = _mm_add_ps(inPhaseAcc1, _mm_mul_ps(signal1, _mm_loadu_ps(p_inPhase + sampleIdx + 4)));
+            quadratureAcc0 = _mm_add_ps(quadratureAcc0, _mm_mul_ps(signal0, _mm_loadu_ps(p_quadrature + sampleIdx)));
+            quadratureAcc1 = _mm_add_ps(quadratureAcc1, _mm_mul_ps(signal1, _mm_loadu_ps(p_quadrature + sampleIdx + 4)));
+        }
+        float inPhaseSum = horizontalSum(_mm_add_ps(inPhaseAcc0, inPhaseAcc1));
+        float quadratureSum = horizontalSum(_mm_add_ps(quadratureAcc0, quadratureAcc1));
+        for (; sampleIdx < p_count; ++sampleIdx)
+        {
+            inPhaseSum += p_signal[sampleIdx] * p_inPhase[sampleIdx];
+            quadratureSum += p_signal[sampleIdx] * p_quadrature[sampleIdx];
+        }
+        p_inPhaseSum = inPhaseSum;
+        p_quadratureSum = quadratureSum;
+    }
+
+    double sumAbsoluteFloatSse2(const float *p_signal, size_t p_count)
+    {
+        const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+        __m128 sumAcc0 = _mm_setzero_ps();
+        __m128 sumAcc1 = _mm_setzero_ps();
+        size_t sampleIdx = 0;
+        for (; sampleIdx + 8 <= p_count; sampleIdx += 8)
+        {
+            sumAcc0 = _mm_add_ps(sumAcc0, _mm_and_ps(absMask, _mm_loadu_ps(p_signal + sampleIdx)));
+            sumAcc1 = _mm_add_ps(sumAcc1, _mm_and_ps(absMask, _mm_loadu_ps(p_signal + sampleIdx + 4)));
+        }
+        float sum = horizontalSum(_mm_add_ps(sumAcc0, sumAcc1));
+        for (; sampleIdx < p_count; ++sampleIdx)
+        {
+            sum += std::fabs(p_signal[sampleIdx]);
+        }
+        return sum;
+    }
+
+    /**
+     * @brief Add 4 int32 values to 2 double accumulators, exact where an int32 accumulator would overflow
+     *
+     * @param p_values - 4 int32 values
+     * @param p_acc0 - accumulator of the lower 2 values
+     * @param p_acc1 - accumulator of the upper 2 values
+     */
+    inline void accumulateInt32(__m128i p_values, __m128d &p_acc0, __m128d &p_acc1)
+    {
+        p_acc0 = _mm_add_pd(p_acc0, _mm_cvtepi32_pd(p_values));
+        p_acc1 = _mm_add_pd(p_acc1, _mm_cvtepi32_pd(_mm_unpackhi_epi64(p_values, p_values)));
+    }
+
+    void correlateQuadratureQ15Sse2(const Q15 *p_signal, const Q15 *p_inPhase, const Q15 *p_quadrature,
+                                    size_t p_count, double &p_inPhaseSum, double &p_quadratureSum)
+    {
+        // pmaddwd multiplies 8 pairs of Q15 and adds neighbouring products into 4 exact int32
+        __m128d inPhaseAcc0 = _mm_setzero_pd();
+        __m128d inPhaseAcc1 = _mm_setzero_pd();
+        __m128d quadratureAcc0 = _mm_setzero_pd();
+        __m128d quadratureAcc1 = _mm_setzero_pd();
+        size_t sampleIdx = 0;
+        for (; sampleIdx + 8 <= p_count; sampleIdx += 8)
+        {
+            __m128i signal = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p_signal + sampleIdx));
+            __m128i inPhase = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p_inPhase + sampleIdx));
+            __m128i quadrature = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p_quadrature + sampleIdx));
+            accumulateInt32(_mm_madd_epi16(signal, inPhase), inPhaseAcc0, inPhaseAcc1);
+            accumulateInt32(_mm_madd_epi16(signal, quadrature), quadratureAcc0, quadratureAcc1);
+        }
+        double inPhaseSum = horizontalSum(_mm_add_pd(inPhaseAcc0, inPhaseAcc1));
+        double quadratureSum = horizontalSum(_mm_add_pd(quadratureAcc0, quadratureAcc1));
+        for (; sampleIdx < p_count; ++sampleIdx)
+        {
+            inPhaseSum += static_cast<int32_t>(p_signal[sampleIdx]) * p_inPhase[sampleIdx];
+            quadratureSum += static_cast<int32_t>(p_signal[sampleIdx]) * p_quadrature[sampleIdx];
+        }
+        p_inPhaseSum = inPhaseSum * Q15_PRODUCT_SCALE;
+        p_quadratureSum = quadratureSum * Q15_PRODUCT_SCALE;
+    }
+
+    double sumAbsoluteQ15Sse2(const Q15 *p_signal, size_t p_count)
+    {
+        // The saturating negation keeps |INT16_MIN| at INT16_MAX instead of wrapping to INT16_MIN
+        const __m128i ones = _mm_set1_epi16(1);
+        __m128d sumAcc0 = _mm_setzero_pd();
+        __m128d sumAcc1 = _mm_setzero_pd();
+        size_t sampleIdx = 0;
+        for (; sampleIdx + 8 <= p_count; sampleIdx += 8)
+        {
+            __m128i signal = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p_signal + sampleIdx));
+            __m128i absolute = _mm_max_epi16(signal, _mm_subs_epi16(_mm_setzero_si128(), signal));
+            accumulateInt32(_mm_madd_epi16(absolute, ones), sumAcc0, sumAcc1);
+        }
+        double sum = horizontalSum(_mm_add_pd(sumAcc0, sumAcc1));
+        for (; sampleIdx < p_count; ++sampleIdx)
+        {
+            sum += std::min(std::abs(static_cast<int32_t>(p_signal[sampleIdx])), static_cast<int32_t>(INT16_MAX));
+        }
+        return sum / SAMPLE_Q15_SCALE;
+    }
+
+    __attribute__((target("avx2,fma"))) inline double horizontalSum(__m256d p_value)
+    {
+        return horizontalSum(_mm_add_pd(_mm256_castpd256_pd128(p_value), _mm256_extractf128_pd(p_value, 1)));
+    }
+
+    __attribute__((target("avx2,fma"))) void correlateQuadratureAvx2(const double *p_signal, const double *p_inPhase,
+                                                                     const double *p_quadrature, size_t p_count,
+                                                                     double &p_inPhaseSum, double &p_quadratureSum)
+    {
+        __m256d inPhaseAcc0 = _mm256_setzero_pd();
+        __m256d inPhaseAcc1 = _mm256_setzero_pd();
+        __m256d quadratureAcc0 = _mm256_setzero_pd();
+        __m256d quadratureAcc1 = _mm256_setzero_pd();
+        size_t sampleIdx = 0;
+        for (; sampleIdx + 8 <= p_count; sampleIdx += 8)
+        {
+            __m256d signal0 = _mm256_loadu_pd(p_signal + sampleIdx);
+            __m256d signal1 = _mm256_loadu_pd(p_signal + sampleIdx + 4);
+            inPhaseAcc0 = _mm256_fmadd_pd(signal0, _mm256_loadu_pd(p_inPhase + sampleIdx), inPhaseAcc0);
+            inPhaseAcc1 = _mm256_fmadd_pd(signal1, _mm256_loadu_pd(p_inPhase + sampleIdx + 4), inPhaseAcc1);
+            quadratureAcc0 = _mm256_fmadd_pd(signal0, _mm256_loadu_pd(p_quadrature + sampleIdx), quadratureAcc0);
+            quadratureAcc1 = _mm256_fmadd_pd(signal1, _mm256_loadu_pd(p_quadrature + sampleIdx + 4), quadratureAcc1);
+        }
+        double inPhaseSum = horizontalSum(_mm256_add_pd(inPhaseAcc0, inPhaseAcc1));
+        double quadratureSum = horizontalSum(_mm256_add_pd(quadratureAcc0, quadratureAcc1));
+        for (; sampleIdx < p_count; ++sampleIdx)
+        {
+            inPhaseSum += p_signal[sampleIdx] * p_inPhase[sampleIdx];
+            quadratureSum += p_signal[sampleIdx] * p_quadrature[sampleIdx];
+        }
+        p_inPhaseSum = inPhaseSum;
+        p_quadratureSum = quadratureSum;
+    }
+
+    __attribute__((target("avx2,fma"))) double sumAbsoluteAvx2(const double *p_signal, size_t p_count)
+    {
+        const __m256d absMask = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7FFFFFFFFFFFFFFFLL));
+        __m256d sumAcc0 = _mm256_setzero_pd();
+        __m256d sumAcc1 = _mm256_setzero_pd();
+        size_t sampleIdx = 0;
+        for (; sampleIdx + 8 <= p_count; sampleIdx += 8)
+        {
+            sumAcc0 = _mm256_add_pd(sumAcc0, _mm256_and_pd(absMask, _mm256_loadu_pd(p_signal + sampleIdx)));
+            sumAcc1 = _mm256_add_pd(sumAcc1, _mm256_and_pd(absMask, _mm256_loadu_pd(p_signal + sampleIdx + 4)));
+        }
+        double sum = horizontalSum(_mm256_add_pd(sumAcc0, sumAcc1));
+        for (; sampleIdx < p_count; ++sampleIdx)
+        {
+            sum += std::fabs(p_signal[sampleIdx]);
+        }
+        return sum;
+    }
+
+    __attribute__((target("avx2,fma"))) inline float horizontalSum(__m256 p_value)
+    {
+        return horizontalSum(_mm_add_ps(_mm256_castps256_ps128(p_value), _mm256_extractf128_ps(p_value, 1)));
+    }
+
+    __attribute__((target("avx2,fma"))) void correlateQuadratureFloatAvx2(const float *p_signal, const float *p_inPhase,
+                                                                          const float *p_quadrature, size_t p_count,
+                                                                          double &p_inPhaseSum, double &p_quadratureSum)
+    {
+        __m256 inPhaseAcc0 = _mm256_setzero_ps();
+        __m256 inPhaseAcc1 = _mm256_setzero_ps();
+        __m256 quadratureAcc0 = _mm256_setzero_ps();
+        __m256 quadratureAcc1 = _mm256_setzero_ps();
+        size_t sampleIdx = 0;
+        for (; sampleIdx + 16 <= p_count; sampleIdx += 16)
+        {
+            __m256 signal0 = _mm256_loadu_ps(p_signal + sampleIdx);
+            __m256 signal1 = _mm256_loadu_ps(p_signal + sampleIdx + 8);
+            inPhaseAcc0 = _mm256_fmadd_ps(signal0, _mm256_loadu_ps(p_inPhase + sampleIdx), inPhaseAcc0);
+            inPhaseAcc1 = _mm256_fmadd_ps(signal1, _mm256_loadu_ps(p_inPhase + sampleIdx + 8), inPhaseAcc1);
+            quadratureAcc0 = _mm256_fmadd_ps(signal0, _mm256_loadu_ps(p_quadrature + sampleIdx), quadratureAcc0);
+            quadratureAcc1 = _mm256_fmadd_ps(signal1, _mm256_loadu_ps(p_quadrature + sampleIdx + 8), quadratureAcc1);
+        }
+        float inPhaseSum = horizontalSum(_mm256_add_ps(inPhaseAcc0, inPhaseAcc1));
+        float quadratureSum = horizontalSum(_mm256_add_ps(quadratureAcc0, quadratureAcc1));
+        for (; sampleIdx < p_count; ++sampleIdx)
+        {
+            inPhaseSum += p_signal[sampleIdx] * p_inPhase[sampleIdx];
+            quadratureSum += p_signal[sampleIdx] * p_quadrature[sampleIdx];
+        }
+        p_inPhaseSum = inPhaseSum;
+        p_quadratureSum = quadratureSum;
+    }
+
+    __attribute__((target("avx2,fma"))) double sumAbsoluteFloatAvx2(const float *p_signal, size_t p_count)
+    {
+        const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+        __m256 sumAcc0 = _mm256_setzero_ps();
+        __m256 sumAcc1 = _mm256_setzero_ps();
+        size_t sampleIdx = 0;
+        for (; sampleIdx + 16 <= p_count; sampleIdx += 16)
+        {
+            sumAcc0 = _mm256_add_ps(sumAcc0, _mm256_and_ps(absMask, _mm256_loadu_ps(p_signal + sampleIdx)));
+            sumAcc1 = _mm256_add_ps(sumAcc1, _mm256_and_ps(absMask, _mm256_loadu_ps(p_signal + sampleIdx + 8)));
+        }
+        float sum = horizontalSum(_mm256_add_ps(sumAcc0, sumAcc1));
+        for (; sampleIdx < p_count; ++sampleIdx)
+        {
+            sum += std::fabs(p_signal[sampleIdx]);
+        }
+        return sum;
+    }
+
+    __attribute__((target("avx2,fma"))) inline void accumulateInt32(__m256i p_values, __m256d &p_acc0, __m256d &p_acc1)
+    {
+        p_acc0 = _mm256_add_pd(p_acc0, _mm256_cvtepi32_pd(_mm256_castsi256_si128(p_values)));
+        p_acc1 = _mm256_add_pd(p_acc1, _mm256_cvtepi32_pd(_mm256_extracti128_si256(p_values, 1)));
+    }
+
+    __attribute__((target("avx2,fma"))) void correlateQuadratureQ15Avx2(const Q15 *p_signal, const Q15 *p_inPhase,
+                                                                        const Q15 *p_quadrature, size_t p_count,
+                                                                        double &p_inPhaseSum, double &p_quadratureSum)
+    {
+        __m256d inPhaseAcc0 = _mm256_setzero_pd();
+        __m256d inPhaseAcc1 = _mm256_setzero_pd();
+        __m256d quadratureAcc0 = _mm256_setzero_pd();
+        __m256d quadratureAcc1 = _mm256_setzero_pd();
+        size_t sampleIdx = 0;
+        for (; sampleIdx + 16 <= p_count; sampleIdx += 16)
+        {
+            __m256i signal = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p_signal + sampleIdx));
+            __m256i inPhase = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p_inPhase + sampleIdx));
+            __m256i quadrature = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p_quadrature + sampleIdx));
+            accumulateInt32(_mm256_madd_epi16(signal, inPhase), inPhaseAcc0, inPhaseAcc1);
+            accumulateInt32(_mm256_madd_epi16(signal, quadrature), quadratureAcc0, quadratureAcc1);
+        }
+        double inPhaseSum = horizontalSum(_mm256_add_pd(inPhaseAcc0, inPhaseAcc1));
+        double quadratureSum = horizontalSum(_mm256_add_pd(quadratureAcc0, quadratureAcc1));
+        for (; sampleIdx < p_count; ++sampleIdx)
+        {
+            inPhaseSum += static_cast<int32_t>(p_signal[sampleIdx]) * p_inPhase[sampleIdx];
+            quadratureSum += static_cast<int32_t>(p_signal[sampleIdx]) * p_quadrature[sampleIdx];
+        }
+        p_inPhaseSum = inPhaseSum * Q15_PRODUCT_SCALE;
+        p_quadratureSum = quadratureSum * Q15_PRODUCT_SCALE;
+    }
+
+    __attribute__((target("avx2,fma"))) double sumAbsoluteQ15Avx2(const Q15 *p_signal, size_t p_count)
+    {
+        const __m256i ones = _mm256_set1_epi16(1);
+        __m256d sumAcc0 = _mm256_setzero_pd();
+        __m256d sumAcc1 = _mm256_setzero_pd();
+        size_t sampleIdx = 0;
+        for (; sampleIdx + 16 <= p_count; sampleIdx += 16)
+        {
+            __m256i signal = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p_signal + sampleIdx));
+            __m256i absolute = _mm256_max_epi16(signal, _mm256_subs_epi16(_mm256_setzero_si256(), signal));
+            accumulateInt32(_mm256_madd_epi16(absolute, ones), sumAcc0, sumAcc1);
+        }
+        double sum = horizontalSum(_mm256_add_pd(sumAcc0, sumAcc1));
+        for (; sampleIdx < p_count; ++sampleIdx)
+        {
+            sum += std::min(std::abs(static_cast<int32_t>(p_signal[sampleIdx])), static_cast<int32_t>(INT16_MAX));
+        }
+        return sum / SAMPLE_Q15_SCALE;
+    }
+#endif
+
+    /// @brief The kernels of one instruction set level
+    struct KernelTable
+    {
+        QuadratureKernel quadrature;
+        AbsoluteKernel absolute;
+        QuadratureFloatKernel quadratureFloat;
+        AbsoluteFloatKernel absoluteFloat;
+        QuadratureQ15Kernel quadratureQ15;
+        AbsoluteQ15Kernel absoluteQ15;
+    };
+
+    /// @brief The scalar kernels of every sample format
+    constexpr KernelTable SCALAR_KERNELS = {correlateQuadratureScalar,      sumAbsoluteScalar,
+                                            correlateQuadratureFloatScalar, sumAbsoluteFloatScalar,
+                                            correlateQuadratureQ15Scalar,   sumAbsoluteQ15Scalar};
+
+    /// @brief The kernels indexed by SimdLevel, falling back to the closest lower level
+    const KernelTable KERNEL_TABLES[] = {
+        SCALAR_KERNELS,
+#if defined(__x86_64__)
+        {correlateQuadratureSse2, sumAbsoluteSse2, correlateQuadratureFloatSse2, sumAbsoluteFloatSse2,
+         correlateQuadratureQ15Sse2, sumAbsoluteQ15Sse2},
+        {correlateQuadratureAvx2, sumAbsoluteAvx2, correlateQuadratureFloatAvx2, sumAbsoluteFloatAvx2,
+         correlateQuadratureQ15Avx2, sumAbsoluteQ15Avx2},
+#else
+        SCALAR_KERNELS,
+        SCALAR_KERNELS,
+#endif
+    };
+
+    const KernelTable &getKernelTable()
+    {
+        return KERNEL_TABLES[static_cast<int>(getSimdLevel())];
+    }
+}
+
+ReferenceWaveform buildReferenceWaveform(const double p_frequency, const double p_sampleRate,
+                                         const double p_phase, const size_t p_samples)
+{
+    ReferenceWaveform reference;
+    reference.inPhase.resize(p_samples);
+    reference.quadrature.resize(p_samples);
+    Oscillator tone(p_frequency, p_sampleRate, p_phase);
+    for (size_t sampleIdx = 0; sampleIdx < p_samples; ++sampleIdx)
+    {
+        tone.nextQuadrature(reference.inPhase[sampleIdx], reference.quadrature[sampleIdx]);
+    }
+    reference.inPhaseFloat.resize(p_samples);
+    reference.quadratureFloat.resize(p_samples);
+    reference.inPhaseQ15.resize(p_samples);
+    reference.quadratureQ15.resize(p_samples);
+    toSamples(reference.inPhase.data(), p_samples, reference.inPhaseFloat.data());
+    toSamples(reference.quadrature.data(), p_samples, reference.quadratureFloat.data());
+    toSamples(reference.inPhase.data(), p_samples, reference.inPhaseQ15.data());
+    toSamples(reference.quadrature.data(), p_samples, reference.quadratureQ15.data());
+    return reference;
+}
+
+void correlateQuadrature(const double *p_signal, const double *p_inPhase, const double *p_quadrature,
+                         const size_t p_count, double &p_inPhaseSum, double &p_quadratureSum)
+{
+    getKernelTable().quadrature(p_signal, p_inPhase, p_quadrature, p_count, p_inPhaseSum, p_quadratureSum);
+}
+
+void correlateQuadrature(const float *p_signal, const float *p_inPhase, const float *p_quadrature,
+                         const size_t p_count, double &p_inPhaseSum, double &p_quadratureSum)
+{
+    getKernelTable().quadratureFloat(p_signal, p_inPhase, p_quadrature, p_count, p_inPhaseSum, p_quadratureSum);
+}
+
+void correlateQuadrature(const Q15 *p_signal, const Q15 *p_inPhase, const Q15 *p_quadrature,
+                         const size_t p_count, double &p_inPhaseSum, double &p_quadratureSum)
+{
+    getKernelTable().quadratureQ15(p_signal, p_inPhase, p_quadrature, p_count, p_inPhaseSum, p_quadratureSum);
+}
+
+void rotateCorrelation(const uint64_t p_windowPhase, double &p_inPhase, double &p_quadrature)
+{
+    // cos(a + b) = cos(a)cos(b) - sin(a)sin(b), sin(a + b) = sin(a)cos(b) + cos(a)sin(b)
+    double cosWindow = Oscillator::cosine(p_windowPhase);
+    double sinWindow = Oscillator::sine(p_windowPhase);
+    double inPhase = p_inPhase;
+    p_inPhase = cosWindow * inPhase - sinWindow * p_quadrature;
+    p_quadrature = sinWindow * inPhase + cosWindow * p_quadrature;
+}
+
+double sumAbsolute(const double *p_signal, const size_t p_count)
+{
+    return getKernelTable().absolute(p_signal, p_count);
+}
+
+double sumAbsolute(const float *p_signal, const size_t p_count)
+{
+    return getKernelTable().absoluteFloat(p_signal, p_count);
+}
+
+double sumAbsolute(const Q15 *p_signal, const size_t p_count)
+{
+    return getKernelTable().absoluteQ15(p_signal, p_count);
+}
@@ -0,0 +1,303 @@
+#include "fft.h"
+#include <cmath>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace
+{
+    /// @brief exp(-2*pi*i*p_index/p_size)
+    std::complex<double> getTwiddle(const size_t p_index, const size_t p_size)
+    {
+        double angle = -2.0 * M_PI * static_cast<double>(p_index) / static_cast<double>(p_size);
+        return std::complex<double>(std::cos(angle), std::sin(angle));
+    }
+
+    /// @brief Plans kept for the lifetime of the process, a plan never moves once it is built
+    template <typename Plan>
+    const Plan &getCachedPlan(const size_t p_size)
+    {
+        static std::mutex cacheMutex;
+        static std::map<size_t, std::unique_ptr<Plan>> cache;
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        std::unique_ptr<Plan> &plan = cache[p_size];
+        if (!plan)
+        {
+            plan = std::make_unique<Plan>(p_size);
+        }
+        return *plan;
+    }
+}
+
+FftPlan::FftPlan(const size_t p_size) : m_size(p_size == 0 ? 1 : p_size)
+{
+    m_twiddles.resize(m_size);
+    for (size_t index = 0; index < m_size; ++index)
+    {
+        m_twiddles[index] = getTwiddle(index, m_size);
+    }
+
+    // Radix 4 first, then 2, then odd factors from 3 upwards
+    size_t remaining = m_size;
+    size_t radix = 4;
+    while (remaining > 1)
+    {
+        while (remaining % radix != 0)
+        {
+            radix = radix == 4 ? 2 : (radix == 2 ? 3 : radix + 2);
+            if (radix * radix > remaining)
+            {
+                radix = remaining;
+            }
+        }
+        remaining /= radix;
+        m_stages.emplace_back(radix, remaining);
+    }
+}
+
+size_t FftPlan::size() const
+{
+    return m_size;
+}
+
+void FftPlan::transform(const std::complex<double> *p_input, std::complex<double> *p_output) const
+{
+    if (m_stages.empty())
+    {
+        p_output[0] = p_input[0];
+        return;
+    }
+    transformStage(p_output, p_input, 1, 0);
+}
+
+void FftPlan::transformStage(std::complex<double> *p_output, const std::complex<double> *p_input,
+                             const size_t p_stride, const size_t p_stageIdx) const
+{
+    size_t radix = m_stages[p_stageIdx].first;
+    size_t length = m_stages[p_stageIdx].second;
+    // Decimation in time: sub-sequence j holds the points j, j + radix, j + 2 * radix... of this level
+    if (length == 1)
+    {
+        for (size_t pointIdx = 0; pointIdx < radix; ++pointIdx)
+        {
+            p_output[pointIdx] = p_input[pointIdx * p_stride];
+        }
+    }
+    else
+    {
+        for (size_t subIdx = 0; subIdx < radix; ++subIdx)
+        {
+            transformStage(p_output + subIdx * length, p_input + subIdx * p_stride, p_stride * radix, p_stageIdx + 1);
+        }
+    }
+
+    switch (radix)
+    {
+    case 2:
+        butterfly2(p_output, p_stride, length);
+        break;
+    case 3:
+        butterfly3(p_output, p_stride, length);
+        break;
+    case 4:
+        butterfly4(p_output, p_stride, length);
+        break;
+    case 5:
+        butterfly5(p_output, p_stride, length);
+        break;
+    default:
+        butterflyGeneric(p_output, p_stride, length, radix);
+        break;
+    }
+}
+
+void FftPlan::butterfly2(std::complex<double> *p_output, const size_t p_stride, const size_t p_length) const
+{
+    for (size_t index = 0; index < p_length; ++index)
+    {
+        std::complex<double> odd = p_output[index + p_length] * m_twiddles[index * p_stride];
+        p_output[index + p_length] = p_output[index] - odd;
+        p_output[index] += odd;
+    }
+}
+
+void FftPlan::butterfly3(std::complex<double> *p_output, const size_t p_stride, const size_t p_length) const
+{
+    // Imaginary part of exp(-2*pi*i/3)
+    const double sinThird = m_twiddles[p_stride * p_length].imag();
+    for (size_t index = 0; index < p_length; ++index)
+    {
+        std::complex<double> first = p_output[index + p_length] * m_twiddles[index * p_stride];
+        std::complex<double> second = p_output[index + 2 * p_length] * m_twiddles[2 * index * p_stride];
+        std::complex<double> sum = first + second;
+        std::complex<double> difference = (first - second) * sinThird;
+        std::complex<double> middle = p_output[index] - sum * 0.5;
+        p_output[index] += sum;
+        p_output[index + p_length] = middle + std::complex<double>(-difference.imag(), difference.real());
+        p_output[index + 2 * p_length] = middle + std::complex<double>(difference.imag(), -difference.real());
+    }
+}
+
+void FftPlan::butterfly4(std::complex<double> *p_output, const size_t p_stride, const size_t p_length) const
+{
+    for (size_t index = 0; index < p_length; ++index)
+    {
+        std::complex<double> quarter1 = p_output[index + p_length] * m_twiddles[index * p_stride];
+        std::complex<double> quarter2 = p_output[index + 2 * p_length] * m_twiddles[2 * index * p_stride];
+        std::complex<double> quarter3 = p_output[index + 3 * p_length] * m_twiddles[3 * index * p_stride];
+        std::complex<double> evenSum = p_output[index] + quarter2;
+        std::complex<double> evenDifference = p_output[index] - quarter2;
+        std::complex<double> oddSum = quarter1 + quarter3;
+        std::complex<double> oddDifference = quarter1 - quarter3;
+        // Multiplying by -i rotates by a quarter turn without a multiplication
+        std::complex<double> rotated(oddDifference.imag(), -oddDifference.real());
+        p_output[index] = evenSum + oddSum;
+        p_output[index + p_length] = evenDifference + rotated;
+        p_output[index + 2 * p_length] = evenSum - oddSum;
+        p_output[index + 3 * p_length] = evenDifference - rotated;
+    }
+}
+
+void FftPlan::butterfly5(std::complex<double> *p_output, const size_t p_stride, const size_t p_length) const
+{
+    // exp(-2*pi*i/5) and exp(-4*pi*i/5)
+    const std::complex<double> fifth = m_twiddles[p_stride * p_length];
+    const std::complex<double> twoFifths = m_twiddles[2 * p_stride * p_length];
+    for (size_t index = 0; index < p_length; ++index)
+    {
+        std::complex<double> point0 = p_output[index];
+        std::complex<double> point1 = p_output[index + p_length] * m_twiddles[index * p_stride];
+        std::complex<double> point2 = p_output[index + 2 * p_length] * m_twiddles[2 * index * p_stride];
+        std::complex<double> point3 = p_output[index + 3 * p_length] * m_twiddles[3 * index * p_stride];
+        std::complex<double> point4 = p_output[index + 4 * p_length] * m_twiddles[4 * index * p_stride];
+        // Points k and 5 - k share the cosine and have opposite sines
+        std::complex<double> sum14 = point1 + point4;
+        std::complex<double> difference14 = point1 - point4;
+        std::complex<double> sum23 = point2 + point3;
+        std::complex<double> difference23 = point2 - point3;
+
+        std::complex<double> real1 = point0 + sum14 * fifth.real() + sum23 * twoFifths.real();
+        std::complex<double> imaginary1(difference14.imag() * fifth.imag() + difference23.imag() * twoFifths.imag(),
+                                        -(difference14.real() * fifth.imag() + difference23.real() * twoFifths.imag()));
+        std::complex<double> real2 = point0 + sum14 * twoFifths.real() + sum23 * fifth.real();
+        std::complex<double> imaginary2(-difference14.imag() * twoFifths.imag() + difference23.imag() * fifth.imag(),
+                                        difference14.real() * twoFifths.imag() - difference23.real() * fifth.imag());
+
+        p_output[index] = point0 + sum14 + sum23;
+        p_output[index + p_length] = real1 - imaginary1;
+        p_output[index + 4 * p_length] = real1 + imaginary1;
+        p_output[index + 2 * p_length] = real2 + imaginary2;
+        p_output[index + 3 * p_length] = real2 - imaginary2;
+    }
+}
+
+void FftPlan::butterflyGeneric(std::complex<double> *p_output, const size_t p_stride, const size_t p_length,
+                               const size_t p_radix) const
+{
+    std::vector<std::complex<double>> points(p_radix);
+    for (size_t index = 0; index < p_length; ++index)
+    {
+        for (size_t pointIdx = 0; pointIdx < p_radix; ++pointIdx)
+        {
+            points[pointIdx] = p_output[index + pointIdx * p_length];
+        }
+        for (size_t binIdx = 0; binIdx < p_radix; ++binIdx)
+        {
+            size_t outputIdx = index + binIdx * p_length;
+            std::complex<double> sum = points[0];
+            size_t twiddleIdx = 0;
+            for (size_t pointIdx = 1; pointIdx < p_radix; ++pointIdx)
+            {
+                // p_stride * outputIdx is below the size, one subtraction keeps the index in the table
+                twiddleIdx += p_stride * outputIdx;
+                if (twiddleIdx >= m_size)
+                {
+                    twiddleIdx -= m_size;
+                }
+                sum += points[pointIdx] * m_twiddles[twiddleIdx];
+            }
+            p_output[outputIdx] = sum;
+        }
+    }
+}
+
+RealFftPlan::RealFftPlan(const size_t p_size)
+    : m_size(p_size == 0 ? 1 : p_size), m_complexPlan(m_size % 2 == 0 ? m_size / 2 : m_size)
+{
+    if (m_size % 2 == 0)
+    {
+        m_splitTwiddles.resize(m_size / 2 + 1);
+        for (size_t index = 0; index <= m_size / 2; ++index)
+        {
+            m_splitTwiddles[index] = getTwiddle(index, m_size);
+        }
+    }
+}
+
+size_t RealFftPlan::size() const
+{
+    return m_size;
+}
+
+size_t RealFftPlan::getBinCount() const
+{
+    return m_size / 2 + 1;
+}
+
+void RealFftPlan::transform(const double *p_input, std::complex<double> *p_output,
+                            std::vector<std::complex<double>> &p_scratch) const
+{
+    size_t complexSize = m_complexPlan.size();
+    p_scratch.resize(2 * complexSize);
+    std::complex<double> *packed = p_scratch.data();
+    std::complex<double> *spectrum = p_scratch.data() + complexSize;
+    if (m_size % 2 != 0)
+    {
+        for (size_t index = 0; index < m_size; ++index)
+        {
+            packed[index] = p_input[index];
+        }
+        m_complexPlan.transform(packed, spectrum);
+        std::copy(spectrum, spectrum + getBinCount(), p_output);
+        return;
+    }
+
+    // z[n] = x[2n] + i * x[2n + 1]
+    for (size_t index = 0; index < complexSize; ++index)
+    {
+        packed[index] = std::complex<double>(p_input[2 * index], p_input[2 * index + 1]);
+    }
+    m_complexPlan.transform(packed, spectrum);
+    // X[k] = E[k] + exp(-2*pi*i*k/N) * O[k], where E and O are the transforms of the even and odd points:
+    // E[k] = (Z[k] + conj(Z[N/2 - k])) / 2 and O[k] = (Z[k] - conj(Z[N/2 - k])) / 2i
+    for (size_t binIdx = 0; binIdx <= complexSize; ++binIdx)
+    {
+        std::complex<double> current = spectrum[binIdx % complexSize];
+        std::complex<double> mirrored = std::conj(spectrum[(complexSize - binIdx) % complexSize]);
+        std::complex<double> even = (current + mirrored) * 0.5;
+        std::complex<double> odd = (current - mirrored) * std::complex<double>(0.0, -0.5);
+        p_output[binIdx] = even + m_splitTwiddles[binIdx] * odd;
+    }
+}
+
+const FftPlan &getFftPlan(const size_t p_size)
+{
+    return getCachedPlan<FftPlan>(p_size);
+}
+
+const RealFftPlan &getRealFftPlan(const size_t p_size)
+{
+    return getCachedPlan<RealFftPlan>(p_size);
+}
+
+void getFftFrequencies(const size_t p_size, const double p_sampleRate, std::vector<double> &p_output)
+{
+    p_output.resize(p_size);
+    // Bins from ceil(N/2) on stand for the negative frequencies
+    size_t positiveCount = (p_size + 1) / 2;
+    for (size_t binIdx = 0; binIdx < p_size; ++binIdx)
+    {
+        double bin = binIdx < positiveCount ? static_cast<double>(binIdx) : static_cast<double>(binIdx) - p_size;
+        p_output[binIdx] = bin * p_sampleRate / p_size;
+    }
+}
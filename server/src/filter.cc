@@ -0,0 +1,389 @@
+#include "filter.h"
+#include "simd.h"
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace
+{
+    /// @brief FIR kernel: p_output[n] = sum(p_taps[j] * p_history[n + j]) for the taps oldest first
+    using FirKernel = void (*)(const double *, const double *, size_t, double *, size_t);
+
+    void filterFirScalar(const double *p_history, const double *p_taps, size_t p_tapCount, double *p_output,
+                         size_t p_count)
+    {
+        for (size_t sampleIdx = 0; sampleIdx < p_count; ++sampleIdx)
+        {
+            double sum = 0.0;
+            for (size_t tapIdx = 0; tapIdx < p_tapCount; ++tapIdx)
+            {
+                sum += p_taps[tapIdx] * p_history[sampleIdx + tapIdx];
+            }
+            p_output[sampleIdx] = sum;
+        }
+    }
+
+#if defined(__x86_64__)
+    void filterFirSse2(const double *p_history, const double *p_taps, size_t p_tapCount, double *p_output,
+                       size_t p_count)
+    {
+        size_t sampleIdx = 0;
+        // 4 outputs per step, every tap broadcast over them
+        for (; sampleIdx + 4 <= p_count; sampleIdx += 4)
+        {
+            __m128d sum0 = _mm_setzero_pd();
+            __m128d sum1 = _mm_setzero_pd();
+            const double *history = p_history + sampleIdx;
+            for (size_t tapIdx = 0; tapIdx < p_tapCount; ++tapIdx)
+            {
+                __m128d tap = _mm_set1_pd(p_taps[tapIdx]);
+                sum0 = _mm_add_pd(sum0, _mm_mul_pd(tap, _mm_loadu_pd(history + tapIdx)));
+                sum1 = _mm_add_pd(sum1, _mm_mul_pd(tap, _mm_loadu_pd(history + tapIdx + 2)));
+            }
+            _mm_storeu_pd(p_output + sampleIdx, sum0);
+            _mm_storeu_pd(p_output + sampleIdx + 2, sum1);
+        }
+        filterFirScalar(p_history + sampleIdx, p_taps, p_tapCount, p_output + sampleIdx, p_count - sampleIdx);
+    }
+
+    __attribute__((target("avx2,fma"))) void filterFirAvx2(const double *p_history, const double *p_taps,
+                                                           size_t p_tapCount, double *p_output, size_t p_count)
+    {
+        size_t sampleIdx = 0;
+        // 8 outputs per step in two accumulators, so consecutive FMAs do not wait on each other
+        for (; sampleIdx + 8 <= p_count; sampleIdx += 8)
+        {
+            __m256d sum0 = _mm256_setzero_pd();
+            __m256d sum1 = _mm256_setzero_pd();
+            const double *history = p_history + sampleIdx;
+            for (size_t tapIdx = 0; tapIdx < p_tapCount; ++tapIdx)
+            {
+                __m256d tap = _mm256_broadcast_sd(p_taps + tapIdx);
+                sum0 = _mm256_fmadd_pd(tap, _mm256_loadu_pd(history + tapIdx), sum0);
+                sum1 = _mm256_fmadd_pd(tap, _mm256_loadu_pd(history + tapIdx + 4), sum1);
+            }
+            _mm256_storeu_pd(p_output + sampleIdx, sum0);
+            _mm256_storeu_pd(p_output + sampleIdx + 4, sum1);
+        }
+        filterFirScalar(p_history + sampleIdx, p_taps, p_tapCount, p_output + sampleIdx, p_count - sampleIdx);
+    }
+#endif
+
+    /// @brief The FIR kernels indexed by SimdLevel, falling back to the closest lower level
+    const FirKernel FIR_KERNELS[] = {
+        filterFirScalar,
+#if defined(__x86_64__)
+        filterFirSse2,
+        filterFirAvx2,
+#else
+        filterFirScalar,
+        filterFirScalar,
+#endif
+    };
+
+    /**
+     * @brief Parse numbers separated by spaces
+     *
+     * @param p_text - the numbers
+     * @return the numbers in order
+     * @throw std::invalid_argument if a value is not a number
+     */
+    std::vector<double> parseCoefficients(const std::string &p_text)
+    {
+        std::istringstream stream(p_text);
+        std::vector<double> values;
+        std::string token;
+        while (stream >> token)
+        {
+            size_t parsed = 0;
+            double value = 0.0;
+            try
+            {
+                value = std::stod(token, &parsed);
+            }
+            catch (const std::exception &)
+            {
+                parsed = 0;
+            }
+            if (parsed != token.size() || !std::isfinite(value))
+            {
+                throw std::invalid_argument("Filter coefficient is not a number: " + token);
+            }
+            values.push_back(value);
+        }
+        return values;
+    }
+}
+
+FirFilter::FirFilter(const std::vector<double> &p_taps)
+{
+    setTaps(p_taps);
+}
+
+void FirFilter::setTaps(const std::vector<double> &p_taps)
+{
+    if (p_taps.empty())
+    {
+        throw std::invalid_argument("A FIR filter needs at least one tap.");
+    }
+    m_taps = p_taps;
+    m_reversedTaps.assign(p_taps.rbegin(), p_taps.rend());
+    m_history.assign(m_taps.size() - 1 + FILTER_BLOCK_SIZE, 0.0);
+    m_isPrimed = false;
+}
+
+const std::vector<double> &FirFilter::getTaps() const
+{
+    return m_taps;
+}
+
+void FirFilter::reset()
+{
+    m_isPrimed = false;
+}
+
+void FirFilter::process(double *p_signal, const size_t p_size)
+{
+    if (p_size == 0)
+    {
+        return;
+    }
+    size_t historySize = m_taps.size() - 1;
+    if (!m_isPrimed)
+    {
+        std::fill(m_history.begin(), m_history.begin() + historySize, p_signal[0]);
+        m_isPrimed = true;
+    }
+    FirKernel kernel = FIR_KERNELS[static_cast<int>(getSimdLevel())];
+    for (size_t blockStart = 0; blockStart < p_size; blockStart += FILTER_BLOCK_SIZE)
+    {
+        size_t blockSize = std::min(FILTER_BLOCK_SIZE, p_size - blockStart);
+        // The inputs are copied behind the history, so the block can be overwritten by the outputs
+        std::copy(p_signal + blockStart, p_signal + blockStart + blockSize, m_history.begin() + historySize);
+        kernel(m_history.data(), m_reversedTaps.data(), m_reversedTaps.size(), p_signal + blockStart, blockSize);
+        std::copy(m_history.begin() + blockSize, m_history.begin() + blockSize + historySize, m_history.begin());
+    }
+}
+
+std::complex<double> FirFilter::getResponse(const double p_angularFrequency) const
+{
+    std::complex<double> response;
+    for (size_t tapIdx = 0; tapIdx < m_taps.size(); ++tapIdx)
+    {
+        response += m_taps[tapIdx] * std::polar(1.0, -p_angularFrequency * tapIdx);
+    }
+    return response;
+}
+
+BiquadCascade::BiquadCascade(const std::vector<BiquadSection> &p_sections)
+{
+    setSections(p_sections);
+}
+
+void BiquadCascade::setSections(const std::vector<BiquadSection> &p_sections)
+{
+    m_sections = p_sections;
+    m_states.assign(m_sections.size(), {0.0, 0.0});
+    m_isPrimed = false;
+}
+
+void BiquadCascade::reset()
+{
+    m_isPrimed = false;
+}
+
+void BiquadCascade::process(double *p_signal, const size_t p_size)
+{
+    if (p_size == 0)
+    {
+        return;
+    }
+    if (!m_isPrimed)
+    {
+        // A steady input x leaves the steady output y = G * x, then z1 = y - b0 * x and z2 = b2 * x - a2 * y
+        double input = p_signal[0];
+        for (size_t sectionIdx = 0; sectionIdx < m_sections.size(); ++sectionIdx)
+        {
+            const BiquadSection &section = m_sections[sectionIdx];
+            double gain = (section.b0 + section.b1 + section.b2) / (1.0 + section.a1 + section.a2);
+            double output = gain * input;
+            m_states[sectionIdx] = {output - section.b0 * input, section.b2 * input - section.a2 * output};
+            input = output;
+        }
+        m_isPrimed = true;
+    }
+    for (size_t sectionIdx = 0; sectionIdx < m_sections.size(); ++sectionIdx)
+    {
+        const BiquadSection section = m_sections[sectionIdx];
+        double state1 = m_states[sectionIdx][0];
+        double state2 = m_states[sectionIdx][1];
+        // Transposed direct form II, two additions on the recursion path
+        for (size_t sampleIdx = 0; sampleIdx < p_size; ++sampleIdx)
+        {
+            double input = p_signal[sampleIdx];
+            double output = section.b0 * input + state1;
+            state1 = section.b1 * input - section.a1 * output + state2;
+            state2 = section.b2 * input - section.a2 * output;
+            p_signal[sampleIdx] = output;
+        }
+        m_states[sectionIdx] = {state1, state2};
+    }
+}
+
+std::complex<double> BiquadCascade::getResponse(const double p_angularFrequency) const
+{
+    std::complex<double> response(1.0, 0.0);
+    std::complex<double> delay1 = std::polar(1.0, -p_angularFrequency);
+    std::complex<double> delay2 = std::polar(1.0, -2.0 * p_angularFrequency);
+    for (const BiquadSection &section : m_sections)
+    {
+        response *= (section.b0 + section.b1 * delay1 + section.b2 * delay2) /
+                    (1.0 + section.a1 * delay1 + section.a2 * delay2);
+    }
+    return response;
+}
+
+FilterBank::FilterBank(const std::vector<double> &p_taps) : m_isBiquad(false), m_fir(p_taps)
+{
+}
+
+void FilterBank::configure(const std::string &p_type, const std::string &p_coefficients)
+{
+    std::vector<double> coefficients = parseCoefficients(p_coefficients);
+    if (p_type == FILTER_TYPE_FIR)
+    {
+        setFir(coefficients);
+        return;
+    }
+    if (p_type != FILTER_TYPE_BIQUAD)
+    {
+        throw std::invalid_argument("Unknown filter type: " + p_type);
+    }
+    if (coefficients.empty() || coefficients.size() % BIQUAD_COEFFICIENTS != 0)
+    {
+        throw std::invalid_argument("Every biquad section needs the 5 coefficients b0 b1 b2 a1 a2.");
+    }
+    std::vector<BiquadSection> sections;
+    for (size_t position = 0; position < coefficients.size(); position += BIQUAD_COEFFICIENTS)
+    {
+        sections.push_back({coefficients[position], coefficients[position + 1], coefficients[position + 2],
+                            coefficients[position + 3], coefficients[position + 4]});
+    }
+    setBiquad(sections);
+}
+
+void FilterBank::setFir(const std::vector<double> &p_taps)
+{
+    m_fir.setTaps(p_taps);
+    m_isBiquad = false;
+}
+
+void FilterBank::setBiquad(const std::vector<BiquadSection> &p_sections)
+{
+    m_biquad.setSections(p_sections);
+    m_isBiquad = true;
+}
+
+void FilterBank::reset()
+{
+    m_fir.reset();
+    m_biquad.reset();
+}
+
+void FilterBank::process(double *p_signal, const size_t p_size)
+{
+    if (m_isBiquad)
+    {
+        m_biquad.process(p_signal, p_size);
+    }
+    else
+    {
+        m_fir.process(p_signal, p_size);
+    }
+}
+
+std::complex<double> FilterBank::getResponse(const double p_angularFrequency) const
+{
+    return m_isBiquad ? m_biquad.getResponse(p_angularFrequency) : m_fir.getResponse(p_angularFrequency);
+}
+
+std::vector<double> designLowPass(const double p_cutoff, const double p_sampleRate, const size_t p_tapCount)
+{
+    std::vector<double> taps(p_tapCount);
+    double normalizedCutoff = 2.0 * p_cutoff / p_sampleRate;
+    double center = (p_tapCount - 1) / 2.0;
+    double sum = 0.0;
+    for (size_t tapIdx = 0; tapIdx < p_tapCount; ++tapIdx)
+    {
+        double offset = tapIdx - center;
+        double sinc = offset == 0.0 ? normalizedCutoff
+                                    : std::sin(M_PI * normalizedCutoff * offset) / (M_PI * offset);
+        double window = p_tapCount == 1 ? 1.0 : 0.54 - 0.46 * std::cos(2.0 * M_PI * tapIdx / (p_tapCount - 1));
+        taps[tapIdx] = sinc * window;
+        sum += taps[tapIdx];
+    }
+    for (double &tap : taps)
+    {
+        tap /= sum;
+    }
+    return taps;
+}
+
+std::vector<double> designRaisedCosine(const double p_rolloff, const size_t p_samplesPerSymbol,
+                                       const size_t p_spanSymbols)
+{
+    size_t tapCount = p_samplesPerSymbol * p_spanSymbols + 1;
+    std::vector<double> taps(tapCount);
+    double center = (tapCount - 1) / 2.0;
+    double sum = 0.0;
+    for (size_t tapIdx = 0; tapIdx < tapCount; ++tapIdx)
+    {
+        double time = (tapIdx - center) / p_samplesPerSymbol;
+        double sinc = time == 0.0 ? 1.0 : std::sin(M_PI * time) / (M_PI * time);
+        double denominator = 1.0 - 4.0 * p_rolloff * p_rolloff * time * time;
+        // At t = +-1 / (2 * rolloff) the cosine term tends to pi / 4
+        double shape = std::fabs(denominator) < 1e-12 ? M_PI / 4.0 : std::cos(M_PI * p_rolloff * time) / denominator;
+        taps[tapIdx] = sinc * shape;
+        sum += taps[tapIdx];
+    }
+    for (double &tap : taps)
+    {
+        tap /= sum;
+    }
+    return taps;
+}
+
+std::vector<double> designMatchedFilter(const double *p_pulse, const size_t p_size)
+{
+    std::vector<double> taps(p_pulse, p_pulse + p_size);
+    std::reverse(taps.begin(), taps.end());
+    double energy = 0.0;
+    for (double tap : taps)
+    {
+        energy += tap * tap;
+    }
+    if (energy > 0.0)
+    {
+        double scale = 1.0 / std::sqrt(energy);
+        for (double &tap : taps)
+        {
+            tap *= scale;
+        }
+    }
+    return taps;
+}
+
+BiquadSection designLowPassBiquad(const double p_cutoff, const double p_sampleRate, const double p_quality)
+{
+    // Bilinear transform of 1 / (s^2 + s / Q + 1)
+    double angle = 2.0 * M_PI * p_cutoff / p_sampleRate;
+    double alpha = std::sin(angle) / (2.0 * p_quality);
+    double cosine = std::cos(angle);
+    double a0 = 1.0 + alpha;
+    double b1 = (1.0 - cosine) / a0;
+    return {b1 / 2.0, b1, b1 / 2.0, -2.0 * cosine / a0, (1.0 - alpha) / a0};
+}
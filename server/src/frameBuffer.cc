@@ -0,0 +1,172 @@
+#include "frameBuffer.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+FrameReader::FrameReader() : m_start(0), m_end(0)
+{
+}
+
+size_t FrameReader::getBufferedSize() const
+{
+    return m_end - m_start;
+}
+
+bool FrameReader::extractFrames(const FrameSink &p_sink)
+{
+    while (m_end - m_start >= FRAME_HEADER_SIZE)
+    {
+        const unsigned char *header = reinterpret_cast<const unsigned char *>(m_buffer.data() + m_start);
+        size_t payloadSize = 0;
+        for (size_t byteIdx = 0; byteIdx < FRAME_HEADER_SIZE; ++byteIdx)
+        {
+            payloadSize = (payloadSize << 8) | header[byteIdx];
+        }
+        if (payloadSize > FRAME_MAX_PAYLOAD)
+        {
+            return false;
+        }
+        if (m_end - m_start - FRAME_HEADER_SIZE < payloadSize)
+        {
+            break;
+        }
+        p_sink(m_buffer.data() + m_start + FRAME_HEADER_SIZE, payloadSize);
+        m_start += FRAME_HEADER_SIZE + payloadSize;
+    }
+    // Move the partial frame to the front, so the buffer never grows past one frame and one chunk
+    if (m_start != 0)
+    {
+        std::memmove(m_buffer.data(), m_buffer.data() + m_start, m_end - m_start);
+        m_end -= m_start;
+        m_start = 0;
+    }
+    return true;
+}
+
+SocketStatus FrameReader::readFrom(const int p_socket, const FrameSink &p_sink, const ReadPause &p_pause)
+{
+    while (true)
+    {
+        if (p_pause && p_pause())
+        {
+            return SocketStatus::PAUSED;
+        }
+        if (m_buffer.size() - m_end < FRAME_READ_CHUNK)
+        {
+            m_buffer.resize(std::max(2 * m_buffer.size(), m_end + FRAME_READ_CHUNK));
+        }
+        ssize_t received = recv(p_socket, m_buffer.data() + m_end, m_buffer.size() - m_end, 0);
+        if (received > 0)
+        {
+            m_end += received;
+            if (!extractFrames(p_sink))
+            {
+                return SocketStatus::INVALID_FRAME;
+            }
+            continue;
+        }
+        if (received == 0)
+        {
+            return SocketStatus::CLOSED;
+        }
+        if (errno == EINTR)
+        {
+            continue;
+        }
+        // Edge-triggered epoll only signals new bytes again once the socket has been drained
+        if (errno == EAGAIN || errno == EWOULDBLOCK)
+        {
+            return SocketStatus::OPEN;
+        }
+        return SocketStatus::FAILED;
+    }
+}
+
+FrameWriter::FrameWriter() : m_written(0), m_pendingSize(0)
+{
+}
+
+void FrameWriter::push(const char *p_payload, const size_t p_size)
+{
+    push(std::string(p_payload, p_size));
+}
+
+void FrameWriter::push(const std::string &p_payload)
+{
+    push(std::string(p_payload));
+}
+
+void FrameWriter::push(std::string &&p_payload)
+{
+    Frame &frame = m_frames.emplace_back();
+    for (size_t byteIdx = 0; byteIdx < FRAME_HEADER_SIZE; ++byteIdx)
+    {
+        frame.header[byteIdx] = static_cast<char>((p_payload.size() >> (8 * (FRAME_HEADER_SIZE - 1 - byteIdx))) & 0xFF);
+    }
+    frame.payload = std::move(p_payload);
+    m_pendingSize += FRAME_HEADER_SIZE + frame.payload.size();
+}
+
+SocketStatus FrameWriter::flush(const int p_socket)
+{
+    struct iovec buffers[2 * FRAME_WRITE_BATCH];
+    while (m_pendingSize != 0)
+    {
+        // Gather the unwritten part of the oldest frame and the frames behind it
+        size_t bufferCount = 0;
+        size_t skipped = m_written;
+        for (size_t frameIdx = 0; frameIdx < m_frames.size() && frameIdx < FRAME_WRITE_BATCH; ++frameIdx)
+        {
+            Frame &frame = m_frames[frameIdx];
+            if (skipped < FRAME_HEADER_SIZE)
+            {
+                buffers[bufferCount++] = {frame.header.data() + skipped, FRAME_HEADER_SIZE - skipped};
+                skipped = 0;
+            }
+            else
+            {
+                skipped -= FRAME_HEADER_SIZE;
+            }
+            if (skipped < frame.payload.size())
+            {
+                buffers[bufferCount++] = {frame.payload.data() + skipped, frame.payload.size() - skipped};
+            }
+            skipped = 0;
+        }
+
+        // sendmsg() is writev() with flags: MSG_NOSIGNAL turns a closed peer into EPIPE instead of killing the process
+        struct msghdr message = {};
+        message.msg_iov = buffers;
+        message.msg_iovlen = bufferCount;
+        ssize_t sent = sendmsg(p_socket, &message, MSG_NOSIGNAL);
+        if (sent < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+            {
+                return SocketStatus::OPEN;
+            }
+            return SocketStatus::FAILED;
+        }
+
+        // Drop the frames written completely
+        m_pendingSize -= sent;
+        m_written += sent;
+        while (!m_frames.empty() && m_written >= FRAME_HEADER_SIZE + m_frames.front().payload.size())
+        {
+            m_written -= FRAME_HEADER_SIZE + m_frames.front().payload.size();
+            m_frames.pop_front();
+        }
+    }
+    return SocketStatus::OPEN;
+}
+
+size_t FrameWriter::getPendingSize() const
+{
+    return m_pendingSize;
+}
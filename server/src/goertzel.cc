@@ -0,0 +1,259 @@
+#include "goertzel.h"
+#include "simd.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace
+{
+    /**
+     * @brief Goertzel kernel: runs the recursions of GOERTZEL_MAX_TONES tones over p_groupCount groups of
+     * GOERTZEL_LANES samples, p_states[tone][0][lane] receiving s[M - 1] and p_states[tone][1][lane] s[M - 2]
+     */
+    template <typename Sample>
+    using GoertzelKernel = void (*)(const Sample *, size_t, const double *, double (*)[2][GOERTZEL_LANES]);
+
+    template <typename Sample>
+    void goertzelScalar(const Sample *p_samples, size_t p_groupCount, const double *p_coefficients,
+                        double (*p_states)[2][GOERTZEL_LANES])
+    {
+        for (size_t toneIdx = 0; toneIdx < GOERTZEL_MAX_TONES; ++toneIdx)
+        {
+            double coefficient = p_coefficients[toneIdx];
+            double state1[GOERTZEL_LANES] = {};
+            double state2[GOERTZEL_LANES] = {};
+            for (size_t groupIdx = 0; groupIdx < p_groupCount; ++groupIdx)
+            {
+                const Sample *group = p_samples + groupIdx * GOERTZEL_LANES;
+                for (size_t laneIdx = 0; laneIdx < GOERTZEL_LANES; ++laneIdx)
+                {
+                    double state = static_cast<double>(group[laneIdx]) + coefficient * state1[laneIdx] - state2[laneIdx];
+                    state2[laneIdx] = state1[laneIdx];
+                    state1[laneIdx] = state;
+                }
+            }
+            for (size_t laneIdx = 0; laneIdx < GOERTZEL_LANES; ++laneIdx)
+            {
+                p_states[toneIdx][0][laneIdx] = state1[laneIdx];
+                p_states[toneIdx][1][laneIdx] = state2[laneIdx];
+            }
+        }
+    }
+
+#if defined(__x86_64__)
+    inline void loadGroupSse2(const double *p_group, __m128d *p_values)
+    {
+        for (size_t vectorIdx = 0; vectorIdx < GOERTZEL_LANES / 2; ++vectorIdx)
+        {
+            p_values[vectorIdx] = _mm_loadu_pd(p_group + 2 * vectorIdx);
+        }
+    }
+
+    inline void loadGroupSse2(const float *p_group, __m128d *p_values)
+    {
+        __m128 low = _mm_loadu_ps(p_group);
+        __m128 high = _mm_loadu_ps(p_group + 4);
+        p_values[0] = _mm_cvtps_pd(low);
+        p_values[1] = _mm_cvtps_pd(_mm_movehl_ps(low, low));
+        p_values[2] = _mm_cvtps_pd(high);
+        p_values[3] = _mm_cvtps_pd(_mm_movehl_ps(high, high));
+    }
+
+    inline void loadGroupSse2(const Q15 *p_group, __m128d *p_values)
+    {
+        // Widen to int32 by placing every sample in the upper half and shifting its sign back down
+        __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p_group));
+        __m128i low = _mm_srai_epi32(_mm_unpacklo_epi16(samples, samples), 16);
+        __m128i high = _mm_srai_epi32(_mm_unpackhi_epi16(samples, samples), 16);
+        p_values[0] = _mm_cvtepi32_pd(low);
+        p_values[1] = _mm_cvtepi32_pd(_mm_shuffle_epi32(low, 0xEE));
+        p_values[2] = _mm_cvtepi32_pd(high);
+        p_values[3] = _mm_cvtepi32_pd(_mm_shuffle_epi32(high, 0xEE));
+    }
+
+    template <typename Sample>
+    void goertzelSse2(const Sample *p_samples, size_t p_groupCount, const double *p_coefficients,
+                      double (*p_states)[2][GOERTZEL_LANES])
+    {
+        constexpr size_t vectorCount = GOERTZEL_LANES / 2;
+        // One tone per pass, the states of both tones do not fit in the 16 registers
+        for (size_t toneIdx = 0; toneIdx < GOERTZEL_MAX_TONES; ++toneIdx)
+        {
+            __m128d coefficient = _mm_set1_pd(p_coefficients[toneIdx]);
+            __m128d state1[vectorCount];
+            __m128d state2[vectorCount];
+            for (size_t vectorIdx = 0; vectorIdx < vectorCount; ++vectorIdx)
+            {
+                state1[vectorIdx] = _mm_setzero_pd();
+                state2[vectorIdx] = _mm_setzero_pd();
+            }
+            for (size_t groupIdx = 0; groupIdx < p_groupCount; ++groupIdx)
+            {
+                __m128d values[vectorCount];
+                loadGroupSse2(p_samples + groupIdx * GOERTZEL_LANES, values);
+                for (size_t vectorIdx = 0; vectorIdx < vectorCount; ++vectorIdx)
+                {
+                    __m128d state = _mm_add_pd(_mm_mul_pd(coefficient, state1[vectorIdx]),
+                                               _mm_sub_pd(values[vectorIdx], state2[vectorIdx]));
+                    state2[vectorIdx] = state1[vectorIdx];
+                    state1[vectorIdx] = state;
+                }
+            }
+            for (size_t vectorIdx = 0; vectorIdx < vectorCount; ++vectorIdx)
+            {
+                _mm_storeu_pd(p_states[toneIdx][0] + 2 * vectorIdx, state1[vectorIdx]);
+                _mm_storeu_pd(p_states[toneIdx][1] + 2 * vectorIdx, state2[vectorIdx]);
+            }
+        }
+    }
+
+    __attribute__((target("avx2,fma"))) inline void loadGroupAvx2(const double *p_group, __m256d &p_low, __m256d &p_high)
+    {
+        p_low = _mm256_loadu_pd(p_group);
+        p_high = _mm256_loadu_pd(p_group + 4);
+    }
+
+    __attribute__((target("avx2,fma"))) inline void loadGroupAvx2(const float *p_group, __m256d &p_low, __m256d &p_high)
+    {
+        p_low = _mm256_cvtps_pd(_mm_loadu_ps(p_group));
+        p_high = _mm256_cvtps_pd(_mm_loadu_ps(p_group + 4));
+    }
+
+    __attribute__((target("avx2,fma"))) inline void loadGroupAvx2(const Q15 *p_group, __m256d &p_low, __m256d &p_high)
+    {
+        __m256i samples = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p_group)));
+        p_low = _mm256_cvtepi32_pd(_mm256_castsi256_si128(samples));
+        p_high = _mm256_cvtepi32_pd(_mm256_extracti128_si256(samples, 1));
+    }
+
+    template <typename Sample>
+    __attribute__((target("avx2,fma"))) void goertzelAvx2(const Sample *p_samples, size_t p_groupCount,
+                                                          const double *p_coefficients,
+                                                          double (*p_states)[2][GOERTZEL_LANES])
+    {
+        static_assert(GOERTZEL_MAX_TONES == 2 && GOERTZEL_LANES == 8, "one pass holds 2 tones of 2 vectors");
+        // Both tones in one pass: four independent recursions hide the latency of the multiply-add
+        __m256d coefficient0 = _mm256_set1_pd(p_coefficients[0]);
+        __m256d coefficient1 = _mm256_set1_pd(p_coefficients[1]);
+        __m256d tone0Low1 = _mm256_setzero_pd(), tone0Low2 = _mm256_setzero_pd();
+        __m256d tone0High1 = _mm256_setzero_pd(), tone0High2 = _mm256_setzero_pd();
+        __m256d tone1Low1 = _mm256_setzero_pd(), tone1Low2 = _mm256_setzero_pd();
+        __m256d tone1High1 = _mm256_setzero_pd(), tone1High2 = _mm256_setzero_pd();
+        for (size_t groupIdx = 0; groupIdx < p_groupCount; ++groupIdx)
+        {
+            __m256d low;
+            __m256d high;
+            loadGroupAvx2(p_samples + groupIdx * GOERTZEL_LANES, low, high);
+            __m256d state = _mm256_fmadd_pd(coefficient0, tone0Low1, _mm256_sub_pd(low, tone0Low2));
+            tone0Low2 = tone0Low1;
+            tone0Low1 = state;
+            state = _mm256_fmadd_pd(coefficient0, tone0High1, _mm256_sub_pd(high, tone0High2));
+            tone0High2 = tone0High1;
+            tone0High1 = state;
+            state = _mm256_fmadd_pd(coefficient1, tone1Low1, _mm256_sub_pd(low, tone1Low2));
+            tone1Low2 = tone1Low1;
+            tone1Low1 = state;
+            state = _mm256_fmadd_pd(coefficient1, tone1High1, _mm256_sub_pd(high, tone1High2));
+            tone1High2 = tone1High1;
+            tone1High1 = state;
+        }
+        _mm256_storeu_pd(p_states[0][0], tone0Low1);
+        _mm256_storeu_pd(p_states[0][0] + 4, tone0High1);
+        _mm256_storeu_pd(p_states[0][1], tone0Low2);
+        _mm256_storeu_pd(p_states[0][1] + 4, tone0High2);
+        _mm256_storeu_pd(p_states[1][0], tone1Low1);
+        _mm256_storeu_pd(p_states[1][0] + 4, tone1High1);
+        _mm256_storeu_pd(p_states[1][1], tone1Low2);
+        _mm256_storeu_pd(p_states[1][1] + 4, tone1High2);
+    }
+#endif
+
+    /**
+     * @brief Get the Goertzel kernel of the current instruction set level for a sample format
+     *
+     * @return the kernel, falling back to the closest lower level
+     */
+    template <typename Sample>
+    GoertzelKernel<Sample> getGoertzelKernel()
+    {
+        static const GoertzelKernel<Sample> kernels[] = {
+            goertzelScalar<Sample>,
+#if defined(__x86_64__)
+            goertzelSse2<Sample>,
+            goertzelAvx2<Sample>,
+#else
+            goertzelScalar<Sample>,
+            goertzelScalar<Sample>,
+#endif
+        };
+        return kernels[static_cast<int>(getSimdLevel())];
+    }
+}
+
+GoertzelDetector::GoertzelDetector() : m_toneCount(0), m_angle{}, m_coefficient{}, m_groupCount(SIZE_MAX)
+{
+}
+
+void GoertzelDetector::configure(const double *p_frequencies, const size_t p_toneCount, const double p_sampleRate)
+{
+    m_toneCount = std::min(p_toneCount, GOERTZEL_MAX_TONES);
+    for (size_t toneIdx = 0; toneIdx < GOERTZEL_MAX_TONES; ++toneIdx)
+    {
+        // The unused tones run at 0 Hz and are not read
+        m_angle[toneIdx] = toneIdx < m_toneCount ? 2 * M_PI * p_frequencies[toneIdx] / p_sampleRate : 0.0;
+        m_coefficient[toneIdx] = 2 * std::cos(GOERTZEL_LANES * m_angle[toneIdx]);
+        m_groupDelay[toneIdx] = std::polar(1.0, -static_cast<double>(GOERTZEL_LANES) * m_angle[toneIdx]);
+        for (size_t laneIdx = 0; laneIdx < GOERTZEL_LANES; ++laneIdx)
+        {
+            m_laneRotation[toneIdx][laneIdx] = std::polar(1.0, -m_angle[toneIdx] * laneIdx);
+        }
+    }
+    m_groupCount = SIZE_MAX;
+}
+
+template <typename Sample>
+void GoertzelDetector::correlate(const Sample *p_samples, const size_t p_count, std::complex<double> *p_correlations)
+{
+    size_t groupCount = p_count / GOERTZEL_LANES;
+    if (groupCount != m_groupCount)
+    {
+        // Symbol windows all have the same length, so this runs once per configuration
+        m_groupCount = groupCount;
+        for (size_t toneIdx = 0; toneIdx < m_toneCount; ++toneIdx)
+        {
+            double groups = static_cast<double>(groupCount) - 1.0;
+            m_groupRotation[toneIdx] = std::polar(1.0, -static_cast<double>(GOERTZEL_LANES) * m_angle[toneIdx] * groups);
+        }
+    }
+    double states[GOERTZEL_MAX_TONES][2][GOERTZEL_LANES];
+    getGoertzelKernel<Sample>()(p_samples, groupCount, m_coefficient, states);
+
+    const Sample *tail = p_samples + groupCount * GOERTZEL_LANES;
+    size_t tailCount = p_count - groupCount * GOERTZEL_LANES;
+    double sampleScale = SampleFormat<Sample>::toAmplitude(1);
+    for (size_t toneIdx = 0; toneIdx < m_toneCount; ++toneIdx)
+    {
+        // Lane k holds the DFT of x[8m + k] at 8w ending at m = M - 1: y = s[M - 1] - exp(-j * 8w) * s[M - 2]
+        std::complex<double> sum;
+        for (size_t laneIdx = 0; laneIdx < GOERTZEL_LANES; ++laneIdx)
+        {
+            std::complex<double> output = states[toneIdx][0][laneIdx] - m_groupDelay[toneIdx] * states[toneIdx][1][laneIdx];
+            sum += m_laneRotation[toneIdx][laneIdx] * output;
+        }
+        std::complex<double> correlation = m_groupRotation[toneIdx] * sum;
+        // The samples past the last whole group start at exp(-j * 8w * M)
+        std::complex<double> tailRotation = m_groupRotation[toneIdx] * m_groupDelay[toneIdx];
+        for (size_t sampleIdx = 0; sampleIdx < tailCount; ++sampleIdx)
+        {
+            correlation += static_cast<double>(tail[sampleIdx]) * tailRotation * m_laneRotation[toneIdx][sampleIdx];
+        }
+        p_correlations[toneIdx] = correlation * sampleScale;
+    }
+}
+
+template void GoertzelDetector::correlate<double>(const double *, const size_t, std::complex<double> *);
+template void GoertzelDetector::correlate<float>(const float *, const size_t, std::complex<double> *);
+template void GoertzelDetector::correlate<Q15>(const Q15 *, const size_t, std::complex<double> *);
@@ -0,0 +1,65 @@
+#include "jobQueue.h"
+#include <algorithm>
+
+JobQueue::JobQueue(const size_t p_workerCount) : m_isStopping(false)
+{
+    size_t workerCount = std::max<size_t>(p_workerCount, 1);
+    for (size_t workerIdx = 0; workerIdx < workerCount; ++workerIdx)
+    {
+        m_workers.emplace_back(&JobQueue::runWorker, this, workerIdx);
+    }
+}
+
+JobQueue::~JobQueue()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isStopping = true;
+        m_jobs.clear();
+    }
+    m_jobReady.notify_all();
+    for (std::thread &worker : m_workers)
+    {
+        worker.join();
+    }
+}
+
+void JobQueue::push(Job &&p_job)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_jobs.push_back(std::move(p_job));
+    }
+    m_jobReady.notify_one();
+}
+
+size_t JobQueue::getWorkerCount() const
+{
+    return m_workers.size();
+}
+
+size_t JobQueue::getQueuedCount()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_jobs.size();
+}
+
+void JobQueue::runWorker(const size_t p_workerIdx)
+{
+    while (true)
+    {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_jobReady.wait(lock, [this]()
+                            { return m_isStopping || !m_jobs.empty(); });
+            if (m_isStopping)
+            {
+                return;
+            }
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+        }
+        job(p_workerIdx);
+    }
+}
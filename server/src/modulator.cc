@@ -1,10 +1,15 @@
 #include "modulator.h"
 #include "serverCommon.h"
+#include <algorithm>
+#include <atomic>
+#include <numeric>
 #include <random>
 #include <stdexcept>
+#include <type_traits>
 
-Modulator::Modulator()
+Modulator::Modulator() : m_fskDetector(FskDetector::CORRELATOR), m_threadPool(nullptr)
 {
+    m_waveformTables.fill(nullptr);
     readDatabase();
 }
 
@@ -26,10 +31,33 @@ void Modulator::readDatabase()
     floatValue = InMemDatabase::getInstance().getValue(PSK_ONE_SIGN_KEY);
     extractValue(floatValue, m_pskOneSign);
     m_pskOneSign = m_pskOneSign * M_PI / 180;
+    // cos(x + phase) = cos(phase) * cos(x) - sin(phase) * sin(x)
+    m_pskInPhase[0] = CARRIER_AMPLITUDE * cos(m_pskZeroSign);
+    m_pskQuadrature[0] = -CARRIER_AMPLITUDE * sin(m_pskZeroSign);
+    m_pskInPhase[1] = CARRIER_AMPLITUDE * cos(m_pskOneSign);
+    m_pskQuadrature[1] = -CARRIER_AMPLITUDE * sin(m_pskOneSign);
     floatValue = InMemDatabase::getInstance().getValue(FSK_ZERO_SIGN_KEY);
     extractValue(floatValue, m_fskZeroSign);
     floatValue = InMemDatabase::getInstance().getValue(FSK_ONE_SIGN_KEY);
     extractValue(floatValue, m_fskOneSign);
+    try
+    {
+        auto detectorValue = InMemDatabase::getInstance().getValue(FSK_DETECTOR_KEY);
+        const char *detector = "";
+        extractValue<char const *>(detectorValue, detector);
+        if (std::string(detector) == FSK_DETECTOR_GOERTZEL)
+        {
+            m_fskDetector = FskDetector::GOERTZEL;
+        }
+        else if (std::string(detector) != FSK_DETECTOR_CORRELATOR)
+        {
+            g_serverLogger.error(stringify("Unknown FSK detector, using the correlator: ", detector));
+        }
+    }
+    catch (const DBException &)
+    {
+        // Databases without the setting keep the correlator
+    }
     const char *sampleChar = "";
     auto intValue = InMemDatabase::getInstance().getValue(SAMPLE_RATE_KEY);
     extractValue<char const *>(intValue, sampleChar);
@@ -42,13 +70,50 @@ void Modulator::setFrequency(const double &p_frequency)
     m_carrierFrequency = p_frequency;
     m_bitRate = p_frequency;
     m_samplesPerBit = m_sampleRate / m_bitRate;
+
+    // Build the symbol templates of every scheme the first time this frequency is used,
+    // and bind them so modulation does not look them up again
+    for (ModulationType type : {ModulationType::ASK, ModulationType::BPSK, ModulationType::BFSK, ModulationType::QAM16,
+                                ModulationType::QAM64, ModulationType::QAM256})
+    {
+        m_waveformTables[static_cast<size_t>(type)] = &getWaveformTable(toNetwork(type));
+    }
+    m_ofdm.configure(m_samplesPerBit);
 }
 
 void Modulator::setBinaryInput(const std::string &p_binaryData)
+{
+    if (!m_binaryInput.assignAscii(p_binaryData))
+    {
+        g_serverLogger.error("Binary input contains characters other than '0' and '1'");
+    }
+}
+
+void Modulator::setBinaryInput(const BitStream &p_binaryData)
 {
     m_binaryInput = p_binaryData;
 }
 
+int Modulator::getSampleRate()
+{
+    return m_sampleRate;
+}
+
+void Modulator::setThreadPool(ThreadPool *p_threadPool)
+{
+    m_threadPool = p_threadPool;
+}
+
+void Modulator::setFskDetector(const FskDetector p_detector)
+{
+    m_fskDetector = p_detector;
+}
+
+FskDetector Modulator::getFskDetector()
+{
+    return m_fskDetector;
+}
+
 double Modulator::getCarrierSignalValue(const double &p_amplitudeIndex, const double &p_frequencyIndex, const double &p_time, const double &p_phase)
 {
     double amplitude = p_amplitudeIndex * CARRIER_AMPLITUDE;
@@ -56,326 +121,888 @@ double Modulator::getCarrierSignalValue(const double &p_amplitudeIndex, const do
     return amplitude * cos(2 * M_PI * frequency * p_time + p_phase);
 }
 
-std::vector<double> Modulator::askModulation()
+template <typename Sample>
+void Modulator::correlateWindow(const Sample *p_window, const ReferenceWaveform &p_reference, const uint64_t p_windowPhase,
+                                double &p_inPhase, double &p_quadrature)
 {
-    std::vector<double> signal;
-    double time = 0.0; // Time variable
-    
-    for (size_t bitIdx = 0; bitIdx < m_binaryInput.size(); ++bitIdx)
+    double inPhase = 0.0;
+    double quadrature = 0.0;
+    correlateQuadrature(p_window, p_reference.getInPhase<Sample>(), p_reference.getQuadrature<Sample>(), m_samplesPerBit,
+                        inPhase, quadrature);
+    rotateCorrelation(p_windowPhase, inPhase, quadrature);
+    p_inPhase = inPhase;
+    p_quadrature = quadrature;
+}
+
+template <ModulationType Type>
+void Modulator::modulateScheme(double *p_output)
+{
+    constexpr unsigned int bitsPerSymbol = ModulationScheme<Type>::BITS_PER_SYMBOL;
+    if (m_binaryInput.size() % bitsPerSymbol != 0)
+    {
+        throw std::invalid_argument(stringify("Binary data length must be a multiple of ", bitsPerSymbol, " for ",
+                                              ModulationScheme<Type>::NAME, "."));
+    }
+
+    size_t totalSymbols = m_binaryInput.size() / bitsPerSymbol;
+    const WaveformTable &waveforms = *m_waveformTables[static_cast<size_t>(Type)];
+    // A symbol only depends on its own bits and position, so every range fills its slice independently
+    auto modulateRange = [&](size_t p_begin, size_t p_end)
     {
-        double amplitudeIndex = (m_binaryInput[bitIdx] == '1') ? m_askOneSign : m_askZeroSign;
-        for (size_t sampleIdx = 0; sampleIdx < m_samplesPerBit; ++sampleIdx)
+        for (size_t symbolIdx = p_begin; symbolIdx < p_end; ++symbolIdx)
         {
-            signal.emplace_back(getCarrierSignalValue(amplitudeIndex, DEFAULT_FREQUENCY_INDEX, time, DEFAULT_PHASE));
-            time += m_sampleDuration;
+            // The bits of the symbol, first bit as most significant, index the templates
+            unsigned int symbol = 0;
+            if constexpr (bitsPerSymbol == 1)
+            {
+                symbol = m_binaryInput.get(symbolIdx);
+            }
+            else
+            {
+                symbol = m_binaryInput.getBits(symbolIdx * bitsPerSymbol, bitsPerSymbol);
+            }
+            waveforms.writeSymbol(symbolIdx, symbol, p_output + symbolIdx * m_samplesPerBit);
         }
+    };
+    if (m_threadPool != nullptr && totalSymbols >= PARALLEL_MODULATION_MIN_SYMBOLS)
+    {
+        m_threadPool->parallelFor(totalSymbols, modulateRange);
+    }
+    else
+    {
+        modulateRange(0, totalSymbols);
     }
-    return signal;
 }
 
-std::string Modulator::askDemodulation(const std::vector<double> &p_signal)
+template <ModulationType Type, typename Sample, typename Visitor>
+bool Modulator::correlateWindows(const Sample *p_signal, const size_t p_symbolCount, const size_t p_groupSymbols,
+                                 Visitor p_visit)
 {
-    std::string outputBinary;
-    double threshold = m_askZeroSign;
-    int totalBits = p_signal.size() / m_samplesPerBit;
-    for (size_t bitIdx = 0; bitIdx < totalBits; ++bitIdx)
+    DemodulationReferences references = getDemodulationReferences(Type);
+    std::atomic<bool> isDecided(true);
+    // Every window is correlated on its own, so a range of windows needs nothing from the others
+    auto correlateRange = [&](size_t p_begin, size_t p_end)
     {
-        double accumulator = 0.0;
-        for (size_t sampleIdx = 0; sampleIdx < m_samplesPerBit && (bitIdx * m_samplesPerBit + sampleIdx) < p_signal.size(); ++sampleIdx)
+        Oscillator windowClocks[DEMODULATION_MAX_TONES];
+        for (size_t toneIdx = 0; toneIdx < references.toneCount; ++toneIdx)
         {
-            accumulator += std::abs(p_signal[bitIdx * m_samplesPerBit + sampleIdx]);
+            windowClocks[toneIdx].configure(references.frequency[toneIdx], m_sampleRate);
         }
-        accumulator /= m_samplesPerBit;
-        outputBinary += (accumulator > threshold) ? '1' : '0';
+        GoertzelDetector toneDetector;
+        toneDetector.configure(references.frequency, references.toneCount, m_sampleRate);
+
+        for (size_t symbolIdx = p_begin; symbolIdx < p_end && isDecided.load(std::memory_order_relaxed); ++symbolIdx)
+        {
+            const Sample *window = p_signal + symbolIdx * m_samplesPerBit;
+            WindowCorrelation correlation{};
+            if (references.needsEnvelope)
+            {
+                correlation.absolute = sumAbsolute(window, m_samplesPerBit);
+            }
+            if (references.needsTonePower)
+            {
+                std::complex<double> tones[GOERTZEL_MAX_TONES];
+                toneDetector.correlate(window, m_samplesPerBit, tones);
+                for (size_t toneIdx = 0; toneIdx < references.toneCount; ++toneIdx)
+                {
+                    correlation.power[toneIdx] = std::norm(tones[toneIdx]);
+                }
+            }
+            else
+            {
+                for (size_t toneIdx = 0; toneIdx < references.toneCount; ++toneIdx)
+                {
+                    windowClocks[toneIdx].seek(symbolIdx * m_samplesPerBit);
+                    correlateWindow(window, *references.reference[toneIdx], windowClocks[toneIdx].getPhase(),
+                                    correlation.inPhase[toneIdx], correlation.quadrature[toneIdx]);
+                }
+            }
+
+            if (!p_visit(symbolIdx, correlation))
+            {
+                isDecided = false;
+                return;
+            }
+        }
+    };
+
+    if (m_threadPool != nullptr && p_symbolCount >= PARALLEL_DEMODULATION_MIN_SYMBOLS)
+    {
+        size_t groupCount = (p_symbolCount + p_groupSymbols - 1) / p_groupSymbols;
+        m_threadPool->parallelFor(groupCount, [&](size_t p_begin, size_t p_end)
+                                  { correlateRange(p_begin * p_groupSymbols, std::min(p_end * p_groupSymbols, p_symbolCount)); });
+    }
+    else
+    {
+        correlateRange(0, p_symbolCount);
     }
-    return outputBinary;
+    return isDecided;
 }
 
-std::vector<double> Modulator::pskModulation()
+template <ModulationType Type, typename Sample>
+size_t Modulator::demodulateScheme(const Sample *p_signal, const size_t p_size, BitStream &p_output)
 {
-    std::vector<double> signal;
-    double time = 0.0; // Time variable
-    for (size_t bitIdx = 0; bitIdx < m_binaryInput.size(); ++bitIdx)
+    constexpr unsigned int bitsPerSymbol = ModulationScheme<Type>::BITS_PER_SYMBOL;
+    size_t totalSymbols = p_size / m_samplesPerBit;
+    // The bits of a group of symbols fill whole words, so two threads never write the same word
+    constexpr size_t groupSymbols = std::lcm<size_t>(bitsPerSymbol, BITSTREAM_WORD_BITS) / bitsPerSymbol;
+    // Every window is decided on its own, its bits go to the position given by its index
+    auto decide = [&](size_t p_symbolIdx, const WindowCorrelation &p_correlation)
     {
-        double phase = (m_binaryInput[bitIdx] == '1') ? m_pskOneSign : m_pskZeroSign;
-        for (size_t sampleIdx = 0; sampleIdx < m_samplesPerBit; ++sampleIdx)
+        unsigned int symbol = 0;
+        if (!decideSymbol<Type>(p_correlation, symbol))
         {
-            signal.emplace_back(getCarrierSignalValue(DEFAULT_AMPLITUDE_INDEX, DEFAULT_FREQUENCY_INDEX, time, DEFAULT_PHASE + phase));
-            time += m_sampleDuration;
+            return false;
         }
+        if constexpr (bitsPerSymbol == 1)
+        {
+            p_output.set(p_symbolIdx, symbol);
+        }
+        else
+        {
+            p_output.setBits(p_symbolIdx * bitsPerSymbol, symbol, bitsPerSymbol);
+        }
+        return true;
+    };
+    if (!correlateWindows<Type>(p_signal, totalSymbols, groupSymbols, decide))
+    {
+        return 0;
     }
-    return signal;
+    return totalSymbols * bitsPerSymbol;
 }
 
-std::string Modulator::pskDemodulation(const std::vector<double> &p_signal)
+template <ModulationType Type>
+size_t Modulator::demodulateSoftScheme(const double *p_signal, const size_t p_size, float *p_llr)
 {
-    std::string outputBinary;
-    int totalBits = p_signal.size() / m_samplesPerBit;
-    for (size_t bitIdx = 0; bitIdx < totalBits; ++bitIdx)
+    constexpr unsigned int bitsPerSymbol = ModulationScheme<Type>::BITS_PER_SYMBOL;
+    size_t totalSymbols = p_size / m_samplesPerBit;
+    // Ratios are whole floats, so any window can go to any thread
+    correlateWindows<Type>(p_signal, totalSymbols, 1,
+                           [&](size_t p_symbolIdx, const WindowCorrelation &p_correlation)
+                           {
+                               softDecideSymbol<Type>(p_correlation, p_llr + p_symbolIdx * bitsPerSymbol);
+                               return true;
+                           });
+    return totalSymbols * bitsPerSymbol;
+}
+
+void Modulator::modulateOfdm(double *p_output)
+{
+    if (m_binaryInput.size() % BIT_SIZE_16QAM != 0)
     {
-        // These variables accumulate the correlation between the received signal
-        // and the reference signal for binary '0' and '1', respectively.
-        double correlation0 = 0.0;
-        double correlation1 = 0.0;
-        for (size_t sampleIdx = 0; sampleIdx < m_samplesPerBit && (bitIdx * m_samplesPerBit + sampleIdx) < p_signal.size(); ++sampleIdx)
-        {
-            double time = static_cast<double>(bitIdx * m_samplesPerBit + sampleIdx) / m_sampleRate;
-            double signalValue = p_signal[bitIdx * m_samplesPerBit + sampleIdx];
-            correlation0 += getCarrierSignalValue(signalValue, DEFAULT_FREQUENCY_INDEX, time, DEFAULT_PHASE + m_pskZeroSign);
-            correlation1 += getCarrierSignalValue(signalValue, DEFAULT_FREQUENCY_INDEX, time, DEFAULT_PHASE + m_pskOneSign);
-        }
-        // After calculating the correlations for a chunk, compares correlation0 and correlation1.
-        // If correlation0 is greater, it means the signal is more similar to the reference signal
-        // for '0', so the output bit is '0'. Otherwise, it's '1'.
-        outputBinary += (correlation0 > correlation1) ? '0' : '1';
+        throw std::invalid_argument(stringify("Binary data length must be a multiple of ", BIT_SIZE_16QAM, " for ",
+                                              ModulationScheme<ModulationType::OFDM>::NAME, "."));
     }
-    return outputBinary;
+    m_ofdm.modulate(m_binaryInput, p_output);
 }
 
-std::vector<double> Modulator::fskModulation()
+size_t Modulator::demodulateOfdm(const double *p_signal, const size_t p_size, BitStream &p_output)
 {
-    std::vector<double> signal;
+    return m_ofdm.demodulate(p_signal, p_size, p_output);
+}
 
-    double time = 0.0; // Time variable
-    for (size_t bitIdx = 0; bitIdx < m_binaryInput.size(); ++bitIdx)
+size_t Modulator::demodulateOfdmSoft(const double *p_signal, const size_t p_size, float *p_llr)
+{
+    return m_ofdm.demodulateSoft(p_signal, p_size, p_llr);
+}
+
+bool Modulator::isConfigured(const ModulationType p_type)
+{
+    if (p_type == ModulationType::OFDM)
     {
-        double frequencyIndex = (m_binaryInput[bitIdx] == '1') ? m_fskOneSign : m_fskZeroSign;
-        for (size_t sampleIdx = 0; sampleIdx < m_samplesPerBit; ++sampleIdx)
-        {
-            signal.emplace_back(getCarrierSignalValue(DEFAULT_AMPLITUDE_INDEX, frequencyIndex, time, DEFAULT_PHASE));
-            time += m_sampleDuration;
-        }
+        return m_ofdm.getSymbolSize() != 0;
     }
-    return signal;
+    return m_waveformTables[static_cast<size_t>(p_type)] != nullptr;
+}
+
+bool Modulator::hasBaseband(const ModulationType p_type)
+{
+    return getKernel(p_type).decide != nullptr && isConfigured(p_type);
+}
+
+template <>
+bool Modulator::decideSymbol<ModulationType::ASK>(const WindowCorrelation &p_correlation, unsigned int &p_symbol)
+{
+    double threshold = m_askZeroSign;
+    double accumulator = p_correlation.absolute / m_samplesPerBit;
+    p_symbol = accumulator > threshold;
+    return true;
 }
 
-std::string Modulator::fskDemodulation(const std::vector<double> &p_signal)
+template <>
+bool Modulator::decideSymbol<ModulationType::BPSK>(const WindowCorrelation &p_correlation, unsigned int &p_symbol)
 {
-    std::string outputBinary;
-    int totalBits = p_signal.size() / m_samplesPerBit;
-    for (size_t bitIdx = 0; bitIdx < totalBits; ++bitIdx)
+    // These variables hold the correlation between the received signal
+    // and the reference signal for binary '0' and '1', respectively.
+    double correlation0 = m_pskInPhase[0] * p_correlation.inPhase[0] + m_pskQuadrature[0] * p_correlation.quadrature[0];
+    double correlation1 = m_pskInPhase[1] * p_correlation.inPhase[0] + m_pskQuadrature[1] * p_correlation.quadrature[0];
+    // After calculating the correlations for a chunk, compares correlation0 and correlation1.
+    // If correlation0 is greater, it means the signal is more similar to the reference signal
+    // for '0', so the output bit is '0'. Otherwise, it's '1'.
+    p_symbol = correlation0 <= correlation1;
+    return true;
+}
+
+template <>
+bool Modulator::decideSymbol<ModulationType::BFSK>(const WindowCorrelation &p_correlation, unsigned int &p_symbol)
+{
+    // Tone 0 is the reference signal for binary '0', tone 1 for binary '1'.
+    if (m_fskDetector == FskDetector::GOERTZEL)
     {
-        // These variables accumulate the correlation between the received signal
-        // and the reference signal for binary '0' and '1', respectively.
-        double correlation0 = 0.0;
-        double correlation1 = 0.0;
-        for (size_t sampleIdx = 0; sampleIdx < m_samplesPerBit && (bitIdx * m_samplesPerBit + sampleIdx) < p_signal.size(); ++sampleIdx)
-        {
-            double time = static_cast<double>(bitIdx * m_samplesPerBit + sampleIdx) / m_sampleRate;
-            double signalValue = p_signal[bitIdx * m_samplesPerBit + sampleIdx];
-            correlation0 += getCarrierSignalValue(signalValue, m_fskZeroSign, time, DEFAULT_PHASE);
-            correlation1 += getCarrierSignalValue(signalValue, m_fskOneSign, time, DEFAULT_PHASE);
-        }
-        // After calculating the correlations for a chunk, compares correlation0 and correlation1.
-        // If correlation1 is greater, it means the signal is more similar to the reference signal
-        // for '1', so the output bit is '1'. Otherwise, it's '0'.
-        outputBinary += (correlation1 > correlation0) ? '1' : '0';
+        // The tone carrying the most power is the one sent, whatever its phase
+        p_symbol = p_correlation.power[1] > p_correlation.power[0];
+        return true;
     }
+    // If correlation1 is greater, it means the signal is more similar to the reference signal
+    // for '1', so the output bit is '1'. Otherwise, it's '0'.
+    p_symbol = p_correlation.inPhase[1] > p_correlation.inPhase[0];
+    return true;
+}
 
-    return outputBinary;
+template <ModulationType Type>
+bool Modulator::decideSymbol(const WindowCorrelation &p_correlation, unsigned int &p_symbol)
+{
+    using Constellation = typename ModulationScheme<Type>::Constellation;
+    // Normalize I and Q by the number of samples per symbol
+    double iAvg = p_correlation.inPhase[0] * CARRIER_AMPLITUDE / m_samplesPerBit;
+    double qAvg = p_correlation.quadrature[0] * CARRIER_AMPLITUDE / m_samplesPerBit;
+
+    // Map I and Q to the closest constellation points
+    // During signal generation
+    // The in-phase component I is scaled by cos(2*pi*f_c*t),
+    // and the quadrature component Q is scaled by sin(2*pi*f_c*t).
+    // These scaling factors lead to a factor of 1/2
+    // when you're averaging the received signal to recover I and Q.
+    // When compute the average over the symbol duration
+    // (which is essentially performing an integration over time)
+    // we get a floatValue that is half the magnitude of the original transmitted values for both I and Q.
+    // hence, multiply by 2.
+    double iIndex = iAvg * 2;
+    double qIndex = qAvg * 2;
+    double distance = 0.0;
+    p_symbol = Constellation::slice(iIndex, qIndex, distance);
+    // The bound shrinks with the spacing of the levels, RADIUS_BOUND_16QAM being the bound of 16-QAM
+    constexpr double radiusBound =
+        RADIUS_BOUND_16QAM * Constellation::SPACING / ModulationScheme<ModulationType::QAM16>::Constellation::SPACING;
+    if (distance > radiusBound * radiusBound)
+    {
+        g_serverLogger.error(stringify("Signal in ", ModulationScheme<Type>::NAME, " symbol out of bounds! Distance: ", distance));
+        return false;
+    }
+    return true;
 }
 
-std::complex<double> mapToQAM16Constellation(const int (&bits)[BIT_SIZE_16QAM])
+template <>
+void Modulator::softDecideSymbol<ModulationType::ASK>(const WindowCorrelation &p_correlation, float *p_llr)
 {
+    // The mean of |a * sin| over whole carrier cycles is 2 * |a| / pi, the envelope of each bit on one axis
+    double envelope0 = M_2_PI * m_askZeroSign * CARRIER_AMPLITUDE;
+    double envelope1 = M_2_PI * m_askOneSign * CARRIER_AMPLITUDE;
+    double accumulator = p_correlation.absolute / m_samplesPerBit;
+    // Measured from the threshold of decideSymbol(), so the sign of the ratio is the hard decision
+    p_llr[0] = static_cast<float>(2.0 * (envelope1 - envelope0) * (m_askZeroSign - accumulator));
+}
 
-    int sizeIQ = sizeof(IQ_VALUES) / sizeof(IQ_VALUES[0]);
+template <>
+void Modulator::softDecideSymbol<ModulationType::BPSK>(const WindowCorrelation &p_correlation, float *p_llr)
+{
+    // The correlations of a window are half its samples times the point, and both symbols have the same energy
+    double correlation0 = m_pskInPhase[0] * p_correlation.inPhase[0] + m_pskQuadrature[0] * p_correlation.quadrature[0];
+    double correlation1 = m_pskInPhase[1] * p_correlation.inPhase[0] + m_pskQuadrature[1] * p_correlation.quadrature[0];
+    p_llr[0] = static_cast<float>(2.0 * (correlation0 - correlation1) * 2.0 / m_samplesPerBit);
+}
 
-    // Mapping for I and Q components
+template <>
+void Modulator::softDecideSymbol<ModulationType::BFSK>(const WindowCorrelation &p_correlation, float *p_llr)
+{
+    // The tones are orthogonal, so every symbol is a unit point on its own axis
+    double amplitude0 = 0.0;
+    double amplitude1 = 0.0;
+    if (m_fskDetector == FskDetector::GOERTZEL)
+    {
+        amplitude0 = std::sqrt(p_correlation.power[0]);
+        amplitude1 = std::sqrt(p_correlation.power[1]);
+    }
+    else
+    {
+        amplitude0 = p_correlation.inPhase[0];
+        amplitude1 = p_correlation.inPhase[1];
+    }
+    p_llr[0] = static_cast<float>(2.0 * (amplitude0 - amplitude1) * 2.0 / m_samplesPerBit);
+}
+
+template <ModulationType Type>
+void Modulator::softDecideSymbol(const WindowCorrelation &p_correlation, float *p_llr)
+{
+    using Constellation = typename ModulationScheme<Type>::Constellation;
+    // The point as in decideSymbol(), a window correlates to half its samples times the point
+    double iIndex = p_correlation.inPhase[0] * CARRIER_AMPLITUDE / m_samplesPerBit * 2;
+    double qIndex = p_correlation.quadrature[0] * CARRIER_AMPLITUDE / m_samplesPerBit * 2;
+    Constellation::softSlice(iIndex, qIndex, p_llr);
+}
+
+DemodulationReferences Modulator::getDemodulationReferences(const ModulationType p_type)
+{
+    DemodulationReferences references{};
+    if (p_type == ModulationType::ASK)
+    {
+        references.needsEnvelope = true;
+    }
+    else if (p_type == ModulationType::BPSK || p_type == ModulationType::QAM16 || p_type == ModulationType::QAM64 ||
+             p_type == ModulationType::QAM256)
+    {
+        // Correlate with the in-phase (cosine) and quadrature (cosine delayed by pi/2) carriers
+        references.toneCount = 1;
+        references.frequency[0] = DEFAULT_FREQUENCY_INDEX * m_carrierFrequency;
+    }
+    else if (p_type == ModulationType::BFSK)
+    {
+        references.toneCount = 2;
+        references.frequency[0] = m_fskZeroSign * m_carrierFrequency;
+        references.frequency[1] = m_fskOneSign * m_carrierFrequency;
+        references.needsTonePower = m_fskDetector == FskDetector::GOERTZEL;
+    }
+    for (size_t toneIdx = 0; toneIdx < references.toneCount; ++toneIdx)
+    {
+        references.reference[toneIdx] = &getReferenceWaveform(references.frequency[toneIdx]);
+    }
+    return references;
+}
 
-    double iValues[sizeIQ];
+template <ModulationType Type>
+std::vector<SymbolShape> Modulator::getQamShapes()
+{
+    using Constellation = typename ModulationScheme<Type>::Constellation;
+    std::vector<SymbolShape> shapes;
+    for (unsigned int symbol = 0; symbol < (1u << ModulationScheme<Type>::BITS_PER_SYMBOL); ++symbol)
+    {
+        std::complex<double> point = Constellation::map(symbol);
+        // In-phase (I) component rides on the cosine wave,
+        // quadrature (Q) component on the cosine wave delayed by pi/2, which is the sine wave
+        shapes.push_back({DEFAULT_FREQUENCY_INDEX, DEFAULT_PHASE, point.real() * CARRIER_AMPLITUDE, point.imag() * CARRIER_AMPLITUDE});
+    }
+    return shapes;
+}
 
-    double qValues[sizeIQ];
+std::vector<SymbolShape> Modulator::getSymbolShapes(const std::string &p_networkTypes)
+{
+    double amplitude = DEFAULT_AMPLITUDE_INDEX * CARRIER_AMPLITUDE;
+    if (p_networkTypes == "2G")
+    {
+        return {{DEFAULT_FREQUENCY_INDEX, DEFAULT_PHASE, m_askZeroSign * CARRIER_AMPLITUDE, 0.0},
+                {DEFAULT_FREQUENCY_INDEX, DEFAULT_PHASE, m_askOneSign * CARRIER_AMPLITUDE, 0.0}};
+    }
+    if (p_networkTypes == "3G")
+    {
+        // cos(x + phase) = cos(phase) * cos(x) - sin(phase) * sin(x)
+        return {{DEFAULT_FREQUENCY_INDEX, DEFAULT_PHASE, amplitude * cos(m_pskZeroSign), -amplitude * sin(m_pskZeroSign)},
+                {DEFAULT_FREQUENCY_INDEX, DEFAULT_PHASE, amplitude * cos(m_pskOneSign), -amplitude * sin(m_pskOneSign)}};
+    }
+    if (p_networkTypes == "4G")
+    {
+        return {{m_fskZeroSign, DEFAULT_PHASE, amplitude, 0.0},
+                {m_fskOneSign, DEFAULT_PHASE, amplitude, 0.0}};
+    }
+    if (p_networkTypes == ModulationScheme<ModulationType::QAM16>::NETWORK)
+    {
+        return getQamShapes<ModulationType::QAM16>();
+    }
+    if (p_networkTypes == ModulationScheme<ModulationType::QAM64>::NETWORK)
+    {
+        return getQamShapes<ModulationType::QAM64>();
+    }
+    if (p_networkTypes == ModulationScheme<ModulationType::QAM256>::NETWORK)
+    {
+        return getQamShapes<ModulationType::QAM256>();
+    }
+    return {};
+}
 
-    std::copy(IQ_VALUES, IQ_VALUES + sizeIQ, iValues);
+const WaveformTable &Modulator::getWaveformTable(const std::string &p_networkTypes)
+{
+    WaveformKey key{p_networkTypes, m_carrierFrequency, m_sampleRate};
+    const WaveformTable *waveforms = m_waveformCache.find(key);
+    if (waveforms == nullptr)
+    {
+        waveforms = &m_waveformCache.insert(key, getSymbolShapes(p_networkTypes), m_samplesPerBit);
+    }
+    return *waveforms;
+}
 
-    std::copy(IQ_VALUES, IQ_VALUES + sizeIQ, qValues);
+const ReferenceWaveform &Modulator::getReferenceWaveform(const double p_frequency)
+{
+    std::pair<double, size_t> key(p_frequency, m_samplesPerBit);
+    auto reference = m_referenceCache.find(key);
+    if (reference == m_referenceCache.end())
+    {
+        reference = m_referenceCache.emplace(key, buildReferenceWaveform(p_frequency, m_sampleRate, DEFAULT_PHASE, m_samplesPerBit)).first;
+    }
+    return reference->second;
+}
 
-    // Map 2-bit pair to I and Q values
-    double I = iValues[bits[0] * 2 + bits[1]]; // First two bits map to I
-    double Q = qValues[bits[2] * 2 + bits[3]]; // Last two bits map to Q
+std::string Modulator::randomBinaryMessageGenerator(const int p_length)
+{
+    std::string binaryMessage;
+    srand(time(0));
+    for (int index = 0; index < p_length; index++)
+    {
+        binaryMessage += (rand() % 2 + '0');
+    }
+    return binaryMessage;
+}
 
-    // Return the complex floatValue (I + jQ)
-    return std::complex<double>(I, Q);
+const Modulator::ModulationKernel &Modulator::getKernel(const ModulationType p_type)
+{
+    // Indexed by ModulationType, so binding a scheme is a table lookup instead of string comparisons
+    static const ModulationKernel kernels[MODULATION_TYPE_COUNT] = {
+        {0, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr},
+        getSchemeKernel<ModulationType::ASK>(),
+        getSchemeKernel<ModulationType::BPSK>(),
+        getSchemeKernel<ModulationType::BFSK>(),
+        getSchemeKernel<ModulationType::QAM16>(),
+        // OFDM symbols are transformed as a whole, they have no per-window decision nor streaming
+        {ModulationScheme<ModulationType::OFDM>::BITS_PER_SYMBOL, &Modulator::modulateOfdm, &Modulator::demodulateOfdm,
+         nullptr, nullptr, nullptr, &Modulator::demodulateOfdmSoft, nullptr},
+        getSchemeKernel<ModulationType::QAM64>(),
+        getSchemeKernel<ModulationType::QAM256>(),
+    };
+    return kernels[static_cast<size_t>(p_type)];
 }
 
-std::vector<std::complex<double>> mapBitsToSymbols16QAM(const std::string &p_binaryData)
+template <ModulationType Type>
+constexpr Modulator::ModulationKernel Modulator::getSchemeKernel()
 {
-    std::vector<std::complex<double>> symbols;
+    return {ModulationScheme<Type>::BITS_PER_SYMBOL,
+            &Modulator::modulateScheme<Type>,
+            &Modulator::demodulateScheme<Type, double>,
+            &Modulator::decideSymbol<Type>,
+            &Modulator::demodulateScheme<Type, float>,
+            &Modulator::demodulateScheme<Type, Q15>,
+            &Modulator::demodulateSoftScheme<Type>,
+            &Modulator::softDecideSymbol<Type>};
+}
 
-    if (p_binaryData.size() % BIT_SIZE_16QAM != 0)
+size_t Modulator::getModulatedSize(const ModulationType p_type)
+{
+    if (p_type == ModulationType::OFDM)
     {
-        throw std::invalid_argument("Binary data length must be a multiple of 4 for 16-QAM.");
+        return m_ofdm.getSignalSize(m_binaryInput.size());
     }
+    unsigned int bitsPerSymbol = getKernel(p_type).bitsPerSymbol;
+    return bitsPerSymbol == 0 ? 0 : m_binaryInput.size() / bitsPerSymbol * m_samplesPerBit;
+}
 
-    // Process each group of 4 bits
+size_t Modulator::getModulatedSize(const std::string &p_networkTypes)
+{
+    return getModulatedSize(toModulationType(p_networkTypes));
+}
 
-    for (size_t bitIdx = 0; bitIdx < p_binaryData.size(); bitIdx += BIT_SIZE_16QAM)
+size_t Modulator::modulate(const ModulationType p_type, double *p_output, const size_t p_capacity)
+{
+    const ModulationKernel &kernel = getKernel(p_type);
+    if (kernel.modulate == nullptr)
+    {
+        g_serverLogger.error("Unknown modulation scheme");
+        return 0;
+    }
+    if (!isConfigured(p_type))
+    {
+        g_serverLogger.error("Carrier frequency of the modulator has not been set");
+        return 0;
+    }
+    size_t signalSize = getModulatedSize(p_type);
+    if (signalSize > p_capacity)
     {
-        // Convert from string to int by minus '0'
-        int bits[BIT_SIZE_16QAM] = {p_binaryData[bitIdx] - '0', p_binaryData[bitIdx + 1] - '0',
-                                    p_binaryData[bitIdx + 2] - '0', p_binaryData[bitIdx + 3] - '0'};
+        g_serverLogger.error(stringify("Output buffer too small for modulated signal: ", p_capacity, " < ", signalSize));
+        return 0;
+    }
+    (this->*kernel.modulate)(p_output);
+    return signalSize;
+}
+
+size_t Modulator::modulate(const ModulationType p_type, float *p_output, const size_t p_capacity)
+{
+    return modulateSamples(p_type, p_output, p_capacity);
+}
 
-        symbols.emplace_back(mapToQAM16Constellation(bits));
+size_t Modulator::modulate(const ModulationType p_type, Q15 *p_output, const size_t p_capacity)
+{
+    return modulateSamples(p_type, p_output, p_capacity);
+}
+
+template <typename Sample>
+size_t Modulator::modulateSamples(const ModulationType p_type, Sample *p_output, const size_t p_capacity)
+{
+    // The templates are copied in double, converting once per sample at the edge keeps a single set of templates
+    m_conversionBuffer.resize(getModulatedSize(p_type));
+    if (m_conversionBuffer.size() > p_capacity)
+    {
+        g_serverLogger.error(stringify("Output buffer too small for modulated signal: ", p_capacity, " < ",
+                                       m_conversionBuffer.size()));
+        return 0;
     }
+    size_t signalSize = modulate(p_type, m_conversionBuffer.data(), m_conversionBuffer.size());
+    toSamples(m_conversionBuffer.data(), signalSize, p_output);
+    return signalSize;
+}
+
+size_t Modulator::modulate(const std::string &p_networkTypes, double *p_output, const size_t p_capacity)
+{
+    return modulate(toModulationType(p_networkTypes), p_output, p_capacity);
+}
 
-    return symbols;
+void Modulator::modulate(const ModulationType p_type, std::vector<double> &p_output)
+{
+    // resize() keeps the capacity, so a reused buffer is not reallocated
+    p_output.resize(getModulatedSize(p_type));
+    p_output.resize(modulate(p_type, p_output.data(), p_output.size()));
 }
 
-std::vector<double> Modulator::qam16Modulation()
+void Modulator::modulate(const std::string &p_networkTypes, std::vector<double> &p_output)
 {
-    std::vector<std::complex<double>> symbols = mapBitsToSymbols16QAM(m_binaryInput);
+    modulate(toModulationType(p_networkTypes), p_output);
+}
 
+std::vector<double> Modulator::modulate(const std::string &p_networkTypes)
+{
     std::vector<double> signal;
+    modulate(toModulationType(p_networkTypes), signal);
+    return signal;
+}
 
-    double time = 0.0; // Time variable
-    for (const auto &symbol : symbols)
+StreamingModulator Modulator::openStream(const ModulationType p_type, SampleSink p_sink, const size_t p_blockSize)
+{
+    const WaveformTable *waveforms = m_waveformTables[static_cast<size_t>(p_type)];
+    if (getKernel(p_type).bitsPerSymbol == 0 || waveforms == nullptr)
     {
-        // Generate the signal for the symbol
-        for (int sampleIdx = 0; sampleIdx < m_samplesPerBit; ++sampleIdx)
-        {
-            // In-phase (I) and Quadrature (Q) components of the symbol
-            // Cosine wave for the I component
-            double inPhase = getCarrierSignalValue(symbol.real(), DEFAULT_FREQUENCY_INDEX, time, DEFAULT_PHASE);
-            // Sine wave for the Q component
-            double quadrature = getCarrierSignalValue(symbol.imag(), DEFAULT_FREQUENCY_INDEX, time, DEFAULT_PHASE - M_PI / 2);
+        throw std::invalid_argument("Unknown modulation scheme or carrier frequency not set for streaming modulation.");
+    }
+    StreamingModulator stream(*waveforms, getKernel(p_type).bitsPerSymbol, m_samplesPerBit, std::move(p_sink), p_blockSize);
+    stream.setThreadPool(m_threadPool);
+    return stream;
+}
 
-            signal.emplace_back(inPhase + quadrature);
+StreamingDemodulator Modulator::openDemodulationStream(const ModulationType p_type, BitSink p_sink)
+{
+    const ModulationKernel &kernel = getKernel(p_type);
+    if (kernel.decide == nullptr || m_waveformTables[static_cast<size_t>(p_type)] == nullptr)
+    {
+        throw std::invalid_argument("Unknown modulation scheme or carrier frequency not set for streaming demodulation.");
+    }
+    auto decide = [this, &kernel](const WindowCorrelation &p_correlation, unsigned int &p_symbol)
+    {
+        return (this->*kernel.decide)(p_correlation, p_symbol);
+    };
+    return StreamingDemodulator(getDemodulationReferences(p_type), kernel.bitsPerSymbol, m_samplesPerBit, m_sampleRate,
+                                decide, std::move(p_sink));
+}
 
-            time += m_sampleDuration;
-        }
+size_t Modulator::getDemodulatedSize(const size_t p_signalSize, const ModulationType p_type)
+{
+    if (p_type == ModulationType::OFDM)
+    {
+        return m_ofdm.getMaxBitCount(p_signalSize);
     }
-    return signal;
+    return p_signalSize / m_samplesPerBit * getKernel(p_type).bitsPerSymbol;
 }
 
-// Normalize p_symbol from range (-4, 4) into mapping values (-3, -1, 1, 3)
-double normalizeIQ(double p_symbol)
+size_t Modulator::getDemodulatedSize(const size_t p_signalSize, const std::string &p_networkTypes)
 {
-    p_symbol = static_cast<int>(floor(p_symbol * 2)) * 2 + 1;
-    // Scale IQ_VALUES into {-0.75, -0.25, 0.25, 0.75}
-    p_symbol /= 4.0;
-    return p_symbol;
+    return getDemodulatedSize(p_signalSize, toModulationType(p_networkTypes));
 }
 
-std::string mapSymbolToBits16QAM(double &p_symbol)
+size_t Modulator::demodulate(const double *p_signal, const size_t p_size, const ModulationType p_type,
+                             BitStream &p_output)
 {
-    std::string bits;
-    // For comparing double to double
-    double epsilon = 1e-6;
-    std::string bitArray[] = {"00", "01", "10", "11"};
-    int sizeIQ = sizeof(IQ_VALUES) / sizeof(IQ_VALUES[0]);
+    const ModulationKernel &kernel = getKernel(p_type);
+    if (kernel.demodulate == nullptr)
+    {
+        g_serverLogger.error("Unknown modulation scheme");
+        p_output.clear();
+        return 0;
+    }
+    // resize() keeps the capacity, so a reused stream is not reallocated
+    p_output.resize(getDemodulatedSize(p_size, p_type));
+    size_t binarySize = (this->*kernel.demodulate)(p_signal, p_size, p_output);
+    p_output.resize(binarySize);
+    return binarySize;
+}
 
-    p_symbol = normalizeIQ(p_symbol);
+size_t Modulator::demodulate(const float *p_signal, const size_t p_size, const ModulationType p_type,
+                             BitStream &p_output)
+{
+    return demodulateSamples(p_signal, p_size, p_type, p_output);
+}
 
-    for (int bitIdx = 0; bitIdx < sizeIQ; ++bitIdx)
+size_t Modulator::demodulate(const Q15 *p_signal, const size_t p_size, const ModulationType p_type,
+                             BitStream &p_output)
+{
+    return demodulateSamples(p_signal, p_size, p_type, p_output);
+}
+
+template <typename Sample>
+size_t Modulator::demodulateSamples(const Sample *p_signal, const size_t p_size, const ModulationType p_type,
+                                    BitStream &p_output)
+{
+    const ModulationKernel &kernel = getKernel(p_type);
+    size_t (Modulator::*demodulateFormat)(const Sample *, const size_t, BitStream &) = nullptr;
+    if constexpr (std::is_same_v<Sample, Q15>)
     {
-        if (std::fabs(IQ_VALUES[bitIdx] - p_symbol) < epsilon)
-        {
-            bits = bitArray[bitIdx];
-        }
+        demodulateFormat = kernel.demodulateQ15;
     }
-    if (bits.empty())
+    else
     {
-        g_serverLogger.error("Invalid symbol of 16 QAM!");
+        demodulateFormat = kernel.demodulateFloat;
     }
-    return bits;
+    if (demodulateFormat == nullptr)
+    {
+        // OFDM transforms whole symbols in double
+        m_conversionBuffer.resize(p_size);
+        toAmplitudes(p_signal, p_size, m_conversionBuffer.data());
+        return demodulate(m_conversionBuffer.data(), p_size, p_type, p_output);
+    }
+    p_output.resize(getDemodulatedSize(p_size, p_type));
+    size_t binarySize = (this->*demodulateFormat)(p_signal, p_size, p_output);
+    p_output.resize(binarySize);
+    return binarySize;
+}
+
+size_t Modulator::demodulate(const double *p_signal, const size_t p_size, const std::string &p_networkTypes,
+                             BitStream &p_output)
+{
+    return demodulate(p_signal, p_size, toModulationType(p_networkTypes), p_output);
 }
 
-std::string Modulator::qam16Demodulation(const std::vector<double> &p_signal)
+size_t Modulator::demodulate(const double *p_signal, const size_t p_size, const ModulationType p_type,
+                             char *p_output, const size_t p_capacity)
 {
-    std::string demodulatedBits;
-    int totalBits = p_signal.size() / m_samplesPerBit;
-    for (size_t bitIdx = 0; bitIdx < totalBits; ++bitIdx)
+    size_t binarySize = getDemodulatedSize(p_size, p_type);
+    if (binarySize > p_capacity)
     {
-        double iAvg = 0.0, qAvg = 0.0;
+        g_serverLogger.error(stringify("Output buffer too small for demodulated data: ", p_capacity, " < ", binarySize));
+        return 0;
+    }
+    binarySize = demodulate(p_signal, p_size, p_type, m_demodulatedBits);
+    m_demodulatedBits.toAscii(p_output);
+    return binarySize;
+}
 
-        // Accumulate the in-phase and quadrature components
-        for (size_t sampleIdx = 0; sampleIdx < m_samplesPerBit; ++sampleIdx)
-        {
-            double time = (bitIdx * m_samplesPerBit + sampleIdx) * m_sampleDuration;
-            double signalValue = p_signal[bitIdx * m_samplesPerBit + sampleIdx];
-            iAvg += getCarrierSignalValue(signalValue, DEFAULT_FREQUENCY_INDEX, time, DEFAULT_PHASE);
-            qAvg += getCarrierSignalValue(signalValue, DEFAULT_FREQUENCY_INDEX, time, DEFAULT_PHASE - M_PI / 2);
-        }
+size_t Modulator::demodulate(const double *p_signal, const size_t p_size, const std::string &p_networkTypes,
+                             char *p_output, const size_t p_capacity)
+{
+    return demodulate(p_signal, p_size, toModulationType(p_networkTypes), p_output, p_capacity);
+}
 
-        // Normalize I and Q by the number of samples per symbol
-        iAvg /= m_samplesPerBit;
-        qAvg /= m_samplesPerBit;
-
-        // Map I and Q to the closest constellation points
-        // During signal generation
-        // The in-phase component I is scaled by cos(2*pi*f_c*t),
-        // and the quadrature component Q is scaled by sin(2*pi*f_c*t).
-        // These scaling factors lead to a factor of 1/2
-        // when you're averaging the received signal to recover I and Q.
-        // When compute the average over the symbol duration
-        // (which is essentially performing an integration over time)
-        // we get a floatValue that is half the magnitude of the original transmitted values for both I and Q.
-        // hence, multiply by 2.
-        double iIndex = iAvg * 2;
-        double qIndex = qAvg * 2;
-        double distance = pow(iIndex - normalizeIQ(iIndex), 2) + pow(qIndex - normalizeIQ(qIndex), 2);
-        if (distance > pow(RADIUS_BOUND_16QAM, 2))
-        {
-            g_serverLogger.error(stringify("Signal in 16QAM symbol out of bounds! Distance: ", distance));
-            return "";
-        }
+void Modulator::demodulate(const std::vector<double> &p_signal, const ModulationType p_type, std::string &p_output)
+{
+    demodulate(p_signal.data(), p_signal.size(), p_type, m_demodulatedBits);
+    m_demodulatedBits.toAscii(p_output);
+}
 
-        // Map indices to bits
-        demodulatedBits += mapSymbolToBits16QAM(iIndex);
-        demodulatedBits += mapSymbolToBits16QAM(qIndex);
-    }
-    return demodulatedBits;
+void Modulator::demodulate(const std::vector<double> &p_signal, const std::string &p_networkTypes, std::string &p_output)
+{
+    demodulate(p_signal, toModulationType(p_networkTypes), p_output);
 }
 
-std::string Modulator::randomBinaryMessageGenerator(const int p_length)
+std::string Modulator::demodulate(const std::vector<double> &p_signal, const std::string &p_networkTypes)
 {
-    std::string binaryMessage;
-    srand(time(0));
-    for (int index = 0; index < p_length; index++)
+    std::string binaryData;
+    demodulate(p_signal, p_networkTypes, binaryData);
+    return binaryData;
+}
+
+size_t Modulator::demodulateSoft(const double *p_signal, const size_t p_size, const ModulationType p_type,
+                                 float *p_llr, const size_t p_capacity)
+{
+    const ModulationKernel &kernel = getKernel(p_type);
+    if (kernel.demodulateSoft == nullptr)
     {
-        binaryMessage += (rand() % 2 + '0');
+        g_serverLogger.error("Unknown modulation scheme");
+        return 0;
     }
-    return binaryMessage;
+    size_t llrSize = getDemodulatedSize(p_size, p_type);
+    if (llrSize > p_capacity)
+    {
+        g_serverLogger.error(stringify("Output buffer too small for soft bits: ", p_capacity, " < ", llrSize));
+        return 0;
+    }
+    return (this->*kernel.demodulateSoft)(p_signal, p_size, p_llr);
 }
 
-std::vector<double> Modulator::modulate(const std::string &p_networkTypes)
+size_t Modulator::demodulateSoft(const double *p_signal, const size_t p_size, const ModulationType p_type,
+                                 std::vector<float> &p_llr)
 {
-    if (p_networkTypes == "2G")
+    // resize() keeps the capacity, so a reused vector is not reallocated
+    p_llr.resize(getDemodulatedSize(p_size, p_type));
+    size_t llrSize = demodulateSoft(p_signal, p_size, p_type, p_llr.data(), p_llr.size());
+    p_llr.resize(llrSize);
+    return llrSize;
+}
+
+size_t Modulator::getBasebandSize(const ModulationType p_type)
+{
+    const ModulationKernel &kernel = getKernel(p_type);
+    return kernel.decide == nullptr ? 0 : m_binaryInput.size() / kernel.bitsPerSymbol * BASEBAND_SAMPLES_PER_SYMBOL;
+}
+
+size_t Modulator::modulateBaseband(const ModulationType p_type, std::vector<IqSample> &p_output)
+{
+    if (!hasBaseband(p_type))
     {
-        return askModulation();
+        g_serverLogger.error("Modulation scheme without baseband form or carrier frequency not set");
+        p_output.clear();
+        return 0;
     }
-    if (p_networkTypes == "3G")
+    unsigned int bitsPerSymbol = getKernel(p_type).bitsPerSymbol;
+    if (m_binaryInput.size() % bitsPerSymbol != 0)
     {
-        return pskModulation();
+        throw std::invalid_argument(stringify("Binary data length must be a multiple of ", bitsPerSymbol, " for ",
+                                              toNetwork(p_type), "."));
     }
-    if (p_networkTypes == "4G")
+
+    // The passband symbol a * cos(tone) + b * sin(tone) is Re{x * exp(j * carrier phase)} with
+    // x = (a - jb) * exp(j * (tone phase - carrier phase)), so the point only turns for the tones of FSK
+    const std::vector<SymbolShape> &shapes = m_waveformTables[static_cast<size_t>(p_type)]->getShapes();
+    std::vector<std::complex<double>> points(shapes.size());
+    std::vector<double> toneCycles(shapes.size());
+    for (size_t symbol = 0; symbol < shapes.size(); ++symbol)
     {
-        return fskModulation();
+        const SymbolShape &shape = shapes[symbol];
+        points[symbol] = std::polar(1.0, shape.phase - DEFAULT_PHASE) * std::complex<double>(shape.inPhase, -shape.quadrature);
+        toneCycles[symbol] = (shape.frequencyIndex - DEFAULT_FREQUENCY_INDEX) * m_carrierFrequency * m_samplesPerBit / m_sampleRate;
     }
-    if (p_networkTypes == "5G")
+
+    size_t totalSymbols = m_binaryInput.size() / bitsPerSymbol;
+    p_output.resize(totalSymbols * BASEBAND_SAMPLES_PER_SYMBOL);
+    for (size_t symbolIdx = 0; symbolIdx < totalSymbols; ++symbolIdx)
     {
-        return qam16Modulation();
+        unsigned int symbol = m_binaryInput.getBits(symbolIdx * bitsPerSymbol, bitsPerSymbol);
+        IqSample *window = p_output.data() + symbolIdx * BASEBAND_SAMPLES_PER_SYMBOL;
+        if (toneCycles[symbol] == 0.0)
+        {
+            std::fill(window, window + BASEBAND_SAMPLES_PER_SYMBOL, IqSample(points[symbol]));
+            continue;
+        }
+        for (size_t sampleIdx = 0; sampleIdx < BASEBAND_SAMPLES_PER_SYMBOL; ++sampleIdx)
+        {
+            double cycles = toneCycles[symbol] * (symbolIdx + static_cast<double>(sampleIdx) / BASEBAND_SAMPLES_PER_SYMBOL);
+            window[sampleIdx] = IqSample(points[symbol] * std::polar(1.0, 2 * M_PI * cycles));
+        }
     }
-    return {};
+    return p_output.size();
 }
 
-std::string Modulator::demodulate(const std::vector<double> &p_signal, const std::string &p_networkTypes)
+template <typename Visitor>
+bool Modulator::correlateBaseband(const IqSample *p_signal, const size_t p_size, const ModulationType p_type,
+                                  Visitor p_visit)
 {
-    if (p_networkTypes == "2G")
+    DemodulationReferences references = getDemodulationReferences(p_type);
+    // Every reference tone turns against the carrier by a whole window of its offset, the first window starting at 0
+    IqSample toneWindows[DEMODULATION_MAX_TONES][BASEBAND_SAMPLES_PER_SYMBOL];
+    double toneCycles[DEMODULATION_MAX_TONES];
+    for (size_t toneIdx = 0; toneIdx < references.toneCount; ++toneIdx)
     {
-        return askDemodulation(p_signal);
+        toneCycles[toneIdx] = (references.frequency[toneIdx] - m_carrierFrequency) * m_samplesPerBit / m_sampleRate;
+        for (size_t sampleIdx = 0; sampleIdx < BASEBAND_SAMPLES_PER_SYMBOL; ++sampleIdx)
+        {
+            double cycles = toneCycles[toneIdx] * sampleIdx / BASEBAND_SAMPLES_PER_SYMBOL;
+            toneWindows[toneIdx][sampleIdx] = IqSample(std::polar(1.0, -2 * M_PI * cycles));
+        }
     }
-    if (p_networkTypes == "3G")
+
+    size_t totalSymbols = p_size / BASEBAND_SAMPLES_PER_SYMBOL;
+    // A passband window correlated against the carrier gives half its samples times the point
+    double correlationScale = m_samplesPerBit / 2.0;
+    for (size_t symbolIdx = 0; symbolIdx < totalSymbols; ++symbolIdx)
     {
-        return pskDemodulation(p_signal);
+        const IqSample *window = p_signal + symbolIdx * BASEBAND_SAMPLES_PER_SYMBOL;
+        WindowCorrelation correlation{};
+        if (references.needsEnvelope)
+        {
+            IqSample sum = std::accumulate(window, window + BASEBAND_SAMPLES_PER_SYMBOL, IqSample());
+            // The mean of |a * cos| over whole carrier cycles is 2 * |a| / pi
+            correlation.absolute = m_samplesPerBit * M_2_PI * std::abs(sum) / BASEBAND_SAMPLES_PER_SYMBOL;
+        }
+        for (size_t toneIdx = 0; toneIdx < references.toneCount; ++toneIdx)
+        {
+            IqSample sum;
+            for (size_t sampleIdx = 0; sampleIdx < BASEBAND_SAMPLES_PER_SYMBOL; ++sampleIdx)
+            {
+                sum += window[sampleIdx] * toneWindows[toneIdx][sampleIdx];
+            }
+            std::complex<double> point = std::complex<double>(sum) / static_cast<double>(BASEBAND_SAMPLES_PER_SYMBOL);
+            if (toneCycles[toneIdx] != 0.0)
+            {
+                point *= std::polar(1.0, -2 * M_PI * toneCycles[toneIdx] * symbolIdx);
+            }
+            correlation.inPhase[toneIdx] = correlationScale * point.real();
+            correlation.quadrature[toneIdx] = -correlationScale * point.imag();
+            correlation.power[toneIdx] = correlationScale * correlationScale * std::norm(point);
+        }
+
+        if (!p_visit(symbolIdx, correlation))
+        {
+            return false;
+        }
     }
-    if (p_networkTypes == "4G")
+    return true;
+}
+
+size_t Modulator::demodulateBaseband(const IqSample *p_signal, const size_t p_size, const ModulationType p_type,
+                                     BitStream &p_output)
+{
+    if (!hasBaseband(p_type))
     {
-        return fskDemodulation(p_signal);
+        g_serverLogger.error("Modulation scheme without baseband form or carrier frequency not set");
+        p_output.clear();
+        return 0;
     }
-    if (p_networkTypes == "5G")
+    const ModulationKernel &kernel = getKernel(p_type);
+    p_output.resize(p_size / BASEBAND_SAMPLES_PER_SYMBOL * kernel.bitsPerSymbol);
+    auto decide = [&](size_t p_symbolIdx, const WindowCorrelation &p_correlation)
+    {
+        unsigned int symbol = 0;
+        if (!(this->*kernel.decide)(p_correlation, symbol))
+        {
+            return false;
+        }
+        p_output.setBits(p_symbolIdx * kernel.bitsPerSymbol, symbol, kernel.bitsPerSymbol);
+        return true;
+    };
+    if (!correlateBaseband(p_signal, p_size, p_type, decide))
     {
-        return qam16Demodulation(p_signal);
+        p_output.clear();
+        return 0;
     }
-    return "";
-}
\ No newline at end of file
+    return p_output.size();
+}
+
+size_t Modulator::demodulateBasebandSoft(const IqSample *p_signal, const size_t p_size, const ModulationType p_type,
+                                         std::vector<float> &p_llr)
+{
+    if (!hasBaseband(p_type))
+    {
+        g_serverLogger.error("Modulation scheme without baseband form or carrier frequency not set");
+        p_llr.clear();
+        return 0;
+    }
+    const ModulationKernel &kernel = getKernel(p_type);
+    p_llr.resize(p_size / BASEBAND_SAMPLES_PER_SYMBOL * kernel.bitsPerSymbol);
+    correlateBaseband(p_signal, p_size, p_type,
+                      [&](size_t p_symbolIdx, const WindowCorrelation &p_correlation)
+                      {
+                          (this->*kernel.softDecide)(p_correlation, p_llr.data() + p_symbolIdx * kernel.bitsPerSymbol);
+                          return true;
+                      });
+    return p_llr.size();
+}
+
+Upconverter Modulator::openUpconverter()
+{
+    return Upconverter(m_carrierFrequency, m_sampleRate, DEFAULT_PHASE, m_samplesPerBit);
+}
+
+size_t Modulator::getSamplesPerSymbol()
+{
+    return m_samplesPerBit;
+}
@@ -0,0 +1,375 @@
+#include "noiseGenerator.h"
+#include "simd.h"
+#include <algorithm>
+#include <cmath>
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace
+{
+    /// @brief The start of the tail of the 128 layer ziggurat
+    constexpr double ZIGGURAT_TAIL = 3.442619855899;
+
+    /// @brief The area of every layer of the 128 layer ziggurat
+    constexpr double ZIGGURAT_AREA = 9.91256303526217e-3;
+
+    /// @brief 2^-53, turns the upper 53 bits of a word into a value in [0, 1)
+    constexpr double UNIFORM_STEP = 1.0 / 9007199254740992.0;
+
+    /// @brief 2^-51, turns the upper 52 bits of a word into a value in [0, 2)
+    constexpr double POSITION_STEP = 1.0 / 2251799813685248.0;
+
+    /**
+     * @brief Right edges of the layers and the part of every layer inside the next narrower one
+     *
+     * @param edge - edge[i] is the right edge of layer i, edge[0] the width of the base with the tail area
+     * @param ratio - ratio[i] = edge[i + 1] / edge[i], a point of layer i below it is under the curve
+     */
+    struct ZigguratTable
+    {
+        double edge[NOISE_ZIGGURAT_LAYERS + 1];
+        double ratio[NOISE_ZIGGURAT_LAYERS];
+
+        ZigguratTable()
+        {
+            double density = std::exp(-0.5 * ZIGGURAT_TAIL * ZIGGURAT_TAIL);
+            edge[0] = ZIGGURAT_AREA / density;
+            edge[1] = ZIGGURAT_TAIL;
+            edge[NOISE_ZIGGURAT_LAYERS] = 0.0;
+            for (size_t layerIdx = 2; layerIdx < NOISE_ZIGGURAT_LAYERS; ++layerIdx)
+            {
+                edge[layerIdx] = std::sqrt(-2.0 * std::log(ZIGGURAT_AREA / edge[layerIdx - 1] + density));
+                density = std::exp(-0.5 * edge[layerIdx] * edge[layerIdx]);
+            }
+            for (size_t layerIdx = 0; layerIdx < NOISE_ZIGGURAT_LAYERS; ++layerIdx)
+            {
+                ratio[layerIdx] = edge[layerIdx + 1] / edge[layerIdx];
+            }
+        }
+    };
+
+    const ZigguratTable &getZigguratTable()
+    {
+        static const ZigguratTable table;
+        return table;
+    }
+
+    inline uint64_t rotateLeft(const uint64_t p_value, const int p_shift)
+    {
+        return (p_value << p_shift) | (p_value >> (64 - p_shift));
+    }
+
+    /**
+     * @brief Step of the splitmix64 generator, spreads a seed over the xoshiro states
+     *
+     * @param p_state - state advanced by the step
+     * @return a well mixed word
+     */
+    uint64_t splitMix64(uint64_t &p_state)
+    {
+        uint64_t value = (p_state += 0x9E3779B97F4A7C15ULL);
+        value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+        return value ^ (value >> 31);
+    }
+
+    /**
+     * @brief Get the signed position of a word in its layer
+     *
+     * @param p_bits - a uniform word, its upper 52 bits give the position
+     * @return a value in [-1, 1), the same as the exponent trick of the vector kernels
+     */
+    inline double toPosition(const uint64_t p_bits)
+    {
+        return static_cast<double>(p_bits >> 12) * POSITION_STEP - 1.0;
+    }
+
+    using RefillKernel = void (*)(uint64_t (*)[NOISE_LANES], uint64_t *);
+
+    /// @brief Ziggurat fast path of a block, returns the amount of rejected words written to the last argument
+    using TransformKernel = size_t (*)(const uint64_t *, double *, const ZigguratTable &, uint16_t *);
+
+    size_t transformScalar(const uint64_t *p_block, double *p_samples, const ZigguratTable &p_table, uint16_t *p_rejected)
+    {
+        size_t rejectedCount = 0;
+        for (size_t wordIdx = 0; wordIdx < NOISE_BLOCK_SIZE; ++wordIdx)
+        {
+            // The upper 52 bits give the signed position in the layer, the lower 7 bits the layer
+            size_t layer = p_block[wordIdx] & (NOISE_ZIGGURAT_LAYERS - 1);
+            double position = toPosition(p_block[wordIdx]);
+            p_samples[wordIdx] = position * p_table.edge[layer];
+            if (!(std::fabs(position) < p_table.ratio[layer]))
+            {
+                p_rejected[rejectedCount++] = static_cast<uint16_t>(wordIdx);
+            }
+        }
+        return rejectedCount;
+    }
+
+    void refillScalar(uint64_t (*p_state)[NOISE_LANES], uint64_t *p_block)
+    {
+        for (size_t laneIdx = 0; laneIdx < NOISE_LANES; ++laneIdx)
+        {
+            uint64_t s0 = p_state[0][laneIdx];
+            uint64_t s1 = p_state[1][laneIdx];
+            uint64_t s2 = p_state[2][laneIdx];
+            uint64_t s3 = p_state[3][laneIdx];
+            for (size_t wordIdx = laneIdx; wordIdx < NOISE_BLOCK_SIZE; wordIdx += NOISE_LANES)
+            {
+                p_block[wordIdx] = rotateLeft(s0 + s3, 23) + s0;
+                uint64_t shifted = s1 << 17;
+                s2 ^= s0;
+                s3 ^= s1;
+                s1 ^= s2;
+                s0 ^= s3;
+                s2 ^= shifted;
+                s3 = rotateLeft(s3, 45);
+            }
+            p_state[0][laneIdx] = s0;
+            p_state[1][laneIdx] = s1;
+            p_state[2][laneIdx] = s2;
+            p_state[3][laneIdx] = s3;
+        }
+    }
+
+#if defined(__x86_64__)
+    template <int Shift>
+    inline __m128i rotateLeft(__m128i p_value)
+    {
+        return _mm_or_si128(_mm_slli_epi64(p_value, Shift), _mm_srli_epi64(p_value, 64 - Shift));
+    }
+
+    void refillSse2(uint64_t (*p_state)[NOISE_LANES], uint64_t *p_block)
+    {
+        // Two vectors of 2 lanes cover the 4 lanes
+        for (size_t halfIdx = 0; halfIdx < NOISE_LANES; halfIdx += 2)
+        {
+            __m128i s0 = _mm_load_si128(reinterpret_cast<const __m128i *>(&p_state[0][halfIdx]));
+            __m128i s1 = _mm_load_si128(reinterpret_cast<const __m128i *>(&p_state[1][halfIdx]));
+            __m128i s2 = _mm_load_si128(reinterpret_cast<const __m128i *>(&p_state[2][halfIdx]));
+            __m128i s3 = _mm_load_si128(reinterpret_cast<const __m128i *>(&p_state[3][halfIdx]));
+            for (size_t wordIdx = halfIdx; wordIdx < NOISE_BLOCK_SIZE; wordIdx += NOISE_LANES)
+            {
+                __m128i result = _mm_add_epi64(rotateLeft<23>(_mm_add_epi64(s0, s3)), s0);
+                _mm_store_si128(reinterpret_cast<__m128i *>(p_block + wordIdx), result);
+                __m128i shifted = _mm_slli_epi64(s1, 17);
+                s2 = _mm_xor_si128(s2, s0);
+                s3 = _mm_xor_si128(s3, s1);
+                s1 = _mm_xor_si128(s1, s2);
+                s0 = _mm_xor_si128(s0, s3);
+                s2 = _mm_xor_si128(s2, shifted);
+                s3 = rotateLeft<45>(s3);
+            }
+            _mm_store_si128(reinterpret_cast<__m128i *>(&p_state[0][halfIdx]), s0);
+            _mm_store_si128(reinterpret_cast<__m128i *>(&p_state[1][halfIdx]), s1);
+            _mm_store_si128(reinterpret_cast<__m128i *>(&p_state[2][halfIdx]), s2);
+            _mm_store_si128(reinterpret_cast<__m128i *>(&p_state[3][halfIdx]), s3);
+        }
+    }
+
+    template <int Shift>
+    __attribute__((target("avx2"))) inline __m256i rotateLeft(__m256i p_value)
+    {
+        return _mm256_or_si256(_mm256_slli_epi64(p_value, Shift), _mm256_srli_epi64(p_value, 64 - Shift));
+    }
+
+    __attribute__((target("avx2"))) void refillAvx2(uint64_t (*p_state)[NOISE_LANES], uint64_t *p_block)
+    {
+        __m256i s0 = _mm256_load_si256(reinterpret_cast<const __m256i *>(p_state[0]));
+        __m256i s1 = _mm256_load_si256(reinterpret_cast<const __m256i *>(p_state[1]));
+        __m256i s2 = _mm256_load_si256(reinterpret_cast<const __m256i *>(p_state[2]));
+        __m256i s3 = _mm256_load_si256(reinterpret_cast<const __m256i *>(p_state[3]));
+        for (size_t wordIdx = 0; wordIdx < NOISE_BLOCK_SIZE; wordIdx += NOISE_LANES)
+        {
+            __m256i result = _mm256_add_epi64(rotateLeft<23>(_mm256_add_epi64(s0, s3)), s0);
+            _mm256_store_si256(reinterpret_cast<__m256i *>(p_block + wordIdx), result);
+            __m256i shifted = _mm256_slli_epi64(s1, 17);
+            s2 = _mm256_xor_si256(s2, s0);
+            s3 = _mm256_xor_si256(s3, s1);
+            s1 = _mm256_xor_si256(s1, s2);
+            s0 = _mm256_xor_si256(s0, s3);
+            s2 = _mm256_xor_si256(s2, shifted);
+            s3 = rotateLeft<45>(s3);
+        }
+        _mm256_store_si256(reinterpret_cast<__m256i *>(p_state[0]), s0);
+        _mm256_store_si256(reinterpret_cast<__m256i *>(p_state[1]), s1);
+        _mm256_store_si256(reinterpret_cast<__m256i *>(p_state[2]), s2);
+        _mm256_store_si256(reinterpret_cast<__m256i *>(p_state[3]), s3);
+    }
+
+    __attribute__((target("avx2"))) size_t transformAvx2(const uint64_t *p_block, double *p_samples,
+                                                         const ZigguratTable &p_table, uint16_t *p_rejected)
+    {
+        // The upper 52 bits under the exponent of 1.0 give a value in [1, 2), so 2 * value - 3 is the position
+        const __m256i layerMask = _mm256_set1_epi64x(NOISE_ZIGGURAT_LAYERS - 1);
+        const __m256i one = _mm256_set1_epi64x(0x3FF0000000000000LL);
+        const __m256d three = _mm256_set1_pd(3.0);
+        const __m256d absMask = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7FFFFFFFFFFFFFFFLL));
+        size_t rejectedCount = 0;
+        for (size_t wordIdx = 0; wordIdx < NOISE_BLOCK_SIZE; wordIdx += 4)
+        {
+            __m256i bits = _mm256_load_si256(reinterpret_cast<const __m256i *>(p_block + wordIdx));
+            __m256i layer = _mm256_and_si256(bits, layerMask);
+            __m256d value = _mm256_castsi256_pd(_mm256_or_si256(_mm256_srli_epi64(bits, 12), one));
+            __m256d position = _mm256_sub_pd(_mm256_add_pd(value, value), three);
+            __m256d edge = _mm256_i64gather_pd(p_table.edge, layer, 8);
+            __m256d ratio = _mm256_i64gather_pd(p_table.ratio, layer, 8);
+            _mm256_store_pd(p_samples + wordIdx, _mm256_mul_pd(position, edge));
+            int accepted = _mm256_movemask_pd(_mm256_cmp_pd(_mm256_and_pd(position, absMask), ratio, _CMP_LT_OQ));
+            if (accepted != 0xF)
+            {
+                for (size_t laneIdx = 0; laneIdx < 4; ++laneIdx)
+                {
+                    if (!(accepted & (1 << laneIdx)))
+                    {
+                        p_rejected[rejectedCount++] = static_cast<uint16_t>(wordIdx + laneIdx);
+                    }
+                }
+            }
+        }
+        return rejectedCount;
+    }
+#endif
+
+    /// @brief The kernels of one instruction set level
+    struct KernelTable
+    {
+        RefillKernel refill;
+        TransformKernel transform;
+    };
+
+    /// @brief The kernels indexed by SimdLevel, falling back to the closest lower level
+    const KernelTable KERNEL_TABLES[] = {
+        {refillScalar, transformScalar},
+#if defined(__x86_64__)
+        // SSE2 has no gather, the table lookups of the transform stay scalar
+        {refillSse2, transformScalar},
+        {refillAvx2, transformAvx2},
+#else
+        {refillScalar, transformScalar},
+        {refillScalar, transformScalar},
+#endif
+    };
+}
+
+NoiseGenerator::NoiseGenerator(const uint64_t p_seed, const uint64_t p_stream)
+{
+    seed(p_seed, p_stream);
+}
+
+void NoiseGenerator::seed(const uint64_t p_seed, const uint64_t p_stream)
+{
+    // Every stream starts its own splitmix64 sequence, which spreads to the lanes
+    uint64_t mixer = p_seed;
+    uint64_t streamKey = p_stream;
+    mixer ^= splitMix64(streamKey);
+    for (size_t laneIdx = 0; laneIdx < NOISE_LANES; ++laneIdx)
+    {
+        for (size_t wordIdx = 0; wordIdx < 4; ++wordIdx)
+        {
+            m_state[wordIdx][laneIdx] = splitMix64(mixer);
+        }
+    }
+    for (size_t wordIdx = 0; wordIdx < 4; ++wordIdx)
+    {
+        m_slowState[wordIdx] = splitMix64(mixer);
+    }
+    m_position = NOISE_BLOCK_SIZE;
+}
+
+void NoiseGenerator::refill()
+{
+    const KernelTable &kernels = KERNEL_TABLES[static_cast<int>(getSimdLevel())];
+    const ZigguratTable &table = getZigguratTable();
+    uint16_t rejected[NOISE_BLOCK_SIZE];
+    kernels.refill(m_state, m_block);
+    size_t rejectedCount = kernels.transform(m_block, m_samples, table, rejected);
+    // In the order of the block, so the slow path draws the same words on every instruction set
+    for (size_t rejectedIdx = 0; rejectedIdx < rejectedCount; ++rejectedIdx)
+    {
+        m_samples[rejected[rejectedIdx]] = sampleSlow(m_block[rejected[rejectedIdx]]);
+    }
+    m_position = 0;
+}
+
+void NoiseGenerator::fill(double *p_output, const size_t p_size, const double p_deviation)
+{
+    size_t written = 0;
+    while (written < p_size)
+    {
+        if (m_position == NOISE_BLOCK_SIZE)
+        {
+            refill();
+        }
+        size_t count = std::min(p_size - written, NOISE_BLOCK_SIZE - m_position);
+        const double *samples = m_samples + m_position;
+        for (size_t sampleIdx = 0; sampleIdx < count; ++sampleIdx)
+        {
+            p_output[written + sampleIdx] = samples[sampleIdx] * p_deviation;
+        }
+        written += count;
+        m_position += count;
+    }
+}
+
+double NoiseGenerator::next()
+{
+    double sample = 0.0;
+    fill(&sample, 1, 1.0);
+    return sample;
+}
+
+uint64_t NoiseGenerator::nextSlowUniform()
+{
+    uint64_t *state = m_slowState;
+    uint64_t result = rotateLeft(state[0] + state[3], 23) + state[0];
+    uint64_t shifted = state[1] << 17;
+    state[2] ^= state[0];
+    state[3] ^= state[1];
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+    state[2] ^= shifted;
+    state[3] = rotateLeft(state[3], 45);
+    return result;
+}
+
+double NoiseGenerator::nextOpenUniform()
+{
+    return (static_cast<double>(nextSlowUniform() >> 11) + 0.5) * UNIFORM_STEP;
+}
+
+double NoiseGenerator::sampleSlow(uint64_t p_bits)
+{
+    const ZigguratTable &table = getZigguratTable();
+    while (true)
+    {
+        size_t layer = p_bits & (NOISE_ZIGGURAT_LAYERS - 1);
+        double position = toPosition(p_bits);
+        if (std::fabs(position) < table.ratio[layer])
+        {
+            return position * table.edge[layer];
+        }
+        if (layer == 0)
+        {
+            // Sample the tail past ZIGGURAT_TAIL (Marsaglia)
+            double offset = 0.0;
+            double height = 0.0;
+            do
+            {
+                offset = std::log(nextOpenUniform()) / ZIGGURAT_TAIL;
+                height = std::log(nextOpenUniform());
+            } while (-2.0 * height < offset * offset);
+            return position < 0.0 ? offset - ZIGGURAT_TAIL : ZIGGURAT_TAIL - offset;
+        }
+        // Keep the point of the wedge between the layer and the next one if it is under the curve
+        double value = position * table.edge[layer];
+        double outer = std::exp(-0.5 * (table.edge[layer] * table.edge[layer] - value * value));
+        double inner = std::exp(-0.5 * (table.edge[layer + 1] * table.edge[layer + 1] - value * value));
+        if (inner + nextOpenUniform() * (outer - inner) < 1.0)
+        {
+            return value;
+        }
+        p_bits = nextSlowUniform();
+    }
+}
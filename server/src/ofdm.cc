@@ -0,0 +1,196 @@
+#include "ofdm.h"
+#include <algorithm>
+
+namespace
+{
+    /// @brief Amplitude of one subcarrier, keeps the RMS of a full symbol close to that of a single carrier
+    const double SUBCARRIER_GAIN = 1.0 / std::sqrt(static_cast<double>(OFDM_SUBCARRIERS));
+
+    /// @brief The 16-QAM points carried by the subcarriers
+    using SubcarrierConstellation = ModulationScheme<ModulationType::QAM16>::Constellation;
+}
+
+OfdmModem::OfdmModem() : m_fftSize(0), m_prefixSize(0)
+{
+}
+
+bool OfdmModem::configure(const size_t p_fftSize)
+{
+    // Bins 1 to OFDM_SUBCARRIERS and their mirrors must not meet at N / 2
+    if (p_fftSize <= 2 * OFDM_SUBCARRIERS)
+    {
+        m_fftSize = 0;
+        m_prefixSize = 0;
+        return false;
+    }
+    m_fftSize = p_fftSize;
+    m_prefixSize = p_fftSize / OFDM_CYCLIC_PREFIX_DIVISOR;
+    m_trainingPoints.resize(OFDM_SUBCARRIERS);
+    for (size_t carrierIdx = 0; carrierIdx < OFDM_SUBCARRIERS; ++carrierIdx)
+    {
+        // Magnitude of the largest 16-QAM point, quadratic phase
+        double phase = M_PI * carrierIdx * carrierIdx / OFDM_SUBCARRIERS;
+        m_trainingPoints[carrierIdx] = std::polar(IQ_VALUES[3] * M_SQRT2, phase);
+    }
+    m_channel.assign(OFDM_SUBCARRIERS, std::complex<double>(1.0, 0.0));
+    m_bins.resize(m_fftSize);
+    m_samples.resize(m_fftSize);
+    return true;
+}
+
+size_t OfdmModem::getSymbolSize() const
+{
+    return m_fftSize + m_prefixSize;
+}
+
+size_t OfdmModem::getSignalSize(const size_t p_bitCount) const
+{
+    if (m_fftSize == 0 || p_bitCount == 0)
+    {
+        return 0;
+    }
+    size_t dataSymbols = (p_bitCount + OFDM_BITS_PER_SYMBOL - 1) / OFDM_BITS_PER_SYMBOL;
+    return (1 + dataSymbols) * getSymbolSize();
+}
+
+size_t OfdmModem::getMaxBitCount(const size_t p_signalSize) const
+{
+    if (m_fftSize == 0 || p_signalSize < 2 * getSymbolSize())
+    {
+        return 0;
+    }
+    return (p_signalSize / getSymbolSize() - 1) * OFDM_BITS_PER_SYMBOL;
+}
+
+void OfdmModem::writeSymbol(const std::complex<double> *p_points, double *p_output)
+{
+    // x[n] = g * Re(sum(X[k] * exp(2*pi*i*k*n/N))) is half the forward transform of conj(X[k]) at k and X[k] at N - k
+    std::fill(m_bins.begin(), m_bins.end(), std::complex<double>(0.0, 0.0));
+    for (size_t carrierIdx = 0; carrierIdx < OFDM_SUBCARRIERS; ++carrierIdx)
+    {
+        size_t bin = carrierIdx + 1;
+        m_bins[bin] = std::conj(p_points[carrierIdx]);
+        m_bins[m_fftSize - bin] = p_points[carrierIdx];
+    }
+    getFftPlan(m_fftSize).transform(m_bins.data(), m_samples.data());
+    double *body = p_output + m_prefixSize;
+    for (size_t sampleIdx = 0; sampleIdx < m_fftSize; ++sampleIdx)
+    {
+        body[sampleIdx] = SUBCARRIER_GAIN * 0.5 * m_samples[sampleIdx].real();
+    }
+    // The cyclic prefix repeats the end of the symbol, so a short channel memory stays inside the symbol
+    std::copy(body + m_fftSize - m_prefixSize, body + m_fftSize, p_output);
+}
+
+const std::complex<double> *OfdmModem::readSymbol(const double *p_symbol)
+{
+    getRealFftPlan(m_fftSize).transform(p_symbol + m_prefixSize, m_bins.data(), m_scratch);
+    return m_bins.data() + 1;
+}
+
+void OfdmModem::modulate(const BitStream &p_bits, double *p_output)
+{
+    if (m_fftSize == 0)
+    {
+        return;
+    }
+    writeSymbol(m_trainingPoints.data(), p_output);
+    std::complex<double> points[OFDM_SUBCARRIERS];
+    size_t pointCount = p_bits.size() / BIT_SIZE_16QAM;
+    for (size_t firstPoint = 0; firstPoint < pointCount; firstPoint += OFDM_SUBCARRIERS)
+    {
+        for (size_t carrierIdx = 0; carrierIdx < OFDM_SUBCARRIERS; ++carrierIdx)
+        {
+            size_t pointIdx = firstPoint + carrierIdx;
+            if (pointIdx >= pointCount)
+            {
+                points[carrierIdx] = 0.0;
+                continue;
+            }
+            points[carrierIdx] = SubcarrierConstellation::map(p_bits.getBits(pointIdx * BIT_SIZE_16QAM, BIT_SIZE_16QAM));
+        }
+        p_output += getSymbolSize();
+        writeSymbol(points, p_output);
+    }
+}
+
+void OfdmModem::estimateChannel(const double *p_signal)
+{
+    // The training symbol gives gain and phase of every subcarrier, including the receive filter
+    const std::complex<double> *training = readSymbol(p_signal);
+    for (size_t carrierIdx = 0; carrierIdx < OFDM_SUBCARRIERS; ++carrierIdx)
+    {
+        m_channel[carrierIdx] = training[carrierIdx] / m_trainingPoints[carrierIdx];
+    }
+}
+
+size_t OfdmModem::demodulate(const double *p_signal, const size_t p_size, BitStream &p_output)
+{
+    size_t dataSymbols = getMaxBitCount(p_size) / OFDM_BITS_PER_SYMBOL;
+    if (dataSymbols == 0)
+    {
+        return 0;
+    }
+    estimateChannel(p_signal);
+
+    size_t bitCount = 0;
+    for (size_t symbolIdx = 0; symbolIdx < dataSymbols; ++symbolIdx)
+    {
+        const std::complex<double> *received = readSymbol(p_signal + (symbolIdx + 1) * getSymbolSize());
+        bool isLastSymbol = symbolIdx + 1 == dataSymbols;
+        for (size_t carrierIdx = 0; carrierIdx < OFDM_SUBCARRIERS; ++carrierIdx)
+        {
+            std::complex<double> point = received[carrierIdx] / m_channel[carrierIdx];
+            // Only the last symbol has empty subcarriers, after the end of the payload
+            if (isLastSymbol && std::abs(point) < OFDM_EMPTY_SUBCARRIER_LEVEL)
+            {
+                break;
+            }
+            double distance = 0.0;
+            p_output.setBits(bitCount, SubcarrierConstellation::slice(point.real(), point.imag(), distance), BIT_SIZE_16QAM);
+            bitCount += BIT_SIZE_16QAM;
+        }
+    }
+    return bitCount;
+}
+
+size_t OfdmModem::demodulateSoft(const double *p_signal, const size_t p_size, float *p_llr)
+{
+    size_t dataSymbols = getMaxBitCount(p_size) / OFDM_BITS_PER_SYMBOL;
+    if (dataSymbols == 0)
+    {
+        return 0;
+    }
+    estimateChannel(p_signal);
+    double meanGain = 0.0;
+    for (size_t carrierIdx = 0; carrierIdx < OFDM_SUBCARRIERS; ++carrierIdx)
+    {
+        meanGain += std::norm(m_channel[carrierIdx]);
+    }
+    meanGain /= OFDM_SUBCARRIERS;
+
+    size_t llrCount = 0;
+    for (size_t symbolIdx = 0; symbolIdx < dataSymbols; ++symbolIdx)
+    {
+        const std::complex<double> *received = readSymbol(p_signal + (symbolIdx + 1) * getSymbolSize());
+        bool isLastSymbol = symbolIdx + 1 == dataSymbols;
+        for (size_t carrierIdx = 0; carrierIdx < OFDM_SUBCARRIERS; ++carrierIdx)
+        {
+            std::complex<double> point = received[carrierIdx] / m_channel[carrierIdx];
+            if (isLastSymbol && std::abs(point) < OFDM_EMPTY_SUBCARRIER_LEVEL)
+            {
+                break;
+            }
+            float *llr = p_llr + llrCount;
+            SubcarrierConstellation::softSlice(point.real(), point.imag(), llr);
+            // The equalizer divides the noise by the gain of the subcarrier, as it divides the point
+            float weight = static_cast<float>(std::norm(m_channel[carrierIdx]) / meanGain);
+            for (size_t bitIdx = 0; bitIdx < BIT_SIZE_16QAM; ++bitIdx)
+            {
+                llr[bitIdx] *= weight;
+            }
+            llrCount += BIT_SIZE_16QAM;
+        }
+    }
+    return llrCount;
+}
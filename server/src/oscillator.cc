@@ -0,0 +1,125 @@
+#include "oscillator.h"
+#include <array>
+#include <cmath>
+
+namespace
+{
+    /// @brief The cosine table has one guard entry so interpolation never wraps the index
+    using CosineTable = std::array<double, OSCILLATOR_TABLE_SIZE + 1>;
+
+    const CosineTable &getCosineTable()
+    {
+        static const CosineTable table = []()
+        {
+            CosineTable values{};
+            for (size_t index = 0; index <= OSCILLATOR_TABLE_SIZE; ++index)
+            {
+                values[index] = std::cos(2 * M_PI * index / OSCILLATOR_TABLE_SIZE);
+            }
+            return values;
+        }();
+        return table;
+    }
+
+    /// @brief The weight of one fraction bit, 2^-32
+    constexpr double FRACTION_SCALE = 1.0 / static_cast<double>(static_cast<uint64_t>(1) << OSCILLATOR_FRACTION_BITS);
+
+    inline double interpolateCosine(const double *p_table, const uint64_t p_phase)
+    {
+        size_t index = p_phase >> (64 - OSCILLATOR_TABLE_BITS);
+        uint64_t fractionBits = (p_phase >> (64 - OSCILLATOR_TABLE_BITS - OSCILLATOR_FRACTION_BITS)) &
+                                ((static_cast<uint64_t>(1) << OSCILLATOR_FRACTION_BITS) - 1);
+        double fraction = static_cast<double>(fractionBits) * FRACTION_SCALE;
+        return p_table[index] + fraction * (p_table[index + 1] - p_table[index]);
+    }
+}
+
+Oscillator::Oscillator() : m_phase(0), m_phaseIncrement(0), m_initialPhase(0)
+{
+}
+
+Oscillator::Oscillator(const double p_frequency, const double p_sampleRate, const double p_phase)
+{
+    configure(p_frequency, p_sampleRate, p_phase);
+}
+
+void Oscillator::configure(const double p_frequency, const double p_sampleRate, const double p_phase)
+{
+    m_phaseIncrement = toPhase(2 * M_PI * p_frequency / p_sampleRate);
+    m_initialPhase = toPhase(p_phase);
+    m_phase = m_initialPhase;
+}
+
+void Oscillator::seek(const uint64_t p_sampleIndex)
+{
+    // Unsigned arithmetic wraps modulo 2^64, which is exactly one cycle of phase
+    m_phase = m_initialPhase + p_sampleIndex * m_phaseIncrement;
+}
+
+double Oscillator::next()
+{
+    double value = cosine(m_phase);
+    m_phase += m_phaseIncrement;
+    return value;
+}
+
+void Oscillator::nextQuadrature(double &p_inPhase, double &p_quadrature)
+{
+    p_inPhase = cosine(m_phase);
+    p_quadrature = sine(m_phase);
+    m_phase += m_phaseIncrement;
+}
+
+void Oscillator::generate(double *p_output, const size_t p_count, const double p_inPhaseAmplitude,
+                          const double p_quadratureAmplitude)
+{
+    const double *table = getCosineTable().data();
+    uint64_t phase = m_phase;
+    if (p_quadratureAmplitude == 0.0)
+    {
+        for (size_t sampleIdx = 0; sampleIdx < p_count; ++sampleIdx)
+        {
+            p_output[sampleIdx] = p_inPhaseAmplitude * interpolateCosine(table, phase);
+            phase += m_phaseIncrement;
+        }
+    }
+    else
+    {
+        for (size_t sampleIdx = 0; sampleIdx < p_count; ++sampleIdx)
+        {
+            p_output[sampleIdx] = p_inPhaseAmplitude * interpolateCosine(table, phase) +
+                                  p_quadratureAmplitude * interpolateCosine(table, phase - OSCILLATOR_QUARTER_CYCLE);
+            phase += m_phaseIncrement;
+        }
+    }
+    m_phase = phase;
+}
+
+uint64_t Oscillator::getPhase() const
+{
+    return m_phase;
+}
+
+uint64_t Oscillator::toPhase(const double p_radians)
+{
+    double cycles = p_radians / (2 * M_PI);
+    cycles -= std::floor(cycles);
+    double scaled = std::ldexp(cycles, 64);
+    // A fraction that rounds up to a full cycle is the same phase as 0
+    if (scaled >= std::ldexp(1.0, 64))
+    {
+        return 0;
+    }
+    return static_cast<uint64_t>(scaled);
+}
+
+double Oscillator::cosine(const uint64_t p_phase)
+{
+    return interpolateCosine(getCosineTable().data(), p_phase);
+}
+
+double Oscillator::sine(const uint64_t p_phase)
+{
+    // sin(x) = cos(x - pi/2)
+    return cosine(p_phase - OSCILLATOR_QUARTER_CYCLE);
+}
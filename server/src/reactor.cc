@@ -0,0 +1,463 @@
+#include "reactor.h"
+#include "serverCommon.h"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+int setSocketNonblocking(const int p_sockFD)
+{
+    // fcntl - manipulate file descriptor
+    // If successful, the value returned will depend on the action that was specified.
+    // If unsuccessful, returns a value of -1
+
+    int flags = fcntl(p_sockFD, F_GETFL);
+    if (flags == -1)
+    {
+        g_serverLogger.error("fcntl: " + std::string(strerror(errno)));
+        return -1;
+    }
+    flags |= O_NONBLOCK;
+    if (fcntl(p_sockFD, F_SETFL, flags) == -1)
+    {
+        g_serverLogger.error("fcntl: " + std::string(strerror(errno)));
+        return -1;
+    }
+    return 0;
+}
+
+Reactor::Reactor(const size_t p_index, const size_t p_outputHighWater, const RequestHandler &p_handler)
+    : m_index(p_index), m_outputHighWater(p_outputHighWater), m_handler(p_handler), m_listenSocket(-1),
+      m_epollFd(-1), m_connectionCount(0), m_nextConnectionId(0), m_wakeFd(-1)
+{
+}
+
+Reactor::~Reactor()
+{
+    for (auto &connection : m_connections)
+    {
+        close(connection.first);
+    }
+    if (m_listenSocket != -1)
+    {
+        close(m_listenSocket);
+    }
+    if (m_epollFd != -1)
+    {
+        close(m_epollFd);
+    }
+    if (m_wakeFd != -1)
+    {
+        close(m_wakeFd);
+    }
+}
+
+bool Reactor::listen(const char *p_address, const uint16_t p_port)
+{
+    // Create socket
+    // int socket(int domain, int type, int protocol)
+    // The protocol specifies a particular protocol to be used with the socket.
+    // If PROTOCOL is zero, one is chosen automatically.
+    // Returns a file descriptor for the new socket, or -1 for errors.
+    m_listenSocket = socket(AF_INET, SOCK_STREAM, 0);
+    if (m_listenSocket == -1)
+    {
+        g_serverLogger.error("Failed to create socket.");
+        return false;
+    }
+
+    if (setSocketNonblocking(m_listenSocket) == -1)
+    {
+        g_serverLogger.error("Failed to set non-blocking mode for server.");
+        return false;
+    }
+
+    // A pointer to the buffer in which the value for the requested option is specified.
+    int optval = 1;
+
+    // SO_REUSEADDR
+    // Specifies that the rules used in validating addresses
+    // supplied to bind() should allow reuse of local addresses, if this is supported by the protocol.
+    // Without SO_REUSEADDR, the bind() call in the restarted program's new instance will fail
+    // if there were connections open to the previous instance and even after getting killed (30s~120s)
+    setsockopt(m_listenSocket, SOL_SOCKET, SO_REUSEADDR, &optval, sizeof(optval));
+
+    // SO_REUSEPORT
+    // Every reactor binds its own listener to the same port, the kernel hashes every new connection
+    // to one of them, so the reactors never contend on a shared accept queue.
+    if (setsockopt(m_listenSocket, SOL_SOCKET, SO_REUSEPORT, &optval, sizeof(optval)) == -1)
+    {
+        g_serverLogger.error("setsockopt SO_REUSEPORT: " + std::string(strerror(errno)));
+        return false;
+    }
+
+    // Bind socket to port
+    struct sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = inet_addr(p_address);
+    address.sin_port = htons(p_port);
+
+    // On success, 0 is returned.  On error, -1 is returned.
+    if (bind(m_listenSocket, (struct sockaddr *)&address, sizeof(address)) == -1)
+    {
+        g_serverLogger.error("Bind failed: " + std::string(strerror(errno)));
+        return false;
+    }
+
+    // Listen for incoming connections
+    // Returns 0 on success, -1 for errors.
+    if (::listen(m_listenSocket, MAX_CONNECTION_REQUEST) == -1)
+    {
+        g_serverLogger.error("Listen failed: " + std::string(strerror(errno)));
+        return false;
+    }
+
+    // Create the epoll instance
+    // int epoll_create1(int flags)
+    // If flags is 0, then, the obsolete size argument is dropped
+    // On success, these system calls return a nonnegative file descriptor.
+    // On error, -1 is returned, and errno is set to indicate the error.
+    m_epollFd = epoll_create1(0);
+    if (m_epollFd == -1)
+    {
+        g_serverLogger.error("epoll_create: " + std::string(strerror(errno)));
+        return false;
+    }
+
+    // Add the server socket to the epoll instance
+    struct epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.fd = m_listenSocket;
+
+    // epoll_ctl - control interface for an epoll file descriptor
+    // When successful, returns zero.
+    // When an error occurs, returns -1 and errno is set to indicate the error.
+    if (epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_listenSocket, &event) == -1)
+    {
+        g_serverLogger.error("epoll_ctl: " + std::string(strerror(errno)));
+        return false;
+    }
+
+    // Replies computed on other threads wake the loop through an eventfd, level-triggered until it is read
+    m_wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (m_wakeFd == -1)
+    {
+        g_serverLogger.error("eventfd: " + std::string(strerror(errno)));
+        return false;
+    }
+    event.events = EPOLLIN;
+    event.data.fd = m_wakeFd;
+    if (epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_wakeFd, &event) == -1)
+    {
+        g_serverLogger.error("epoll_ctl: " + std::string(strerror(errno)));
+        return false;
+    }
+    return true;
+}
+
+uint16_t Reactor::getPort() const
+{
+    struct sockaddr_in address = {};
+    socklen_t addressLength = sizeof(address);
+    if (m_listenSocket == -1 || getsockname(m_listenSocket, (struct sockaddr *)&address, &addressLength) == -1)
+    {
+        return 0;
+    }
+    return ntohs(address.sin_port);
+}
+
+size_t Reactor::getConnectionCount() const
+{
+    return m_connectionCount;
+}
+
+void Reactor::run(const std::atomic<bool> &p_isRunning)
+{
+    m_loopThread = std::this_thread::get_id();
+
+    // Keep the loop, its connections and its modulator in the caches of one of the cores the process may use
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    int core = -1;
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) == 0 && CPU_COUNT(&allowed) > 0)
+    {
+        size_t rank = m_index % CPU_COUNT(&allowed);
+        for (core = 0; rank != 0 || !CPU_ISSET(core, &allowed); ++core)
+        {
+            rank -= CPU_ISSET(core, &allowed) ? 1 : 0;
+        }
+    }
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    if (core >= 0)
+    {
+        CPU_SET(core, &cpuSet);
+    }
+    if (core < 0 || pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet) != 0)
+    {
+        g_serverLogger.info(stringify("Reactor ", m_index, " runs without CPU affinity"));
+    }
+    else
+    {
+        g_serverLogger.info(stringify("Reactor ", m_index, " runs on core ", core));
+    }
+
+    // Main loop to handle epoll events
+    while (p_isRunning)
+    {
+        //  wait for an I/O event on an epoll file descriptor
+        // int epoll_wait(int epfd, struct epoll_event *events, int maxevents, int timeout);
+        // The "timeout" parameter specifies the maximum wait time in milliseconds(-1 == infinite).
+        // On success, epoll_wait() returns the number of file descriptor ready for the requested I/O operation,
+        // or zero if no file descriptor became ready during the requested timeout milliseconds.
+        // On failure, epoll_wait() returns -1 and errno is set to indicate the error.
+
+        int num_events = epoll_wait(m_epollFd, m_events, MAX_EVENTS, REACTOR_WAIT_TIMEOUT);
+        if (num_events == -1)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            g_serverLogger.error("epoll_wait: " + std::string(strerror(errno)));
+            break;
+        }
+
+        for (int i = 0; i < num_events; i++)
+        {
+            if (m_events[i].data.fd == m_listenSocket)
+            {
+                acceptClients();
+            }
+            else if (m_events[i].data.fd == m_wakeFd)
+            {
+                drainCompletions();
+            }
+            else
+            {
+                // Handle data from an existing client
+                handleClient(m_events[i].data.fd, m_events[i].events);
+            }
+        }
+    }
+}
+
+void Reactor::acceptClients()
+{
+    while (true)
+    {
+        // New client connection
+        // If successful, accept() returns a nonnegative socket descriptor.
+        // If unsuccessful, accept() returns -1 and sets errno to indicate the error.
+        struct sockaddr_in clientAddress = {};
+        socklen_t clientAddrLen = sizeof(clientAddress);
+        int clientSocket = accept(m_listenSocket, (struct sockaddr *)&clientAddress, &clientAddrLen);
+        if (clientSocket == -1)
+        {
+            if (errno != EAGAIN && errno != EWOULDBLOCK)
+            {
+                g_serverLogger.error("accept socket: " + std::string(strerror(errno)));
+            }
+            return;
+        }
+
+        // Set the client socket to non-blocking
+        if (setSocketNonblocking(clientSocket) == -1)
+        {
+            close(clientSocket);
+            continue;
+        }
+
+        // Add the new client socket to the epoll instance
+        // Edge-triggered mode: EPOLLOUT only fires when a full socket buffer gets room again
+        struct epoll_event event = {};
+        event.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+        event.data.fd = clientSocket;
+
+        // epoll_ctl - control interface for an epoll file descriptor
+        // When successful, returns zero.
+        // When an error occurs, returns -1 and errno is set to indicate the error.
+        if (epoll_ctl(m_epollFd, EPOLL_CTL_ADD, clientSocket, &event) == -1)
+        {
+            g_serverLogger.error("epoll_ctl: " + std::string(strerror(errno)));
+            close(clientSocket);
+            continue;
+        }
+
+        ClientConnection &connection = m_connections[clientSocket];
+        connection = ClientConnection();
+        connection.id = m_nextConnectionId++;
+        connection.session = m_sessions.acquire();
+        m_connectionCount = m_connections.size();
+        // inet_ntoa() shares one buffer between the threads
+        char clientIp[INET_ADDRSTRLEN] = {0};
+        inet_ntop(AF_INET, &clientAddress.sin_addr, clientIp, sizeof(clientIp));
+        g_serverLogger.info(stringify("Accepted connection from ", clientIp, ". Client ", clientSocket,
+                                      " connected to reactor ", m_index, "."));
+    }
+}
+
+void Reactor::handleClient(const int p_clientSocket, const uint32_t p_events)
+{
+    auto found = m_connections.find(p_clientSocket);
+    if (found == m_connections.end())
+    {
+        return;
+    }
+    ClientConnection &connection = found->second;
+    SocketStatus writeStatus = SocketStatus::OPEN;
+    bool canRead = (p_events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) != 0;
+
+    if (p_events & EPOLLOUT)
+    {
+        writeStatus = connection.writer.flush(p_clientSocket);
+    }
+    if (connection.isReadPaused && !isBackedUp(connection, 2))
+    {
+        // The edge of the requests waiting in the socket was consumed while paused, read them now
+        g_serverLogger.info(stringify("Client ", p_clientSocket, " caught up with its replies, reading resumed."));
+        connection.isReadPaused = false;
+        canRead = true;
+    }
+    if (connection.isReadPaused || !canRead)
+    {
+        if (writeStatus == SocketStatus::FAILED)
+        {
+            g_serverLogger.error(stringify("Error sending data to client ", p_clientSocket, ": ", strerror(errno)));
+            closeClient(p_clientSocket);
+        }
+        return;
+    }
+
+    auto answerRequest = [&](const char *p_payload, size_t p_size)
+    {
+        std::string request(p_payload, p_size);
+        g_serverLogger.info(stringify("Received message: ", request));
+        // Reserve the slot of the reply first, a reply given at once is then queued in the writer right away
+        uint64_t sequence = connection.firstSequence + connection.replies.size();
+        connection.replies.emplace_back();
+        uint64_t connectionId = connection.id;
+        m_handler(*connection.session, request, [this, p_clientSocket, connectionId, sequence](std::string p_reply)
+                  {
+                      Completion completion{p_clientSocket, connectionId, sequence, std::move(p_reply)};
+                      if (std::this_thread::get_id() == m_loopThread)
+                      {
+                          deliver(std::move(completion));
+                          return;
+                      }
+                      {
+                          std::lock_guard<std::mutex> lock(m_completionMutex);
+                          m_completions.push_back(std::move(completion));
+                      }
+                      uint64_t one = 1;
+                      ssize_t written = write(m_wakeFd, &one, sizeof(one));
+                      (void)written; // Only fails when the counter is already non-zero, the loop wakes up anyway
+                  });
+    };
+    auto shouldPause = [&]()
+    {
+        // Write first, only a client not reading its replies stays above the mark
+        if (connection.writer.getPendingSize() > m_outputHighWater && writeStatus == SocketStatus::OPEN)
+        {
+            writeStatus = connection.writer.flush(p_clientSocket);
+        }
+        return writeStatus != SocketStatus::OPEN || isBackedUp(connection, 1);
+    };
+    // Edge-triggered: drain the socket, a request may be split across reads or share a read with others
+    SocketStatus readStatus = connection.reader.readFrom(p_clientSocket, answerRequest, shouldPause);
+    if (writeStatus == SocketStatus::OPEN)
+    {
+        writeStatus = connection.writer.flush(p_clientSocket);
+    }
+
+    if (readStatus == SocketStatus::CLOSED)
+    {
+        g_serverLogger.info(stringify("Client ", p_clientSocket, " disconnected."));
+        closeClient(p_clientSocket);
+    }
+    else if (readStatus == SocketStatus::INVALID_FRAME)
+    {
+        g_serverLogger.error(stringify("Client ", p_clientSocket, " sent a frame longer than ", FRAME_MAX_PAYLOAD,
+                                       " bytes, closing the connection."));
+        closeClient(p_clientSocket);
+    }
+    else if (readStatus == SocketStatus::FAILED || writeStatus == SocketStatus::FAILED)
+    {
+        g_serverLogger.error(stringify("Error with client ", p_clientSocket, ": ", strerror(errno)));
+        closeClient(p_clientSocket);
+    }
+    else if (readStatus == SocketStatus::PAUSED)
+    {
+        g_serverLogger.info(stringify("Client ", p_clientSocket, " has ", connection.writer.getPendingSize(),
+                                      " reply bytes queued and ", connection.replies.size(),
+                                      " requests in progress, reading paused."));
+        connection.isReadPaused = true;
+    }
+}
+
+bool Reactor::isBackedUp(const ClientConnection &p_connection, const size_t p_divider) const
+{
+    return p_connection.writer.getPendingSize() > m_outputHighWater / p_divider ||
+           p_connection.replies.size() > MAX_PENDING_REPLIES / p_divider;
+}
+
+bool Reactor::deliver(Completion &&p_completion)
+{
+    auto found = m_connections.find(p_completion.socket);
+    if (found == m_connections.end() || found->second.id != p_completion.connectionId)
+    {
+        return false;
+    }
+    ClientConnection &connection = found->second;
+    PendingReply &reply = connection.replies[p_completion.sequence - connection.firstSequence];
+    reply.isReady = true;
+    reply.payload = std::move(p_completion.payload);
+    while (!connection.replies.empty() && connection.replies.front().isReady)
+    {
+        connection.writer.push(std::move(connection.replies.front().payload));
+        connection.replies.pop_front();
+        ++connection.firstSequence;
+    }
+    return true;
+}
+
+void Reactor::drainCompletions()
+{
+    uint64_t count = 0;
+    ssize_t received = read(m_wakeFd, &count, sizeof(count));
+    (void)received; // EAGAIN when another wake-up already reset the counter, the queue is checked anyway
+    std::vector<Completion> completions;
+    {
+        std::lock_guard<std::mutex> lock(m_completionMutex);
+        completions.swap(m_completions);
+    }
+    for (Completion &completion : completions)
+    {
+        int clientSocket = completion.socket;
+        if (deliver(std::move(completion)))
+        {
+            // Write the reply as if the socket became writable, which also resumes a client paused for it
+            handleClient(clientSocket, EPOLLOUT);
+        }
+    }
+}
+
+void Reactor::closeClient(const int p_clientSocket)
+{
+    // Closing the socket also removes it from the epoll instance
+    close(p_clientSocket);
+    auto found = m_connections.find(p_clientSocket);
+    if (found == m_connections.end())
+    {
+        return;
+    }
+    m_sessions.release(std::move(found->second.session));
+    m_connections.erase(found);
+    m_connectionCount = m_connections.size();
+}
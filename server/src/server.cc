@@ -1,14 +1,13 @@
 #include "server.h"
 #include <regex>
+#include <algorithm>
 #include <cstring>
 #include <fcntl.h>
 #include <errno.h>
 #include <vector>
 #include <complex>
 #include <sstream>
-
-bool saveInputFile(const std::vector<double> &p_inputWave, bool isFilter);
-bool isBinaryString(std::string p_string);
+#include <fstream>
 
 void initLogger()
 {
@@ -28,116 +27,166 @@ void Server::initDB()
     g_serverLogger.info(stringify("The default database directory is '", m_dbPath, "'"));
 }
 
-Server::Server() : m_serverRunning(true)
+size_t Server::readWorkerThreads()
 {
-    m_dbPath = INITIAL_DATABASE_PATH;
-    initLogger();
-    initDB();
-    m_carrier = std::make_unique<Carrier>();
-    m_modulator = std::make_unique<Modulator>();
-    m_antenna = std::make_unique<Antenna>();
+    int threads = 0;
+    try
+    {
+        auto intValue = InMemDatabase::getInstance().getValue(WORKER_THREADS_KEY);
+        extractValue<int>(intValue, threads);
+    }
+    catch (const DBException &e)
+    {
+        g_serverLogger.info(stringify("No worker thread setting, using every hardware thread: ", e.what()));
+    }
+    if (threads <= 0)
+    {
+        threads = std::max(1U, std::thread::hardware_concurrency());
+    }
+    g_serverLogger.info(stringify("Modulating on ", threads, " threads"));
+    return threads;
 }
 
-Server::~Server()
+bool Server::readBaseband()
 {
-    m_threads.clear();
+    int isBaseband = 0;
+    try
+    {
+        auto intValue = InMemDatabase::getInstance().getValue(BASEBAND_KEY);
+        extractValue<int>(intValue, isBaseband);
+    }
+    catch (const DBException &e)
+    {
+        g_serverLogger.info(stringify("No UL channel setting, using passband samples: ", e.what()));
+    }
+    return isBaseband != 0;
 }
 
-int Server::setSocketNonblocking(const int &p_sockFD)
+uint64_t Server::readNoiseSeed()
 {
-    // fcntl - manipulate file descriptor
-    // If successful, the value returned will depend on the action that was specified.
-    // If unsuccessful, returns a value of -1
-
-    int flags = fcntl(p_sockFD, F_GETFL);
-    if (flags == -1)
+    int seed = 0;
+    try
     {
-        g_serverLogger.error("fcntl: " + std::string(strerror(errno)));
-        return -1;
+        auto intValue = InMemDatabase::getInstance().getValue(NOISE_SEED_KEY);
+        extractValue<int>(intValue, seed);
     }
-    flags |= O_NONBLOCK;
-    if (fcntl(p_sockFD, F_SETFL, flags) == -1)
+    catch (const DBException &e)
     {
-        g_serverLogger.error("fcntl: " + std::string(strerror(errno)));
-        return -1;
+        g_serverLogger.info(stringify("No noise seed setting, using a random seed: ", e.what()));
     }
-    return 0;
+    if (seed != 0)
+    {
+        g_serverLogger.info(stringify("Channel noise seeded with ", seed));
+    }
+    return static_cast<uint32_t>(seed);
 }
 
-void Server::init()
+size_t Server::readOutputHighWater()
 {
-    // Create socket
-    // int socket(int domain, int type, int protocol)
-    // The protocol specifies a particular protocol to be used with the socket.
-    // If PROTOCOL is zero, one is chosen automatically.
-    // Returns a file descriptor for the new socket, or -1 for errors.
-    m_serverSocket = socket(AF_INET, SOCK_STREAM, 0);
-    if (m_serverSocket == -1)
+    int highWater = 0;
+    try
     {
-        g_serverLogger.error("Failed to create socket.");
+        auto intValue = InMemDatabase::getInstance().getValue(OUTPUT_HIGH_WATER_KEY);
+        extractValue<int>(intValue, highWater);
     }
-
-    if (setSocketNonblocking(m_serverSocket) == -1)
+    catch (const DBException &e)
     {
-        g_serverLogger.error("Failed to set non-blocking mode for server.");
+        g_serverLogger.info(stringify("No output high-water setting, using ", DEFAULT_OUTPUT_HIGH_WATER, " bytes: ",
+                                      e.what()));
     }
+    if (highWater <= 0)
+    {
+        return DEFAULT_OUTPUT_HIGH_WATER;
+    }
+    return highWater;
+}
 
-    // Bind socket to port
-    m_serverAddress.sin_family = AF_INET;
-    m_serverAddress.sin_addr.s_addr = inet_addr(SERVER_IP_ADDR);
-    m_serverAddress.sin_port = htons(SERVER_PORT);
-
-    // A pointer to the buffer in which the value for the requested option is specified.
-    int optval = 1;
-
-    // SO_REUSEADDR
-    // Specifies that the rules used in validating addresses
-    // supplied to bind() should allow reuse of local addresses, if this is supported by the protocol.
-    // Without SO_REUSEADDR, the bind() call in the restarted program's new instance will fail
-    // if there were connections open to the previous instance and even after getting killed (30s~120s)
-    setsockopt(m_serverSocket, SOL_SOCKET, SO_REUSEADDR, &optval, sizeof(optval));
-
-    // On success, 0 is returned.  On error, -1 is returned.
-    if (bind(m_serverSocket, (struct sockaddr *)&m_serverAddress, sizeof(m_serverAddress)) == -1)
+size_t Server::readReactorCount()
+{
+    int reactors = 1;
+    try
     {
-        g_serverLogger.error("Bind failed.");
-        close(m_serverSocket);
+        auto intValue = InMemDatabase::getInstance().getValue(REACTORS_KEY);
+        extractValue<int>(intValue, reactors);
     }
+    catch (const DBException &e)
+    {
+        g_serverLogger.info(stringify("No reactor setting, serving every client on one event loop: ", e.what()));
+    }
+    if (reactors <= 0)
+    {
+        reactors = std::max(1U, std::thread::hardware_concurrency());
+    }
+    g_serverLogger.info(stringify("Serving clients on ", reactors, " reactors"));
+    return reactors;
+}
 
-    // Listen for incoming connections
-    // Returns 0 on success, -1 for errors.
-    if (listen(m_serverSocket, MAX_CONNECTION_REQUEST) == -1)
+size_t Server::readRadioWorkerCount()
+{
+    int workers = 1;
+    try
+    {
+        auto intValue = InMemDatabase::getInstance().getValue(RADIO_WORKERS_KEY);
+        extractValue<int>(intValue, workers);
+    }
+    catch (const DBException &e)
     {
-        g_serverLogger.error("Listen failed.");
-        close(m_serverSocket);
+        g_serverLogger.info(stringify("No radio worker setting, running the bursts one at a time: ", e.what()));
     }
+    if (workers <= 0)
+    {
+        workers = std::max(1U, std::thread::hardware_concurrency());
+    }
+    g_serverLogger.info(stringify("Running DL and UL bursts on ", workers, " radio workers"));
+    return workers;
+}
 
-    // Create the epoll instance
-    // int epoll_create1(int flags)
-    // If flags is 0, then, the obsolete size argument is dropped
-    // On success, these system calls return a nonnegative file descriptor.
-    // On error, -1 is returned, and errno is set to indicate the error.
-    m_epollFd = epoll_create1(0);
-    if (m_epollFd == -1)
+Server::Server() : m_serverRunning(true)
+{
+    m_dbPath = INITIAL_DATABASE_PATH;
+    initLogger();
+    initDB();
+    size_t workerCount = readRadioWorkerCount();
+    // Several workers already keep the cores busy, a shared pool would only oversubscribe them
+    if (workerCount == 1)
     {
-        g_serverLogger.error("epoll_create: " + std::string(strerror(errno)));
-        close(m_serverSocket);
+        m_threadPool = std::make_unique<ThreadPool>(readWorkerThreads());
     }
+    bool isBaseband = readBaseband();
+    uint64_t noiseSeed = readNoiseSeed();
+    for (size_t workerIdx = 0; workerIdx < workerCount; ++workerIdx)
+    {
+        // Every worker gets its own noise stream and its own signal files
+        m_transceivers.push_back(std::make_unique<Transceiver>(
+            m_threadPool.get(), isBaseband, noiseSeed, workerIdx, workerIdx == 0 ? "" : stringify("_worker", workerIdx)));
+    }
+    size_t reactorCount = readReactorCount();
+    size_t outputHighWater = readOutputHighWater();
+    for (size_t reactorIdx = 0; reactorIdx < reactorCount; ++reactorIdx)
+    {
+        m_reactors.push_back(std::make_unique<Reactor>(reactorIdx, outputHighWater,
+                                                       [this](Session &p_session, const std::string &p_request,
+                                                              const ReplySink &p_reply)
+                                                       { handleRequest(p_session, p_request, p_reply); }));
+    }
+    m_radioJobs = std::make_unique<JobQueue>(workerCount);
+}
 
-    // Add the server socket to the epoll instance
-    ev.events = EPOLLIN;
-    ev.data.fd = m_serverSocket;
+Server::~Server()
+{
+    m_threads.clear();
+}
 
-    // epoll_ctl - control interface for an epoll file descriptor
-    // When successful, returns zero.
-    // When an error occurs, returns -1 and errno is set to indicate the error.
-    if (epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_serverSocket, &ev) == -1)
+void Server::init()
+{
+    for (auto &reactor : m_reactors)
     {
-        g_serverLogger.error("epoll_ctl: " + std::string(strerror(errno)));
-        close(m_serverSocket);
-        close(m_epollFd);
+        if (!reactor.get()->listen(SERVER_IP_ADDR, SERVER_PORT))
+        {
+            g_serverLogger.error(stringify("Failed to listen on port ", SERVER_PORT, "."));
+            exit(1);
+        }
     }
-
     g_serverLogger.info(stringify("Server listening on port ", SERVER_PORT, "..."));
 }
 
@@ -146,72 +195,13 @@ void Server::start()
     m_threads.emplace_back([&, this]()
                            { handleCommand(); });
 
-    // Main loop to handle epoll events
-    while (m_serverRunning)
+    for (size_t reactorIdx = 1; reactorIdx < m_reactors.size(); ++reactorIdx)
     {
-        //  wait for an I/O event on an epoll file descriptor
-        // int epoll_wait(int epfd, struct epoll_event *events, int maxevents, int timeout);
-        // The "timeout" parameter specifies the maximum wait time in milliseconds(-1 == infinite).
-        // On success, epoll_wait() returns the number of file descriptor ready for the requested I/O operation,
-        // or zero if no file descriptor became ready during the requested timeout milliseconds.
-        // On failure, epoll_wait() returns -1 and errno is set to indicate the error.
-
-        int num_events = epoll_wait(m_epollFd, events, MAX_EVENTS, -1);
-        if (num_events == -1)
-        {
-            if (errno == EINTR)
-            {
-                continue;
-            }
-            g_serverLogger.error("epoll_wait: " + std::string(strerror(errno)));
-            break;
-        }
-
-        for (int i = 0; i < num_events; i++)
-        {
-            if (events[i].data.fd == m_serverSocket)
-            {
-                // New client connection
-                // If successful, accept() returns a nonnegative socket descriptor.
-                // If unsuccessful, accept() returns -1 and sets errno to indicate the error.
-                m_clientSocket = accept(m_serverSocket, (struct sockaddr *)&m_clientAddress, &m_clientAddrLen);
-                if (m_clientSocket == -1)
-                {
-                    g_serverLogger.error("accept socket: " + std::string(strerror(errno)));
-                    continue;
-                }
-
-                // Set the client socket to non-blocking
-                if (setSocketNonblocking(m_clientSocket) == -1)
-                {
-                    close(m_clientSocket);
-                    continue;
-                }
-
-                // Add the new client socket to the epoll instance
-                ev.events = EPOLLIN | EPOLLET; // Edge-triggered mode
-                ev.data.fd = m_clientSocket;
-
-                // epoll_ctl - control interface for an epoll file descriptor
-                // When successful, returns zero.
-                // When an error occurs, returns -1 and errno is set to indicate the error.
-                if (epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_clientSocket, &ev) == -1)
-                {
-                    g_serverLogger.error("epoll_ctl: " + std::string(strerror(errno)));
-                    close(m_clientSocket);
-                    continue;
-                }
-
-                g_serverLogger.info(stringify("Accepted connection from ", inet_ntoa(m_clientAddress.sin_addr),
-                                              ". Client ", m_clientSocket, " connected."));
-            }
-            else
-            {
-                // Handle data from an existing client
-                handleClient(events[i].data.fd);
-            }
-        }
+        Reactor &reactor = *m_reactors[reactorIdx];
+        m_threads.emplace_back([&, this]()
+                               { reactor.run(m_serverRunning); });
     }
+    m_reactors[0].get()->run(m_serverRunning);
 
     for (auto &th : m_threads)
     {
@@ -220,10 +210,6 @@ void Server::start()
             th.join();
         }
     }
-
-    // Close the server socket and epoll instance
-    close(m_serverSocket);
-    close(m_epollFd);
 }
 
 void Server::handleCommand()
@@ -247,9 +233,14 @@ void Server::handleCommand()
         else if (firstCmd == "info")
         {
             std::cout << "Server listening on port " << SERVER_PORT << "." << "\n";
-            std::cout << "The server address is " << inet_ntoa(m_serverAddress.sin_addr) << "\n";
-            std::cout << "The server network is " << m_carrier.get()->getNetwork() << "\n";
-            std::cout << "Frequency Carrier is " << m_carrier.get()->getFrequency() << "\n";
+            std::cout << "The server address is " << SERVER_IP_ADDR << "\n";
+            for (size_t reactorIdx = 0; reactorIdx < m_reactors.size(); ++reactorIdx)
+            {
+                std::cout << "Reactor " << reactorIdx << " serves " << m_reactors[reactorIdx].get()->getConnectionCount()
+                          << " clients" << "\n";
+            }
+            std::cout << "Radio workers: " << m_radioJobs.get()->getWorkerCount() << ", bursts waiting: "
+                      << m_radioJobs.get()->getQueuedCount() << "\n";
         }
         else if (firstCmd == "help")
         {
@@ -281,15 +272,53 @@ void Server::handleCommand()
     }
 }
 
-std::string Server::handleClientCommand(const char *p_buffer)
+void Server::handleRequest(Session &p_session, const std::string &p_request, const ReplySink &p_reply)
+{
+    std::stringstream strStream(p_request);
+    std::string query;
+    std::string binaryData;
+    strStream >> query;
+    if (query != "DL" && query != "UL")
+    {
+        p_reply(handleClientCommand(p_session, p_request));
+        return;
+    }
+
+    // The burst runs on a copy, so a setup while it is queued or a closed connection does not change it
+    Carrier carrier = p_session.carrier;
+    if (!carrier.getCarrierStatus())
+    {
+        p_reply(query == "DL" ? "Please setup carrier: 'server carrier setup <network> <frequency>"
+                              : "Please setup network: 'server carrier setup <network> <frequency>");
+        return;
+    }
+    if (query == "DL")
+    {
+        strStream >> binaryData;
+        if (binaryData == "")
+        {
+            p_reply("Missing binaryData");
+            return;
+        }
+    }
+    // Modulation, file exports and plots take far longer than any other request, the event loop goes on
+    // serving the other clients meanwhile
+    m_radioJobs.get()->push([this, query, binaryData, carrier, p_reply](size_t p_workerIdx) mutable
+                            {
+                                Transceiver &transceiver = *m_transceivers[p_workerIdx];
+                                p_reply(query == "DL" ? transceiver.downlink(carrier, binaryData)
+                                                      : transceiver.uplink(carrier));
+                            });
+}
+
+std::string Server::handleClientCommand(Session &p_session, const std::string &p_request)
 {
     std::string message;
-    std::string bufferStr = p_buffer;
+    const std::string &bufferStr = p_request;
     std::stringstream strStream(bufferStr);
     std::string query;
     std::string keyNetwork;
     std::string frequency;
-    std::string binaryData;
 
     strStream >> query;
 
@@ -312,19 +341,21 @@ std::string Server::handleClientCommand(const char *p_buffer)
         strStream >> query;
         if (query == "setup")
         {
+            std::string fec = FEC_NONE;
             strStream >> keyNetwork;
             strStream >> frequency;
+            strStream >> fec;
             if (keyNetwork == "" || frequency == "")
             {
                 message = "Missing keyNetwork or frequency";
                 return message;
             }
             ssize_t numFreq = std::stol(frequency);
-            message = setNetworkForServer(keyNetwork, numFreq);
+            message = setNetworkForServer(p_session.carrier, keyNetwork, numFreq, fec);
         }
         else if (query == "release")
         {
-            m_carrier.get()->releaseCarrier();
+            p_session.carrier.releaseCarrier();
             message = "Release carrier setting";
         }
         else
@@ -332,98 +363,6 @@ std::string Server::handleClientCommand(const char *p_buffer)
             message = "Invalid command for carrier";
         }
     }
-    else if (query == "DL")
-    {
-        if (!m_carrier.get()->getCarrierStatus())
-        {
-            message = "Please setup carrier: 'server carrier setup <network> <frequency>";
-        }
-        else
-        {
-            strStream >> binaryData;
-            if (binaryData == "")
-            {
-                message = "Missing binaryData";
-                return message;
-            }
-            else if (!isBinaryString(binaryData))
-            {
-                message = "Data received is not a binary string";
-                return message;
-            }
-            std::cout << "Received binary data: " << binaryData << std::endl;
-            std::string passNetwork = m_carrier.get()->getNetwork();
-            if (passNetwork == "5G" && binaryData.length() % 4 != 0)
-            {
-                message = "Binary data length must be a multiple of 4 for 16-QAM.";
-                g_serverLogger.error("Binary data length must be a multiple of 4 for 16-QAM.");
-            }
-            else
-            {
-                m_modulator.get()->setBinaryInput(binaryData);
-                m_modulator.get()->setFrequency(m_carrier.get()->getFrequency());
-                std::vector<double> signalModulated = m_modulator.get()->modulate(passNetwork);
-                if (saveInputFile(signalModulated, true))
-                {
-                    g_serverLogger.info("Open file inputFiltered successfully");
-                }
-                else
-                {
-                    g_serverLogger.error("Fail to open file for wave inputFiltered data");
-                }               
-                m_antenna.get()->addNoise(signalModulated);
-                if (saveInputFile(signalModulated, false))
-                {
-                    g_serverLogger.info("Open file inputNoise successfully");
-                }
-                else
-                {
-                    g_serverLogger.error("Fail to open file for wave inputNoise data");
-                }
-                std::optional<std::pair<std::string, std::string>> dlParam = std::make_pair(binaryData, std::to_string(m_carrier.get()->getFrequency()));
-                m_antenna.get()->visualizeData(dlParam);
-            }
-        }
-    }
-    else if (query == "UL")
-    {
-        if (!m_carrier.get()->getCarrierStatus())
-        {
-            message = "Please setup network: 'server carrier setup <network> <frequency>";
-            return message;
-        }
-        int bitSize = 13;
-        if (m_carrier.get()->getNetwork() == "5G")
-        {
-            bitSize *= 4;
-        }
-        std::string binaryGenerated = m_antenna.get()->randomBinaryMessageGenerator(bitSize);
-        m_modulator.get()->setBinaryInput(binaryGenerated);
-        m_modulator.get()->setFrequency(m_carrier.get()->getFrequency());
-        std::vector<double> signalGenerated = m_modulator.get()->modulate(m_carrier.get()->getNetwork());
-        if (saveInputFile(signalGenerated, true))
-        {
-            g_serverLogger.info("Open file inputFilter is successfull");
-        }
-        else
-        {
-            g_serverLogger.error("Fail to open file for wave inputFilter data");
-        }
-        m_antenna.get()->addNoise(signalGenerated);
-        if (saveInputFile(signalGenerated, false))
-        {
-            g_serverLogger.info("Open file inputNoise is successfull");
-        }
-        else
-        {
-            g_serverLogger.error("Fail to open file for wave inputNoise data");
-        }
-        m_antenna.get()->filterNoise(signalGenerated);
-        std::string demodBinaryData = m_modulator.get()->demodulate(signalGenerated, m_carrier.get()->getNetwork());
-        g_serverLogger.info(binaryGenerated);
-        m_antenna.get()->visualizeData();
-        message = demodBinaryData;
-    }
     else
     {
         message = bufferStr;
@@ -431,41 +370,6 @@ std::string Server::handleClientCommand(const char *p_buffer)
     return message;
 }
 
-void Server::handleClient(const int &p_clientSocket)
-{
-    char buffer[BUFFER_SIZE] = {0};
-
-    // ssize_t recv(int socket, char *buffer, int length, int flags);
-    // if flags are 0, no flags are specified
-    // If successful, recv() returns the length of the message or datagram in bytes. The value 0 indicates the connection is closed.
-    // If unsuccessful, recv() returns -1 and sets errno to indicate the error.
-
-    ssize_t bytesRead = recv(p_clientSocket, buffer, sizeof(buffer), 0);
-    if (bytesRead > 0)
-    {
-        buffer[bytesRead] = '\0';
-
-        g_serverLogger.info(stringify("Received message: ", std::string(buffer)));
-        std::string message = handleClientCommand(buffer);
-
-        // Convert message to char array
-        strcpy(buffer, message.c_str());
-
-        // Echo the message back to the client
-        // ssize_t send(int socket, const void *buffer, size_t length, int flags);
-        // if flags are 0, no flags are specified
-        send(p_clientSocket, buffer, message.size(), 0);
-    }
-    else if (bytesRead == 0)
-    {
-        g_serverLogger.info(stringify("Client ", p_clientSocket, " disconnected."));
-    }
-    else
-    {
-        g_serverLogger.error("Error receiving data.");
-    }
-}
-
 void Server::handleDBCommand()
 {
     std::stringstream strStream(m_command);
@@ -518,24 +422,34 @@ std::string Server::handleClientGetDBCommand(const std::string &p_key)
     return message;
 }
 
-std::string Server::setNetworkForServer(const std::string &p_network, const ssize_t &p_freq)
+std::string Server::setNetworkForServer(Carrier &p_carrier, const std::string &p_network, const ssize_t &p_freq,
+                                        const std::string &p_fec)
 {
     std::string message;
-    if (m_carrier.get()->checkSupportedCarrier(p_network) &&
-        m_carrier.get()->checkSupportedFrequency(p_freq))
+    if (p_fec != FEC_NONE && p_fec != FEC_CONVOLUTIONAL)
+    {
+        message = stringify("Unknown FEC ", p_fec, ", must be ", FEC_NONE, " or ", FEC_CONVOLUTIONAL);
+    }
+    else if (p_carrier.checkSupportedCarrier(p_network) &&
+        p_carrier.checkSupportedFrequency(p_freq))
     {
         g_serverLogger.info("The server has support " + p_network + "!");
-        if (m_carrier.get()->setNetwork(p_network))
+        if (p_carrier.setNetwork(p_network))
         {
-            m_carrier.get()->setFrequency(p_freq);
+            p_carrier.setFrequency(p_freq);
+            p_carrier.setFec(p_fec);
             message = "Successfully set up " + p_network + " network";
+            if (p_carrier.getFec() != FecType::NONE)
+            {
+                message += " with " + p_fec + " FEC";
+            }
         }
         else
         {
             message = "Please remove old network setting";
         }
     }
-    else if (!m_carrier.get()->checkSupportedFrequency(p_freq))
+    else if (!p_carrier.checkSupportedFrequency(p_freq))
     {
         message = "Frequency out of range, must be from 1-10";
     }
@@ -546,43 +460,3 @@ std::string Server::setNetworkForServer(const std::string &p_network, const ssiz
     }
     return message;
 }
-
-bool saveInputFile(const std::vector<double> &p_inputWave, bool isFilter)
-{
-    std::string inputFilePathKey;
-    if (!isFilter)
-    {
-        inputFilePathKey = "/inputNoise";
-    }
-    else
-    {
-        inputFilePathKey = "/inputFiltered";
-    }
-    const char *inputFilePath = "";
-    auto var = InMemDatabase::getInstance().getValue(inputFilePathKey);
-    extractValue<char const *>(var, inputFilePath);
-    std::string strInputFilePath(inputFilePath);
-    std::ofstream file(strInputFilePath);
-    if (!file.is_open())
-    {
-        return false;
-    }
-    for (auto value : p_inputWave)
-    {
-        file << value << std::endl;
-    }
-    file.close();
-    return true;
-}
-
-bool isBinaryString(std::string p_string)
-{
-    for (char curChar : p_string)
-    {
-        if (curChar != '0' && curChar != '1')
-        {
-            return false;
-        }
-    }
-    return true;
-}
\ No newline at end of file
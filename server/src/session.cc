@@ -0,0 +1,37 @@
+#include "session.h"
+
+void Session::reset()
+{
+    carrier = Carrier();
+}
+
+SessionPool::SessionPool(const size_t p_capacity) : m_capacity(p_capacity)
+{
+}
+
+std::unique_ptr<Session> SessionPool::acquire()
+{
+    if (m_free.empty())
+    {
+        return std::make_unique<Session>();
+    }
+    std::unique_ptr<Session> session = std::move(m_free.back());
+    m_free.pop_back();
+    return session;
+}
+
+void SessionPool::release(std::unique_ptr<Session> &&p_session)
+{
+    if (!p_session || m_free.size() >= m_capacity)
+    {
+        p_session.reset();
+        return;
+    }
+    p_session.get()->reset();
+    m_free.push_back(std::move(p_session));
+}
+
+size_t SessionPool::getFreeCount() const
+{
+    return m_free.size();
+}
@@ -0,0 +1,49 @@
+#include "simd.h"
+#include <atomic>
+
+namespace
+{
+    SimdLevel detectSimdLevel()
+    {
+#if defined(__x86_64__)
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+        {
+            return SimdLevel::AVX2;
+        }
+        // SSE2 is part of the x86-64 baseline
+        return SimdLevel::SSE2;
+#else
+        return SimdLevel::SCALAR;
+#endif
+    }
+
+    std::atomic<SimdLevel> &getSelectedLevel()
+    {
+        static std::atomic<SimdLevel> level(detectSimdLevel());
+        return level;
+    }
+}
+
+SimdLevel getSimdLevel()
+{
+    return getSelectedLevel().load(std::memory_order_relaxed);
+}
+
+void setSimdLevel(const SimdLevel p_level)
+{
+    SimdLevel supported = detectSimdLevel();
+    getSelectedLevel().store(p_level < supported ? p_level : supported, std::memory_order_relaxed);
+}
+
+const char *toString(const SimdLevel p_level)
+{
+    switch (p_level)
+    {
+    case SimdLevel::AVX2:
+        return "avx2";
+    case SimdLevel::SSE2:
+        return "sse2";
+    default:
+        return "scalar";
+    }
+}
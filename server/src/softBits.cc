@@ -0,0 +1,109 @@
+#include "softBits.h"
+#include "simd.h"
+#include <algorithm>
+#include <cmath>
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace
+{
+    using QuantizeKernel = void (*)(const float *, size_t, float, int8_t *);
+    using HardDecideKernel = void (*)(const float *, size_t, uint64_t *);
+
+    void quantizeLlrsScalar(const float *p_llr, size_t p_size, float p_scale, int8_t *p_output)
+    {
+        for (size_t llrIdx = 0; llrIdx < p_size; ++llrIdx)
+        {
+            float step = std::clamp(p_llr[llrIdx] * p_scale, -static_cast<float>(LLR_INT8_MAX),
+                                    static_cast<float>(LLR_INT8_MAX));
+            p_output[llrIdx] = static_cast<int8_t>(std::nearbyint(step));
+        }
+    }
+
+    void hardDecideScalar(const float *p_llr, size_t p_size, uint64_t *p_words)
+    {
+        for (size_t llrIdx = 0; llrIdx < p_size; ++llrIdx)
+        {
+            p_words[llrIdx / BITSTREAM_WORD_BITS] |= static_cast<uint64_t>(std::signbit(p_llr[llrIdx]))
+                                                      << (llrIdx % BITSTREAM_WORD_BITS);
+        }
+    }
+
+#if defined(__x86_64__)
+    void quantizeLlrsSse2(const float *p_llr, size_t p_size, float p_scale, int8_t *p_output)
+    {
+        const __m128 scale = _mm_set1_ps(p_scale);
+        const __m128 upper = _mm_set1_ps(LLR_INT8_MAX);
+        const __m128 lower = _mm_set1_ps(-LLR_INT8_MAX);
+        size_t llrIdx = 0;
+        // 16 ratios per step: clamp, round to the closest step, then pack down to bytes
+        for (; llrIdx + 16 <= p_size; llrIdx += 16)
+        {
+            __m128i steps[4];
+            for (size_t vectorIdx = 0; vectorIdx < 4; ++vectorIdx)
+            {
+                __m128 value = _mm_mul_ps(_mm_loadu_ps(p_llr + llrIdx + 4 * vectorIdx), scale);
+                steps[vectorIdx] = _mm_cvtps_epi32(_mm_max_ps(_mm_min_ps(value, upper), lower));
+            }
+            __m128i packed = _mm_packs_epi16(_mm_packs_epi32(steps[0], steps[1]), _mm_packs_epi32(steps[2], steps[3]));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(p_output + llrIdx), packed);
+        }
+        quantizeLlrsScalar(p_llr + llrIdx, p_size - llrIdx, p_scale, p_output + llrIdx);
+    }
+
+    void hardDecideSse2(const float *p_llr, size_t p_size, uint64_t *p_words)
+    {
+        size_t llrIdx = 0;
+        // The sign bits of 4 ratios at a time are the decisions, 16 steps fill a word
+        for (; llrIdx + BITSTREAM_WORD_BITS <= p_size; llrIdx += BITSTREAM_WORD_BITS)
+        {
+            uint64_t word = 0;
+            for (size_t groupIdx = 0; groupIdx < BITSTREAM_WORD_BITS / 4; ++groupIdx)
+            {
+                word |= static_cast<uint64_t>(_mm_movemask_ps(_mm_loadu_ps(p_llr + llrIdx + 4 * groupIdx)))
+                        << (4 * groupIdx);
+            }
+            p_words[llrIdx / BITSTREAM_WORD_BITS] = word;
+        }
+        hardDecideScalar(p_llr + llrIdx, p_size - llrIdx, p_words + llrIdx / BITSTREAM_WORD_BITS);
+    }
+#endif
+
+    /// @brief The kernels of one instruction set level
+    struct KernelTable
+    {
+        QuantizeKernel quantize;
+        HardDecideKernel hardDecide;
+    };
+
+    /// @brief The kernels indexed by SimdLevel, AVX2 keeps the SSE2 kernels as they are bound by the stores
+    const KernelTable KERNEL_TABLES[] = {
+        {quantizeLlrsScalar, hardDecideScalar},
+#if defined(__x86_64__)
+        {quantizeLlrsSse2, hardDecideSse2},
+        {quantizeLlrsSse2, hardDecideSse2},
+#else
+        {quantizeLlrsScalar, hardDecideScalar},
+        {quantizeLlrsScalar, hardDecideScalar},
+#endif
+    };
+
+    const KernelTable &getKernelTable()
+    {
+        return KERNEL_TABLES[static_cast<int>(getSimdLevel())];
+    }
+}
+
+void quantizeLlrs(const float *p_llr, const size_t p_size, const float p_scale, int8_t *p_output)
+{
+    getKernelTable().quantize(p_llr, p_size, p_scale, p_output);
+}
+
+void hardDecide(const float *p_llr, const size_t p_size, BitStream &p_output)
+{
+    // Every word is rebuilt from 0, the bits past the end stay 0
+    p_output.clear();
+    p_output.resize(p_size);
+    getKernelTable().hardDecide(p_llr, p_size, p_output.data());
+}
@@ -0,0 +1,105 @@
+#include "spectrum.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    /// @brief Fill the frequencies of the one-sided bins and find the peak of the amplitudes
+    void finishSpectrum(const size_t p_size, const double p_sampleRate, Spectrum &p_output)
+    {
+        p_output.frequency.resize(p_output.amplitude.size());
+        for (size_t binIdx = 0; binIdx < p_output.frequency.size(); ++binIdx)
+        {
+            p_output.frequency[binIdx] = binIdx * p_sampleRate / p_size;
+        }
+        // max_element keeps the first of equal values, as numpy.argmax
+        p_output.peakIndex = std::max_element(p_output.amplitude.begin(), p_output.amplitude.end()) -
+                             p_output.amplitude.begin();
+    }
+
+    /// @brief |X[k]| * 2 / N for the first N / 2 bins
+    void computeAmplitudes(const double *p_signal, const size_t p_size, std::vector<std::complex<double>> &p_bins,
+                           std::vector<std::complex<double>> &p_scratch, std::vector<double> &p_amplitude)
+    {
+        const RealFftPlan &plan = getRealFftPlan(p_size);
+        p_bins.resize(plan.getBinCount());
+        plan.transform(p_signal, p_bins.data(), p_scratch);
+        p_amplitude.resize(p_size / 2);
+        for (size_t binIdx = 0; binIdx < p_amplitude.size(); ++binIdx)
+        {
+            p_amplitude[binIdx] = std::abs(p_bins[binIdx]) * 2.0 / p_size;
+        }
+    }
+}
+
+void computeSpectrum(const double *p_signal, const size_t p_size, const double p_sampleRate, Spectrum &p_output)
+{
+    if (p_size == 0)
+    {
+        p_output.frequency.clear();
+        p_output.amplitude.clear();
+        p_output.peakIndex = 0;
+        return;
+    }
+    std::vector<std::complex<double>> bins;
+    std::vector<std::complex<double>> scratch;
+    computeAmplitudes(p_signal, p_size, bins, scratch, p_output.amplitude);
+    finishSpectrum(p_size, p_sampleRate, p_output);
+}
+
+SpectrumMonitor::SpectrumMonitor(const double p_sampleRate, const size_t p_frameSize)
+    : m_sampleRate(p_sampleRate), m_frameSize(std::max<size_t>(p_frameSize, 2)), m_frame(m_frameSize), m_frameFill(0),
+      m_amplitudeSum(m_frameSize / 2), m_frameCount(0)
+{
+}
+
+void SpectrumMonitor::write(const double *p_samples, const size_t p_count)
+{
+    size_t copied = 0;
+    while (copied < p_count)
+    {
+        size_t count = std::min(p_count - copied, m_frameSize - m_frameFill);
+        std::copy(p_samples + copied, p_samples + copied + count, m_frame.data() + m_frameFill);
+        m_frameFill += count;
+        copied += count;
+        if (m_frameFill == m_frameSize)
+        {
+            closeFrame();
+        }
+    }
+}
+
+void SpectrumMonitor::closeFrame()
+{
+    const RealFftPlan &plan = getRealFftPlan(m_frameSize);
+    m_bins.resize(plan.getBinCount());
+    plan.transform(m_frame.data(), m_bins.data(), m_scratch);
+    for (size_t binIdx = 0; binIdx < m_amplitudeSum.size(); ++binIdx)
+    {
+        m_amplitudeSum[binIdx] += std::abs(m_bins[binIdx]) * 2.0 / m_frameSize;
+    }
+    ++m_frameCount;
+    m_frameFill = 0;
+}
+
+void SpectrumMonitor::getSpectrum(Spectrum &p_output)
+{
+    if (m_frameCount == 0)
+    {
+        computeSpectrum(m_frame.data(), m_frameFill, m_sampleRate, p_output);
+        return;
+    }
+    p_output.amplitude.resize(m_amplitudeSum.size());
+    for (size_t binIdx = 0; binIdx < m_amplitudeSum.size(); ++binIdx)
+    {
+        p_output.amplitude[binIdx] = m_amplitudeSum[binIdx] / m_frameCount;
+    }
+    finishSpectrum(m_frameSize, m_sampleRate, p_output);
+}
+
+void SpectrumMonitor::reset()
+{
+    m_frameFill = 0;
+    m_frameCount = 0;
+    std::fill(m_amplitudeSum.begin(), m_amplitudeSum.end(), 0.0);
+}
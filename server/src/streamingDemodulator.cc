@@ -0,0 +1,126 @@
+#include "streamingDemodulator.h"
+#include <algorithm>
+#include <cmath>
+
+StreamingDemodulator::StreamingDemodulator(const DemodulationReferences &p_references, const unsigned int p_bitsPerSymbol,
+                                           const size_t p_samplesPerSymbol, const double p_sampleRate,
+                                           SymbolDecider p_decider, BitSink p_sink)
+    : m_references(p_references), m_bitsPerSymbol(p_bitsPerSymbol), m_samplesPerSymbol(p_samplesPerSymbol),
+      m_decider(std::move(p_decider)), m_sink(std::move(p_sink)), m_partial{}, m_partialTones{}, m_toneAngle{},
+      m_windowFill(0), m_sampleClock(0), m_symbolIndex(0), m_errorCount(0)
+{
+    for (size_t toneIdx = 0; toneIdx < m_references.toneCount; ++toneIdx)
+    {
+        m_windowClocks[toneIdx].configure(m_references.frequency[toneIdx], p_sampleRate);
+        m_toneAngle[toneIdx] = 2 * M_PI * m_references.frequency[toneIdx] / p_sampleRate;
+    }
+    m_toneDetector.configure(m_references.frequency, m_references.toneCount, p_sampleRate);
+}
+
+void StreamingDemodulator::write(const double *p_samples, const size_t p_count)
+{
+    if (m_samplesPerSymbol == 0)
+    {
+        return;
+    }
+    size_t consumed = 0;
+    while (consumed < p_count)
+    {
+        // Correlate the part of the block that belongs to the open window against the matching part of the references
+        const double *segment = p_samples + consumed;
+        size_t count = std::min(p_count - consumed, m_samplesPerSymbol - m_windowFill);
+        if (m_references.needsEnvelope)
+        {
+            m_partial.absolute += sumAbsolute(segment, count);
+        }
+        if (m_references.needsTonePower)
+        {
+            // The DFT of the segment starts at its own first sample, turned back to the start of the window
+            std::complex<double> tones[GOERTZEL_MAX_TONES];
+            m_toneDetector.correlate(segment, count, tones);
+            for (size_t toneIdx = 0; toneIdx < m_references.toneCount; ++toneIdx)
+            {
+                m_partialTones[toneIdx] += std::polar(1.0, -m_toneAngle[toneIdx] * m_windowFill) * tones[toneIdx];
+            }
+        }
+        else
+        {
+            for (size_t toneIdx = 0; toneIdx < m_references.toneCount; ++toneIdx)
+            {
+                const ReferenceWaveform &reference = *m_references.reference[toneIdx];
+                double inPhase = 0.0;
+                double quadrature = 0.0;
+                correlateQuadrature(segment, reference.inPhase.data() + m_windowFill,
+                                    reference.quadrature.data() + m_windowFill, count, inPhase, quadrature);
+                m_partial.inPhase[toneIdx] += inPhase;
+                m_partial.quadrature[toneIdx] += quadrature;
+            }
+        }
+        m_windowFill += count;
+        m_sampleClock += count;
+        consumed += count;
+        if (m_windowFill == m_samplesPerSymbol)
+        {
+            closeWindow();
+        }
+    }
+    if (!m_bits.empty())
+    {
+        m_sink(m_bits);
+        m_bits.clear();
+    }
+}
+
+void StreamingDemodulator::closeWindow()
+{
+    WindowCorrelation correlation = m_partial;
+    for (size_t toneIdx = 0; toneIdx < m_references.toneCount; ++toneIdx)
+    {
+        correlation.power[toneIdx] = std::norm(m_partialTones[toneIdx]);
+        m_partialTones[toneIdx] = 0.0;
+        m_windowClocks[toneIdx].seek(m_symbolIndex * m_samplesPerSymbol);
+        rotateCorrelation(m_windowClocks[toneIdx].getPhase(), correlation.inPhase[toneIdx], correlation.quadrature[toneIdx]);
+    }
+    unsigned int symbol = 0;
+    if (!m_decider(correlation, symbol))
+    {
+        symbol = 0;
+        ++m_errorCount;
+    }
+    for (unsigned int bitIdx = m_bitsPerSymbol; bitIdx > 0; --bitIdx)
+    {
+        m_bits.pushBack((symbol >> (bitIdx - 1)) & 1);
+    }
+    ++m_symbolIndex;
+    m_windowFill = 0;
+    m_partial = WindowCorrelation{};
+}
+
+void StreamingDemodulator::reset()
+{
+    m_partial = WindowCorrelation{};
+    for (std::complex<double> &tone : m_partialTones)
+    {
+        tone = 0.0;
+    }
+    m_windowFill = 0;
+    m_sampleClock = 0;
+    m_symbolIndex = 0;
+    m_errorCount = 0;
+    m_bits.clear();
+}
+
+uint64_t StreamingDemodulator::getSampleCount() const
+{
+    return m_sampleClock;
+}
+
+uint64_t StreamingDemodulator::getSymbolCount() const
+{
+    return m_symbolIndex;
+}
+
+uint64_t StreamingDemodulator::getErrorCount() const
+{
+    return m_errorCount;
+}
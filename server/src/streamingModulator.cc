@@ -0,0 +1,152 @@
+#include "streamingModulator.h"
+#include <algorithm>
+#include <cstring>
+
+StreamingModulator::StreamingModulator(const WaveformTable &p_waveforms, const unsigned int p_bitsPerSymbol,
+                                       const size_t p_samplesPerSymbol, SampleSink p_sink, const size_t p_blockSize)
+    : m_waveforms(&p_waveforms), m_bitsPerSymbol(p_bitsPerSymbol), m_samplesPerSymbol(p_samplesPerSymbol),
+      m_sink(std::move(p_sink)), m_blockSize(std::max<size_t>(p_blockSize, 1)), m_block(m_blockSize), m_blockFill(0),
+      m_symbolWindow(p_samplesPerSymbol), m_pendingSymbol(0), m_pendingBits(0), m_symbolIndex(0), m_threadPool(nullptr)
+{
+}
+
+void StreamingModulator::write(const BitStream &p_bits)
+{
+    size_t position = 0;
+    if (m_threadPool != nullptr)
+    {
+        // Complete the symbol left open by the previous write, the rest starts on a symbol boundary
+        for (; m_pendingBits != 0 && position < p_bits.size(); ++position)
+        {
+            addPendingBit(p_bits.get(position));
+        }
+        if (m_pendingBits == 0)
+        {
+            emitBatches(p_bits, position);
+        }
+    }
+    if (m_bitsPerSymbol == 1)
+    {
+        for (; position < p_bits.size(); ++position)
+        {
+            emitSymbol(p_bits.get(position));
+        }
+        return;
+    }
+    for (; position < p_bits.size(); ++position)
+    {
+        addPendingBit(p_bits.get(position));
+    }
+}
+
+void StreamingModulator::setThreadPool(ThreadPool *p_threadPool)
+{
+    m_threadPool = p_threadPool;
+}
+
+void StreamingModulator::addPendingBit(const bool p_bit)
+{
+    m_pendingSymbol = (m_pendingSymbol << 1) | p_bit;
+    if (++m_pendingBits == m_bitsPerSymbol)
+    {
+        emitSymbol(m_pendingSymbol);
+        m_pendingSymbol = 0;
+        m_pendingBits = 0;
+    }
+}
+
+void StreamingModulator::emitSymbol(const unsigned int p_symbol)
+{
+    if (m_blockSize - m_blockFill >= m_samplesPerSymbol)
+    {
+        m_waveforms->writeSymbol(m_symbolIndex, p_symbol, m_block.data() + m_blockFill);
+        m_blockFill += m_samplesPerSymbol;
+        if (m_blockFill == m_blockSize)
+        {
+            emitBlock();
+        }
+    }
+    else
+    {
+        // The window straddles the end of the block, split it over as many blocks as needed
+        m_waveforms->writeSymbol(m_symbolIndex, p_symbol, m_symbolWindow.data());
+        appendSamples(m_symbolWindow.data(), m_samplesPerSymbol);
+    }
+    ++m_symbolIndex;
+}
+
+void StreamingModulator::emitBatches(const BitStream &p_bits, size_t &p_position)
+{
+    if (m_samplesPerSymbol == 0)
+    {
+        return;
+    }
+    // One batch spans about one block per thread, so memory stays independent of the payload
+    size_t batchSymbols = std::max(PARALLEL_MODULATION_MIN_SYMBOLS,
+                                   m_threadPool->getThreadCount() * m_blockSize / m_samplesPerSymbol);
+    while ((p_bits.size() - p_position) / m_bitsPerSymbol >= PARALLEL_MODULATION_MIN_SYMBOLS)
+    {
+        size_t symbolCount = std::min(batchSymbols, (p_bits.size() - p_position) / m_bitsPerSymbol);
+        m_batch.resize(symbolCount * m_samplesPerSymbol);
+        size_t firstBit = p_position;
+        m_threadPool->parallelFor(symbolCount, [&](size_t p_begin, size_t p_end)
+                                  {
+                                      for (size_t symbolIdx = p_begin; symbolIdx < p_end; ++symbolIdx)
+                                      {
+                                          unsigned int symbol = p_bits.getBits(firstBit + symbolIdx * m_bitsPerSymbol, m_bitsPerSymbol);
+                                          m_waveforms->writeSymbol(m_symbolIndex + symbolIdx, symbol,
+                                                                   m_batch.data() + symbolIdx * m_samplesPerSymbol);
+                                      } });
+        appendSamples(m_batch.data(), m_batch.size());
+        m_symbolIndex += symbolCount;
+        p_position += symbolCount * m_bitsPerSymbol;
+    }
+}
+
+void StreamingModulator::appendSamples(const double *p_samples, const size_t p_count)
+{
+    size_t copied = 0;
+    while (copied < p_count)
+    {
+        size_t count = std::min(p_count - copied, m_blockSize - m_blockFill);
+        std::memcpy(m_block.data() + m_blockFill, p_samples + copied, count * sizeof(double));
+        m_blockFill += count;
+        copied += count;
+        if (m_blockFill == m_blockSize)
+        {
+            emitBlock();
+        }
+    }
+}
+
+void StreamingModulator::emitBlock()
+{
+    m_sink(m_block.data(), m_blockFill);
+    m_blockFill = 0;
+}
+
+void StreamingModulator::flush()
+{
+    if (m_blockFill != 0)
+    {
+        emitBlock();
+    }
+}
+
+void StreamingModulator::reset()
+{
+    m_blockFill = 0;
+    m_pendingSymbol = 0;
+    m_pendingBits = 0;
+    m_symbolIndex = 0;
+}
+
+uint64_t StreamingModulator::getSymbolCount() const
+{
+    return m_symbolIndex;
+}
+
+unsigned int StreamingModulator::getPendingBits() const
+{
+    return m_pendingBits;
+}
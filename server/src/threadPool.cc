@@ -0,0 +1,131 @@
+#include "threadPool.h"
+#include <algorithm>
+
+ThreadPool::ThreadPool(const size_t p_threadCount) : m_queuedTasks(0), m_isStopping(false)
+{
+    size_t threadCount = std::max<size_t>(p_threadCount, 1);
+    for (size_t queueIdx = 0; queueIdx < threadCount; ++queueIdx)
+    {
+        m_queues.push_back(std::make_unique<WorkQueue>());
+    }
+    // The caller of parallelFor() is thread 0
+    for (size_t queueIdx = 1; queueIdx < threadCount; ++queueIdx)
+    {
+        m_workers.emplace_back(&ThreadPool::runWorker, this, queueIdx);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_isStopping = true;
+    }
+    m_taskReady.notify_all();
+    for (std::thread &worker : m_workers)
+    {
+        worker.join();
+    }
+}
+
+size_t ThreadPool::getThreadCount() const
+{
+    return m_queues.size();
+}
+
+void ThreadPool::parallelFor(const size_t p_count, const std::function<void(size_t, size_t)> &p_body)
+{
+    size_t rangeCount = std::min(getThreadCount() * THREAD_POOL_RANGES_PER_THREAD, p_count);
+    if (getThreadCount() == 1 || rangeCount <= 1)
+    {
+        if (p_count != 0)
+        {
+            p_body(0, p_count);
+        }
+        return;
+    }
+
+    std::mutex doneMutex;
+    std::condition_variable doneSignal;
+    size_t remaining = rangeCount;
+    for (size_t rangeIdx = 0; rangeIdx < rangeCount; ++rangeIdx)
+    {
+        size_t begin = p_count * rangeIdx / rangeCount;
+        size_t end = p_count * (rangeIdx + 1) / rangeCount;
+        // Deal the ranges round robin, so every thread starts on its own share
+        WorkQueue &queue = *m_queues[rangeIdx % m_queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        ++m_queuedTasks;
+        queue.tasks.push_back([&, begin, end]()
+                              {
+                                  p_body(begin, end);
+                                  std::lock_guard<std::mutex> doneLock(doneMutex);
+                                  if (--remaining == 0)
+                                  {
+                                      doneSignal.notify_one();
+                                  } });
+    }
+    {
+        // A worker checks the counter under this lock before sleeping, so it cannot miss the notification
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+    }
+    m_taskReady.notify_all();
+
+    // Work instead of waiting while any range is still queued
+    while (runTask(0))
+    {
+    }
+    std::unique_lock<std::mutex> doneLock(doneMutex);
+    doneSignal.wait(doneLock, [&remaining]()
+                    { return remaining == 0; });
+}
+
+void ThreadPool::runWorker(const size_t p_queueIdx)
+{
+    while (true)
+    {
+        if (runTask(p_queueIdx))
+        {
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_taskReady.wait(lock, [this]()
+                         { return m_isStopping || m_queuedTasks != 0; });
+        if (m_isStopping && m_queuedTasks == 0)
+        {
+            return;
+        }
+    }
+}
+
+bool ThreadPool::runTask(const size_t p_queueIdx)
+{
+    std::function<void()> task;
+    for (size_t offset = 0; offset < m_queues.size() && !task; ++offset)
+    {
+        WorkQueue &queue = *m_queues[(p_queueIdx + offset) % m_queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty())
+        {
+            continue;
+        }
+        // The own queue is used as a stack for locality, stolen ranges are taken from the other end
+        if (offset == 0)
+        {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        }
+        else
+        {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+        --m_queuedTasks;
+    }
+    if (!task)
+    {
+        return false;
+    }
+    task();
+    return true;
+}
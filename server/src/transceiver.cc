@@ -0,0 +1,278 @@
+#include "transceiver.h"
+#include <algorithm>
+#include <optional>
+
+void writeInputSamples(std::ofstream &p_file, const double *p_samples, size_t p_count);
+
+Transceiver::Transceiver(ThreadPool *p_threadPool, const bool p_isBaseband, const uint64_t p_noiseSeed,
+                         const uint64_t p_noiseStream, const std::string &p_fileSuffix)
+    : m_fileSuffix(p_fileSuffix), m_isBaseband(p_isBaseband)
+{
+    m_modulator = std::make_unique<Modulator>();
+    m_modulator.get()->setThreadPool(p_threadPool);
+    m_antenna = std::make_unique<Antenna>();
+    m_antenna.get()->loadFilter();
+    if (p_noiseSeed != 0)
+    {
+        m_antenna.get()->seedNoise(p_noiseSeed, p_noiseStream);
+    }
+    m_spectrumMonitor = std::make_unique<SpectrumMonitor>(m_modulator.get()->getSampleRate());
+}
+
+void Transceiver::transmit(const ModulationType p_type, const SampleSink &p_sink)
+{
+    if (p_type != ModulationType::OFDM)
+    {
+        StreamingModulator stream = m_modulator.get()->openStream(p_type, p_sink);
+        stream.write(m_bitBuffer);
+        stream.flush();
+        return;
+    }
+    m_modulator.get()->setBinaryInput(m_bitBuffer);
+    m_modulator.get()->modulate(p_type, m_signalBuffer);
+    for (size_t position = 0; position < m_signalBuffer.size(); position += STREAMING_BLOCK_SAMPLES)
+    {
+        p_sink(m_signalBuffer.data() + position, std::min(STREAMING_BLOCK_SAMPLES, m_signalBuffer.size() - position));
+    }
+}
+
+void Transceiver::encodePayload(Carrier &p_carrier, const unsigned int p_bitsPerSymbol)
+{
+    if (p_carrier.getFec() == FecType::NONE)
+    {
+        return;
+    }
+    convolutionalEncode(m_bitBuffer, m_codedBits);
+    size_t symbolCount = (m_codedBits.size() + p_bitsPerSymbol - 1) / p_bitsPerSymbol;
+    m_codedBits.resize(symbolCount * p_bitsPerSymbol);
+    std::swap(m_bitBuffer, m_codedBits);
+}
+
+void Transceiver::decodePayload(Carrier &p_carrier, const size_t p_bitCount)
+{
+    if (p_carrier.getFec() == FecType::NONE)
+    {
+        return;
+    }
+    if (!m_softBits.empty())
+    {
+        m_viterbi.decode(m_softBits.data(), m_softBits.size(), p_bitCount, m_receivedBits);
+        return;
+    }
+    // A scheme that rejected the burst gave no bit, the decoder then sees erasures only
+    std::swap(m_receivedBits, m_codedBits);
+    m_viterbi.decode(m_codedBits, p_bitCount, m_receivedBits);
+}
+
+void Transceiver::logSpectrum(const std::string &p_direction)
+{
+    m_spectrumMonitor.get()->getSpectrum(m_spectrum);
+    if (m_spectrum.amplitude.empty())
+    {
+        return;
+    }
+    g_serverLogger.info(stringify("Spectrum peak of ", p_direction, " burst: ", m_spectrum.frequency[m_spectrum.peakIndex],
+                                  " Hz, amplitude ", m_spectrum.amplitude[m_spectrum.peakIndex]));
+}
+
+void Transceiver::receivePassband(Carrier &p_carrier, const ModulationType p_type, std::ofstream &p_filteredFile,
+                                  std::ofstream &p_noiseFile)
+{
+    // Every block goes through the channel and the receiver as soon as it is modulated,
+    // OFDM symbols are demodulated as a whole once the burst has gone through the channel
+    std::optional<StreamingDemodulator> receiver;
+    if (p_type != ModulationType::OFDM)
+    {
+        receiver.emplace(m_modulator.get()->openDemodulationStream(p_type, [&](const BitStream &p_bits)
+                                                                   { m_receivedBits.append(p_bits); }));
+    }
+    m_antenna.get()->resetFilter();
+    auto receiveBlock = [&](double *p_samples, size_t p_count)
+    {
+        writeInputSamples(p_filteredFile, p_samples, p_count);
+        m_antenna.get()->addNoise(p_samples, p_count);
+        writeInputSamples(p_noiseFile, p_samples, p_count);
+        m_spectrumMonitor.get()->write(p_samples, p_count);
+        m_antenna.get()->filterNoise(p_samples, p_count);
+        if (receiver)
+        {
+            receiver->write(p_samples, p_count);
+        }
+    };
+    transmit(p_type, receiveBlock);
+    if (!receiver)
+    {
+        // The blocks were filtered in place, so the burst buffer holds the received signal
+        if (p_carrier.getFec() != FecType::NONE)
+        {
+            m_modulator.get()->demodulateSoft(m_signalBuffer.data(), m_signalBuffer.size(), p_type, m_softBits);
+        }
+        else
+        {
+            m_modulator.get()->demodulate(m_signalBuffer.data(), m_signalBuffer.size(), p_type, m_receivedBits);
+        }
+    }
+}
+
+void Transceiver::receiveBaseband(Carrier &p_carrier, const ModulationType p_type, std::ofstream &p_filteredFile,
+                                  std::ofstream &p_noiseFile)
+{
+    Modulator &modulator = *m_modulator.get();
+    modulator.setBinaryInput(m_bitBuffer);
+    size_t size = modulator.modulateBaseband(p_type, m_basebandBuffer);
+    bool isExported = p_filteredFile.is_open() || p_noiseFile.is_open();
+    if (isExported)
+    {
+        modulator.openUpconverter().write(m_basebandBuffer.data(), size, m_signalBuffer);
+        writeInputSamples(p_filteredFile, m_signalBuffer.data(), m_signalBuffer.size());
+    }
+    m_antenna.get()->addNoise(m_basebandBuffer.data(), size,
+                              static_cast<double>(BASEBAND_SAMPLES_PER_SYMBOL) / modulator.getSamplesPerSymbol());
+    if (isExported)
+    {
+        modulator.openUpconverter().write(m_basebandBuffer.data(), size, m_signalBuffer);
+        writeInputSamples(p_noiseFile, m_signalBuffer.data(), m_signalBuffer.size());
+        m_spectrumMonitor.get()->write(m_signalBuffer.data(), m_signalBuffer.size());
+    }
+    m_antenna.get()->filterNoise(m_basebandBuffer.data(), size,
+                                 2 * M_PI * p_carrier.getFrequency() / modulator.getSampleRate());
+    if (p_carrier.getFec() != FecType::NONE)
+    {
+        modulator.demodulateBasebandSoft(m_basebandBuffer.data(), size, p_type, m_softBits);
+    }
+    else
+    {
+        modulator.demodulateBaseband(m_basebandBuffer.data(), size, p_type, m_receivedBits);
+    }
+}
+
+std::string Transceiver::downlink(Carrier &p_carrier, const std::string &p_binaryData)
+{
+    std::string message;
+    // Validate and pack the ASCII bits in one pass, the modulator only sees the packed stream
+    if (!m_bitBuffer.assignAscii(p_binaryData))
+    {
+        message = "Data received is not a binary string";
+        return message;
+    }
+    std::cout << "Received binary data: " << p_binaryData << std::endl;
+    ModulationType modulationType = p_carrier.getModulationType();
+    // QAM symbols and OFDM subcarriers carry several bits each
+    unsigned int bitsPerSymbol = getBitsPerSymbol(modulationType);
+    // Coded bits are padded to whole symbols, so only uncoded payloads must fill them
+    bool isCoded = p_carrier.getFec() != FecType::NONE;
+    if (!isCoded && bitsPerSymbol > 1 && p_binaryData.length() % bitsPerSymbol != 0)
+    {
+        message = stringify("Binary data length must be a multiple of ", bitsPerSymbol, " for ",
+                            toNetwork(modulationType), ".");
+        g_serverLogger.error(message);
+        return message;
+    }
+    encodePayload(p_carrier, bitsPerSymbol);
+    m_modulator.get()->setFrequency(p_carrier.getFrequency());
+    std::ofstream filteredFile;
+    std::ofstream noiseFile;
+    if (openInputFile(filteredFile, true))
+    {
+        g_serverLogger.info("Open file inputFiltered successfully");
+    }
+    else
+    {
+        g_serverLogger.error("Fail to open file for wave inputFiltered data");
+    }
+    if (openInputFile(noiseFile, false))
+    {
+        g_serverLogger.info("Open file inputNoise successfully");
+    }
+    else
+    {
+        g_serverLogger.error("Fail to open file for wave inputNoise data");
+    }
+    // Modulate block by block straight into the files, memory does not grow with the payload
+    auto writeBlock = [&](double *p_samples, size_t p_count)
+    {
+        writeInputSamples(filteredFile, p_samples, p_count);
+        m_antenna.get()->addNoise(p_samples, p_count);
+        writeInputSamples(noiseFile, p_samples, p_count);
+        m_spectrumMonitor.get()->write(p_samples, p_count);
+    };
+    m_spectrumMonitor.get()->reset();
+    transmit(modulationType, writeBlock);
+    logSpectrum("DL");
+    std::optional<std::pair<std::string, std::string>> dlParam = std::make_pair(p_binaryData, std::to_string(p_carrier.getFrequency()));
+    m_antenna.get()->visualizeData(dlParam, m_fileSuffix);
+    return message;
+}
+
+std::string Transceiver::uplink(Carrier &p_carrier)
+{
+    ModulationType modulationType = p_carrier.getModulationType();
+    int bitSize = 13 * getBitsPerSymbol(modulationType);
+    m_antenna.get()->randomBitStream(bitSize, m_bitBuffer);
+    std::string binaryGenerated = m_bitBuffer.toAscii();
+    std::cout << "Generated data: " << binaryGenerated << std::endl;
+    encodePayload(p_carrier, getBitsPerSymbol(modulationType));
+    m_modulator.get()->setFrequency(p_carrier.getFrequency());
+    std::ofstream filteredFile;
+    std::ofstream noiseFile;
+    if (openInputFile(filteredFile, true))
+    {
+        g_serverLogger.info("Open file inputFilter is successfull");
+    }
+    else
+    {
+        g_serverLogger.error("Fail to open file for wave inputFilter data");
+    }
+    if (openInputFile(noiseFile, false))
+    {
+        g_serverLogger.info("Open file inputNoise is successfull");
+    }
+    else
+    {
+        g_serverLogger.error("Fail to open file for wave inputNoise data");
+    }
+    m_receivedBits.clear();
+    m_softBits.clear();
+    m_spectrumMonitor.get()->reset();
+    if (m_isBaseband && modulationType != ModulationType::OFDM)
+    {
+        receiveBaseband(p_carrier, modulationType, filteredFile, noiseFile);
+    }
+    else
+    {
+        receivePassband(p_carrier, modulationType, filteredFile, noiseFile);
+    }
+    logSpectrum("UL");
+    decodePayload(p_carrier, bitSize);
+    m_receivedBits.toAscii(m_binaryBuffer);
+    g_serverLogger.info(binaryGenerated);
+    m_antenna.get()->visualizeData(std::nullopt, m_fileSuffix);
+    return m_binaryBuffer;
+}
+
+bool Transceiver::openInputFile(std::ofstream &p_file, const bool p_isFilter)
+{
+    std::string inputFilePathKey;
+    if (!p_isFilter)
+    {
+        inputFilePathKey = "/inputNoise";
+    }
+    else
+    {
+        inputFilePathKey = "/inputFiltered";
+    }
+    const char *inputFilePath = "";
+    auto var = InMemDatabase::getInstance().getValue(inputFilePathKey);
+    extractValue<char const *>(var, inputFilePath);
+    std::string strInputFilePath(inputFilePath);
+    p_file.open(addFileSuffix(strInputFilePath, m_fileSuffix));
+    return p_file.is_open();
+}
+
+void writeInputSamples(std::ofstream &p_file, const double *p_samples, size_t p_count)
+{
+    for (size_t sampleIdx = 0; sampleIdx < p_count; ++sampleIdx)
+    {
+        p_file << p_samples[sampleIdx] << '\n';
+    }
+}
@@ -0,0 +1,99 @@
+#include "waveformCache.h"
+#include "oscillator.h"
+#include <cmath>
+#include <cstring>
+
+WaveformTable::WaveformTable(const WaveformKey &p_key, const std::vector<SymbolShape> &p_shapes,
+                             const size_t p_samplesPerSymbol)
+    : m_key(p_key), m_shapes(p_shapes), m_samplesPerSymbol(p_samplesPerSymbol), m_phaseCount(0)
+{
+    if (m_shapes.empty() || m_samplesPerSymbol == 0)
+    {
+        return;
+    }
+    size_t symbolSamples = m_shapes.size() * m_samplesPerSymbol;
+    m_phaseCount = findPhasePeriod(WAVEFORM_CACHE_MAX_SAMPLES / symbolSamples);
+    m_samples.resize(m_phaseCount * symbolSamples);
+    for (size_t phaseIdx = 0; phaseIdx < m_phaseCount; ++phaseIdx)
+    {
+        for (unsigned int symbol = 0; symbol < m_shapes.size(); ++symbol)
+        {
+            generateSymbol(phaseIdx, symbol, &m_samples[(phaseIdx * m_shapes.size() + symbol) * m_samplesPerSymbol]);
+        }
+    }
+}
+
+size_t WaveformTable::findPhasePeriod(const size_t p_maxPeriod) const
+{
+    for (size_t period = 1; period <= p_maxPeriod; ++period)
+    {
+        bool isWholeCycles = true;
+        for (const SymbolShape &shape : m_shapes)
+        {
+            // Carrier cycles elapsed over `period` symbol windows
+            double cycles = period * shape.frequencyIndex * m_key.carrierFrequency * m_samplesPerSymbol / m_key.sampleRate;
+            if (std::fabs(cycles - std::round(cycles)) > WAVEFORM_PHASE_EPSILON)
+            {
+                isWholeCycles = false;
+                break;
+            }
+        }
+        if (isWholeCycles)
+        {
+            return period;
+        }
+    }
+    return 0;
+}
+
+void WaveformTable::generateSymbol(const uint64_t p_symbolIndex, const unsigned int p_symbol, double *p_output) const
+{
+    const SymbolShape &shape = m_shapes[p_symbol];
+    Oscillator tone(shape.frequencyIndex * m_key.carrierFrequency, m_key.sampleRate, shape.phase);
+    tone.seek(p_symbolIndex * m_samplesPerSymbol);
+    tone.generate(p_output, m_samplesPerSymbol, shape.inPhase, shape.quadrature);
+}
+
+bool WaveformTable::isCached() const
+{
+    return m_phaseCount != 0;
+}
+
+void WaveformTable::writeSymbol(const uint64_t p_symbolIndex, const unsigned int p_symbol, double *p_output) const
+{
+    if (!isCached())
+    {
+        generateSymbol(p_symbolIndex, p_symbol, p_output);
+        return;
+    }
+    size_t phaseIdx = p_symbolIndex % m_phaseCount;
+    const double *waveform = &m_samples[(phaseIdx * m_shapes.size() + p_symbol) * m_samplesPerSymbol];
+    std::memcpy(p_output, waveform, m_samplesPerSymbol * sizeof(double));
+}
+
+size_t WaveformTable::getPhaseCount() const
+{
+    return m_phaseCount;
+}
+
+const std::vector<SymbolShape> &WaveformTable::getShapes() const
+{
+    return m_shapes;
+}
+
+const WaveformTable *WaveformCache::find(const WaveformKey &p_key) const
+{
+    auto table = m_tables.find(p_key);
+    return table == m_tables.end() ? nullptr : &table->second;
+}
+
+const WaveformTable &WaveformCache::insert(const WaveformKey &p_key, const std::vector<SymbolShape> &p_shapes,
+                                           const size_t p_samplesPerSymbol)
+{
+    return m_tables.insert_or_assign(p_key, WaveformTable(p_key, p_shapes, p_samplesPerSymbol)).first->second;
+}
+
+void WaveformCache::clear()
+{
+    m_tables.clear();
+}
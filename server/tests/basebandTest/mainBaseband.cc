@@ -0,0 +1,120 @@
+#include "modulator.h"
+#include "serverCommon.h"
+#include <gtest/gtest.h>
+#include <random>
+
+/// @brief The database directory of server, relative to the tests directory
+constexpr const char *TEST_DATABASE_PATH = "../db";
+
+/// @brief Schemes with a baseband form
+constexpr ModulationType BASEBAND_TYPES[] = {ModulationType::ASK, ModulationType::BPSK, ModulationType::BFSK,
+                                             ModulationType::QAM16, ModulationType::QAM64, ModulationType::QAM256};
+
+/// @brief Testing environment class for baseband to be able to work with Database
+class BasebandTestingEnvironment : public ::testing::Environment
+{
+public:
+    void SetUp() override
+    {
+        InMemDatabase::getInstance().init(TEST_DATABASE_PATH);
+    }
+};
+
+/// @brief Test every scheme gives back the binary data from BASEBAND_SAMPLES_PER_SYMBOL samples per window
+TEST(BasebandTest, roundTrip)
+{
+    Modulator generator;
+    std::string binaryData = generator.randomBinaryMessageGenerator(480);
+    for (double frequency : {1.0, 3.0, 5.0, 10.0})
+    {
+        Modulator modulator(frequency, binaryData);
+        for (ModulationType type : BASEBAND_TYPES)
+        {
+            std::vector<IqSample> signal;
+            ASSERT_EQ(modulator.modulateBaseband(type, signal), binaryData.size() / getBitsPerSymbol(type) * BASEBAND_SAMPLES_PER_SYMBOL);
+            EXPECT_EQ(signal.size(), modulator.getBasebandSize(type));
+            BitStream bits;
+            modulator.demodulateBaseband(signal.data(), signal.size(), type, bits);
+            EXPECT_EQ(bits.toAscii(), binaryData) << toNetwork(type) << " at " << frequency << " Hz";
+        }
+    }
+}
+
+/// @brief Test the up-converted signal of the single point schemes is the passband signal
+TEST(BasebandTest, upconvertMatchesPassband)
+{
+    const std::string binaryData = "011010011100010110010110001110100110100111000101";
+    for (double frequency : {3.0, 5.0})
+    {
+        Modulator modulator(frequency, binaryData);
+        for (ModulationType type : {ModulationType::ASK, ModulationType::BPSK, ModulationType::QAM16, ModulationType::QAM64})
+        {
+            std::vector<double> expected;
+            modulator.modulate(type, expected);
+            std::vector<IqSample> baseband;
+            modulator.modulateBaseband(type, baseband);
+            // Two writes continue the carrier phase
+            Upconverter upconverter = modulator.openUpconverter();
+            size_t half = baseband.size() / BASEBAND_SAMPLES_PER_SYMBOL / 2 * BASEBAND_SAMPLES_PER_SYMBOL;
+            std::vector<double> first;
+            std::vector<double> second;
+            upconverter.write(baseband.data(), half, first);
+            upconverter.write(baseband.data() + half, baseband.size() - half, second);
+            first.insert(first.end(), second.begin(), second.end());
+            ASSERT_EQ(first.size(), expected.size());
+            for (size_t sampleIdx = 0; sampleIdx < expected.size(); ++sampleIdx)
+            {
+                ASSERT_NEAR(first[sampleIdx], expected[sampleIdx], 1e-5) << toNetwork(type) << " sample " << sampleIdx;
+            }
+        }
+    }
+}
+
+/// @brief Test the baseband equivalent of the antenna noise and filter keeps every scheme decodable
+TEST(BasebandTest, noisyChannel)
+{
+    Modulator generator;
+    std::string binaryData = generator.randomBinaryMessageGenerator(960);
+    Modulator modulator(5.0, binaryData);
+    // Same noise per symbol window and filter gain at the carrier as the antenna
+    double deviation = 0.07 * std::sqrt(2.0 * BASEBAND_SAMPLES_PER_SYMBOL / modulator.getSamplesPerSymbol());
+    IqSample gain(0.7 + 0.3 * std::polar(1.0, -2 * M_PI * 5.0 / modulator.getSampleRate()));
+    std::mt19937 engine(7);
+    std::normal_distribution<float> noise(0.0f, deviation);
+    for (ModulationType type : BASEBAND_TYPES)
+    {
+        std::vector<IqSample> signal;
+        modulator.modulateBaseband(type, signal);
+        for (IqSample &sample : signal)
+        {
+            float inPhase = noise(engine);
+            sample = (sample + IqSample(inPhase, noise(engine))) * gain;
+        }
+        BitStream bits;
+        modulator.demodulateBaseband(signal.data(), signal.size(), type, bits);
+        EXPECT_EQ(bits.toAscii(), binaryData) << toNetwork(type);
+    }
+}
+
+/// @brief Test OFDM and unknown schemes have no baseband form
+TEST(BasebandTest, unsupportedScheme)
+{
+    Modulator modulator(5.0, "1101");
+    std::vector<IqSample> signal(4);
+    BitStream bits(4);
+    for (ModulationType type : {ModulationType::OFDM, ModulationType::UNKNOWN})
+    {
+        EXPECT_EQ(modulator.getBasebandSize(type), 0);
+        EXPECT_EQ(modulator.modulateBaseband(type, signal), 0);
+        EXPECT_TRUE(signal.empty());
+        EXPECT_EQ(modulator.demodulateBaseband(signal.data(), signal.size(), type, bits), 0);
+        EXPECT_TRUE(bits.empty());
+    }
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    ::testing::AddGlobalTestEnvironment(new BasebandTestingEnvironment);
+    return RUN_ALL_TESTS();
+}
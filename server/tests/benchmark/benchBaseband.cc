@@ -0,0 +1,65 @@
+#include "modulator.h"
+#include "serverCommon.h"
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/// @brief The database directory of server, relative to the tests directory
+constexpr const char *BENCH_DATABASE_PATH = "../db";
+
+/// @brief The carrier frequency of the benchmark, 1000 passband samples per symbol window
+constexpr double BENCH_FREQUENCY = 5.0;
+
+/// @brief The amount of bits of the burst, a multiple of every QAM order
+constexpr size_t BENCH_BITS = 24 * 256;
+
+/// @brief The amount of round trips per measurement
+constexpr size_t BENCH_CALLS = 5;
+
+template <typename Function>
+double measureMillisecondsPerCall(Function p_function)
+{
+    // Warm up the caches before timing
+    p_function();
+    auto start = std::chrono::steady_clock::now();
+    for (size_t callIdx = 0; callIdx < BENCH_CALLS; ++callIdx)
+    {
+        p_function();
+    }
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / BENCH_CALLS;
+}
+
+/**
+ * @brief Compare the modulation and demodulation of one burst on passband and on complex baseband samples
+ */
+int main()
+{
+    InMemDatabase::getInstance().init(BENCH_DATABASE_PATH);
+    Modulator generator;
+    Modulator modulator(BENCH_FREQUENCY, generator.randomBinaryMessageGenerator(BENCH_BITS));
+
+    std::cout << "scheme  passband samples, ms  baseband samples, ms\n";
+    for (ModulationType type : {ModulationType::ASK, ModulationType::BPSK, ModulationType::BFSK, ModulationType::QAM16,
+                                ModulationType::QAM256})
+    {
+        std::vector<double> signal;
+        BitStream bits;
+        double passbandTime = measureMillisecondsPerCall([&]()
+                                                         { modulator.modulate(type, signal);
+                                                           modulator.demodulate(signal.data(), signal.size(), type, bits); });
+        std::vector<IqSample> baseband;
+        double basebandTime = measureMillisecondsPerCall([&]()
+                                                         { modulator.modulateBaseband(type, baseband);
+                                                           modulator.demodulateBaseband(baseband.data(), baseband.size(), type, bits); });
+        if (bits.size() != BENCH_BITS)
+        {
+            std::cout << toNetwork(type) << " round trip failed\n";
+            return 1;
+        }
+        std::cout << toNetwork(type) << "  " << signal.size() << ", " << passbandTime << "  " << baseband.size() << ", "
+                  << basebandTime << "\n";
+    }
+    return 0;
+}
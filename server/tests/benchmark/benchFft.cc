@@ -0,0 +1,53 @@
+#include "fft.h"
+#include "spectrum.h"
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+/// @brief The amount of spectrums per measurement
+constexpr size_t BENCH_CALLS = 2000;
+
+/// @brief The sample rate of the server database
+constexpr double BENCH_SAMPLE_RATE = 5000.0;
+
+template <typename Function>
+double measureMicrosecondsPerCall(Function p_function)
+{
+    // Warm up the caches and the plan cache before timing
+    p_function();
+    auto start = std::chrono::steady_clock::now();
+    for (size_t callIdx = 0; callIdx < BENCH_CALLS; ++callIdx)
+    {
+        p_function();
+    }
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / BENCH_CALLS;
+}
+
+int main()
+{
+    std::cout << "samples  complex us/transform  real us/transform  spectrum us/call\n";
+    // Powers of 4 and 2, then sizes of one second of signal and a burst which need the mixed radix stages
+    for (size_t size : std::vector<size_t>{1024, 4096, 8192, 5000, 13000})
+    {
+        std::vector<double> signal(size);
+        std::vector<std::complex<double>> complexSignal(size);
+        for (size_t sampleIdx = 0; sampleIdx < size; ++sampleIdx)
+        {
+            signal[sampleIdx] = std::cos(2.0 * M_PI * 5.0 * sampleIdx / BENCH_SAMPLE_RATE);
+            complexSignal[sampleIdx] = signal[sampleIdx];
+        }
+        std::vector<std::complex<double>> bins(size);
+        std::vector<std::complex<double>> scratch;
+        Spectrum spectrum;
+        double complexTime = measureMicrosecondsPerCall([&]()
+                                                        { getFftPlan(size).transform(complexSignal.data(), bins.data()); });
+        double realTime = measureMicrosecondsPerCall([&]()
+                                                     { getRealFftPlan(size).transform(signal.data(), bins.data(), scratch); });
+        double spectrumTime = measureMicrosecondsPerCall([&]()
+                                                         { computeSpectrum(signal.data(), size, BENCH_SAMPLE_RATE, spectrum); });
+        std::cout << size << "     " << complexTime << "     " << realTime << "     " << spectrumTime << "\n";
+    }
+    return 0;
+}
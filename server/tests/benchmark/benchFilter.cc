@@ -0,0 +1,88 @@
+#include "filter.h"
+#include "simd.h"
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+/// @brief The amount of samples of one burst, a 256-QAM burst of 6144 bits at 1000 samples per window
+constexpr size_t BENCH_SAMPLES = 768000;
+
+/// @brief The amount of bursts per measurement
+constexpr size_t BENCH_CALLS = 5;
+
+/// @brief The amount of samples filtered per call, the size of a streaming block
+constexpr size_t BENCH_BLOCK_SIZE = 4096;
+
+template <typename Function>
+double measureMillisecondsPerCall(Function p_function)
+{
+    // Warm up the caches before timing
+    p_function();
+    auto start = std::chrono::steady_clock::now();
+    for (size_t callIdx = 0; callIdx < BENCH_CALLS; ++callIdx)
+    {
+        p_function();
+    }
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / BENCH_CALLS;
+}
+
+/**
+ * @brief Filter a burst block by block
+ *
+ * @param p_filter - the filter
+ * @param p_signal - the burst, filtered in place
+ */
+template <typename Filter>
+void filterBurst(Filter &p_filter, std::vector<double> &p_signal)
+{
+    for (size_t blockStart = 0; blockStart < p_signal.size(); blockStart += BENCH_BLOCK_SIZE)
+    {
+        p_filter.process(p_signal.data() + blockStart, std::min(BENCH_BLOCK_SIZE, p_signal.size() - blockStart));
+    }
+}
+
+/**
+ * @brief Compare the former scalar 2-tap loop of the antenna with the FIR kernels and a biquad cascade
+ */
+int main()
+{
+    std::vector<double> signal(BENCH_SAMPLES);
+    for (size_t sampleIdx = 0; sampleIdx < BENCH_SAMPLES; ++sampleIdx)
+    {
+        signal[sampleIdx] = (sampleIdx % 97) / 97.0 - 0.5;
+    }
+
+    double emaTime = measureMillisecondsPerCall([&]()
+                                                {
+                                                    double previous = signal[0];
+                                                    for (size_t sampleIdx = 1; sampleIdx < signal.size(); ++sampleIdx)
+                                                    {
+                                                        double current = signal[sampleIdx];
+                                                        signal[sampleIdx] = 0.7 * current + 0.3 * previous;
+                                                        previous = current;
+                                                    } });
+    std::cout << "scalar 2-tap loop: " << emaTime << " ms, " << BENCH_SAMPLES / emaTime / 1000.0 << " Msamples/s\n";
+
+    SimdLevel bestLevel = getSimdLevel();
+    for (size_t tapCount : {2, 16, 63})
+    {
+        FirFilter filter(tapCount == 2 ? std::vector<double>{0.7, 0.3} : designLowPass(500.0, 5000.0, tapCount));
+        for (SimdLevel level : {SimdLevel::SCALAR, SimdLevel::SSE2, SimdLevel::AVX2})
+        {
+            setSimdLevel(level);
+            double time = measureMillisecondsPerCall([&]()
+                                                     { filterBurst(filter, signal); });
+            std::cout << "FIR " << tapCount << " taps " << toString(getSimdLevel()) << ": " << time << " ms, "
+                      << BENCH_SAMPLES / time / 1000.0 << " Msamples/s\n";
+        }
+    }
+    setSimdLevel(bestLevel);
+
+    BiquadCascade cascade({designLowPassBiquad(500.0, 5000.0, 0.54), designLowPassBiquad(500.0, 5000.0, 1.31)});
+    double biquadTime = measureMillisecondsPerCall([&]()
+                                                   { filterBurst(cascade, signal); });
+    std::cout << "biquad 2 sections: " << biquadTime << " ms, " << BENCH_SAMPLES / biquadTime / 1000.0
+              << " Msamples/s\n";
+    return 0;
+}
@@ -0,0 +1,145 @@
+#include "modulator.h"
+#include "noiseGenerator.h"
+#include "serverCommon.h"
+#include "simd.h"
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+/// @brief The database directory of server, relative to the tests directory
+constexpr const char *BENCH_DATABASE_PATH = "../db";
+
+/// @brief The carrier frequency of the benchmark, 1000 samples per symbol window
+constexpr double BENCH_FREQUENCY = 5.0;
+
+/// @brief The amount of bits of the burst
+constexpr size_t BENCH_BITS = 4096;
+
+/// @brief The amount of repetitions per measurement
+constexpr size_t BENCH_CALLS = 5;
+
+/// @brief The amount of noisy bursts per bit error rate
+constexpr size_t BENCH_NOISY_BURSTS = 10;
+
+template <typename Function>
+double measureMillisecondsPerCall(Function p_function)
+{
+    // Warm up the caches before timing
+    p_function();
+    auto start = std::chrono::steady_clock::now();
+    for (size_t callIdx = 0; callIdx < BENCH_CALLS; ++callIdx)
+    {
+        p_function();
+    }
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / BENCH_CALLS;
+}
+
+/**
+ * @brief Count the bits differing between two streams of the same size
+ *
+ * @param p_bits - demodulated bits
+ * @param p_expected - transmitted bits
+ * @return the amount of bit errors, every bit if the sizes differ
+ */
+size_t countBitErrors(const BitStream &p_bits, const BitStream &p_expected)
+{
+    if (p_bits.size() != p_expected.size())
+    {
+        return p_expected.size();
+    }
+    size_t errors = 0;
+    for (size_t bitIdx = 0; bitIdx < p_bits.size(); ++bitIdx)
+    {
+        errors += p_bits.get(bitIdx) != p_expected.get(bitIdx);
+    }
+    return errors;
+}
+
+/**
+ * @brief Bit error rate of both detectors through Gaussian noise
+ *
+ * @param p_modulator - modulator of the burst
+ * @param p_signal - the burst
+ * @param p_bits - the bits of the burst
+ * @param p_deviation - deviation of the noise
+ * @param p_detector - the detector
+ * @return the amount of bit errors divided by the amount of bits
+ */
+double measureBitErrorRate(Modulator &p_modulator, const std::vector<double> &p_signal, const BitStream &p_bits,
+                           const double p_deviation, const FskDetector p_detector)
+{
+    // The same noise for both detectors
+    NoiseGenerator noiseGenerator(1);
+    std::vector<double> noise(p_signal.size());
+    std::vector<double> channel(p_signal.size());
+    BitStream demodulated;
+    p_modulator.setFskDetector(p_detector);
+    size_t errors = 0;
+    for (size_t burstIdx = 0; burstIdx < BENCH_NOISY_BURSTS; ++burstIdx)
+    {
+        noiseGenerator.fill(noise.data(), noise.size(), p_deviation);
+        for (size_t sampleIdx = 0; sampleIdx < channel.size(); ++sampleIdx)
+        {
+            channel[sampleIdx] = p_signal[sampleIdx] + noise[sampleIdx];
+        }
+        p_modulator.demodulate(channel.data(), channel.size(), ModulationType::BFSK, demodulated);
+        errors += countBitErrors(demodulated, p_bits);
+    }
+    return static_cast<double>(errors) / (BENCH_NOISY_BURSTS * p_bits.size());
+}
+
+/**
+ * @brief Compare the coherent correlator and the Goertzel detector on BFSK: speed, then bit error rate
+ * with the transmitter in phase and with a phase offset
+ */
+int main()
+{
+    InMemDatabase::getInstance().init(BENCH_DATABASE_PATH);
+    Modulator generator;
+    BitStream bits;
+    bits.assignAscii(generator.randomBinaryMessageGenerator(BENCH_BITS));
+    Modulator modulator(BENCH_FREQUENCY, "0");
+    modulator.setBinaryInput(bits);
+    std::vector<double> signal;
+    modulator.modulate(ModulationType::BFSK, signal);
+    BitStream demodulated;
+
+    SimdLevel bestLevel = getSimdLevel();
+    std::cout << "detector  level  demodulate, ms  Msamples/s\n";
+    for (FskDetector detector : {FskDetector::CORRELATOR, FskDetector::GOERTZEL})
+    {
+        modulator.setFskDetector(detector);
+        for (SimdLevel level : {SimdLevel::SCALAR, SimdLevel::SSE2, SimdLevel::AVX2})
+        {
+            setSimdLevel(level);
+            double time = measureMillisecondsPerCall([&]()
+                                                     { modulator.demodulate(signal.data(), signal.size(),
+                                                                            ModulationType::BFSK, demodulated); });
+            std::cout << (detector == FskDetector::GOERTZEL ? FSK_DETECTOR_GOERTZEL : FSK_DETECTOR_CORRELATOR) << "  "
+                      << toString(getSimdLevel()) << "  " << time << "  " << signal.size() / time / 1000.0 << "\n";
+        }
+    }
+    setSimdLevel(bestLevel);
+
+    // The same tones a quarter of a period off the modulator phase, as a receiver without carrier phase recovery sees them
+    size_t samplesPerSymbol = modulator.getSamplesPerSymbol();
+    double sampleRate = modulator.getSampleRate();
+    std::vector<double> shifted(signal.size());
+    for (size_t sampleIdx = 0; sampleIdx < shifted.size(); ++sampleIdx)
+    {
+        double tone = bits.get(sampleIdx / samplesPerSymbol) ? 2.0 : 1.0;
+        shifted[sampleIdx] = std::cos(2 * M_PI * tone * BENCH_FREQUENCY * sampleIdx / sampleRate - M_PI);
+    }
+
+    std::cout << "noise deviation  correlator BER  goertzel BER  correlator BER (phase offset)  goertzel BER (phase offset)\n";
+    for (double deviation : {4.0, 6.0, 8.0, 10.0})
+    {
+        std::cout << deviation << "  " << measureBitErrorRate(modulator, signal, bits, deviation, FskDetector::CORRELATOR)
+                  << "  " << measureBitErrorRate(modulator, signal, bits, deviation, FskDetector::GOERTZEL) << "  "
+                  << measureBitErrorRate(modulator, shifted, bits, deviation, FskDetector::CORRELATOR) << "  "
+                  << measureBitErrorRate(modulator, shifted, bits, deviation, FskDetector::GOERTZEL) << "\n";
+    }
+    return 0;
+}
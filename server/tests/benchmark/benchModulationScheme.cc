@@ -0,0 +1,63 @@
+#include "modulator.h"
+#include "serverCommon.h"
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+/// @brief The database directory of server, relative to the tests directory
+constexpr const char *BENCH_DATABASE_PATH = "../db";
+
+/// @brief The carrier frequency of the benchmark, the highest one keeps the symbol windows short
+constexpr double BENCH_FREQUENCY = 1000.0;
+
+/// @brief A short payload, so the per-call dispatch is a visible part of the cost, a multiple of every QAM order
+constexpr const char *BENCH_BINARY_DATA = "011010011100010110010110001110100110100111000101";
+
+/// @brief The amount of modulate/demodulate calls per run
+constexpr size_t BENCH_CALLS = 200000;
+
+template <typename Function>
+double measureNanosecondsPerCall(Function p_function)
+{
+    // Warm up the caches before timing
+    p_function();
+    auto start = std::chrono::steady_clock::now();
+    for (size_t callIdx = 0; callIdx < BENCH_CALLS; ++callIdx)
+    {
+        p_function();
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / BENCH_CALLS;
+}
+
+int main()
+{
+    InMemDatabase::getInstance().init(BENCH_DATABASE_PATH);
+    Modulator modulator(BENCH_FREQUENCY, BENCH_BINARY_DATA);
+    std::vector<double> signal(modulator.getModulatedSize(ModulationType::ASK));
+    BitStream bits;
+
+    std::cout << "scheme  modulate ns/call (network string, bound scheme)  demodulate ns/call (network string, bound scheme)\n";
+    for (ModulationType type : {ModulationType::ASK, ModulationType::BPSK, ModulationType::BFSK, ModulationType::QAM16,
+                                ModulationType::QAM64, ModulationType::QAM256})
+    {
+        const std::string network = toNetwork(type);
+        double stringModulate = measureNanosecondsPerCall([&]()
+                                                          { modulator.modulate(network, signal.data(), signal.size()); });
+        double boundModulate = measureNanosecondsPerCall([&]()
+                                                         { modulator.modulate(type, signal.data(), signal.size()); });
+        size_t signalSize = modulator.getModulatedSize(type);
+        double stringDemodulate = measureNanosecondsPerCall([&]()
+                                                            { modulator.demodulate(signal.data(), signalSize, network, bits); });
+        double boundDemodulate = measureNanosecondsPerCall([&]()
+                                                           { modulator.demodulate(signal.data(), signalSize, type, bits); });
+        if (bits.toAscii() != BENCH_BINARY_DATA)
+        {
+            std::cout << network << " round trip failed\n";
+            return 1;
+        }
+        std::cout << network << "      " << stringModulate << ", " << boundModulate << "      "
+                  << stringDemodulate << ", " << boundDemodulate << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,70 @@
+#include "noiseGenerator.h"
+#include "simd.h"
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+/// @brief The amount of samples of one burst, a 256-QAM burst of 6144 bits at 1000 samples per window
+constexpr size_t BENCH_SAMPLES = 768000;
+
+/// @brief The amount of bursts per measurement
+constexpr size_t BENCH_CALLS = 5;
+
+/// @brief The deviation of the noise, as in the antenna
+constexpr double BENCH_DEVIATION = 0.07;
+
+template <typename Function>
+double measureMillisecondsPerCall(Function p_function)
+{
+    // Warm up the caches before timing
+    p_function();
+    auto start = std::chrono::steady_clock::now();
+    for (size_t callIdx = 0; callIdx < BENCH_CALLS; ++callIdx)
+    {
+        p_function();
+    }
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / BENCH_CALLS;
+}
+
+/**
+ * @brief Compare the noise of one burst drawn from the standard library and from NoiseGenerator
+ */
+int main()
+{
+    std::vector<double> signal(BENCH_SAMPLES, 0.5);
+    std::default_random_engine engine(1);
+    double standardTime = measureMillisecondsPerCall([&]()
+                                                     {
+                                                         std::normal_distribution<double> distribution(0.0, BENCH_DEVIATION);
+                                                         for (double &sample : signal)
+                                                         {
+                                                             sample += distribution(engine);
+                                                         } });
+    std::cout << "std::normal_distribution: " << standardTime << " ms, "
+              << BENCH_SAMPLES / standardTime / 1000.0 << " Msamples/s\n";
+
+    SimdLevel bestLevel = getSimdLevel();
+    std::vector<double> noise(NOISE_BLOCK_SIZE);
+    for (SimdLevel level : {SimdLevel::SCALAR, SimdLevel::SSE2, SimdLevel::AVX2})
+    {
+        setSimdLevel(level);
+        NoiseGenerator generator(1);
+        double time = measureMillisecondsPerCall([&]()
+                                                 {
+                                                     for (size_t blockStart = 0; blockStart < BENCH_SAMPLES; blockStart += NOISE_BLOCK_SIZE)
+                                                     {
+                                                         size_t blockSize = std::min(NOISE_BLOCK_SIZE, BENCH_SAMPLES - blockStart);
+                                                         generator.fill(noise.data(), blockSize, BENCH_DEVIATION);
+                                                         for (size_t sampleIdx = 0; sampleIdx < blockSize; ++sampleIdx)
+                                                         {
+                                                             signal[blockStart + sampleIdx] += noise[sampleIdx];
+                                                         }
+                                                     } });
+        std::cout << "NoiseGenerator " << toString(getSimdLevel()) << ": " << time << " ms, "
+                  << BENCH_SAMPLES / time / 1000.0 << " Msamples/s\n";
+    }
+    setSimdLevel(bestLevel);
+    return 0;
+}
@@ -0,0 +1,64 @@
+#include "modulator.h"
+#include "serverCommon.h"
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/// @brief The database directory of server, relative to the tests directory
+constexpr const char *BENCH_DATABASE_PATH = "../db";
+
+/// @brief The carrier frequency of the benchmark, 1000 samples per symbol window at 5000 samples per second
+constexpr double BENCH_FREQUENCY = 5.0;
+
+/// @brief The amount of bits of the burst, 64 OFDM symbols
+constexpr size_t BENCH_BITS = 1 << 14;
+
+/// @brief The amount of round trips per measurement
+constexpr size_t BENCH_CALLS = 5;
+
+template <typename Function>
+double measureMillisecondsPerCall(Function p_function)
+{
+    // Warm up the caches and the plan cache before timing
+    p_function();
+    auto start = std::chrono::steady_clock::now();
+    for (size_t callIdx = 0; callIdx < BENCH_CALLS; ++callIdx)
+    {
+        p_function();
+    }
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / BENCH_CALLS;
+}
+
+/**
+ * @brief Compare OFDM with single carrier 16-QAM on the same burst: processing speed of one core and air time
+ */
+int main()
+{
+    InMemDatabase::getInstance().init(BENCH_DATABASE_PATH);
+    Modulator generator;
+    Modulator modulator(BENCH_FREQUENCY, generator.randomBinaryMessageGenerator(BENCH_BITS));
+    int sampleRate = modulator.getSampleRate();
+
+    std::cout << "scheme  samples  modulate ms  demodulate ms  processed kbit/s  air bit/s\n";
+    for (ModulationType type : {ModulationType::QAM16, ModulationType::OFDM})
+    {
+        std::vector<double> signal;
+        std::string received;
+        double modulateTime = measureMillisecondsPerCall([&]()
+                                                         { modulator.modulate(type, signal); });
+        double demodulateTime = measureMillisecondsPerCall([&]()
+                                                           { modulator.demodulate(signal, type, received); });
+        if (received.size() != BENCH_BITS)
+        {
+            std::cout << toNetwork(type) << " round trip failed\n";
+            return 1;
+        }
+        double processedRate = BENCH_BITS / (modulateTime + demodulateTime);
+        double airRate = BENCH_BITS * static_cast<double>(sampleRate) / signal.size();
+        std::cout << toNetwork(type) << "  " << signal.size() << "  " << modulateTime << "  " << demodulateTime
+                  << "  " << processedRate << "  " << airRate << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,72 @@
+#include "oscillator.h"
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+/// @brief The sample rate used in server database
+constexpr double BENCH_SAMPLE_RATE = 5000.0;
+
+/// @brief The carrier frequency of the benchmark (not phase coherent with the sample rate)
+constexpr double BENCH_FREQUENCY = 3.0;
+
+/// @brief The amount of samples generated per run
+constexpr size_t BENCH_SAMPLES = 1 << 24;
+
+/// @brief The phase used by the modulator for every carrier
+constexpr double BENCH_PHASE = -M_PI / 2;
+
+/**
+ * @brief Generate samples the way Modulator did before the oscillator:
+ * accumulate time and call cos for every sample
+ */
+void generateWithCos(std::vector<double> &p_signal)
+{
+    double time = 0.0;
+    double sampleDuration = 1.0 / BENCH_SAMPLE_RATE;
+    for (double &sample : p_signal)
+    {
+        sample = cos(2 * M_PI * BENCH_FREQUENCY * time + BENCH_PHASE);
+        time += sampleDuration;
+    }
+}
+
+template <typename Function>
+double measureSamplesPerSecond(Function p_function)
+{
+    auto start = std::chrono::steady_clock::now();
+    p_function();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return BENCH_SAMPLES / elapsed.count();
+}
+
+int main()
+{
+    std::vector<double> cosSignal(BENCH_SAMPLES);
+    std::vector<double> oscillatorSignal(BENCH_SAMPLES);
+
+    double cosRate = measureSamplesPerSecond([&]()
+                                             { generateWithCos(cosSignal); });
+    double oscillatorRate = measureSamplesPerSecond([&]()
+                                                    {
+        Oscillator carrier(BENCH_FREQUENCY, BENCH_SAMPLE_RATE, BENCH_PHASE);
+        carrier.generate(oscillatorSignal.data(), oscillatorSignal.size()); });
+
+    // Error against the old accumulated-time path, and against the exact sample time
+    double maxErrorToCosPath = 0.0;
+    double maxErrorToExact = 0.0;
+    for (size_t sampleIdx = 0; sampleIdx < BENCH_SAMPLES; ++sampleIdx)
+    {
+        double exact = cos(2 * M_PI * BENCH_FREQUENCY * sampleIdx / BENCH_SAMPLE_RATE + BENCH_PHASE);
+        maxErrorToCosPath = std::max(maxErrorToCosPath, std::fabs(oscillatorSignal[sampleIdx] - cosSignal[sampleIdx]));
+        maxErrorToExact = std::max(maxErrorToExact, std::fabs(oscillatorSignal[sampleIdx] - exact));
+    }
+
+    std::cout << "samples                 : " << BENCH_SAMPLES << "\n";
+    std::cout << "cos path   (samples/s)  : " << cosRate << "\n";
+    std::cout << "oscillator (samples/s)  : " << oscillatorRate << "\n";
+    std::cout << "speed up                : " << oscillatorRate / cosRate << "x\n";
+    std::cout << "max error vs cos path   : " << maxErrorToCosPath << "\n";
+    std::cout << "max error vs exact time : " << maxErrorToExact << " (bound " << OSCILLATOR_MAX_ERROR << ")\n";
+    return maxErrorToExact <= OSCILLATOR_MAX_ERROR ? 0 : 1;
+}
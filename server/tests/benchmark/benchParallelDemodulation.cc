@@ -0,0 +1,74 @@
+#include "modulator.h"
+#include "serverCommon.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/// @brief The database directory of server, relative to the tests directory
+constexpr const char *BENCH_DATABASE_PATH = "../db";
+
+/// @brief The carrier frequency of the benchmark, 50 samples per symbol window at 5000 samples per second
+constexpr double BENCH_FREQUENCY = 100.0;
+
+/// @brief The amount of bits of the UL capture, 3.3 million samples for the 1-bit schemes
+constexpr size_t BENCH_BITS = 1 << 16;
+
+/// @brief The amount of demodulations per measurement
+constexpr size_t BENCH_CALLS = 5;
+
+template <typename Function>
+double measureMillisecondsPerCall(Function p_function)
+{
+    // Warm up the caches before timing
+    p_function();
+    auto start = std::chrono::steady_clock::now();
+    for (size_t callIdx = 0; callIdx < BENCH_CALLS; ++callIdx)
+    {
+        p_function();
+    }
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / BENCH_CALLS;
+}
+
+/**
+ * @brief Demodulate a long capture with 1 to N threads, N given as argument or every hardware thread
+ */
+int main(int argc, char **argv)
+{
+    InMemDatabase::getInstance().init(BENCH_DATABASE_PATH);
+    size_t maxThreads = argc > 1 ? std::stoul(argv[1]) : std::max(1U, std::thread::hardware_concurrency());
+    std::string binaryData;
+    for (size_t bitIdx = 0; bitIdx < BENCH_BITS; ++bitIdx)
+    {
+        binaryData += (bitIdx * 7 + bitIdx / 3) % 2 ? '1' : '0';
+    }
+    Modulator modulator(BENCH_FREQUENCY, binaryData);
+    std::vector<double> signal;
+    BitStream bits;
+
+    std::cout << "scheme  threads  ms/demodulation  speedup\n";
+    for (ModulationType type : {ModulationType::ASK, ModulationType::BPSK, ModulationType::BFSK, ModulationType::QAM16})
+    {
+        modulator.setThreadPool(nullptr);
+        modulator.modulate(type, signal);
+        double serial = 0.0;
+        for (size_t threads = 1; threads <= maxThreads; ++threads)
+        {
+            ThreadPool pool(threads);
+            modulator.setThreadPool(&pool);
+            double elapsed = measureMillisecondsPerCall([&]()
+                                                        { modulator.demodulate(signal.data(), signal.size(), type, bits); });
+            modulator.setThreadPool(nullptr);
+            if (bits.toAscii() != binaryData)
+            {
+                std::cout << toNetwork(type) << " round trip failed on " << threads << " threads\n";
+                return 1;
+            }
+            serial = threads == 1 ? elapsed : serial;
+            std::cout << toNetwork(type) << "      " << threads << "        " << elapsed << "        " << serial / elapsed << "\n";
+        }
+    }
+    return 0;
+}
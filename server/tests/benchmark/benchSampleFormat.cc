@@ -0,0 +1,131 @@
+#include "modulator.h"
+#include "antenna.h"
+#include "serverCommon.h"
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/// @brief The database directory of server, relative to the tests directory
+constexpr const char *BENCH_DATABASE_PATH = "../db";
+
+/// @brief The carrier frequency of the benchmark, 1000 samples per symbol window
+constexpr double BENCH_FREQUENCY = 5.0;
+
+/// @brief The amount of bits of the burst, a multiple of every QAM order
+constexpr size_t BENCH_BITS = 24 * 64;
+
+/// @brief The amount of repetitions per measurement
+constexpr size_t BENCH_CALLS = 5;
+
+template <typename Function>
+double measureMillisecondsPerCall(Function p_function)
+{
+    // Warm up the caches before timing
+    p_function();
+    auto start = std::chrono::steady_clock::now();
+    for (size_t callIdx = 0; callIdx < BENCH_CALLS; ++callIdx)
+    {
+        p_function();
+    }
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / BENCH_CALLS;
+}
+
+/**
+ * @brief Count the bits differing between two streams of the same size
+ *
+ * @param p_bits - demodulated bits
+ * @param p_expected - transmitted bits
+ * @return the amount of bit errors, every bit if the sizes differ
+ */
+size_t countBitErrors(const BitStream &p_bits, const BitStream &p_expected)
+{
+    if (p_bits.size() != p_expected.size())
+    {
+        return p_expected.size();
+    }
+    size_t errors = 0;
+    for (size_t bitIdx = 0; bitIdx < p_bits.size(); ++bitIdx)
+    {
+        errors += p_bits.get(bitIdx) != p_expected.get(bitIdx);
+    }
+    return errors;
+}
+
+/**
+ * @brief Measure one sample format: conversion, channel and demodulation time, then the accuracy against double
+ *
+ * @param p_modulator - modulator holding the burst
+ * @param p_antenna - channel adding noise and filtering
+ * @param p_type - a modulation scheme
+ * @param p_reference - the burst modulated in double
+ * @param p_bits - the bits of the burst
+ */
+template <typename Sample>
+void benchFormat(Modulator &p_modulator, Antenna &p_antenna, const ModulationType p_type,
+                 const std::vector<double> &p_reference, const BitStream &p_bits)
+{
+    std::vector<Sample> signal(p_reference.size());
+    std::vector<Sample> channel(p_reference.size());
+    BitStream demodulated;
+    double convertTime = measureMillisecondsPerCall([&]()
+                                                    { toSamples(p_reference.data(), p_reference.size(), signal.data()); });
+    double channelTime = measureMillisecondsPerCall([&]()
+                                                    { channel = signal;
+                                                      p_antenna.resetFilter();
+                                                      p_antenna.addNoise(channel.data(), channel.size());
+                                                      p_antenna.filterNoise(channel.data(), channel.size()); });
+    double demodulateTime = measureMillisecondsPerCall([&]()
+                                                       { p_modulator.demodulate(channel.data(), channel.size(), p_type,
+                                                                                demodulated); });
+
+    double maxError = 0.0;
+    for (size_t sampleIdx = 0; sampleIdx < signal.size(); ++sampleIdx)
+    {
+        maxError = std::max(maxError, std::fabs(SampleFormat<Sample>::toAmplitude(signal[sampleIdx]) - p_reference[sampleIdx]));
+    }
+    p_modulator.demodulate(signal.data(), signal.size(), p_type, demodulated);
+    size_t cleanErrors = countBitErrors(demodulated, p_bits);
+    size_t noisyErrors = 0;
+    for (size_t callIdx = 0; callIdx < BENCH_CALLS; ++callIdx)
+    {
+        channel = signal;
+        p_antenna.resetFilter();
+        p_antenna.addNoise(channel.data(), channel.size());
+        p_antenna.filterNoise(channel.data(), channel.size());
+        p_modulator.demodulate(channel.data(), channel.size(), p_type, demodulated);
+        noisyErrors += countBitErrors(demodulated, p_bits);
+    }
+
+    std::cout << toNetwork(p_type) << "  " << SampleFormat<Sample>::NAME << "  " << sizeof(Sample) * signal.size() / 1024
+              << " KiB  " << convertTime << "  " << channelTime << "  " << demodulateTime << "  " << maxError << "  "
+              << cleanErrors << "  " << noisyErrors << "/" << BENCH_CALLS * p_bits.size() << "\n";
+}
+
+/**
+ * @brief Compare double, float and Q15 signals through the channel and the demodulator
+ */
+int main()
+{
+    InMemDatabase::getInstance().init(BENCH_DATABASE_PATH);
+    Modulator generator;
+    BitStream bits;
+    bits.assignAscii(generator.randomBinaryMessageGenerator(BENCH_BITS));
+    Modulator modulator(BENCH_FREQUENCY, "0");
+    modulator.setBinaryInput(bits);
+    Antenna antenna;
+
+    std::cout << "scheme  format  burst  convert, ms  noise + filter, ms  demodulate, ms  max error  clean bit errors"
+                 "  noisy bit errors\n";
+    for (ModulationType type : {ModulationType::BPSK, ModulationType::BFSK, ModulationType::QAM16, ModulationType::QAM64})
+    {
+        std::vector<double> reference;
+        modulator.modulate(type, reference);
+        benchFormat<double>(modulator, antenna, type, reference, bits);
+        benchFormat<float>(modulator, antenna, type, reference, bits);
+        benchFormat<Q15>(modulator, antenna, type, reference, bits);
+    }
+    return 0;
+}
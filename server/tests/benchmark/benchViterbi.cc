@@ -0,0 +1,73 @@
+#include "convolutionalCode.h"
+#include "simd.h"
+#include "softBits.h"
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+/// @brief The amount of payload bits of one call
+constexpr size_t BENCH_BITS = 1 << 20;
+
+/// @brief The amount of calls per measurement
+constexpr size_t BENCH_CALLS = 5;
+
+template <typename Function>
+double measureMillisecondsPerCall(Function p_function)
+{
+    // Warm up the caches before timing
+    p_function();
+    auto start = std::chrono::steady_clock::now();
+    for (size_t callIdx = 0; callIdx < BENCH_CALLS; ++callIdx)
+    {
+        p_function();
+    }
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / BENCH_CALLS;
+}
+
+/**
+ * @brief Measure the encoder and the decoder kernels of every instruction set on noisy soft bits
+ */
+int main()
+{
+    std::mt19937 engine(1);
+    BitStream payload;
+    payload.resize(BENCH_BITS);
+    for (size_t bitIdx = 0; bitIdx < BENCH_BITS; ++bitIdx)
+    {
+        payload.set(bitIdx, engine() & 1);
+    }
+    BitStream coded;
+    double encodeTime = measureMillisecondsPerCall([&]()
+                                                   { convolutionalEncode(payload, coded); });
+    std::cout << "encoder: " << encodeTime << " ms, " << BENCH_BITS / encodeTime / 1000.0 << " Mbit/s\n";
+
+    std::normal_distribution<float> noise(0.0f, 0.5f);
+    std::vector<float> llrs(coded.size());
+    for (size_t bitIdx = 0; bitIdx < coded.size(); ++bitIdx)
+    {
+        llrs[bitIdx] = 4.0f * ((coded.get(bitIdx) ? -1.0f : 1.0f) + noise(engine));
+    }
+    std::vector<int8_t> quantized(llrs.size());
+    quantizeLlrs(llrs.data(), llrs.size(), CONV_LLR_SCALE, quantized.data());
+
+    SimdLevel bestLevel = getSimdLevel();
+    ViterbiDecoder decoder;
+    BitStream decoded;
+    for (SimdLevel level : {SimdLevel::SCALAR, SimdLevel::SSE2, SimdLevel::AVX2})
+    {
+        setSimdLevel(level);
+        double time = measureMillisecondsPerCall([&]()
+                                                 { decoder.decode(quantized.data(), quantized.size(), BENCH_BITS, decoded); });
+        size_t errors = 0;
+        for (size_t bitIdx = 0; bitIdx < BENCH_BITS; ++bitIdx)
+        {
+            errors += decoded.get(bitIdx) != payload.get(bitIdx);
+        }
+        std::cout << "Viterbi " << toString(getSimdLevel()) << ": " << time << " ms, " << BENCH_BITS / time / 1000.0
+                  << " Mbit/s, " << errors << " bit errors\n";
+    }
+    setSimdLevel(bestLevel);
+    return 0;
+}
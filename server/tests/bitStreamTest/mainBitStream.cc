@@ -0,0 +1,90 @@
+#include "bitStream.h"
+#include "simd.h"
+#include <gtest/gtest.h>
+
+/// @brief Build a deterministic binary data series with a length that is not a multiple of 64
+std::string makeBinaryData(const size_t p_size)
+{
+    std::string binaryData(p_size, '0');
+    for (size_t bitIdx = 0; bitIdx < p_size; ++bitIdx)
+    {
+        if ((bitIdx * 7 + bitIdx / 5) % 3 == 0)
+        {
+            binaryData[bitIdx] = '1';
+        }
+    }
+    return binaryData;
+}
+
+/// @brief Test packing and unpacking give back the binary data at every instruction set level
+TEST(BitStreamTest, asciiRoundTrip)
+{
+    const SimdLevel detected = getSimdLevel();
+    for (SimdLevel level : {SimdLevel::SCALAR, SimdLevel::SSE2, SimdLevel::AVX2})
+    {
+        setSimdLevel(level);
+        for (size_t size : {0, 1, 15, 63, 64, 65, 200, 1027})
+        {
+            std::string binaryData = makeBinaryData(size);
+            BitStream bits;
+            ASSERT_TRUE(bits.assignAscii(binaryData)) << toString(getSimdLevel()) << " size " << size;
+            ASSERT_EQ(bits.size(), size);
+            EXPECT_EQ(bits.toAscii(), binaryData) << toString(getSimdLevel()) << " size " << size;
+
+            size_t bitIdx = 0;
+            for (bool bit : bits)
+            {
+                EXPECT_EQ(bit, binaryData[bitIdx] == '1');
+                ++bitIdx;
+            }
+            EXPECT_EQ(bitIdx, size);
+        }
+    }
+    setSimdLevel(detected);
+}
+
+/// @brief Test characters other than '0' and '1' are rejected wherever they are
+TEST(BitStreamTest, rejectInvalidCharacters)
+{
+    const SimdLevel detected = getSimdLevel();
+    for (SimdLevel level : {SimdLevel::SCALAR, SimdLevel::SSE2, SimdLevel::AVX2})
+    {
+        setSimdLevel(level);
+        for (size_t position : {0, 17, 63, 64, 130})
+        {
+            for (char invalid : {'2', '/', ' ', 'a', '\0', static_cast<char>(0xB1)})
+            {
+                std::string binaryData = makeBinaryData(131);
+                EXPECT_TRUE(isBinaryAscii(binaryData.data(), binaryData.size()));
+                binaryData[position] = invalid;
+                EXPECT_FALSE(isBinaryAscii(binaryData.data(), binaryData.size())) << toString(getSimdLevel());
+                BitStream bits;
+                EXPECT_FALSE(bits.assignAscii(binaryData)) << toString(getSimdLevel()) << " position " << position;
+                EXPECT_TRUE(bits.empty());
+            }
+        }
+    }
+    setSimdLevel(detected);
+}
+
+/// @brief Test symbols are read and written with the first bit as most significant, across words
+TEST(BitStreamTest, symbolAccess)
+{
+    BitStream bits(130);
+    bits.setBits(62, 0xB, 4);
+    EXPECT_EQ(bits.toAscii().substr(60, 8), "00101100");
+    EXPECT_EQ(bits.getBits(62, 4), 0xBU);
+    EXPECT_EQ(bits.getBits(63, 2), 0x1U);
+
+    bits.pushBack(true);
+    EXPECT_EQ(bits.size(), 131);
+    EXPECT_TRUE(bits.get(130));
+
+    // Shrinking clears the bits past the end, so streams with the same bits compare equal
+    bits.resize(64);
+    BitStream expected;
+    ASSERT_TRUE(expected.assignAscii(bits.toAscii()));
+    EXPECT_EQ(bits, expected);
+    bits.resize(66);
+    EXPECT_EQ(bits.getBits(62, 4), 0x8U);
+}
@@ -0,0 +1,142 @@
+#include "convolutionalCode.h"
+#include "noiseGenerator.h"
+#include "simd.h"
+#include "softBits.h"
+#include <gtest/gtest.h>
+#include <random>
+
+namespace
+{
+    /**
+     * @brief Draw a random payload
+     *
+     * @param p_size - the amount of bits
+     * @return the payload
+     */
+    BitStream randomPayload(const size_t p_size)
+    {
+        std::mt19937 engine(11);
+        BitStream bits;
+        bits.resize(p_size);
+        for (size_t bitIdx = 0; bitIdx < p_size; ++bitIdx)
+        {
+            bits.set(bitIdx, engine() & 1);
+        }
+        return bits;
+    }
+
+    /**
+     * @brief Encode a payload one bit at a time through the shift register
+     *
+     * @param p_input - the payload
+     * @return the coded bits
+     */
+    BitStream encodeSerial(const BitStream &p_input)
+    {
+        BitStream coded;
+        coded.resize(getConvolutionalCodedSize(p_input.size()));
+        unsigned int shiftRegister = 0;
+        for (size_t stepIdx = 0; stepIdx < p_input.size() + CONV_TAIL_BITS; ++stepIdx)
+        {
+            unsigned int bit = stepIdx < p_input.size() ? p_input.get(stepIdx) : 0;
+            shiftRegister = ((shiftRegister << 1) | bit) & ((1u << CONV_CONSTRAINT_LENGTH) - 1);
+            for (size_t codedIdx = 0; codedIdx < CONV_CODED_BITS; ++codedIdx)
+            {
+                coded.set(CONV_CODED_BITS * stepIdx + codedIdx, __builtin_parity(shiftRegister & CONV_POLYNOMIALS[codedIdx]));
+            }
+        }
+        return coded;
+    }
+}
+
+/// @brief Test the word at a time encoder against the shift register, across word boundaries
+TEST(ConvolutionalCodeTest, encoderMatchesShiftRegister)
+{
+    for (size_t size : {0, 1, 26, 27, 58, 63, 64, 65, 200})
+    {
+        BitStream payload = randomPayload(size);
+        BitStream coded;
+        convolutionalEncode(payload, coded);
+        EXPECT_EQ(coded, encodeSerial(payload)) << size;
+    }
+}
+
+/// @brief Test every instruction set decodes clean payloads and corrects scattered hard errors
+TEST(ConvolutionalCodeTest, decodeCorrectsErrors)
+{
+    SimdLevel bestLevel = getSimdLevel();
+    ViterbiDecoder decoder;
+    for (SimdLevel level : {SimdLevel::SCALAR, SimdLevel::SSE2, SimdLevel::AVX2})
+    {
+        setSimdLevel(level);
+        for (size_t size : {0, 1, 63, 64, 65, 1000})
+        {
+            BitStream payload = randomPayload(size);
+            BitStream coded;
+            convolutionalEncode(payload, coded);
+            BitStream decoded;
+            EXPECT_EQ(decoder.decode(coded, size, decoded), size);
+            EXPECT_EQ(decoded, payload) << toString(level) << " " << size;
+
+            // A free distance of 10 corrects any 4 errors close together, one error every 16 coded bits is far apart
+            for (size_t bitIdx = 5; bitIdx < coded.size(); bitIdx += 16)
+            {
+                coded.set(bitIdx, !coded.get(bitIdx));
+            }
+            decoder.decode(coded, size, decoded);
+            EXPECT_EQ(decoded, payload) << "errors " << toString(level) << " " << size;
+
+            // The last coded bits lost on the way are erasures
+            coded.resize(coded.size() - 4);
+            decoder.decode(coded, size, decoded);
+            EXPECT_EQ(decoded, payload) << "erasures " << toString(level) << " " << size;
+        }
+    }
+    setSimdLevel(bestLevel);
+}
+
+/// @brief Test soft bits under Gaussian noise give the same payload on every instruction set, fewer errors than hard bits
+TEST(ConvolutionalCodeTest, softDecisionOnEveryLevel)
+{
+    SimdLevel bestLevel = getSimdLevel();
+    const size_t size = 20000;
+    BitStream payload = randomPayload(size);
+    BitStream coded;
+    convolutionalEncode(payload, coded);
+    // BPSK points at +-1 with noise of deviation 0.8, ratios d1^2 - d0^2 = 4 * x
+    NoiseGenerator noise(21);
+    std::vector<float> llrs(coded.size());
+    BitStream hardBits;
+    hardBits.resize(coded.size());
+    for (size_t bitIdx = 0; bitIdx < coded.size(); ++bitIdx)
+    {
+        double point = (coded.get(bitIdx) ? -1.0 : 1.0) + 0.8 * noise.next();
+        llrs[bitIdx] = static_cast<float>(4.0 * point);
+        hardBits.set(bitIdx, point < 0.0);
+    }
+
+    ViterbiDecoder decoder;
+    setSimdLevel(SimdLevel::SCALAR);
+    BitStream reference;
+    decoder.decode(llrs.data(), llrs.size(), size, reference);
+    BitStream hardDecoded;
+    decoder.decode(hardBits, size, hardDecoded);
+    size_t softErrors = 0;
+    size_t hardErrors = 0;
+    for (size_t bitIdx = 0; bitIdx < size; ++bitIdx)
+    {
+        softErrors += reference.get(bitIdx) != payload.get(bitIdx);
+        hardErrors += hardDecoded.get(bitIdx) != payload.get(bitIdx);
+    }
+    EXPECT_LT(softErrors, hardErrors);
+    EXPECT_LT(softErrors, size / 100);
+
+    for (SimdLevel level : {SimdLevel::SSE2, SimdLevel::AVX2})
+    {
+        setSimdLevel(level);
+        BitStream decoded;
+        decoder.decode(llrs.data(), llrs.size(), size, decoded);
+        EXPECT_EQ(decoded, reference) << toString(level);
+    }
+    setSimdLevel(bestLevel);
+}
@@ -0,0 +1,114 @@
+#include "correlator.h"
+#include <gtest/gtest.h>
+#include <cmath>
+
+/// @brief Build a deterministic test signal with an odd length to exercise the kernel tails
+std::vector<double> makeTestSignal(const size_t p_size)
+{
+    std::vector<double> signal(p_size);
+    for (size_t sampleIdx = 0; sampleIdx < p_size; ++sampleIdx)
+    {
+        signal[sampleIdx] = sin(0.37 * sampleIdx) * 0.8 - 0.1 * cos(1.3 * sampleIdx);
+    }
+    return signal;
+}
+
+/// @brief Test every supported instruction set gives the same correlation as the scalar loop
+TEST(CorrelatorTest, kernelsMatchScalar)
+{
+    const size_t windowSize = 1666;
+    std::vector<double> signal = makeTestSignal(windowSize);
+    ReferenceWaveform reference = buildReferenceWaveform(3.0, 5000.0, -M_PI / 2, windowSize);
+
+    double expectedInPhase = 0.0;
+    double expectedQuadrature = 0.0;
+    double expectedAbsolute = 0.0;
+    for (size_t sampleIdx = 0; sampleIdx < windowSize; ++sampleIdx)
+    {
+        expectedInPhase += signal[sampleIdx] * reference.inPhase[sampleIdx];
+        expectedQuadrature += signal[sampleIdx] * reference.quadrature[sampleIdx];
+        expectedAbsolute += std::fabs(signal[sampleIdx]);
+    }
+
+    SimdLevel bestLevel = getSimdLevel();
+    for (SimdLevel level : {SimdLevel::SCALAR, SimdLevel::SSE2, SimdLevel::AVX2})
+    {
+        setSimdLevel(level);
+        double inPhase = 0.0;
+        double quadrature = 0.0;
+        correlateQuadrature(signal.data(), reference.inPhase.data(), reference.quadrature.data(), windowSize,
+                            inPhase, quadrature);
+        EXPECT_NEAR(inPhase, expectedInPhase, 1e-9) << toString(getSimdLevel());
+        EXPECT_NEAR(quadrature, expectedQuadrature, 1e-9) << toString(getSimdLevel());
+        EXPECT_NEAR(sumAbsolute(signal.data(), windowSize), expectedAbsolute, 1e-9) << toString(getSimdLevel());
+    }
+    setSimdLevel(bestLevel);
+    EXPECT_EQ(getSimdLevel(), bestLevel);
+}
+
+/// @brief Test the float and Q15 kernels of every instruction set stay close to the double correlation
+TEST(CorrelatorTest, sampleFormatKernels)
+{
+    const size_t windowSize = 1666;
+    std::vector<double> signal = makeTestSignal(windowSize);
+    ReferenceWaveform reference = buildReferenceWaveform(3.0, 5000.0, -M_PI / 2, windowSize);
+    double expectedInPhase = 0.0;
+    double expectedQuadrature = 0.0;
+    correlateQuadrature(signal.data(), reference.inPhase.data(), reference.quadrature.data(), windowSize,
+                        expectedInPhase, expectedQuadrature);
+    double expectedAbsolute = sumAbsolute(signal.data(), windowSize);
+
+    std::vector<float> floatSignal(windowSize);
+    std::vector<Q15> q15Signal(windowSize);
+    toSamples(signal.data(), windowSize, floatSignal.data());
+    toSamples(signal.data(), windowSize, q15Signal.data());
+    // Products of Q15 values are exact, so every instruction set gives the same Q15 correlation
+    double scalarQ15InPhase = 0.0;
+    double scalarQ15Quadrature = 0.0;
+
+    SimdLevel bestLevel = getSimdLevel();
+    for (SimdLevel level : {SimdLevel::SCALAR, SimdLevel::SSE2, SimdLevel::AVX2})
+    {
+        setSimdLevel(level);
+        double inPhase = 0.0;
+        double quadrature = 0.0;
+        correlateQuadrature(floatSignal.data(), reference.inPhaseFloat.data(), reference.quadratureFloat.data(),
+                            windowSize, inPhase, quadrature);
+        EXPECT_NEAR(inPhase, expectedInPhase, 1e-3) << toString(getSimdLevel());
+        EXPECT_NEAR(quadrature, expectedQuadrature, 1e-3) << toString(getSimdLevel());
+        EXPECT_NEAR(sumAbsolute(floatSignal.data(), windowSize), expectedAbsolute, 1e-3) << toString(getSimdLevel());
+
+        correlateQuadrature(q15Signal.data(), reference.inPhaseQ15.data(), reference.quadratureQ15.data(),
+                            windowSize, inPhase, quadrature);
+        EXPECT_NEAR(inPhase, expectedInPhase, 1e-2) << toString(getSimdLevel());
+        EXPECT_NEAR(quadrature, expectedQuadrature, 1e-2) << toString(getSimdLevel());
+        EXPECT_NEAR(sumAbsolute(q15Signal.data(), windowSize), expectedAbsolute, 1e-2) << toString(getSimdLevel());
+        if (level == SimdLevel::SCALAR)
+        {
+            scalarQ15InPhase = inPhase;
+            scalarQ15Quadrature = quadrature;
+        }
+        EXPECT_EQ(inPhase, scalarQ15InPhase) << toString(getSimdLevel());
+        EXPECT_EQ(quadrature, scalarQ15Quadrature) << toString(getSimdLevel());
+
+        // The absolute value of the most negative sample saturates instead of wrapping around
+        std::vector<Q15> fullScale(windowSize, INT16_MIN);
+        EXPECT_DOUBLE_EQ(sumAbsolute(fullScale.data(), windowSize), windowSize * INT16_MAX / SAMPLE_Q15_SCALE)
+            << toString(getSimdLevel());
+    }
+    setSimdLevel(bestLevel);
+}
+
+/// @brief Test the references hold the in-phase and quadrature carrier of one window
+TEST(CorrelatorTest, referenceWaveform)
+{
+    ReferenceWaveform reference = buildReferenceWaveform(5.0, 5000.0, 0.3, 1000);
+    ASSERT_EQ(reference.inPhase.size(), 1000);
+    ASSERT_EQ(reference.quadrature.size(), 1000);
+    for (size_t sampleIdx = 0; sampleIdx < 1000; ++sampleIdx)
+    {
+        double angle = 2 * M_PI * 5.0 * sampleIdx / 5000.0 + 0.3;
+        EXPECT_NEAR(reference.inPhase[sampleIdx], cos(angle), 1e-6);
+        EXPECT_NEAR(reference.quadrature[sampleIdx], sin(angle), 1e-6);
+    }
+}
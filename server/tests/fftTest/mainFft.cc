@@ -0,0 +1,124 @@
+#include "fft.h"
+#include "spectrum.h"
+#include <cmath>
+#include <gtest/gtest.h>
+
+/// @brief The tolerance of a transform against the direct sum, relative to the size
+constexpr double FFT_TOLERANCE = 1e-9;
+
+/// @brief Direct O(N^2) discrete Fourier transform
+std::vector<std::complex<double>> directTransform(const std::vector<std::complex<double>> &p_input)
+{
+    size_t size = p_input.size();
+    std::vector<std::complex<double>> output(size);
+    for (size_t binIdx = 0; binIdx < size; ++binIdx)
+    {
+        for (size_t pointIdx = 0; pointIdx < size; ++pointIdx)
+        {
+            double angle = -2.0 * M_PI * static_cast<double>((binIdx * pointIdx) % size) / size;
+            output[binIdx] += p_input[pointIdx] * std::complex<double>(std::cos(angle), std::sin(angle));
+        }
+    }
+    return output;
+}
+
+/// @brief Test the mixed-radix transform against the direct sum for radix 4, 2, 3 and prime sizes
+TEST(FftTest, matchesDirectTransform)
+{
+    for (size_t size : std::vector<size_t>{1, 2, 3, 4, 5, 6, 7, 8, 12, 16, 25, 30, 64, 97, 100, 250, 1024, 5000})
+    {
+        std::vector<std::complex<double>> input(size);
+        for (size_t pointIdx = 0; pointIdx < size; ++pointIdx)
+        {
+            input[pointIdx] = std::complex<double>(std::sin(0.3 * pointIdx) + 0.1 * pointIdx, std::cos(1.7 * pointIdx));
+        }
+        std::vector<std::complex<double>> expected = directTransform(input);
+        std::vector<std::complex<double>> output(size);
+        getFftPlan(size).transform(input.data(), output.data());
+        for (size_t binIdx = 0; binIdx < size; ++binIdx)
+        {
+            ASSERT_NEAR(std::abs(output[binIdx] - expected[binIdx]), 0.0, FFT_TOLERANCE * size) << size << " points, bin " << binIdx;
+        }
+    }
+}
+
+/// @brief Test the real-input transform gives the non-negative bins of the complex transform
+TEST(FftTest, realInput)
+{
+    std::vector<std::complex<double>> scratch;
+    for (size_t size : std::vector<size_t>{1, 2, 3, 9, 10, 64, 100, 4096, 5000})
+    {
+        std::vector<double> input(size);
+        std::vector<std::complex<double>> complexInput(size);
+        for (size_t pointIdx = 0; pointIdx < size; ++pointIdx)
+        {
+            input[pointIdx] = std::cos(0.01 * pointIdx * pointIdx) - 0.25;
+            complexInput[pointIdx] = input[pointIdx];
+        }
+        std::vector<std::complex<double>> expected(size);
+        getFftPlan(size).transform(complexInput.data(), expected.data());
+        const RealFftPlan &plan = getRealFftPlan(size);
+        ASSERT_EQ(plan.getBinCount(), size / 2 + 1);
+        std::vector<std::complex<double>> output(plan.getBinCount());
+        plan.transform(input.data(), output.data(), scratch);
+        for (size_t binIdx = 0; binIdx < output.size(); ++binIdx)
+        {
+            ASSERT_NEAR(std::abs(output[binIdx] - expected[binIdx]), 0.0, FFT_TOLERANCE * size) << size << " points, bin " << binIdx;
+        }
+    }
+}
+
+/// @brief Test plans are built once per size
+TEST(FftTest, planCache)
+{
+    EXPECT_EQ(&getFftPlan(48), &getFftPlan(48));
+    EXPECT_NE(&getFftPlan(48), &getFftPlan(96));
+    EXPECT_EQ(&getRealFftPlan(48), &getRealFftPlan(48));
+    EXPECT_EQ(getFftPlan(48).size(), 48);
+}
+
+/// @brief Test the frequencies follow numpy.fft.fftfreq
+TEST(FftTest, frequencies)
+{
+    std::vector<double> frequencies;
+    getFftFrequencies(5, 10.0, frequencies);
+    EXPECT_EQ(frequencies, (std::vector<double>{0.0, 2.0, 4.0, -4.0, -2.0}));
+    getFftFrequencies(4, 8.0, frequencies);
+    EXPECT_EQ(frequencies, (std::vector<double>{0.0, 2.0, -4.0, -2.0}));
+}
+
+/// @brief Test the spectrum of a tone peaks at its frequency with its amplitude
+TEST(FftTest, spectrumPeak)
+{
+    const double sampleRate = 5000.0;
+    std::vector<double> signal(5000);
+    for (size_t sampleIdx = 0; sampleIdx < signal.size(); ++sampleIdx)
+    {
+        signal[sampleIdx] = 1.5 * std::cos(2.0 * M_PI * 50.0 * sampleIdx / sampleRate) +
+                            0.5 * std::cos(2.0 * M_PI * 400.0 * sampleIdx / sampleRate);
+    }
+    Spectrum spectrum;
+    computeSpectrum(signal.data(), signal.size(), sampleRate, spectrum);
+    ASSERT_EQ(spectrum.amplitude.size(), 2500);
+    EXPECT_DOUBLE_EQ(spectrum.frequency[spectrum.peakIndex], 50.0);
+    EXPECT_NEAR(spectrum.amplitude[spectrum.peakIndex], 1.5, 1e-9);
+    EXPECT_NEAR(spectrum.amplitude[400], 0.5, 1e-9);
+
+    // The monitor averages whole frames and reads a short signal at its own length
+    SpectrumMonitor monitor(sampleRate, 1000);
+    for (size_t position = 0; position < signal.size(); position += 333)
+    {
+        monitor.write(signal.data() + position, std::min<size_t>(333, signal.size() - position));
+    }
+    Spectrum averaged;
+    monitor.getSpectrum(averaged);
+    ASSERT_EQ(averaged.amplitude.size(), 500);
+    EXPECT_DOUBLE_EQ(averaged.frequency[averaged.peakIndex], 50.0);
+    EXPECT_NEAR(averaged.amplitude[averaged.peakIndex], 1.5, 1e-9);
+
+    monitor.reset();
+    monitor.write(signal.data(), 500);
+    monitor.getSpectrum(averaged);
+    ASSERT_EQ(averaged.amplitude.size(), 250);
+    EXPECT_DOUBLE_EQ(averaged.frequency[averaged.peakIndex], 50.0);
+}
@@ -0,0 +1,194 @@
+#include "filter.h"
+#include "simd.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+    /**
+     * @brief A test signal: a slow sine with an alternating ripple
+     *
+     * @param p_size - the amount of samples
+     * @return the samples
+     */
+    std::vector<double> makeSignal(const size_t p_size)
+    {
+        std::vector<double> signal(p_size);
+        for (size_t sampleIdx = 0; sampleIdx < p_size; ++sampleIdx)
+        {
+            signal[sampleIdx] = std::sin(0.05 * sampleIdx) + 0.3 * ((sampleIdx * 7919) % 13 / 6.0 - 1.0);
+        }
+        return signal;
+    }
+
+    /**
+     * @brief Direct convolution, the inputs before the signal equal its first sample
+     *
+     * @param p_signal - the input
+     * @param p_taps - p_taps[k] multiplies the input k samples back
+     * @return the output
+     */
+    std::vector<double> convolve(const std::vector<double> &p_signal, const std::vector<double> &p_taps)
+    {
+        std::vector<double> output(p_signal.size());
+        for (size_t sampleIdx = 0; sampleIdx < p_signal.size(); ++sampleIdx)
+        {
+            for (size_t tapIdx = 0; tapIdx < p_taps.size(); ++tapIdx)
+            {
+                double input = tapIdx > sampleIdx ? p_signal[0] : p_signal[sampleIdx - tapIdx];
+                output[sampleIdx] += p_taps[tapIdx] * input;
+            }
+        }
+        return output;
+    }
+}
+
+/// @brief Test every FIR kernel against a direct convolution, for tap counts around the vector widths
+TEST(FilterTest, firMatchesConvolution)
+{
+    SimdLevel bestLevel = getSimdLevel();
+    std::vector<double> signal = makeSignal(1500);
+    for (size_t tapCount : {1, 2, 3, 7, 8, 31})
+    {
+        std::vector<double> taps = designLowPass(400.0, 5000.0, tapCount);
+        std::vector<double> expected = convolve(signal, taps);
+        for (SimdLevel level : {SimdLevel::SCALAR, SimdLevel::SSE2, SimdLevel::AVX2})
+        {
+            setSimdLevel(level);
+            FirFilter filter(taps);
+            std::vector<double> output = signal;
+            filter.process(output.data(), output.size());
+            for (size_t sampleIdx = 0; sampleIdx < output.size(); ++sampleIdx)
+            {
+                ASSERT_NEAR(output[sampleIdx], expected[sampleIdx], 1e-12)
+                    << toString(getSimdLevel()) << " taps " << tapCount << " sample " << sampleIdx;
+            }
+        }
+    }
+    setSimdLevel(bestLevel);
+}
+
+/// @brief Test filtering in blocks of any size gives the output of filtering the whole signal at once
+TEST(FilterTest, blocksContinueTheState)
+{
+    std::vector<double> signal = makeSignal(2000);
+    FilterBank filter(designRaisedCosine(0.35, 8, 6));
+    std::vector<double> expected = signal;
+    filter.process(expected.data(), expected.size());
+
+    filter.reset();
+    std::vector<double> output = signal;
+    for (size_t position = 0; position < output.size(); position += 37)
+    {
+        filter.process(output.data() + position, std::min<size_t>(37, output.size() - position));
+    }
+    for (size_t sampleIdx = 0; sampleIdx < output.size(); ++sampleIdx)
+    {
+        ASSERT_NEAR(output[sampleIdx], expected[sampleIdx], 1e-12) << sampleIdx;
+    }
+}
+
+/// @brief Test the default 2-tap filter of the antenna keeps the first sample and averages the next ones
+TEST(FilterTest, twoTapAverage)
+{
+    std::vector<double> signal = makeSignal(100);
+    FirFilter filter({0.7, 0.3});
+    std::vector<double> output = signal;
+    filter.process(output.data(), output.size());
+    EXPECT_DOUBLE_EQ(output[0], signal[0]);
+    for (size_t sampleIdx = 1; sampleIdx < output.size(); ++sampleIdx)
+    {
+        EXPECT_NEAR(output[sampleIdx], 0.7 * signal[sampleIdx] + 0.3 * signal[sampleIdx - 1], 1e-15);
+    }
+}
+
+/// @brief Test a biquad cascade against the direct form recursion, starting from a steady first sample
+TEST(FilterTest, biquadMatchesRecursion)
+{
+    std::vector<BiquadSection> sections = {designLowPassBiquad(300.0, 5000.0, 0.54),
+                                           designLowPassBiquad(300.0, 5000.0, 1.31)};
+    std::vector<double> signal = makeSignal(1000);
+    std::vector<double> expected = signal;
+    for (const BiquadSection &section : sections)
+    {
+        std::vector<double> input = expected;
+        double gain = (section.b0 + section.b1 + section.b2) / (1.0 + section.a1 + section.a2);
+        double input1 = input[0], input2 = input[0];
+        double output1 = gain * input[0], output2 = gain * input[0];
+        for (size_t sampleIdx = 0; sampleIdx < input.size(); ++sampleIdx)
+        {
+            double output = section.b0 * input[sampleIdx] + section.b1 * input1 + section.b2 * input2 -
+                            section.a1 * output1 - section.a2 * output2;
+            input2 = input1;
+            input1 = input[sampleIdx];
+            output2 = output1;
+            output1 = output;
+            expected[sampleIdx] = output;
+        }
+    }
+
+    FilterBank filter;
+    filter.setBiquad(sections);
+    std::vector<double> output = signal;
+    filter.process(output.data(), 300);
+    filter.process(output.data() + 300, output.size() - 300);
+    for (size_t sampleIdx = 0; sampleIdx < output.size(); ++sampleIdx)
+    {
+        ASSERT_NEAR(output[sampleIdx], expected[sampleIdx], 1e-9) << sampleIdx;
+    }
+
+    // A steady input comes out unchanged from the first sample on
+    std::vector<double> steady(50, 0.8);
+    filter.reset();
+    filter.process(steady.data(), steady.size());
+    for (double sample : steady)
+    {
+        EXPECT_NEAR(sample, 0.8, 1e-12);
+    }
+}
+
+/// @brief Test the designed filters have unit gain at 0 Hz and the low-pass filters stop high frequencies
+TEST(FilterTest, designs)
+{
+    FirFilter lowPass(designLowPass(250.0, 5000.0, 63));
+    EXPECT_NEAR(std::abs(lowPass.getResponse(0.0)), 1.0, 1e-12);
+    EXPECT_NEAR(std::abs(lowPass.getResponse(2 * M_PI * 100.0 / 5000.0)), 1.0, 0.01);
+    EXPECT_LT(std::abs(lowPass.getResponse(2 * M_PI * 1000.0 / 5000.0)), 0.01);
+
+    std::vector<double> raisedCosine = designRaisedCosine(0.25, 4, 8);
+    ASSERT_EQ(raisedCosine.size(), 33u);
+    EXPECT_NEAR(std::abs(FirFilter(raisedCosine).getResponse(0.0)), 1.0, 1e-12);
+    // Zero crossings at every other symbol from the center
+    EXPECT_NEAR(raisedCosine[16 + 4], 0.0, 1e-12);
+    EXPECT_NEAR(raisedCosine[16 - 8], 0.0, 1e-12);
+
+    BiquadCascade butterworth({designLowPassBiquad(250.0, 5000.0, M_SQRT1_2)});
+    EXPECT_NEAR(std::abs(butterworth.getResponse(0.0)), 1.0, 1e-12);
+    EXPECT_NEAR(std::abs(butterworth.getResponse(2 * M_PI * 250.0 / 5000.0)), M_SQRT1_2, 1e-9);
+
+    const double pulse[] = {1.0, 2.0, 2.0};
+    std::vector<double> matched = designMatchedFilter(pulse, 3);
+    EXPECT_NEAR(matched[0], 2.0 / 3.0, 1e-15);
+    EXPECT_NEAR(matched[2], 1.0 / 3.0, 1e-15);
+}
+
+/// @brief Test the coefficients of the server database select the filter and invalid ones are rejected
+TEST(FilterTest, configure)
+{
+    FilterBank filter;
+    filter.configure(FILTER_TYPE_FIR, "0.5 0.5");
+    EXPECT_NEAR(std::abs(filter.getResponse(M_PI)), 0.0, 1e-15);
+
+    filter.configure(FILTER_TYPE_BIQUAD, "0.25 0.5 0.25 0 0  1 0 0 -0.5 0");
+    // (1 + z^-1)^2 / 4 then 1 / (1 - 0.5 z^-1): a gain of 2 at 0 Hz
+    EXPECT_NEAR(filter.getResponse(0.0).real(), 2.0, 1e-12);
+
+    EXPECT_THROW(filter.configure("iir", "1"), std::invalid_argument);
+    EXPECT_THROW(filter.configure(FILTER_TYPE_FIR, ""), std::invalid_argument);
+    EXPECT_THROW(filter.configure(FILTER_TYPE_FIR, "0.5 half"), std::invalid_argument);
+    EXPECT_THROW(filter.configure(FILTER_TYPE_BIQUAD, "1 0 0 0"), std::invalid_argument);
+    // The previous filter is kept
+    EXPECT_NEAR(filter.getResponse(0.0).real(), 2.0, 1e-12);
+}
@@ -0,0 +1,205 @@
+#include "frameBuffer.h"
+#include <gtest/gtest.h>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <string>
+#include <vector>
+
+namespace
+{
+    /// @brief A connected pair of non-blocking stream sockets, closed at the end of the test
+    class SocketPairTest : public ::testing::Test
+    {
+    protected:
+        int m_sockets[2];
+        std::vector<std::string> m_frames;
+        FrameSink m_sink;
+
+        void SetUp() override
+        {
+            ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, m_sockets), 0);
+            for (int socketFd : m_sockets)
+            {
+                fcntl(socketFd, F_SETFL, fcntl(socketFd, F_GETFL, 0) | O_NONBLOCK);
+            }
+            m_sink = [this](const char *p_payload, size_t p_size)
+            { m_frames.emplace_back(p_payload, p_size); };
+        }
+
+        void TearDown() override
+        {
+            for (int socketFd : m_sockets)
+            {
+                if (socketFd >= 0)
+                {
+                    close(socketFd);
+                }
+            }
+        }
+
+        /**
+         * @brief Write raw bytes to the reading side
+         *
+         * @param p_bytes - the bytes
+         */
+        void sendRaw(const std::string &p_bytes)
+        {
+            ASSERT_EQ(send(m_sockets[0], p_bytes.data(), p_bytes.size(), 0), static_cast<ssize_t>(p_bytes.size()));
+        }
+
+        /**
+         * @brief Get the bytes of a frame as written on the socket
+         *
+         * @param p_payload - the payload
+         * @return the header followed by the payload
+         */
+        static std::string encode(const std::string &p_payload)
+        {
+            std::string frame(FRAME_HEADER_SIZE, '\0');
+            for (size_t byteIdx = 0; byteIdx < FRAME_HEADER_SIZE; ++byteIdx)
+            {
+                frame[byteIdx] = static_cast<char>((p_payload.size() >> (8 * (FRAME_HEADER_SIZE - 1 - byteIdx))) & 0xFF);
+            }
+            return frame + p_payload;
+        }
+    };
+}
+
+/// @brief Test a frame arriving one byte at a time is handed out once, when its last byte arrives
+TEST_F(SocketPairTest, reassemblesSplitFrame)
+{
+    FrameReader reader;
+    std::string bytes = encode("carrier setup 4g 1000");
+    for (size_t byteIdx = 0; byteIdx < bytes.size(); ++byteIdx)
+    {
+        sendRaw(bytes.substr(byteIdx, 1));
+        EXPECT_EQ(reader.readFrom(m_sockets[1], m_sink), SocketStatus::OPEN);
+        EXPECT_EQ(m_frames.size(), byteIdx + 1 == bytes.size() ? 1u : 0u) << byteIdx;
+    }
+    EXPECT_EQ(m_frames[0], "carrier setup 4g 1000");
+    EXPECT_EQ(reader.getBufferedSize(), 0u);
+}
+
+/// @brief Test several frames of one read, an empty one among them, are handed out in order
+TEST_F(SocketPairTest, splitsCoalescedFrames)
+{
+    FrameReader reader;
+    std::string partial = encode("third");
+    sendRaw(encode("first") + encode("") + encode("second") + partial.substr(0, 6));
+    EXPECT_EQ(reader.readFrom(m_sockets[1], m_sink), SocketStatus::OPEN);
+    ASSERT_EQ(m_frames.size(), 3u);
+    EXPECT_EQ(m_frames[0], "first");
+    EXPECT_EQ(m_frames[1], "");
+    EXPECT_EQ(m_frames[2], "second");
+    EXPECT_EQ(reader.getBufferedSize(), 6u);
+
+    sendRaw(partial.substr(6));
+    EXPECT_EQ(reader.readFrom(m_sockets[1], m_sink), SocketStatus::OPEN);
+    ASSERT_EQ(m_frames.size(), 4u);
+    EXPECT_EQ(m_frames[3], "third");
+}
+
+/// @brief Test frames larger than the socket buffer go through several flushes and reads
+TEST_F(SocketPairTest, writesLargeFramesAcrossFlushes)
+{
+    FrameWriter writer;
+    FrameReader reader;
+    std::string large(1 << 20, '\0');
+    for (size_t byteIdx = 0; byteIdx < large.size(); ++byteIdx)
+    {
+        large[byteIdx] = static_cast<char>(byteIdx * 31 + 7);
+    }
+    writer.push(large);
+    writer.push("after");
+
+    size_t rounds = 0;
+    while (m_frames.size() < 2 && rounds < 10000)
+    {
+        ASSERT_EQ(writer.flush(m_sockets[0]), SocketStatus::OPEN);
+        ASSERT_EQ(reader.readFrom(m_sockets[1], m_sink), SocketStatus::OPEN);
+        ++rounds;
+    }
+    EXPECT_GT(rounds, 1u);
+    EXPECT_EQ(writer.getPendingSize(), 0u);
+    ASSERT_EQ(m_frames.size(), 2u);
+    EXPECT_TRUE(m_frames[0] == large);
+    EXPECT_EQ(m_frames[1], "after");
+}
+
+/// @brief Test a length past FRAME_MAX_PAYLOAD is reported rather than waited for
+TEST_F(SocketPairTest, rejectsOversizedFrame)
+{
+    FrameReader reader;
+    sendRaw(encode("ok") + std::string("\x7f\xff\xff\xff", 4));
+    EXPECT_EQ(reader.readFrom(m_sockets[1], m_sink), SocketStatus::INVALID_FRAME);
+    ASSERT_EQ(m_frames.size(), 1u);
+    EXPECT_EQ(m_frames[0], "ok");
+}
+
+/// @brief Test the frames sent before the peer closed are handed out before the close is reported
+TEST_F(SocketPairTest, reportsPeerClose)
+{
+    FrameReader reader;
+    sendRaw(encode("bye"));
+    close(m_sockets[0]);
+    m_sockets[0] = -1;
+    EXPECT_EQ(reader.readFrom(m_sockets[1], m_sink), SocketStatus::CLOSED);
+    ASSERT_EQ(m_frames.size(), 1u);
+    EXPECT_EQ(m_frames[0], "bye");
+
+    FrameWriter writer;
+    writer.push("lost");
+    EXPECT_EQ(writer.flush(m_sockets[1]), SocketStatus::FAILED);
+}
+
+/// @brief Test more frames than one gathered write takes go out in order, with a partial frame in between
+TEST_F(SocketPairTest, gathersManyFramesInOrder)
+{
+    FrameWriter writer;
+    FrameReader reader;
+    const size_t frameCount = 3 * FRAME_WRITE_BATCH + 5;
+    size_t queued = 0;
+    for (size_t frameIdx = 0; frameIdx < frameCount; ++frameIdx)
+    {
+        std::string payload(frameIdx % 7 == 0 ? 0 : 1000 + frameIdx, static_cast<char>('a' + frameIdx % 26));
+        queued += FRAME_HEADER_SIZE + payload.size();
+        writer.push(std::move(payload));
+    }
+    EXPECT_EQ(writer.getPendingSize(), queued);
+
+    size_t rounds = 0;
+    while (m_frames.size() < frameCount && rounds < 10000)
+    {
+        ASSERT_EQ(writer.flush(m_sockets[0]), SocketStatus::OPEN);
+        ASSERT_EQ(reader.readFrom(m_sockets[1], m_sink), SocketStatus::OPEN);
+        ++rounds;
+    }
+    ASSERT_EQ(m_frames.size(), frameCount);
+    EXPECT_EQ(writer.getPendingSize(), 0u);
+    for (size_t frameIdx = 0; frameIdx < frameCount; ++frameIdx)
+    {
+        EXPECT_EQ(m_frames[frameIdx],
+                  std::string(frameIdx % 7 == 0 ? 0 : 1000 + frameIdx, static_cast<char>('a' + frameIdx % 26)))
+            << frameIdx;
+    }
+}
+
+/// @brief Test a pause leaves the bytes in the socket and the next read picks them up
+TEST_F(SocketPairTest, pausesAndResumesReading)
+{
+    FrameReader reader;
+    sendRaw(encode("first") + encode("second"));
+    bool isPaused = true;
+    EXPECT_EQ(reader.readFrom(m_sockets[1], m_sink, [&]()
+                              { return isPaused; }),
+              SocketStatus::PAUSED);
+    EXPECT_TRUE(m_frames.empty());
+
+    isPaused = false;
+    EXPECT_EQ(reader.readFrom(m_sockets[1], m_sink, [&]()
+                              { return isPaused; }),
+              SocketStatus::OPEN);
+    ASSERT_EQ(m_frames.size(), 2u);
+    EXPECT_EQ(m_frames[1], "second");
+}
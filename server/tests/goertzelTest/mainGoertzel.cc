@@ -0,0 +1,104 @@
+#include "goertzel.h"
+#include "simd.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace
+{
+    /**
+     * @brief Direct DFT of a block at one frequency
+     *
+     * @param p_samples - amplitudes of the block
+     * @param p_frequency - frequency (Hz)
+     * @param p_sampleRate - the amount of samples in 1 second
+     * @return sum(x[n] * exp(-j * w * n))
+     */
+    std::complex<double> directDft(const std::vector<double> &p_samples, const double p_frequency,
+                                   const double p_sampleRate)
+    {
+        std::complex<double> sum;
+        for (size_t sampleIdx = 0; sampleIdx < p_samples.size(); ++sampleIdx)
+        {
+            sum += p_samples[sampleIdx] * std::polar(1.0, -2 * M_PI * p_frequency * sampleIdx / p_sampleRate);
+        }
+        return sum;
+    }
+
+    /**
+     * @brief Compare the detector with the direct DFT for blocks of every length around the lane count
+     *
+     * @param p_frequencies - the two tones (Hz)
+     */
+    template <typename Sample>
+    void checkFormat(const double *p_frequencies)
+    {
+        const double sampleRate = 5000.0;
+        std::mt19937 engine(3);
+        std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+        for (size_t count : {0, 1, 7, 8, 9, 63, 1000, 1003})
+        {
+            std::vector<double> amplitudes(count);
+            std::vector<Sample> samples(count);
+            for (size_t sampleIdx = 0; sampleIdx < count; ++sampleIdx)
+            {
+                samples[sampleIdx] = SampleFormat<Sample>::fromAmplitude(distribution(engine));
+                amplitudes[sampleIdx] = SampleFormat<Sample>::toAmplitude(samples[sampleIdx]);
+            }
+            GoertzelDetector detector;
+            detector.configure(p_frequencies, GOERTZEL_MAX_TONES, sampleRate);
+            std::complex<double> correlations[GOERTZEL_MAX_TONES];
+            detector.correlate(samples.data(), count, correlations);
+            for (size_t toneIdx = 0; toneIdx < GOERTZEL_MAX_TONES; ++toneIdx)
+            {
+                std::complex<double> expected = directDft(amplitudes, p_frequencies[toneIdx], sampleRate);
+                EXPECT_NEAR(correlations[toneIdx].real(), expected.real(), 1e-9 * (count + 1))
+                    << SampleFormat<Sample>::NAME << " " << toString(getSimdLevel()) << " " << count;
+                EXPECT_NEAR(correlations[toneIdx].imag(), expected.imag(), 1e-9 * (count + 1))
+                    << SampleFormat<Sample>::NAME << " " << toString(getSimdLevel()) << " " << count;
+            }
+        }
+    }
+}
+
+/// @brief Test the lanes recombine into the DFT of the block on every instruction set and sample format
+TEST(GoertzelTest, matchesDirectDft)
+{
+    SimdLevel bestLevel = getSimdLevel();
+    // The FSK tones of a 5 Hz carrier, and tones close to the folding points of the lane frequency
+    const double toneSets[][GOERTZEL_MAX_TONES] = {{5.0, 10.0}, {625.0, 1249.0}, {0.0, 2500.0}};
+    for (SimdLevel level : {SimdLevel::SCALAR, SimdLevel::SSE2, SimdLevel::AVX2})
+    {
+        setSimdLevel(level);
+        for (const double *tones : toneSets)
+        {
+            checkFormat<double>(tones);
+            checkFormat<float>(tones);
+            checkFormat<Q15>(tones);
+        }
+    }
+    setSimdLevel(bestLevel);
+}
+
+/// @brief Test the power of a tone does not depend on its phase, and the other tone of the window gets none
+TEST(GoertzelTest, phaseInsensitivePower)
+{
+    const double sampleRate = 5000.0;
+    const double tones[] = {5.0, 10.0};
+    const size_t count = 1000;
+    GoertzelDetector detector;
+    detector.configure(tones, 2, sampleRate);
+    for (double phase : {0.0, 0.7, M_PI / 2, 2.5, M_PI})
+    {
+        std::vector<double> window(count);
+        for (size_t sampleIdx = 0; sampleIdx < count; ++sampleIdx)
+        {
+            window[sampleIdx] = std::cos(2 * M_PI * tones[1] * sampleIdx / sampleRate + phase);
+        }
+        std::complex<double> correlations[2];
+        detector.correlate(window.data(), count, correlations);
+        EXPECT_NEAR(std::norm(correlations[1]), count * count / 4.0, 1e-6) << phase;
+        EXPECT_NEAR(std::norm(correlations[0]), 0.0, 1e-6) << phase;
+    }
+}
@@ -0,0 +1,80 @@
+#include "jobQueue.h"
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <gtest/gtest.h>
+
+/// @brief Test every job runs once on a worker of the queue
+TEST(JobQueueTest, runsEveryJobOnce)
+{
+    for (size_t workers : std::vector<size_t>{1, 2, 4})
+    {
+        std::vector<std::atomic<int>> runs(100);
+        std::atomic<size_t> doneCount(0);
+        std::promise<void> allDone;
+        {
+            JobQueue queue(workers);
+            EXPECT_EQ(queue.getWorkerCount(), workers);
+            for (size_t jobIdx = 0; jobIdx < runs.size(); ++jobIdx)
+            {
+                queue.push([&, jobIdx](size_t p_workerIdx)
+                           {
+                               EXPECT_LT(p_workerIdx, workers);
+                               ++runs[jobIdx];
+                               if (++doneCount == runs.size())
+                               {
+                                   allDone.set_value();
+                               } });
+            }
+            ASSERT_EQ(allDone.get_future().wait_for(std::chrono::seconds(5)), std::future_status::ready);
+        }
+        for (size_t jobIdx = 0; jobIdx < runs.size(); ++jobIdx)
+        {
+            ASSERT_EQ(runs[jobIdx], 1) << workers << " workers, job " << jobIdx;
+        }
+    }
+}
+
+/// @brief Test a job pushed while another one runs is picked by a free worker
+TEST(JobQueueTest, freeWorkerTakesNextJob)
+{
+    JobQueue queue(2);
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::promise<size_t> blockedWorker;
+    std::promise<size_t> otherWorker;
+    queue.push([&](size_t p_workerIdx)
+               {
+                   blockedWorker.set_value(p_workerIdx);
+                   released.wait(); });
+    size_t blockedIdx = blockedWorker.get_future().get();
+    queue.push([&](size_t p_workerIdx)
+               { otherWorker.set_value(p_workerIdx); });
+    std::future<size_t> otherIdx = otherWorker.get_future();
+    ASSERT_EQ(otherIdx.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_NE(otherIdx.get(), blockedIdx);
+    release.set_value();
+}
+
+/// @brief Test the destructor waits for the running job and drops the queued ones
+TEST(JobQueueTest, destructorDropsQueuedJobs)
+{
+    std::atomic<int> runCount(0);
+    std::promise<void> started;
+    {
+        JobQueue queue(1);
+        queue.push([&](size_t)
+                   {
+                       started.set_value();
+                       std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                       ++runCount; });
+        started.get_future().wait();
+        for (int jobIdx = 0; jobIdx < 10; ++jobIdx)
+        {
+            queue.push([&](size_t)
+                       { ++runCount; });
+        }
+        EXPECT_EQ(queue.getQueuedCount(), 10u);
+    }
+    EXPECT_EQ(runCount, 1);
+}
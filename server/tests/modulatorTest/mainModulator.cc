@@ -0,0 +1,369 @@
+#include "modulator.h"
+#include "serverCommon.h"
+#include <gtest/gtest.h>
+#include <random>
+
+/// @brief The database directory of server, relative to the tests directory
+constexpr const char *TEST_DATABASE_PATH = "../db";
+
+/// @brief Testing environment class for modulator to be able to work with Database
+class ModulatorTestingEnvironment : public ::testing::Environment
+{
+public:
+    void SetUp() override
+    {
+        InMemDatabase::getInstance().init(TEST_DATABASE_PATH);
+    }
+};
+
+/// @brief Test the generated waveform against the carrier equation of each network
+TEST(modulatorTestSuite, checkModulationPrivateMethod)
+{
+    const std::string binaryData = "0110100111000101";
+    for (double frequency : {2.0, 3.0, 8.0})
+    {
+        Modulator modulator(frequency, binaryData);
+        std::vector<double> askSignal = modulator.modulate("2G");
+        std::vector<double> pskSignal = modulator.modulate("3G");
+        std::vector<double> fskSignal = modulator.modulate("4G");
+        std::vector<double> qamSignal = modulator.modulate("5G");
+        ASSERT_EQ(askSignal.size(), binaryData.size() * modulator.m_samplesPerBit);
+        ASSERT_EQ(qamSignal.size(), binaryData.size() / BIT_SIZE_16QAM * modulator.m_samplesPerBit);
+
+        for (size_t sampleIdx = 0; sampleIdx < askSignal.size(); ++sampleIdx)
+        {
+            bool isOne = binaryData[sampleIdx / modulator.m_samplesPerBit] == '1';
+            double time = sampleIdx * modulator.m_sampleDuration;
+            double askExpected = modulator.getCarrierSignalValue(isOne ? modulator.m_askOneSign : modulator.m_askZeroSign,
+                                                                 DEFAULT_FREQUENCY_INDEX, time, DEFAULT_PHASE);
+            double pskExpected = modulator.getCarrierSignalValue(DEFAULT_AMPLITUDE_INDEX, DEFAULT_FREQUENCY_INDEX, time,
+                                                                 DEFAULT_PHASE + (isOne ? modulator.m_pskOneSign : modulator.m_pskZeroSign));
+            double fskExpected = modulator.getCarrierSignalValue(DEFAULT_AMPLITUDE_INDEX, isOne ? modulator.m_fskOneSign : modulator.m_fskZeroSign,
+                                                                 time, DEFAULT_PHASE);
+            EXPECT_NEAR(askSignal[sampleIdx], askExpected, 1e-6);
+            EXPECT_NEAR(pskSignal[sampleIdx], pskExpected, 1e-6);
+            EXPECT_NEAR(fskSignal[sampleIdx], fskExpected, 1e-6);
+        }
+    }
+}
+
+/// @brief Test demodulation gives back the modulated binary data on a clean channel
+TEST(modulatorTestSuite, modulateDemodulateRoundTrip)
+{
+    const std::string binaryData = "1011001110001111010000101101";
+    for (double frequency : {1.0, 3.0, 5.0, 10.0})
+    {
+        Modulator modulator(frequency, binaryData);
+        for (const std::string network : {"2G", "3G", "4G", "5G"})
+        {
+            EXPECT_EQ(modulator.demodulate(modulator.modulate(network), network), binaryData);
+        }
+    }
+}
+
+/// @brief Test the QAM orders give back the binary data and carry more bits per symbol window
+TEST(modulatorTestSuite, higherOrderQamRoundTrip)
+{
+    // A multiple of 4, 6 and 8 bits with every value of a 256-QAM symbol
+    std::string binaryData;
+    for (unsigned int symbol = 0; symbol < 256; ++symbol)
+    {
+        for (int bitIdx = 7; bitIdx >= 0; --bitIdx)
+        {
+            binaryData += (symbol >> bitIdx) & 1 ? '1' : '0';
+        }
+    }
+    binaryData.resize(binaryData.size() / 24 * 24);
+    for (double frequency : {1.0, 3.0, 5.0, 10.0})
+    {
+        Modulator modulator(frequency, binaryData);
+        for (ModulationType type : {ModulationType::QAM16, ModulationType::QAM64, ModulationType::QAM256})
+        {
+            std::vector<double> signal;
+            modulator.modulate(type, signal);
+            EXPECT_EQ(signal.size(), binaryData.size() / getBitsPerSymbol(type) * static_cast<size_t>(modulator.getSampleRate() / frequency));
+            std::string demodulated;
+            modulator.demodulate(signal, type, demodulated);
+            EXPECT_EQ(demodulated, binaryData) << toNetwork(type) << " at " << frequency << " Hz";
+        }
+    }
+    EXPECT_EQ(toModulationType("64QAM"), ModulationType::QAM64);
+    EXPECT_EQ(toModulationType("256QAM"), ModulationType::QAM256);
+
+    // 64-QAM carries 6 bits per window
+    Modulator modulator(5.0, "1011");
+    std::vector<double> signal;
+    EXPECT_THROW(modulator.modulate(ModulationType::QAM64, signal), std::invalid_argument);
+}
+
+/// @brief Test every scheme goes through float and Q15 signals, clean and with noise at the channel level
+TEST(modulatorTestSuite, sampleFormatRoundTrip)
+{
+    BitStream bits;
+    bits.assignAscii("101100111000111101000010110101110010100111010001");
+    std::mt19937 generator(7);
+    std::normal_distribution<double> noise(0.0, 0.07);
+    for (double frequency : {1.0, 5.0})
+    {
+        Modulator modulator(frequency, "0");
+        modulator.setBinaryInput(bits);
+        for (ModulationType type : {ModulationType::ASK, ModulationType::BPSK, ModulationType::BFSK, ModulationType::QAM16,
+                                    ModulationType::OFDM, ModulationType::QAM64})
+        {
+            std::vector<double> reference;
+            modulator.modulate(type, reference);
+            std::vector<float> floatSignal(reference.size());
+            std::vector<Q15> q15Signal(reference.size());
+            ASSERT_EQ(modulator.modulate(type, floatSignal.data(), floatSignal.size()), reference.size());
+            ASSERT_EQ(modulator.modulate(type, q15Signal.data(), q15Signal.size()), reference.size());
+            for (size_t sampleIdx = 0; sampleIdx < reference.size(); ++sampleIdx)
+            {
+                EXPECT_NEAR(floatSignal[sampleIdx], reference[sampleIdx], 1e-6);
+                EXPECT_NEAR(SampleFormat<Q15>::toAmplitude(q15Signal[sampleIdx]), reference[sampleIdx], 1e-4);
+            }
+
+            BitStream demodulated;
+            EXPECT_EQ(modulator.demodulate(floatSignal.data(), floatSignal.size(), type, demodulated), bits.size());
+            EXPECT_EQ(demodulated, bits) << "float " << toNetwork(type) << " at " << frequency << " Hz";
+            EXPECT_EQ(modulator.demodulate(q15Signal.data(), q15Signal.size(), type, demodulated), bits.size());
+            EXPECT_EQ(demodulated, bits) << "q15 " << toNetwork(type) << " at " << frequency << " Hz";
+
+            for (size_t sampleIdx = 0; sampleIdx < reference.size(); ++sampleIdx)
+            {
+                double amplitude = reference[sampleIdx] + noise(generator);
+                floatSignal[sampleIdx] = SampleFormat<float>::fromAmplitude(amplitude);
+                q15Signal[sampleIdx] = SampleFormat<Q15>::fromAmplitude(amplitude);
+            }
+            modulator.demodulate(floatSignal.data(), floatSignal.size(), type, demodulated);
+            EXPECT_EQ(demodulated, bits) << "noisy float " << toNetwork(type) << " at " << frequency << " Hz";
+            modulator.demodulate(q15Signal.data(), q15Signal.size(), type, demodulated);
+            EXPECT_EQ(demodulated, bits) << "noisy q15 " << toNetwork(type) << " at " << frequency << " Hz";
+        }
+    }
+
+    std::vector<Q15> tooSmall(1);
+    Modulator modulator(5.0, "1011");
+    EXPECT_EQ(modulator.modulate(ModulationType::BPSK, tooSmall.data(), tooSmall.size()), 0);
+}
+
+/// @brief Test the Goertzel FSK detector on every path, and on tones the correlator can not decide without their phase
+TEST(modulatorTestSuite, goertzelFskDetector)
+{
+    BitStream bits;
+    bits.assignAscii("101100111000111101000010110101110010100111010001");
+    for (double frequency : {1.0, 5.0})
+    {
+        Modulator modulator(frequency, "0");
+        modulator.setBinaryInput(bits);
+        EXPECT_EQ(modulator.getFskDetector(), FskDetector::CORRELATOR);
+        modulator.setFskDetector(FskDetector::GOERTZEL);
+        std::vector<double> signal;
+        modulator.modulate(ModulationType::BFSK, signal);
+        std::vector<Q15> q15Signal(signal.size());
+        toSamples(signal.data(), signal.size(), q15Signal.data());
+
+        BitStream demodulated;
+        EXPECT_EQ(modulator.demodulate(signal.data(), signal.size(), ModulationType::BFSK, demodulated), bits.size());
+        EXPECT_EQ(demodulated, bits) << frequency << " Hz";
+        modulator.demodulate(q15Signal.data(), q15Signal.size(), ModulationType::BFSK, demodulated);
+        EXPECT_EQ(demodulated, bits) << "q15 " << frequency << " Hz";
+
+        // Blocks cut the windows anywhere
+        BitStream streamed;
+        StreamingDemodulator stream = modulator.openDemodulationStream(ModulationType::BFSK, [&](const BitStream &p_bits)
+                                                                       { streamed.append(p_bits); });
+        for (size_t position = 0; position < signal.size(); position += 37)
+        {
+            stream.write(signal.data() + position, std::min<size_t>(37, signal.size() - position));
+        }
+        EXPECT_EQ(streamed, bits) << "stream " << frequency << " Hz";
+
+        std::vector<IqSample> baseband;
+        modulator.modulateBaseband(ModulationType::BFSK, baseband);
+        modulator.demodulateBaseband(baseband.data(), baseband.size(), ModulationType::BFSK, demodulated);
+        EXPECT_EQ(demodulated, bits) << "baseband " << frequency << " Hz";
+
+        // Both tones a quarter of a period late leave no in-phase correlation, but all their power
+        size_t samplesPerSymbol = modulator.getSamplesPerSymbol();
+        for (size_t sampleIdx = 0; sampleIdx < signal.size(); ++sampleIdx)
+        {
+            double tone = bits.get(sampleIdx / samplesPerSymbol) ? 2.0 : 1.0;
+            signal[sampleIdx] = std::cos(2 * M_PI * tone * frequency * sampleIdx / modulator.getSampleRate() - M_PI);
+        }
+        modulator.demodulate(signal.data(), signal.size(), ModulationType::BFSK, demodulated);
+        EXPECT_EQ(demodulated, bits) << "phase offset " << frequency << " Hz";
+    }
+}
+
+/// @brief Test the signs of the soft bits of every scheme are the hard decisions, on windows the hard path rejects too
+TEST(modulatorTestSuite, softDecisionOutput)
+{
+    BitStream bits;
+    bits.assignAscii("101100111000111101000010110101110010100111010001");
+    Modulator modulator(5.0, "0");
+    modulator.setBinaryInput(bits);
+    ThreadPool pool(4);
+    const ModulationType types[] = {ModulationType::ASK, ModulationType::BPSK, ModulationType::BFSK, ModulationType::QAM16,
+                                    ModulationType::OFDM, ModulationType::QAM64, ModulationType::QAM256};
+    for (ThreadPool *threadPool : {static_cast<ThreadPool *>(nullptr), &pool})
+    {
+        modulator.setThreadPool(threadPool);
+        for (ModulationType type : types)
+        {
+            std::vector<double> signal;
+            modulator.modulate(type, signal);
+            std::vector<float> llrs;
+            EXPECT_EQ(modulator.demodulateSoft(signal.data(), signal.size(), type, llrs), bits.size());
+            BitStream decided;
+            hardDecide(llrs.data(), llrs.size(), decided);
+            EXPECT_EQ(decided, bits) << toNetwork(type);
+            if (type == ModulationType::OFDM)
+            {
+                continue;
+            }
+            std::vector<IqSample> baseband;
+            modulator.modulateBaseband(type, baseband);
+            modulator.demodulateBasebandSoft(baseband.data(), baseband.size(), type, llrs);
+            hardDecide(llrs.data(), llrs.size(), decided);
+            EXPECT_EQ(decided, bits) << "baseband " << toNetwork(type);
+        }
+    }
+    modulator.setFskDetector(FskDetector::GOERTZEL);
+    std::vector<double> signal;
+    modulator.modulate(ModulationType::BFSK, signal);
+    std::vector<float> llrs;
+    modulator.demodulateSoft(signal.data(), signal.size(), ModulationType::BFSK, llrs);
+    BitStream decided;
+    hardDecide(llrs.data(), llrs.size(), decided);
+    EXPECT_EQ(decided, bits) << "goertzel";
+
+    // A gain of 1.3 moves the outer 16-QAM points out of the radius bound, the soft bits still carry them
+    modulator.modulate(ModulationType::QAM16, signal);
+    for (double &sample : signal)
+    {
+        sample *= 1.3;
+    }
+    EXPECT_EQ(modulator.demodulate(signal.data(), signal.size(), ModulationType::QAM16, decided), 0);
+    modulator.demodulateSoft(signal.data(), signal.size(), ModulationType::QAM16, llrs);
+    hardDecide(llrs.data(), llrs.size(), decided);
+    EXPECT_EQ(decided, bits) << "out of bounds";
+
+    // A buffer that is too small is left untouched
+    std::vector<float> smallBuffer(bits.size() - 1, 7.0f);
+    EXPECT_EQ(modulator.demodulateSoft(signal.data(), signal.size(), ModulationType::QAM16, smallBuffer.data(),
+                                       smallBuffer.size()), 0);
+    EXPECT_EQ(smallBuffer.front(), 7.0f);
+    EXPECT_EQ(modulator.demodulateSoft(signal.data(), signal.size(), ModulationType::UNKNOWN, llrs), 0);
+}
+
+/// @brief Test the caller-owned buffers are filled in place and reused between requests
+TEST(modulatorTestSuite, callerOwnedBuffers)
+{
+    const std::string binaryData = "11000101";
+    Modulator modulator(5.0, binaryData);
+    std::vector<double> signal;
+    std::string demodulated;
+    for (const std::string network : {"2G", "3G", "4G", "5G"})
+    {
+        signal.reserve(modulator.getModulatedSize("2G"));
+        const double *signalData = signal.data();
+        modulator.modulate(network, signal);
+        EXPECT_EQ(signal.size(), modulator.getModulatedSize(network));
+        EXPECT_EQ(signal.data(), signalData);
+        EXPECT_EQ(signal, modulator.modulate(network));
+
+        demodulated.reserve(binaryData.size());
+        const char *binaryDataBuffer = demodulated.data();
+        modulator.demodulate(signal, network, demodulated);
+        EXPECT_EQ(demodulated, binaryData);
+        EXPECT_EQ(demodulated.data(), binaryDataBuffer);
+    }
+
+    // A buffer that is too small is left untouched
+    std::vector<double> smallBuffer(modulator.getModulatedSize("2G") - 1, 7.0);
+    EXPECT_EQ(modulator.modulate("2G", smallBuffer.data(), smallBuffer.size()), 0);
+    EXPECT_EQ(smallBuffer.front(), 7.0);
+    char bits[4];
+    EXPECT_EQ(modulator.demodulate(signal.data(), signal.size(), "5G", bits, sizeof(bits)), 0);
+}
+
+/// @brief Test the schemes resolved once give the same results as the network types
+TEST(modulatorTestSuite, modulationSchemeBinding)
+{
+    const std::string binaryData = "0110100111000101";
+    Modulator modulator(3.0, binaryData);
+    for (const std::string network : {"2G", "3G", "4G", "5G"})
+    {
+        ModulationType type = toModulationType(network);
+        ASSERT_NE(type, ModulationType::UNKNOWN);
+        EXPECT_EQ(toNetwork(type), network);
+
+        std::vector<double> signal;
+        modulator.modulate(type, signal);
+        EXPECT_EQ(signal, modulator.modulate(network));
+
+        std::string demodulated;
+        modulator.demodulate(signal, type, demodulated);
+        EXPECT_EQ(demodulated, binaryData);
+    }
+
+    EXPECT_EQ(toModulationType("6G"), ModulationType::UNKNOWN);
+    EXPECT_EQ(modulator.getModulatedSize(ModulationType::UNKNOWN), 0);
+    std::vector<double> signal(4, 1.0);
+    EXPECT_EQ(modulator.modulate(ModulationType::UNKNOWN, signal.data(), signal.size()), 0);
+    BitStream bits;
+    EXPECT_EQ(modulator.demodulate(signal.data(), signal.size(), ModulationType::UNKNOWN, bits), 0);
+}
+
+/// @brief Test splitting the symbols across threads gives the same signal as one thread
+TEST(modulatorTestSuite, parallelModulation)
+{
+    // Long enough to be split, 3 Hz changes the carrier phase from one symbol to the next
+    std::string binaryData;
+    for (size_t bitIdx = 0; bitIdx < 4 * 4 * PARALLEL_MODULATION_MIN_SYMBOLS; ++bitIdx)
+    {
+        binaryData += (bitIdx * 5 + bitIdx / 3) % 2 ? '1' : '0';
+    }
+    Modulator modulator(3.0, binaryData);
+    ThreadPool pool(4);
+    for (ModulationType type : {ModulationType::ASK, ModulationType::BPSK, ModulationType::BFSK, ModulationType::QAM16})
+    {
+        std::vector<double> expected;
+        modulator.setThreadPool(nullptr);
+        modulator.modulate(type, expected);
+        std::vector<double> signal;
+        modulator.setThreadPool(&pool);
+        modulator.modulate(type, signal);
+        EXPECT_EQ(signal, expected) << toNetwork(type);
+    }
+}
+
+/// @brief Test windows decided on several threads give the same bits as one thread
+TEST(modulatorTestSuite, parallelDemodulation)
+{
+    // An amount of symbols which does not fill the last output word
+    std::string binaryData;
+    for (size_t bitIdx = 0; bitIdx < 4 * (8 * PARALLEL_DEMODULATION_MIN_SYMBOLS + 5); ++bitIdx)
+    {
+        binaryData += (bitIdx * 3 + bitIdx / 7) % 2 ? '1' : '0';
+    }
+    Modulator modulator(3.0, binaryData);
+    ThreadPool pool(4);
+    for (ModulationType type : {ModulationType::ASK, ModulationType::BPSK, ModulationType::BFSK, ModulationType::QAM16})
+    {
+        std::vector<double> signal;
+        modulator.setThreadPool(nullptr);
+        modulator.modulate(type, signal);
+        modulator.setThreadPool(&pool);
+        std::string demodulated;
+        modulator.demodulate(signal, type, demodulated);
+        EXPECT_EQ(demodulated, binaryData) << toNetwork(type);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    ::testing::AddGlobalTestEnvironment(new ModulatorTestingEnvironment);
+    return RUN_ALL_TESTS();
+}
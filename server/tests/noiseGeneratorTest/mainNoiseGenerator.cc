@@ -0,0 +1,79 @@
+#include "noiseGenerator.h"
+#include "simd.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+
+/// @brief Test the samples have the moments and the tail mass of a Gaussian distribution
+TEST(NoiseGeneratorTest, gaussianMoments)
+{
+    const size_t sampleCount = 2000000;
+    NoiseGenerator generator(12345);
+    std::vector<double> samples(sampleCount);
+    generator.fill(samples.data(), samples.size(), 0.5);
+
+    double mean = 0.0;
+    double variance = 0.0;
+    double fourthMoment = 0.0;
+    size_t pastTwoSigma = 0;
+    size_t pastTail = 0;
+    for (double sample : samples)
+    {
+        double standard = sample / 0.5;
+        mean += standard;
+        variance += standard * standard;
+        fourthMoment += standard * standard * standard * standard;
+        pastTwoSigma += std::fabs(standard) > 2.0;
+        pastTail += std::fabs(standard) > 3.5;
+    }
+    mean /= sampleCount;
+    variance /= sampleCount;
+    fourthMoment /= sampleCount;
+    EXPECT_NEAR(mean, 0.0, 0.005);
+    EXPECT_NEAR(variance, 1.0, 0.005);
+    EXPECT_NEAR(fourthMoment, 3.0, 0.05);
+    // P(|x| > 2) = 0.0455, P(|x| > 3.5) = 4.65e-4, the second one only reached through the tail
+    EXPECT_NEAR(static_cast<double>(pastTwoSigma) / sampleCount, 0.0455, 0.001);
+    EXPECT_NEAR(static_cast<double>(pastTail) / sampleCount, 4.65e-4, 0.6e-4);
+}
+
+/// @brief Test a seed and stream give the same noise on every instruction set and other streams differ
+TEST(NoiseGeneratorTest, reproducibleStreams)
+{
+    const size_t sampleCount = 5000;
+    SimdLevel bestLevel = getSimdLevel();
+    std::vector<double> expected(sampleCount);
+    setSimdLevel(SimdLevel::SCALAR);
+    NoiseGenerator(7, 1).fill(expected.data(), sampleCount, 1.0);
+    for (SimdLevel level : {SimdLevel::SSE2, SimdLevel::AVX2})
+    {
+        setSimdLevel(level);
+        NoiseGenerator generator(7, 1);
+        std::vector<double> samples(sampleCount);
+        // Odd block sizes cross the refills at other positions
+        for (size_t position = 0; position < sampleCount; position += 333)
+        {
+            generator.fill(samples.data() + position, std::min<size_t>(333, sampleCount - position), 1.0);
+        }
+        EXPECT_EQ(samples, expected) << toString(getSimdLevel());
+    }
+    setSimdLevel(bestLevel);
+
+    std::vector<double> otherStream(sampleCount);
+    std::vector<double> otherSeed(sampleCount);
+    NoiseGenerator(7, 2).fill(otherStream.data(), sampleCount, 1.0);
+    NoiseGenerator(8, 1).fill(otherSeed.data(), sampleCount, 1.0);
+    EXPECT_NE(otherStream, expected);
+    EXPECT_NE(otherSeed, expected);
+
+    NoiseGenerator generator(7, 1);
+    generator.fill(otherStream.data(), sampleCount, 1.0);
+    generator.seed(7, 1);
+    EXPECT_EQ(generator.next(), expected[0]);
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,94 @@
+#include "modulator.h"
+#include "ofdm.h"
+#include "serverCommon.h"
+#include <gtest/gtest.h>
+#include <random>
+
+/// @brief The database directory of server, relative to the tests directory
+constexpr const char *TEST_DATABASE_PATH = "../db";
+
+/// @brief Testing environment class for OFDM to be able to work with Database
+class OfdmTestingEnvironment : public ::testing::Environment
+{
+public:
+    void SetUp() override
+    {
+        InMemDatabase::getInstance().init(TEST_DATABASE_PATH);
+    }
+};
+
+/// @brief Test payloads filling part of a symbol, exactly one symbol and several symbols come back unchanged
+TEST(OfdmTest, roundTrip)
+{
+    Modulator generator;
+    // 3 Hz gives a transform size which is neither a power of 2 nor made of small factors only
+    for (double frequency : {3.0, 5.0, 10.0})
+    {
+        for (int length : {4, 256, 260, 1024})
+        {
+            std::string binaryData = generator.randomBinaryMessageGenerator(length);
+            Modulator modulator(frequency, binaryData);
+            std::vector<double> signal;
+            modulator.modulate(ModulationType::OFDM, signal);
+            ASSERT_EQ(signal.size(), modulator.getModulatedSize(ModulationType::OFDM));
+
+            std::string received;
+            modulator.demodulate(signal, ModulationType::OFDM, received);
+            EXPECT_EQ(received, binaryData) << frequency << " Hz, " << length << " bits";
+        }
+    }
+}
+
+/// @brief Test the training symbol equalizes the noise filter of the UL channel
+TEST(OfdmTest, noisyChannel)
+{
+    Modulator generator;
+    std::string binaryData = generator.randomBinaryMessageGenerator(1024);
+    Modulator modulator(5.0, binaryData);
+    std::vector<double> signal;
+    modulator.modulate(ModulationType::OFDM, signal);
+
+    // Same noise and filter as the antenna
+    std::mt19937 engine(7);
+    std::normal_distribution<double> noise(0.0, 0.07);
+    double previous = 0.0;
+    for (double &sample : signal)
+    {
+        sample += noise(engine);
+        sample = 0.7 * sample + 0.3 * previous;
+        previous = sample;
+    }
+
+    std::string received;
+    modulator.demodulate(signal, ModulationType::OFDM, received);
+    EXPECT_EQ(received, binaryData);
+}
+
+/// @brief Test the sizes of a burst and the OFDM network type
+TEST(OfdmTest, sizes)
+{
+    OfdmModem modem;
+    EXPECT_EQ(modem.getSignalSize(OFDM_BITS_PER_SYMBOL), 0);
+    // Bins 1 to 64 and their mirrors do not fit into 128 samples
+    EXPECT_FALSE(modem.configure(2 * OFDM_SUBCARRIERS));
+    ASSERT_TRUE(modem.configure(1000));
+    EXPECT_EQ(modem.getSymbolSize(), 1250);
+    EXPECT_EQ(modem.getSignalSize(0), 0);
+    EXPECT_EQ(modem.getSignalSize(4), 2 * 1250);
+    EXPECT_EQ(modem.getSignalSize(OFDM_BITS_PER_SYMBOL + 4), 3 * 1250);
+    EXPECT_EQ(modem.getMaxBitCount(3 * 1250 + 10), 2 * OFDM_BITS_PER_SYMBOL);
+
+    EXPECT_EQ(toModulationType("OFDM"), ModulationType::OFDM);
+    Modulator modulator(5.0, "1101");
+    EXPECT_THROW(modulator.openStream(ModulationType::OFDM, [](double *, size_t) {}), std::invalid_argument);
+    modulator.setBinaryInput("110");
+    std::vector<double> signal;
+    EXPECT_THROW(modulator.modulate(ModulationType::OFDM, signal), std::invalid_argument);
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    ::testing::AddGlobalTestEnvironment(new OfdmTestingEnvironment);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,58 @@
+#include "oscillator.h"
+#include <gtest/gtest.h>
+#include <cmath>
+
+/// @brief The sample rate used in server database
+constexpr double TEST_SAMPLE_RATE = 5000.0;
+
+/// @brief Test the generated tone stays within the error bound of std::cos
+TEST(OscillatorTest, maxErrorAgainstCos)
+{
+    for (double frequency : {1.0, 3.0, 7.0, 10.0, 20.0})
+    {
+        Oscillator oscillator(frequency, TEST_SAMPLE_RATE, -M_PI / 2);
+        double maxError = 0.0;
+        for (size_t sampleIdx = 0; sampleIdx < 200000; ++sampleIdx)
+        {
+            double expected = cos(2 * M_PI * frequency * sampleIdx / TEST_SAMPLE_RATE - M_PI / 2);
+            maxError = std::max(maxError, std::fabs(oscillator.next() - expected));
+        }
+        EXPECT_LE(maxError, OSCILLATOR_MAX_ERROR);
+    }
+}
+
+/// @brief Test seeking gives the same samples as generating continuously
+TEST(OscillatorTest, seekMatchesContinuousPhase)
+{
+    Oscillator continuous(3.0, TEST_SAMPLE_RATE, 0.4);
+    Oscillator seeking(3.0, TEST_SAMPLE_RATE, 0.4);
+    std::vector<double> expected(1666 * 4);
+    continuous.generate(expected.data(), expected.size());
+
+    seeking.seek(1666 * 2);
+    std::vector<double> actual(1666);
+    seeking.generate(actual.data(), actual.size());
+    for (size_t sampleIdx = 0; sampleIdx < actual.size(); ++sampleIdx)
+    {
+        EXPECT_DOUBLE_EQ(actual[sampleIdx], expected[1666 * 2 + sampleIdx]);
+    }
+}
+
+/// @brief Test the quadrature output and the weighted generator
+TEST(OscillatorTest, quadratureComponents)
+{
+    Oscillator reference(5.0, TEST_SAMPLE_RATE);
+    Oscillator weighted(5.0, TEST_SAMPLE_RATE);
+    std::vector<double> signal(1000);
+    weighted.generate(signal.data(), signal.size(), 0.75, -0.25);
+    for (size_t sampleIdx = 0; sampleIdx < signal.size(); ++sampleIdx)
+    {
+        double inPhase = 0.0;
+        double quadrature = 0.0;
+        reference.nextQuadrature(inPhase, quadrature);
+        double angle = 2 * M_PI * 5.0 * sampleIdx / TEST_SAMPLE_RATE;
+        EXPECT_NEAR(inPhase, cos(angle), OSCILLATOR_MAX_ERROR);
+        EXPECT_NEAR(quadrature, sin(angle), OSCILLATOR_MAX_ERROR);
+        EXPECT_NEAR(signal[sampleIdx], 0.75 * inPhase - 0.25 * quadrature, 1e-12);
+    }
+}
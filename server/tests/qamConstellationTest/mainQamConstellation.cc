@@ -0,0 +1,87 @@
+#include "qamConstellation.h"
+#include <gtest/gtest.h>
+#include <random>
+
+/// @brief Check every symbol comes back from its own point and neighbouring levels differ by one bit
+template <unsigned int BitsPerSymbol>
+void checkConstellation()
+{
+    using Constellation = QamConstellation<BitsPerSymbol>;
+    for (unsigned int symbol = 0; symbol < (1u << BitsPerSymbol); ++symbol)
+    {
+        std::complex<double> point = Constellation::map(symbol);
+        double distance = 1.0;
+        EXPECT_EQ(Constellation::slice(point.real(), point.imag(), distance), symbol);
+        EXPECT_DOUBLE_EQ(distance, 0.0);
+        // Less than half the spacing away the point is still sliced to the symbol
+        double offset = 0.45 * Constellation::SPACING;
+        EXPECT_EQ(Constellation::slice(point.real() + offset, point.imag() - offset, distance), symbol);
+    }
+    for (unsigned int levelIdx = 1; levelIdx < Constellation::LEVEL_COUNT; ++levelIdx)
+    {
+        unsigned int changedBits = Constellation::LEVEL_BITS[levelIdx] ^ Constellation::LEVEL_BITS[levelIdx - 1];
+        EXPECT_EQ(changedBits & (changedBits - 1), 0) << "levels " << levelIdx - 1 << " and " << levelIdx;
+        EXPECT_DOUBLE_EQ(Constellation::LEVELS[levelIdx] - Constellation::LEVELS[levelIdx - 1], Constellation::SPACING);
+    }
+    // Values past the outer levels give the outer levels
+    EXPECT_EQ(Constellation::sliceLevel(-3.0), 0);
+    EXPECT_EQ(Constellation::sliceLevel(3.0), Constellation::LEVEL_COUNT - 1);
+}
+
+/// @brief Test the 16, 64 and 256 points constellations
+TEST(QamConstellationTest, mapAndSlice)
+{
+    checkConstellation<4>();
+    checkConstellation<6>();
+    checkConstellation<8>();
+}
+
+/// @brief Test 16-QAM keeps the amplitudes of the 16QAM levels
+TEST(QamConstellationTest, levels)
+{
+    constexpr double expected[] = {-0.75, -0.25, 0.25, 0.75};
+    for (unsigned int levelIdx = 0; levelIdx < 4; ++levelIdx)
+    {
+        EXPECT_DOUBLE_EQ(QamConstellation<4>::LEVELS[levelIdx], expected[levelIdx]);
+    }
+    EXPECT_DOUBLE_EQ(QamConstellation<8>::LEVELS[15], 15.0 / 16.0);
+}
+
+/// @brief Check the soft ratios of random points against the max-log ratio over every point of the constellation,
+/// they must agree in sign everywhere and in value up to half a spacing from the boundary of the bit
+template <unsigned int BitsPerSymbol>
+void checkSoftSlice()
+{
+    using Constellation = QamConstellation<BitsPerSymbol>;
+    std::mt19937 engine(7);
+    std::uniform_real_distribution<double> distribution(-1.3, 1.3);
+    for (size_t pointIdx = 0; pointIdx < 500; ++pointIdx)
+    {
+        std::complex<double> received(distribution(engine), distribution(engine));
+        float llrs[BitsPerSymbol];
+        Constellation::softSlice(received.real(), received.imag(), llrs);
+        for (unsigned int bitIdx = 0; bitIdx < BitsPerSymbol; ++bitIdx)
+        {
+            double closest[2] = {1e9, 1e9};
+            for (unsigned int symbol = 0; symbol < (1u << BitsPerSymbol); ++symbol)
+            {
+                unsigned int bit = (symbol >> (BitsPerSymbol - 1 - bitIdx)) & 1;
+                closest[bit] = std::min(closest[bit], std::norm(received - Constellation::map(symbol)));
+            }
+            double exact = closest[1] - closest[0];
+            EXPECT_EQ(llrs[bitIdx] < 0, exact < 0) << BitsPerSymbol << " bit " << bitIdx;
+            if (std::fabs(llrs[bitIdx]) <= Constellation::SPACING * Constellation::SPACING)
+            {
+                EXPECT_NEAR(llrs[bitIdx], exact, 1e-5) << BitsPerSymbol << " bit " << bitIdx;
+            }
+        }
+    }
+}
+
+/// @brief Test the soft ratios of the 16, 64 and 256 points constellations
+TEST(QamConstellationTest, softSlice)
+{
+    checkSoftSlice<4>();
+    checkSoftSlice<6>();
+    checkSoftSlice<8>();
+}
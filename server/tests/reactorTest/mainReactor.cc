@@ -0,0 +1,247 @@
+#include "reactor.h"
+#include "jobQueue.h"
+#include <gtest/gtest.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    /**
+     * @brief Connect a blocking client to the loopback port
+     *
+     * @param p_port - the port of the reactors
+     * @return the socket, -1 on failure
+     */
+    int connectClient(const uint16_t p_port)
+    {
+        int socketFd = socket(AF_INET, SOCK_STREAM, 0);
+        struct sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = inet_addr("127.0.0.1");
+        address.sin_port = htons(p_port);
+        if (connect(socketFd, (struct sockaddr *)&address, sizeof(address)) == -1)
+        {
+            close(socketFd);
+            return -1;
+        }
+        return socketFd;
+    }
+
+    /**
+     * @brief Send request frames at once
+     *
+     * @param p_socket - a blocking client socket
+     * @param p_requests - the payloads of the requests
+     * @return false if the connection failed
+     */
+    bool sendRequests(const int p_socket, const std::vector<std::string> &p_requests)
+    {
+        FrameWriter writer;
+        for (const std::string &request : p_requests)
+        {
+            writer.push(request);
+        }
+        return writer.flush(p_socket) == SocketStatus::OPEN && writer.getPendingSize() == 0;
+    }
+
+    /**
+     * @brief Wait for the next reply frame
+     *
+     * @param p_socket - a blocking client socket
+     * @return the payload of the reply, empty if the connection failed
+     */
+    std::string receiveReply(const int p_socket)
+    {
+        std::string header(FRAME_HEADER_SIZE, '\0');
+        if (recv(p_socket, header.data(), header.size(), MSG_WAITALL) != static_cast<ssize_t>(header.size()))
+        {
+            return "";
+        }
+        size_t size = 0;
+        for (char byte : header)
+        {
+            size = (size << 8) | static_cast<unsigned char>(byte);
+        }
+        std::string reply(size, '\0');
+        if (size != 0 && recv(p_socket, reply.data(), size, MSG_WAITALL) != static_cast<ssize_t>(size))
+        {
+            return "";
+        }
+        return reply;
+    }
+
+    /**
+     * @brief Send one request frame and wait for its reply frame
+     *
+     * @param p_socket - a blocking client socket
+     * @param p_request - the payload of the request
+     * @return the payload of the reply, empty if the connection failed
+     */
+    std::string requestReply(const int p_socket, const std::string &p_request)
+    {
+        if (!sendRequests(p_socket, {p_request}))
+        {
+            return "";
+        }
+        return receiveReply(p_socket);
+    }
+}
+
+/// @brief Test reactors sharing a port with SO_REUSEPORT each answer their share of the clients on their own thread
+TEST(ReactorTest, reactorsShareThePort)
+{
+    const size_t reactorCount = 2;
+    std::atomic<bool> isRunning(true);
+    std::vector<std::unique_ptr<Reactor>> reactors;
+    for (size_t reactorIdx = 0; reactorIdx < reactorCount; ++reactorIdx)
+    {
+        reactors.push_back(std::make_unique<Reactor>(reactorIdx, 1 << 20,
+                                                     [reactorIdx](Session &, const std::string &p_request, const ReplySink &p_reply)
+                                                     { p_reply(std::to_string(reactorIdx) + ":" + p_request); }));
+    }
+    // The first reactor lets the kernel choose the port, the others join it
+    ASSERT_TRUE(reactors[0].get()->listen("127.0.0.1", 0));
+    uint16_t port = reactors[0].get()->getPort();
+    ASSERT_NE(port, 0);
+    for (size_t reactorIdx = 1; reactorIdx < reactorCount; ++reactorIdx)
+    {
+        ASSERT_TRUE(reactors[reactorIdx].get()->listen("127.0.0.1", port));
+        EXPECT_EQ(reactors[reactorIdx].get()->getPort(), port);
+    }
+    std::vector<std::thread> loops;
+    for (auto &reactor : reactors)
+    {
+        loops.emplace_back([&]()
+                           { reactor.get()->run(isRunning); });
+    }
+
+    const size_t clientCount = 32;
+    std::vector<int> clients;
+    std::vector<size_t> answeredBy(reactorCount, 0);
+    for (size_t clientIdx = 0; clientIdx < clientCount; ++clientIdx)
+    {
+        int client = connectClient(port);
+        ASSERT_NE(client, -1);
+        clients.push_back(client);
+        std::string request = "request " + std::to_string(clientIdx);
+        std::string reply = requestReply(client, request);
+        ASSERT_EQ(reply.size(), request.size() + 2) << reply;
+        EXPECT_EQ(reply.substr(2), request);
+        size_t reactorIdx = reply[0] - '0';
+        ASSERT_LT(reactorIdx, reactorCount);
+        ++answeredBy[reactorIdx];
+        // A connection stays on the reactor that accepted it
+        EXPECT_EQ(requestReply(client, "again"), reply.substr(0, 2) + "again");
+    }
+    size_t connected = 0;
+    for (size_t reactorIdx = 0; reactorIdx < reactorCount; ++reactorIdx)
+    {
+        EXPECT_EQ(reactors[reactorIdx].get()->getConnectionCount(), answeredBy[reactorIdx]);
+        EXPECT_GT(answeredBy[reactorIdx], 0u) << reactorIdx;
+        connected += answeredBy[reactorIdx];
+    }
+    EXPECT_EQ(connected, clientCount);
+
+    for (int client : clients)
+    {
+        close(client);
+    }
+    isRunning = false;
+    for (auto &loop : loops)
+    {
+        loop.join();
+    }
+}
+
+/// @brief Test replies given by a worker keep the request order of their client and never delay other clients
+TEST(ReactorTest, workerRepliesKeepRequestOrder)
+{
+    std::atomic<bool> isRunning(true);
+    std::atomic<bool> isSlowDone(false);
+    JobQueue workers(1);
+    Reactor reactor(0, 1 << 20, [&](Session &, const std::string &p_request, const ReplySink &p_reply)
+                    {
+                        if (p_request != "slow")
+                        {
+                            p_reply("done " + p_request);
+                            return;
+                        }
+                        workers.push([&, p_reply](size_t)
+                                     {
+                                         std::this_thread::sleep_for(std::chrono::milliseconds(300));
+                                         isSlowDone = true;
+                                         p_reply("done slow");
+                                     });
+                    });
+    ASSERT_TRUE(reactor.listen("127.0.0.1", 0));
+    std::thread loop([&]()
+                     { reactor.run(isRunning); });
+
+    int slowClient = connectClient(reactor.getPort());
+    int fastClient = connectClient(reactor.getPort());
+    ASSERT_NE(slowClient, -1);
+    ASSERT_NE(fastClient, -1);
+    ASSERT_TRUE(sendRequests(slowClient, {"slow", "fast"}));
+
+    // The loop answers the other client while the worker is busy
+    EXPECT_EQ(requestReply(fastClient, "other"), "done other");
+    EXPECT_FALSE(isSlowDone);
+
+    // The fast request waited for the slow one sent before it
+    EXPECT_EQ(receiveReply(slowClient), "done slow");
+    EXPECT_EQ(receiveReply(slowClient), "done fast");
+
+    close(slowClient);
+    close(fastClient);
+    isRunning = false;
+    loop.join();
+}
+
+/// @brief Test every connection has its own session and a closed connection gives a reset session back
+TEST(ReactorTest, sessionsBelongToOneConnection)
+{
+    std::atomic<bool> isRunning(true);
+    Reactor reactor(0, 1 << 20, [](Session &p_session, const std::string &p_request, const ReplySink &p_reply)
+                    {
+                        if (p_request != "get")
+                        {
+                            p_session.carrier.setNetwork(p_request);
+                        }
+                        p_reply(p_session.carrier.getNetwork());
+                    });
+    ASSERT_TRUE(reactor.listen("127.0.0.1", 0));
+    std::thread loop([&]()
+                     { reactor.run(isRunning); });
+
+    int firstClient = connectClient(reactor.getPort());
+    int secondClient = connectClient(reactor.getPort());
+    ASSERT_NE(firstClient, -1);
+    ASSERT_NE(secondClient, -1);
+    EXPECT_EQ(requestReply(firstClient, "4G"), "4G");
+    EXPECT_EQ(requestReply(secondClient, "get"), "");
+    EXPECT_EQ(requestReply(secondClient, "5G"), "5G");
+    EXPECT_EQ(requestReply(firstClient, "get"), "4G");
+
+    close(firstClient);
+    while (reactor.getConnectionCount() != 1)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    int nextClient = connectClient(reactor.getPort());
+    ASSERT_NE(nextClient, -1);
+    EXPECT_EQ(requestReply(nextClient, "get"), "");
+    EXPECT_EQ(requestReply(secondClient, "get"), "5G");
+
+    close(nextClient);
+    close(secondClient);
+    isRunning = false;
+    loop.join();
+}
@@ -0,0 +1,54 @@
+#include "sampleFormat.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+/// @brief Test amplitudes are rounded to the closest Q15 step and saturate at full scale
+TEST(SampleFormatTest, q15Saturation)
+{
+    EXPECT_EQ(SampleFormat<Q15>::fromAmplitude(0.0), 0);
+    EXPECT_EQ(SampleFormat<Q15>::fromAmplitude(1.0), static_cast<Q15>(SAMPLE_Q15_SCALE));
+    EXPECT_EQ(SampleFormat<Q15>::fromAmplitude(-0.5), static_cast<Q15>(-SAMPLE_Q15_SCALE / 2));
+    EXPECT_EQ(SampleFormat<Q15>::fromAmplitude(1.4 / SAMPLE_Q15_SCALE), 1);
+    EXPECT_EQ(SampleFormat<Q15>::fromAmplitude(-1.6 / SAMPLE_Q15_SCALE), -2);
+    EXPECT_EQ(SampleFormat<Q15>::fromAmplitude(SAMPLE_Q15_FULL_SCALE), INT16_MAX);
+    EXPECT_EQ(SampleFormat<Q15>::fromAmplitude(-SAMPLE_Q15_FULL_SCALE), INT16_MIN);
+    EXPECT_EQ(SampleFormat<Q15>::fromAmplitude(1e12), INT16_MAX);
+    EXPECT_EQ(SampleFormat<Q15>::fromAmplitude(-1e12), INT16_MIN);
+
+    EXPECT_EQ(saturateQ15(INT16_MAX + 1), INT16_MAX);
+    EXPECT_EQ(saturateQ15(INT16_MIN - 1), INT16_MIN);
+    EXPECT_EQ(saturateQ15(-1234), -1234);
+}
+
+/// @brief Test every format gives back the amplitudes within its resolution
+TEST(SampleFormatTest, roundTrip)
+{
+    std::vector<double> amplitudes;
+    for (int valueIdx = -1000; valueIdx <= 1000; ++valueIdx)
+    {
+        amplitudes.push_back(valueIdx * 0.00173);
+    }
+    std::vector<double> converted(amplitudes.size());
+
+    std::vector<float> floatSamples(amplitudes.size());
+    toSamples(amplitudes.data(), amplitudes.size(), floatSamples.data());
+    toAmplitudes(floatSamples.data(), floatSamples.size(), converted.data());
+    for (size_t sampleIdx = 0; sampleIdx < amplitudes.size(); ++sampleIdx)
+    {
+        EXPECT_NEAR(converted[sampleIdx], amplitudes[sampleIdx], 1e-6);
+    }
+
+    std::vector<Q15> q15Samples(amplitudes.size());
+    toSamples(amplitudes.data(), amplitudes.size(), q15Samples.data());
+    toAmplitudes(q15Samples.data(), q15Samples.size(), converted.data());
+    for (size_t sampleIdx = 0; sampleIdx < amplitudes.size(); ++sampleIdx)
+    {
+        EXPECT_LE(std::fabs(converted[sampleIdx] - amplitudes[sampleIdx]), 0.5 / SAMPLE_Q15_SCALE);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
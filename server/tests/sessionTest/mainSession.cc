@@ -0,0 +1,42 @@
+#include "session.h"
+#include <gtest/gtest.h>
+
+/// @brief Test a released session is reset and handed to the next client
+TEST(SessionPoolTest, reusesResetSessions)
+{
+    SessionPool pool;
+    std::unique_ptr<Session> session = pool.acquire();
+    ASSERT_TRUE(session);
+    EXPECT_FALSE(session.get()->carrier.getCarrierStatus());
+    ASSERT_TRUE(session.get()->carrier.setNetwork("4G"));
+    session.get()->carrier.setFrequency(5);
+    Session *released = session.get();
+    pool.release(std::move(session));
+    EXPECT_FALSE(session);
+    EXPECT_EQ(pool.getFreeCount(), 1u);
+
+    std::unique_ptr<Session> reused = pool.acquire();
+    EXPECT_EQ(reused.get(), released);
+    EXPECT_EQ(pool.getFreeCount(), 0u);
+    EXPECT_FALSE(reused.get()->carrier.getCarrierStatus());
+    EXPECT_EQ(reused.get()->carrier.getNetwork(), "");
+    EXPECT_EQ(reused.get()->carrier.getFrequency(), 0u);
+}
+
+/// @brief Test the pool keeps at most its capacity of released sessions
+TEST(SessionPoolTest, freesSessionsAboveCapacity)
+{
+    SessionPool pool(2);
+    std::vector<std::unique_ptr<Session>> sessions;
+    for (int sessionIdx = 0; sessionIdx < 4; ++sessionIdx)
+    {
+        sessions.push_back(pool.acquire());
+    }
+    for (std::unique_ptr<Session> &session : sessions)
+    {
+        pool.release(std::move(session));
+    }
+    EXPECT_EQ(pool.getFreeCount(), 2u);
+    pool.release(nullptr);
+    EXPECT_EQ(pool.getFreeCount(), 2u);
+}
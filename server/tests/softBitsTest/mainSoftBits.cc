@@ -0,0 +1,88 @@
+#include "softBits.h"
+#include "simd.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace
+{
+    /**
+     * @brief Draw ratios around 0, with exact zeros, negative zeros and values past the quantized range
+     *
+     * @param p_size - the amount of ratios
+     * @return the ratios
+     */
+    std::vector<float> randomLlrs(const size_t p_size)
+    {
+        std::mt19937 engine(5);
+        std::uniform_real_distribution<float> distribution(-40.0f, 40.0f);
+        std::vector<float> llrs(p_size);
+        for (size_t llrIdx = 0; llrIdx < p_size; ++llrIdx)
+        {
+            llrs[llrIdx] = distribution(engine);
+        }
+        if (p_size > 2)
+        {
+            llrs[1] = 0.0f;
+            llrs[2] = -0.0f;
+        }
+        return llrs;
+    }
+}
+
+/// @brief Test every instruction set rounds to the closest step and saturates as the scalar definition
+TEST(SoftBitsTest, quantizeSaturatesAtEveryLevel)
+{
+    SimdLevel bestLevel = getSimdLevel();
+    const float scale = 4.0f;
+    for (size_t size : {0, 1, 15, 16, 17, 100, 1027})
+    {
+        std::vector<float> llrs = randomLlrs(size);
+        for (SimdLevel level : {SimdLevel::SCALAR, SimdLevel::SSE2, SimdLevel::AVX2})
+        {
+            setSimdLevel(level);
+            std::vector<int8_t> quantized(size);
+            quantizeLlrs(llrs.data(), size, scale, quantized.data());
+            for (size_t llrIdx = 0; llrIdx < size; ++llrIdx)
+            {
+                float step = std::fmax(std::fmin(llrs[llrIdx] * scale, LLR_INT8_MAX), -LLR_INT8_MAX);
+                EXPECT_EQ(quantized[llrIdx], static_cast<int8_t>(std::nearbyint(step)))
+                    << toString(level) << " " << size << " " << llrIdx;
+            }
+        }
+    }
+    setSimdLevel(bestLevel);
+}
+
+/// @brief Test the hard decision is the sign of every ratio and leaves the bits past the end at 0
+TEST(SoftBitsTest, hardDecideTakesTheSign)
+{
+    SimdLevel bestLevel = getSimdLevel();
+    for (size_t size : {0, 1, 63, 64, 65, 200})
+    {
+        std::vector<float> llrs = randomLlrs(size);
+        for (SimdLevel level : {SimdLevel::SCALAR, SimdLevel::SSE2, SimdLevel::AVX2})
+        {
+            setSimdLevel(level);
+            // A stream of ones shows the words are rebuilt rather than merged
+            BitStream bits;
+            bits.resize(256);
+            for (size_t bitIdx = 0; bitIdx < bits.size(); ++bitIdx)
+            {
+                bits.set(bitIdx, true);
+            }
+            hardDecide(llrs.data(), size, bits);
+            ASSERT_EQ(bits.size(), size);
+            for (size_t llrIdx = 0; llrIdx < size; ++llrIdx)
+            {
+                EXPECT_EQ(bits.get(llrIdx), std::signbit(llrs[llrIdx])) << toString(level) << " " << llrIdx;
+            }
+            if (size % BITSTREAM_WORD_BITS != 0)
+            {
+                EXPECT_EQ(bits.data()[size / BITSTREAM_WORD_BITS] >> (size % BITSTREAM_WORD_BITS), 0u);
+            }
+        }
+    }
+    setSimdLevel(bestLevel);
+}
@@ -0,0 +1,105 @@
+#include "modulator.h"
+#include "serverCommon.h"
+#include <gtest/gtest.h>
+
+/// @brief The database directory of server, relative to the tests directory
+constexpr const char *TEST_DATABASE_PATH = "../db";
+
+/// @brief Testing environment class for streaming demodulator to be able to work with Database
+class StreamingDemodulatorTestingEnvironment : public ::testing::Environment
+{
+public:
+    void SetUp() override
+    {
+        InMemDatabase::getInstance().init(TEST_DATABASE_PATH);
+    }
+};
+
+/// @brief Test blocks of any size give the same bits as demodulating the whole signal at once
+TEST(StreamingDemodulatorTest, matchesWholeSignal)
+{
+    const std::string binaryData = "10110011100011110100001011010110010111001010011101100001";
+    // 3 Hz does not divide the sample rate, so the carrier phase differs from one symbol to the next
+    for (double frequency : {3.0, 5.0})
+    {
+        Modulator modulator(frequency, binaryData);
+        for (ModulationType type : {ModulationType::ASK, ModulationType::BPSK, ModulationType::BFSK, ModulationType::QAM16})
+        {
+            std::vector<double> signal;
+            modulator.modulate(type, signal);
+            std::string expected;
+            modulator.demodulate(signal, type, expected);
+            ASSERT_EQ(expected, binaryData) << toNetwork(type);
+            // Block sizes which never line up with the symbol windows
+            for (size_t blockSize : std::vector<size_t>{1, 999, 1667, STREAMING_BLOCK_SAMPLES})
+            {
+                BitStream received;
+                StreamingDemodulator stream = modulator.openDemodulationStream(type, [&](const BitStream &p_bits)
+                                                                               { received.append(p_bits); });
+                for (size_t position = 0; position < signal.size(); position += blockSize)
+                {
+                    stream.write(signal.data() + position, std::min(blockSize, signal.size() - position));
+                }
+
+                EXPECT_EQ(received.toAscii(), expected) << toNetwork(type) << " block " << blockSize;
+                EXPECT_EQ(stream.getSampleCount(), signal.size());
+                EXPECT_EQ(stream.getSymbolCount(), binaryData.size() / getBitsPerSymbol(type));
+                EXPECT_EQ(stream.getErrorCount(), 0);
+            }
+        }
+    }
+}
+
+/// @brief Test a partial window waits for its last sample and reset() drops it
+TEST(StreamingDemodulatorTest, partialWindow)
+{
+    Modulator modulator(5.0, "1101");
+    std::vector<double> signal;
+    modulator.modulate(ModulationType::QAM16, signal);
+    BitStream received;
+    StreamingDemodulator stream = modulator.openDemodulationStream(ModulationType::QAM16, [&](const BitStream &p_bits)
+                                                                   { received.append(p_bits); });
+    stream.write(signal.data(), signal.size() - 1);
+    EXPECT_EQ(stream.getSymbolCount(), 0);
+    EXPECT_TRUE(received.empty());
+    stream.write(signal.data() + signal.size() - 1, 1);
+    EXPECT_EQ(stream.getSymbolCount(), 1);
+    EXPECT_EQ(received.toAscii(), "1101");
+
+    stream.reset();
+    received.clear();
+    stream.write(signal.data(), signal.size() / 2);
+    stream.reset();
+    stream.write(signal.data(), signal.size());
+    EXPECT_EQ(stream.getSampleCount(), signal.size());
+    EXPECT_EQ(received.toAscii(), "1101");
+
+    EXPECT_THROW(modulator.openDemodulationStream(ModulationType::UNKNOWN, [](const BitStream &) {}), std::invalid_argument);
+}
+
+/// @brief Test appending streams which do not end on a word boundary
+TEST(StreamingDemodulatorTest, appendBits)
+{
+    std::string expected;
+    BitStream bits;
+    for (size_t size : std::vector<size_t>{1, 63, 2, 64, 65, 7, 130})
+    {
+        std::string chunk;
+        for (size_t bitIdx = 0; bitIdx < size; ++bitIdx)
+        {
+            chunk += ((bitIdx * 7 + size) % 3 == 0) ? '1' : '0';
+        }
+        BitStream chunkBits;
+        chunkBits.assignAscii(chunk);
+        bits.append(chunkBits);
+        expected += chunk;
+        ASSERT_EQ(bits.toAscii(), expected);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    ::testing::AddGlobalTestEnvironment(new StreamingDemodulatorTestingEnvironment);
+    return RUN_ALL_TESTS();
+}
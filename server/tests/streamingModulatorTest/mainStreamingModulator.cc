@@ -0,0 +1,143 @@
+#include "modulator.h"
+#include "serverCommon.h"
+#include <gtest/gtest.h>
+
+/// @brief The database directory of server, relative to the tests directory
+constexpr const char *TEST_DATABASE_PATH = "../db";
+
+/// @brief Testing environment class for streaming modulator to be able to work with Database
+class StreamingModulatorTestingEnvironment : public ::testing::Environment
+{
+public:
+    void SetUp() override
+    {
+        InMemDatabase::getInstance().init(TEST_DATABASE_PATH);
+    }
+};
+
+/// @brief Split a binary data series into chunks of the given sizes, cycling through them
+std::vector<BitStream> splitBits(const std::string &p_binaryData, const std::vector<size_t> &p_chunkSizes)
+{
+    std::vector<BitStream> chunks;
+    size_t position = 0;
+    for (size_t chunkIdx = 0; position < p_binaryData.size(); ++chunkIdx)
+    {
+        size_t size = std::min(p_chunkSizes[chunkIdx % p_chunkSizes.size()], p_binaryData.size() - position);
+        BitStream chunk;
+        chunk.assignAscii(p_binaryData.substr(position, size));
+        chunks.push_back(chunk);
+        position += size;
+    }
+    return chunks;
+}
+
+/// @brief Test chunked writes give the same samples as modulating the whole message at once
+TEST(StreamingModulatorTest, matchesWholeMessage)
+{
+    const std::string binaryData = "10110011100011110100001011010110010111001010011101100001";
+    // 3 Hz does not divide the sample rate, so the carrier phase differs from one symbol to the next
+    for (double frequency : {3.0, 5.0})
+    {
+        Modulator modulator(frequency, binaryData);
+        for (ModulationType type : {ModulationType::ASK, ModulationType::BPSK, ModulationType::BFSK, ModulationType::QAM16})
+        {
+            std::vector<double> expected;
+            modulator.modulate(type, expected);
+            for (size_t blockSize : std::vector<size_t>{1000, 1667, STREAMING_BLOCK_SAMPLES})
+            {
+                std::vector<double> streamed;
+                std::vector<size_t> blockSizes;
+                auto collect = [&](double *p_samples, size_t p_count)
+                {
+                    streamed.insert(streamed.end(), p_samples, p_samples + p_count);
+                    blockSizes.push_back(p_count);
+                };
+                StreamingModulator stream = modulator.openStream(type, collect, blockSize);
+                for (const BitStream &chunk : splitBits(binaryData, {3, 1, 8, 5}))
+                {
+                    stream.write(chunk);
+                }
+                stream.flush();
+
+                EXPECT_EQ(stream.getPendingBits(), 0);
+                EXPECT_EQ(stream.getSymbolCount(), binaryData.size() / getBitsPerSymbol(type));
+                ASSERT_EQ(streamed.size(), expected.size());
+                for (size_t sampleIdx = 0; sampleIdx < expected.size(); ++sampleIdx)
+                {
+                    ASSERT_DOUBLE_EQ(streamed[sampleIdx], expected[sampleIdx]) << toNetwork(type) << " sample " << sampleIdx;
+                }
+                // Every block is full except the last one
+                for (size_t blockIdx = 0; blockIdx + 1 < blockSizes.size(); ++blockIdx)
+                {
+                    EXPECT_EQ(blockSizes[blockIdx], blockSize);
+                }
+            }
+        }
+    }
+}
+
+/// @brief Test a symbol split over two writes waits for its last bit
+TEST(StreamingModulatorTest, pendingSymbolBits)
+{
+    Modulator modulator(5.0, "");
+    size_t emitted = 0;
+    auto count = [&](double *, size_t p_count)
+    {
+        emitted += p_count;
+    };
+    StreamingModulator stream = modulator.openStream(ModulationType::QAM16, count, 1);
+    BitStream bits;
+    bits.assignAscii("101");
+    stream.write(bits);
+    EXPECT_EQ(stream.getPendingBits(), 3);
+    EXPECT_EQ(emitted, 0);
+    bits.assignAscii("1");
+    stream.write(bits);
+    EXPECT_EQ(stream.getPendingBits(), 0);
+    EXPECT_EQ(stream.getSymbolCount(), 1);
+    // One symbol window at 5 Hz and 5000 samples per second
+    EXPECT_EQ(emitted, 1000);
+
+    EXPECT_THROW(modulator.openStream(ModulationType::UNKNOWN, count), std::invalid_argument);
+}
+
+/// @brief Test long writes modulated on a thread pool give the same blocks as one thread
+TEST(StreamingModulatorTest, parallelBatches)
+{
+    std::string binaryData;
+    for (size_t bitIdx = 0; bitIdx < 4 * 3 * PARALLEL_MODULATION_MIN_SYMBOLS + 3; ++bitIdx)
+    {
+        binaryData += (bitIdx * 7 + bitIdx / 5) % 2 ? '1' : '0';
+    }
+    Modulator modulator(3.0, "");
+    ThreadPool pool(3);
+    for (ModulationType type : {ModulationType::ASK, ModulationType::BPSK, ModulationType::BFSK, ModulationType::QAM16})
+    {
+        std::vector<double> expected;
+        std::vector<double> streamed;
+        modulator.setThreadPool(nullptr);
+        StreamingModulator serial = modulator.openStream(type, [&](double *p_samples, size_t p_count)
+                                                         { expected.insert(expected.end(), p_samples, p_samples + p_count); }, 1667);
+        modulator.setThreadPool(&pool);
+        StreamingModulator parallel = modulator.openStream(type, [&](double *p_samples, size_t p_count)
+                                                           { streamed.insert(streamed.end(), p_samples, p_samples + p_count); }, 1667);
+        // A short write leaves a symbol open, the long one completes it before splitting the rest
+        for (const BitStream &chunk : splitBits(binaryData, {3, binaryData.size()}))
+        {
+            serial.write(chunk);
+            parallel.write(chunk);
+        }
+        serial.flush();
+        parallel.flush();
+        EXPECT_EQ(parallel.getSymbolCount(), serial.getSymbolCount());
+        EXPECT_EQ(parallel.getPendingBits(), serial.getPendingBits());
+        EXPECT_EQ(streamed, expected) << toNetwork(type);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    ::testing::AddGlobalTestEnvironment(new StreamingModulatorTestingEnvironment);
+    return RUN_ALL_TESTS();
+}
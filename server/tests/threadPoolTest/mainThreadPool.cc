@@ -0,0 +1,63 @@
+#include "threadPool.h"
+#include <atomic>
+#include <gtest/gtest.h>
+
+/// @brief Test every index is handed to exactly one range
+TEST(ThreadPoolTest, coversEveryIndexOnce)
+{
+    for (size_t threads : std::vector<size_t>{1, 2, 3, 8})
+    {
+        ThreadPool pool(threads);
+        EXPECT_EQ(pool.getThreadCount(), threads);
+        for (size_t count : std::vector<size_t>{0, 1, 2, 7, 1000})
+        {
+            std::vector<std::atomic<int>> visits(count);
+            std::atomic<size_t> ranges(0);
+            pool.parallelFor(count, [&](size_t p_begin, size_t p_end)
+                             {
+                                 EXPECT_LT(p_begin, p_end);
+                                 ++ranges;
+                                 for (size_t index = p_begin; index < p_end; ++index)
+                                 {
+                                     ++visits[index];
+                                 } });
+            for (size_t index = 0; index < count; ++index)
+            {
+                ASSERT_EQ(visits[index], 1) << threads << " threads, index " << index;
+            }
+            size_t expectedRanges = threads == 1 ? std::min<size_t>(count, 1) : std::min(threads * THREAD_POOL_RANGES_PER_THREAD, count);
+            EXPECT_EQ(ranges, expectedRanges);
+        }
+    }
+}
+
+/// @brief Test ranges left by a busy thread are stolen by the others
+TEST(ThreadPoolTest, idleThreadsStealRanges)
+{
+    ThreadPool pool(4);
+    std::atomic<bool> isReleased(false);
+    std::atomic<size_t> finished(0);
+    // The first range blocks its thread until every other range is done, which needs the others to steal its share
+    pool.parallelFor(4 * THREAD_POOL_RANGES_PER_THREAD, [&](size_t p_begin, size_t)
+                     {
+                         if (p_begin == 0)
+                         {
+                             while (finished != 4 * THREAD_POOL_RANGES_PER_THREAD - 1)
+                             {
+                                 std::this_thread::yield();
+                             }
+                             isReleased = true;
+                         }
+                         ++finished; });
+    EXPECT_TRUE(isReleased);
+    EXPECT_EQ(finished, 4 * THREAD_POOL_RANGES_PER_THREAD);
+}
+
+/// @brief Test a pool of 1 thread runs the range on the caller
+TEST(ThreadPoolTest, singleThreadRunsOnCaller)
+{
+    ThreadPool pool(1);
+    std::thread::id caller = std::this_thread::get_id();
+    pool.parallelFor(10, [&](size_t, size_t)
+                     { EXPECT_EQ(std::this_thread::get_id(), caller); });
+}
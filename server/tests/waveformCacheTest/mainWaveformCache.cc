@@ -0,0 +1,77 @@
+#include "waveformCache.h"
+#include "oscillator.h"
+#include <gtest/gtest.h>
+#include <cmath>
+
+/// @brief The sample rate used in server database
+constexpr int TEST_SAMPLE_RATE = 5000;
+
+/// @brief Two symbols on one carrier with opposite phase
+const std::vector<SymbolShape> TEST_SHAPES = {{1.0, -M_PI / 2, 1.0, 0.0}, {1.0, -M_PI / 2, -1.0, 0.0}};
+
+/// @brief Generate a symbol window directly with the oscillator
+std::vector<double> generateReference(const SymbolShape &p_shape, const double p_frequency,
+                                      const size_t p_samplesPerSymbol, const uint64_t p_symbolIndex)
+{
+    std::vector<double> waveform(p_samplesPerSymbol);
+    Oscillator tone(p_shape.frequencyIndex * p_frequency, TEST_SAMPLE_RATE, p_shape.phase);
+    tone.seek(p_symbolIndex * p_samplesPerSymbol);
+    tone.generate(waveform.data(), waveform.size(), p_shape.inPhase, p_shape.quadrature);
+    return waveform;
+}
+
+/// @brief Test the phase period of coherent and non coherent symbol windows
+TEST(WaveformCacheTest, phasePeriod)
+{
+    // 5000 / 5 = 1000 samples per symbol hold exactly one carrier cycle
+    WaveformTable coherent({"3G", 5.0, TEST_SAMPLE_RATE}, TEST_SHAPES, 1000);
+    EXPECT_TRUE(coherent.isCached());
+    EXPECT_EQ(coherent.getPhaseCount(), 1);
+
+    // 3 Hz over 1666 samples is 0.9996 cycles, the window phase repeats after 2500 symbols
+    WaveformTable nonCoherent({"3G", 3.0, TEST_SAMPLE_RATE}, TEST_SHAPES, 1666);
+    EXPECT_FALSE(nonCoherent.isCached());
+
+    // 8 Hz over 625 samples is exactly one cycle, a second tone at 2.5 Hz needs 2 symbols
+    std::vector<SymbolShape> twoTones = {{1.0, 0.0, 1.0, 0.0}, {2.5, 0.0, 1.0, 0.0}};
+    WaveformTable twoToneTable({"4G", 8.0, TEST_SAMPLE_RATE}, twoTones, 625);
+    EXPECT_EQ(twoToneTable.getPhaseCount(), 2);
+}
+
+/// @brief Test cached and generated symbols give the same waveform at any position
+TEST(WaveformCacheTest, writeSymbolMatchesOscillator)
+{
+    for (double frequency : {3.0, 4.0, 8.0})
+    {
+        size_t samplesPerSymbol = TEST_SAMPLE_RATE / static_cast<size_t>(frequency);
+        std::vector<SymbolShape> twoTones = {{1.0, -M_PI / 2, 1.0, 0.0}, {2.5, -M_PI / 2, 0.5, -0.25}};
+        WaveformTable table({"4G", frequency, TEST_SAMPLE_RATE}, twoTones, samplesPerSymbol);
+        std::vector<double> waveform(samplesPerSymbol);
+        for (uint64_t symbolIndex : {0, 1, 2, 7, 1001})
+        {
+            for (unsigned int symbol = 0; symbol < twoTones.size(); ++symbol)
+            {
+                table.writeSymbol(symbolIndex, symbol, waveform.data());
+                std::vector<double> expected = generateReference(twoTones[symbol], frequency, samplesPerSymbol, symbolIndex);
+                for (size_t sampleIdx = 0; sampleIdx < samplesPerSymbol; ++sampleIdx)
+                {
+                    EXPECT_NEAR(waveform[sampleIdx], expected[sampleIdx], 1e-9);
+                }
+            }
+        }
+    }
+}
+
+/// @brief Test the cache keeps one table per network, frequency and sample rate
+TEST(WaveformCacheTest, cacheKey)
+{
+    WaveformCache cache;
+    WaveformKey key{"2G", 5.0, TEST_SAMPLE_RATE};
+    EXPECT_EQ(cache.find(key), nullptr);
+    const WaveformTable &table = cache.insert(key, TEST_SHAPES, 1000);
+    EXPECT_EQ(cache.find(key), &table);
+    EXPECT_EQ(cache.find({"3G", 5.0, TEST_SAMPLE_RATE}), nullptr);
+    EXPECT_EQ(cache.find({"2G", 4.0, TEST_SAMPLE_RATE}), nullptr);
+    cache.clear();
+    EXPECT_EQ(cache.find(key), nullptr);
+}